@@ -29,6 +29,7 @@ import openrazer_daemon.hardware
 from openrazer_daemon.dbus_services.service import DBusService
 from openrazer_daemon.device import DeviceCollection
 from openrazer_daemon.misc.screensaver_monitor import ScreensaverMonitor
+from openrazer_daemon.misc.scheduler import get_scheduler
 
 
 class RazerDaemon(DBusService):
@@ -98,11 +99,14 @@ class RazerDaemon(DBusService):
 
         # Load Classes
         self._device_classes = openrazer_daemon.hardware.get_device_classes()
+        self._device_index = openrazer_daemon.hardware.get_device_class_index(self._device_classes)
 
         self.logger.info("Initialising Daemon (v%s). Pid: %d", __version__, os.getpid())
         self._init_screensaver_monitor()
 
         self._razer_devices = DeviceCollection()
+        # USB parent -> device ID, to attach other interfaces of a device as they appear
+        self._usb_parents = {}
         self._load_devices(first_run=True)
 
         # Add DBus methods
@@ -296,6 +300,9 @@ class RazerDaemon(DBusService):
         """
         Suspend all devices
         """
+        # Periodic jobs like battery checks don't need to run while suspended
+        get_scheduler().suspend()
+
         for device in self._razer_devices:
             device.dbus.suspend_device()
 
@@ -306,6 +313,8 @@ class RazerDaemon(DBusService):
         for device in self._razer_devices:
             device.dbus.resume_device()
 
+        get_scheduler().resume()
+
     def get_serial_list(self):
         """
         Get list of devices serials
@@ -354,107 +363,128 @@ class RazerDaemon(DBusService):
 
                 self.logger.debug(format_str.format(cls.__name__ + ' ', cls.USB_VID, cls.USB_PID))
 
+        # Interoperability between generic list of 0000:0000:0000.0000 and pyudev
         if self._test_dir is not None:
-            device_list = os.listdir(self._test_dir)
-            test_mode = True
+            # TODO add testdir support for additional interfaces
+            device_list = [(sys_name, os.path.join(self._test_dir, sys_name), None) for sys_name in os.listdir(self._test_dir)]
         else:
-            device_list = list(self._udev_context.list_devices(subsystem='hid'))
-            test_mode = False
+            device_list = [(device.sys_name, device.sys_path, self._get_usb_parent(device)) for device in self._udev_context.list_devices(subsystem='hid')]
+
+        # Basically find the other usb interfaces
+        interfaces = openrazer_daemon.hardware.group_interfaces(device_list)
 
         device_number = 0
-        for device in device_list:
-
-            for device_class in self._device_classes:
-                # Interoperability between generic list of 0000:0000:0000.0000 and pyudev
-                if test_mode:
-                    sys_name = device
-                    sys_path = os.path.join(self._test_dir, device)
-                else:
-                    sys_name = device.sys_name
-                    sys_path = device.sys_path
-
-                if sys_name in self._razer_devices:
-                    continue
-
-                if device_class.match(sys_name, sys_path):  # Check it matches sys/ ID format and has device_type file
-                    self.logger.info('Found device.%d: %s', device_number, sys_name)
-
-                    # TODO add testdir support
-                    # Basically find the other usb interfaces
-                    device_match = sys_name.split('.')[0]
-                    additional_interfaces = []
-                    if not test_mode:
-                        for alt_device in device_list:
-                            if device_match in alt_device.sys_name and alt_device.sys_name != sys_name:
-                                additional_interfaces.append(alt_device.sys_path)
-
-                    # Checking permissions
-                    test_file = os.path.join(sys_path, 'device_type')
-                    file_group_id = os.stat(test_file).st_gid
-                    file_group_name = grp.getgrgid(file_group_id)[0]
-
-                    if os.getgid() != file_group_id and file_group_name != 'plugdev':
-                        self.logger.critical("Could not access {0}/device_type, file is not owned by plugdev".format(sys_path))
-                        break
-
-                    razer_device = device_class(sys_path, device_number, self._config, testing=self._test_dir is not None, additional_interfaces=sorted(additional_interfaces))
-
-                    # Wireless devices sometimes don't listen
-                    count = 0
-                    while count < 3:
-                        # Loop to get serial, exit early if it gets one
-                        device_serial = razer_device.get_serial()
-                        if len(device_serial) > 0:
-                            break
-                        time.sleep(0.1)
-                        count += 1
-                    else:
-                        logging.warning("Could not get serial for device {0}. Skipping".format(sys_name))
-                        continue
-
-                    self._razer_devices.add(sys_name, device_serial, razer_device)
-
-                    device_number += 1
-
-    def _add_device(self, device):
+        for sys_name, sys_path, parent in device_list:
+            if sys_name in self._razer_devices:
+                continue
+
+            device_class = openrazer_daemon.hardware.find_device_class(self._device_index, sys_name, sys_path)  # Check it matches sys/ ID format and has device_type file
+            if device_class is None:
+                continue
+
+            self.logger.info('Found device.%d: %s', device_number, sys_name)
+
+            additional_interfaces = [alt_path for alt_name, alt_path in interfaces.get(parent, []) if alt_name != sys_name]
+
+            # Checking permissions
+            test_file = os.path.join(sys_path, 'device_type')
+            file_group_id = os.stat(test_file).st_gid
+            file_group_name = grp.getgrgid(file_group_id)[0]
+
+            if os.getgid() != file_group_id and file_group_name != 'plugdev':
+                self.logger.critical("Could not access {0}/device_type, file is not owned by plugdev".format(sys_path))
+                continue
+
+            razer_device = device_class(sys_path, device_number, self._config, testing=self._test_dir is not None, additional_interfaces=sorted(additional_interfaces))
+
+            # Wireless devices sometimes don't listen
+            count = 0
+            while count < 3:
+                # Loop to get serial, exit early if it gets one
+                device_serial = razer_device.get_serial()
+                if len(device_serial) > 0:
+                    break
+                time.sleep(0.1)
+                count += 1
+            else:
+                logging.warning("Could not get serial for device {0}. Skipping".format(sys_name))
+                continue
+
+            self._razer_devices.add(sys_name, device_serial, razer_device)
+            if parent is not None:
+                self._usb_parents[parent] = sys_name
+
+            device_number += 1
+
+    @staticmethod
+    def _get_usb_parent(device):
+        """
+        Get an identifier for the USB device a HID device belongs to
+
+        :param device: Udev Device
+        :type device: pyudev.device._device.Device
+
+        :return: USB device sys path, or bus:vid:pid if there is no USB parent
+        :rtype: str
+        """
+        usb_device = device.find_parent('usb', 'usb_device')
+
+        if usb_device is not None:
+            return usb_device.sys_path
+
+        return device.sys_name.split('.')[0]
+
+    def _add_device(self, device, interfaces=None):
         """
         Add device event from udev
 
+        Only the event's own device ID is looked at, the rest of the system is not enumerated again.
+
         :param device: Udev Device
         :type device: pyudev.device._device.Device
+
+        :param interfaces: Interfaces added alongside this one, grouped by USB parent
+        :type interfaces: dict or None
         """
-        device_number = len(self._razer_devices)
-        for device_class in self._device_classes:
-            sys_name = device.sys_name
-            sys_path = device.sys_path
+        sys_name = device.sys_name
+        sys_path = device.sys_path
 
-            if sys_name in self._razer_devices:
-                continue
+        if sys_name in self._razer_devices:
+            return
 
-            if device_class.match(sys_name, sys_path):  # Check it matches sys/ ID format and has device_type file
-                self.logger.info('Found valid device.%d: %s', device_number, sys_name)
-                razer_device = device_class(sys_path, device_number, self._config, testing=self._test_dir is not None)
+        parent = self._get_usb_parent(device)
+        device_class = openrazer_daemon.hardware.find_device_class(self._device_index, sys_name, sys_path)  # Check it matches sys/ ID format and has device_type file
 
-                # Its a udev event so currently the device hasn't been chmodded yet
-                time.sleep(0.2)
+        if device_class is not None:
+            device_number = len(self._razer_devices)
+            self.logger.info('Found valid device.%d: %s', device_number, sys_name)
 
-                # Wireless devices sometimes don't listen
-                device_serial = razer_device.get_serial()
+            additional_interfaces = []
+            if interfaces is not None:
+                additional_interfaces = [alt_path for alt_name, alt_path in interfaces.get(parent, []) if alt_name != sys_name]
 
-                if len(device_serial) > 0:
-                    # Add Device
-                    self._razer_devices.add(sys_name, device_serial, razer_device)
-                    self.device_added()
-                else:
-                    logging.warning("Could not get serial for device {0}. Skipping".format(sys_name))
+            razer_device = device_class(sys_path, device_number, self._config, testing=self._test_dir is not None, additional_interfaces=sorted(additional_interfaces))
+
+            # Its a udev event so currently the device hasn't been chmodded yet
+            time.sleep(0.2)
+
+            # Wireless devices sometimes don't listen
+            device_serial = razer_device.get_serial()
+
+            if len(device_serial) > 0:
+                # Add Device
+                self._razer_devices.add(sys_name, device_serial, razer_device)
+                self._usb_parents[parent] = sys_name
+                self.device_added()
             else:
-                # Basically find the other usb interfaces
-                device_match = sys_name.split('.')[0]
-                for d in self._razer_devices:
-                    if device_match in d.device_id and d.device_id != sys_name:
-                        if not sys_path in d.dbus.additional_interfaces:
-                            d.dbus.additional_interfaces.append(sys_path)
-                            return
+                logging.warning("Could not get serial for device {0}. Skipping".format(sys_name))
+        else:
+            # Basically find the other usb interfaces
+            device_id = self._usb_parents.get(parent)
+            if device_id is not None and device_id in self._razer_devices:
+                d = self._razer_devices[device_id]
+                if sys_path not in d.dbus.additional_interfaces:
+                    d.dbus.additional_interfaces.append(sys_path)
 
     def _remove_device(self, device):
         """
@@ -474,6 +504,7 @@ class RazerDaemon(DBusService):
 
             # Delete device
             del self._razer_devices[device.device_id]
+            self._usb_parents = {parent: sys_name for parent, sys_name in self._usb_parents.items() if sys_name != device.device_id}
             self.device_removed()
 
         except IndexError:  # Why didn't i set it up as KeyError
@@ -504,8 +535,10 @@ class RazerDaemon(DBusService):
         time.sleep(2)  # delay to let udev add all devices that we want
         # Sort the devices
         self._collecting_udev_devices.sort(key=lambda x: x.sys_path, reverse=True)
+        # Group the interfaces of each device in one pass, so they can be attached whatever order they arrived in
+        interfaces = openrazer_daemon.hardware.group_interfaces([(d.sys_name, d.sys_path, self._get_usb_parent(d)) for d in self._collecting_udev_devices])
         for d in self._collecting_udev_devices:
-            self._add_device(d)
+            self._add_device(d, interfaces)
         self._collecting_udev = False
 
     def run(self):
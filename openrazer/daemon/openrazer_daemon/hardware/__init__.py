@@ -2,7 +2,7 @@
 Hardware collection
 """
 import os
-from openrazer_daemon.hardware.device_base import RazerDevice
+from openrazer_daemon.hardware.device_base import RazerDevice, parse_device_id
 
 # Hack to get a list of hardware modules to import
 HARDWARE_MODULES = ['openrazer_daemon.hardware.' + os.path.splitext(hw_file)[0] for hw_file in os.listdir(os.path.dirname(__file__)) if hw_file not in ('device_base.py', '__init__.py') and hw_file.endswith('.py')]
@@ -30,3 +30,59 @@ def get_device_classes():
             classes.append(class_instance)
 
     return sorted(classes, key=lambda cls: cls.__name__)
+
+
+def get_device_class_index(classes):
+    """
+    Index hardware classes by USB VID and PID
+
+    :param classes: List of RazerDevice subclasses
+    :type classes: list of callable
+
+    :return: Dictionary of (VID, PID) to hardware class
+    :rtype: dict
+    """
+    return {(cls.USB_VID, cls.USB_PID): cls for cls in classes if cls.USB_VID is not None and cls.USB_PID is not None}
+
+
+def find_device_class(device_index, device_id, dev_path):
+    """
+    Get the hardware class for a device
+
+    :param device_index: Index from get_device_class_index
+    :type device_index: dict
+
+    :param device_id: Device ID like 0000:0000:0000.0000
+    :type device_id: str
+
+    :param dev_path: Device path. Normally '/sys/bus/hid/devices/0000:0000:0000.0000'
+    :type dev_path: str
+
+    :return: Hardware class or None if the device is not supported
+    :rtype: callable or None
+    """
+    device_class = device_index.get(parse_device_id(device_id))
+
+    if device_class is not None and device_class.match(device_id, dev_path):
+        return device_class
+
+    return None
+
+
+def group_interfaces(devices):
+    """
+    Group device interfaces by the USB device they belong to
+
+    :param devices: List of (device ID, device path, USB parent) where USB parent is None if unknown
+    :type devices: list of tuple
+
+    :return: Dictionary of USB parent to list of (device ID, device path)
+    :rtype: dict
+    """
+    groups = {}
+
+    for device_id, dev_path, parent in devices:
+        if parent is not None:
+            groups.setdefault(parent, []).append((device_id, dev_path))
+
+    return groups
@@ -13,6 +13,27 @@ from openrazer_daemon.dbus_services.service import DBusService
 import openrazer_daemon.dbus_services.dbus_methods
 from openrazer_daemon.misc import effect_sync
 
+# Device ID like 0003:1532:0203.0001 (bus:vid:pid.instance)
+DEVICE_ID_REGEX = re.compile(r'^[0-9A-F]{4}:([0-9A-F]{4}):([0-9A-F]{4})\.[0-9A-F]{4}$')
+
+
+def parse_device_id(device_id):
+    """
+    Get the USB VID and PID out of a device ID
+
+    :param device_id: Device ID like 0000:0000:0000.0000
+    :type device_id: str
+
+    :return: (VID, PID) or None if it is not a device ID
+    :rtype: tuple of int or None
+    """
+    match = DEVICE_ID_REGEX.match(device_id)
+
+    if match is None:
+        return None
+
+    return int(match.group(1), 16), int(match.group(2), 16)
+
 
 # pylint: disable=too-many-instance-attributes
 class RazerDevice(DBusService):
@@ -419,11 +440,8 @@ class RazerDevice(DBusService):
         :return: True if its the correct device ID
         :rtype: bool
         """
-        pattern = r'^[0-9A-F]{4}:' + '{0:04X}'.format(cls.USB_VID) + ':' + '{0:04X}'.format(cls.USB_PID) + r'\.[0-9A-F]{4}$'
-
-        if re.match(pattern, device_id) is not None:
-            if 'device_type' in os.listdir(dev_path):
-                return True
+        if parse_device_id(device_id) == (cls.USB_VID, cls.USB_PID):
+            return os.path.isfile(os.path.join(dev_path, 'device_type'))
 
         return False
 
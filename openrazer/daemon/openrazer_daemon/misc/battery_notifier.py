@@ -2,10 +2,12 @@
 This will do until I can be bothered to create indicator applet to do battery level
 """
 import logging
-import threading
-import datetime
 import time
 
+from gi.repository import GLib
+
+from openrazer_daemon.misc.scheduler import get_scheduler
+
 try:
     import notify2
 except ImportError:
@@ -17,18 +19,15 @@ INTERVAL_FREQ = 60 * 10
 NOTIFY_TIMEOUT = 4000
 
 
-class BatteryNotifier(threading.Thread):
+class BatteryNotifier(object):
     """
-    Thread to notify about battery
+    Notify about battery, run periodically by the scheduler on a worker thread
     """
 
     def __init__(self, parent, device_id, device_name):
-        super(BatteryNotifier, self).__init__()
         self._logger = logging.getLogger('razer.device{0}.batterynotifier'.format(device_id))
         self._notify2 = notify2 is not None
 
-        self.event = threading.Event()
-
         if self._notify2:
             try:
                 notify2.init('openrazer_daemon')
@@ -36,7 +35,6 @@ class BatteryNotifier(threading.Thread):
                 self._logger.warning("Failed to init notification daemon, err: {0}".format(err))
                 self._notify2 = False
 
-        self._shutdown = False
         self._device_name = device_name
 
         # Could save reference to parent but only need battery level function
@@ -46,63 +44,72 @@ class BatteryNotifier(threading.Thread):
             self._notification = notify2.Notification(summary="{0}")
             self._notification.set_timeout(NOTIFY_TIMEOUT)
 
-        self._last_notify_time = datetime.datetime(1970, 1, 1)
+        # Bumped by cancel, readings scheduled under an older generation are dropped
+        self._generation = 0
 
     @property
-    def shutdown(self):
+    def generation(self):
+        return self._generation
+
+    def cancel(self):
         """
-        Get the shutdown flag
+        Drop any battery reading still on a worker thread or waiting for the main loop
         """
-        return self._shutdown
+        self._generation += 1
 
-    @shutdown.setter
-    def shutdown(self, value):
+    def notify_battery(self, generation=None):
         """
-        Set the shutdown flag
+        Read the battery level, blocks so it must not run on the main loop
 
-        :param value: Shutdown
-        :type value: bool
+        :param generation: Generation the run was scheduled in, the reading is dropped once it is cancelled
+        :type generation: int or None
         """
-        self._shutdown = value
+        if generation is None:
+            generation = self._generation
+        elif generation != self._generation:
+            return
 
-    def notify_battery(self):
-        now = datetime.datetime.now()
-
-        if (now - self._last_notify_time).seconds > INTERVAL_FREQ:
-            # Update last notified
-            self._last_notify_time = now
+        battery_level = self._get_battery_func()
 
+        # Sometimes on wifi don't get batt
+        if battery_level == -1.0 and generation == self._generation:
+            time.sleep(0.2)
             battery_level = self._get_battery_func()
 
-            # Sometimes on wifi don't get batt
-            if battery_level == -1.0:
-                time.sleep(0.2)
-                battery_level = self._get_battery_func()
+        # notify2 talks D-Bus, so show the notification from the main loop
+        if self._notify2 and generation == self._generation:
+            GLib.idle_add(self._show_battery, battery_level, generation)
 
-            if battery_level < 10.0:
-                if self._notify2:
-                    self._notification.update(summary="{0} Battery at {1:.1f}%".format(self._device_name, battery_level), message='Please charge your device', icon='notification-battery-low')
-                    self._notification.show()
-            else:
-                if self._notify2:
-                    self._notification.update(summary="{0} Battery at {1:.1f}%".format(self._device_name, battery_level))
-                    self._notification.show()
+    def _show_battery(self, battery_level, generation):
+        """
+        Show the battery notification, runs on the main loop
 
-            if self._notify2:
-                self._logger.debug("{0} Battery at {1:.1f}%".format(self._device_name, battery_level))
+        :param battery_level: Battery level read by notify_battery
+        :type battery_level: float
 
-    def run(self):
-        """
-        Main thread function
+        :param generation: Generation the reading was started in
+        :type generation: int
+
+        :return: False so GLib removes the source
+        :rtype: bool
         """
+        # Cancelled after the reading was queued
+        if generation != self._generation:
+            return False
 
-        while not self._shutdown:
-            if self.event.is_set():
-                self.notify_battery()
+        if battery_level < 10.0:
+            if self._notify2:
+                self._notification.update(summary="{0} Battery at {1:.1f}%".format(self._device_name, battery_level), message='Please charge your device', icon='notification-battery-low')
+                self._notification.show()
+        else:
+            if self._notify2:
+                self._notification.update(summary="{0} Battery at {1:.1f}%".format(self._device_name, battery_level))
+                self._notification.show()
 
-            time.sleep(0.1)
+        if self._notify2:
+            self._logger.debug("{0} Battery at {1:.1f}%".format(self._device_name, battery_level))
 
-        self._logger.debug("Shutting down battery notifier")
+        return False
 
 
 class BatteryManager(object):
@@ -110,38 +117,41 @@ class BatteryManager(object):
     Class which manages the overall process of notifing battery levels
     """
 
-    def __init__(self, parent, device_number, device_name):
+    def __init__(self, parent, device_number, device_name, scheduler=None):
         self._logger = logging.getLogger('razer.device{0}.batterymanager'.format(device_number))
         self._parent = parent
+        self._scheduler = scheduler if scheduler is not None else get_scheduler()
 
-        self._battery_thread = BatteryNotifier(parent, device_number, device_name)
-        self._battery_thread.start()
+        self._battery_notifier = BatteryNotifier(parent, device_number, device_name)
+        self._battery_job = None
 
         self._is_closed = False
 
     def close(self):
         """
-        Close the manager, stop ripple thread
+        Close the manager, cancel the battery job
         """
         if not self._is_closed:
             self._logger.debug("Closing Battery Manager")
+            self.active = False
             self._is_closed = True
 
-            self._battery_thread.shutdown = True
-            self._battery_thread.join(timeout=2)
-            if self._battery_thread.is_alive():
-                self._logger.error("Could not stop BatteryNotify thread")
-
     def __del__(self):
         self.close()
 
     @property
     def active(self):
-        return self._battery_thread.event.is_set()
+        return self._battery_job is not None
 
     @active.setter
     def active(self, value):
-        if value:
-            self._battery_thread.event.set()
-        else:
-            self._battery_thread.event.clear()
+        if value and self._battery_job is None and not self._is_closed:
+            # Notify straight away, then every INTERVAL_FREQ seconds
+            # Bind the generation now, the worker thread can start after a cancel
+            generation = self._battery_notifier.generation
+            self._battery_job = self._scheduler.add(lambda: self._battery_notifier.notify_battery(generation), INTERVAL_FREQ, delay=0, threaded=True)
+        elif not value and self._battery_job is not None:
+            self._battery_job.cancel()
+            self._battery_job = None
+            # A run may already be on a worker thread, don't let it notify
+            self._battery_notifier.cancel()
@@ -0,0 +1,264 @@
+"""
+Scheduler for periodic device jobs
+
+Jobs like battery checks are timed by the GLib main loop. They are kept in a heap ordered by deadline and only
+one GLib timeout is armed at a time, for the earliest deadline, so nothing wakes up in between. Deadlines a second
+or more away use a seconds timeout so GLib can coalesce the wakeup with other timers. Jobs which block, like device
+reads, can be run on a worker thread so the main loop keeps serving D-Bus.
+"""
+import heapq
+import itertools
+import logging
+import math
+import random
+import threading
+import time
+
+from gi.repository import GLib
+
+
+class ScheduledJob(object):
+    """
+    Periodic job, returned by Scheduler.add
+    """
+
+    def __init__(self, scheduler, callback, interval, jitter, threaded):
+        self._scheduler = scheduler
+        self.callback = callback
+        self.interval = interval
+        self.jitter = jitter
+        self.threaded = threaded
+        self.deadline = None
+        self.cancelled = False
+        self.running = False
+
+    def cancel(self):
+        """
+        Stop running the job
+        """
+        self._scheduler.cancel(self)
+
+
+class Scheduler(object):
+    """
+    Runs periodic jobs at their deadlines from the main loop
+
+    :param clock: Monotonic clock in seconds
+    :type clock: callable
+
+    :param timeout_add: Function to arm a one-shot timeout, like GLib.timeout_add
+    :type timeout_add: callable
+
+    :param source_remove: Function to disarm a timeout, like GLib.source_remove
+    :type source_remove: callable
+
+    :param timeout_add_seconds: Function to arm a one-shot timeout in whole seconds, like GLib.timeout_add_seconds
+    :type timeout_add_seconds: callable
+
+    :param spawn: Function to run a callable on a worker thread
+    :type spawn: callable
+    """
+
+    def __init__(self, clock=time.monotonic, timeout_add=None, source_remove=None, timeout_add_seconds=None, spawn=None):
+        self._logger = logging.getLogger('razer.scheduler')
+        self._clock = clock
+        self._timeout_add = timeout_add if timeout_add is not None else GLib.timeout_add
+        self._source_remove = source_remove if source_remove is not None else GLib.source_remove
+        self._timeout_add_seconds = timeout_add_seconds if timeout_add_seconds is not None else GLib.timeout_add_seconds
+        self._spawn = spawn if spawn is not None else self._spawn_thread
+
+        # Jobs are added from device constructors which can run on the udev thread
+        self._lock = threading.RLock()
+        self._heap = []
+        self._counter = itertools.count()
+
+        self._source_id = None
+        self._armed_deadline = None
+        self._suspended = False
+
+    def add(self, callback, interval, delay=None, jitter=0.1, threaded=False):
+        """
+        Run a function every interval seconds
+
+        :param callback: Function to run
+        :type callback: callable
+
+        :param interval: Seconds between runs
+        :type interval: float
+
+        :param delay: Seconds until the first run, defaults to the interval
+        :type delay: float or None
+
+        :param jitter: Fraction of the interval randomly added to each deadline, spreads out jobs of several devices
+        :type jitter: float
+
+        :param threaded: Run the callback on a worker thread instead of the main loop, a run still going when the
+                         job is due again is not doubled up
+        :type threaded: bool
+
+        :return: Job which can be cancelled
+        :rtype: ScheduledJob
+        """
+        job = ScheduledJob(self, callback, interval, jitter, threaded)
+
+        with self._lock:
+            self._push(job, self._clock() + (interval if delay is None else delay))
+            self._arm()
+
+        return job
+
+    def cancel(self, job):
+        """
+        Remove a job
+
+        :param job: Job from add
+        :type job: ScheduledJob
+        """
+        with self._lock:
+            if job.cancelled:
+                return
+
+            job.cancelled = True
+            self._heap = [entry for entry in self._heap if entry[2] is not job]
+            heapq.heapify(self._heap)
+            self._arm()
+
+    def suspend(self):
+        """
+        Stop running jobs until resume is called
+        """
+        with self._lock:
+            self._suspended = True
+            self._arm()
+
+    def resume(self):
+        """
+        Start running jobs again, any that fell due while suspended run once straight away
+        """
+        with self._lock:
+            self._suspended = False
+            self._arm()
+
+    @property
+    def suspended(self):
+        """
+        Get the suspended flag
+
+        :return: True if jobs are not being run
+        :rtype: bool
+        """
+        return self._suspended
+
+    def __len__(self):
+        """
+        Get the number of jobs
+
+        :return: Number of jobs
+        :rtype: int
+        """
+        return len(self._heap)
+
+    def _push(self, job, deadline):
+        job.deadline = deadline
+        heapq.heappush(self._heap, (deadline, next(self._counter), job))
+
+    def _arm(self):
+        """
+        Arm the timeout for the earliest deadline, lock must be held
+        """
+        deadline = None
+        if not self._suspended and len(self._heap) > 0:
+            deadline = self._heap[0][0]
+
+        if deadline == self._armed_deadline and (deadline is None or self._source_id is not None):
+            return
+
+        if self._source_id is not None:
+            self._source_remove(self._source_id)
+            self._source_id = None
+
+        self._armed_deadline = deadline
+        if deadline is not None:
+            delay = deadline - self._clock()
+            if delay >= 1:
+                self._source_id = self._timeout_add_seconds(int(delay), self._on_timeout)
+            else:
+                self._source_id = self._timeout_add(max(0, int(math.ceil(delay * 1000))), self._on_timeout)
+
+    def _on_timeout(self):
+        """
+        Run the jobs which are due and arm the next timeout
+
+        :return: False so GLib removes the source
+        :rtype: bool
+        """
+        due = []
+
+        with self._lock:
+            # Seconds timeouts can fire early, the jobs they were armed for still run
+            now = self._clock()
+            due_by = now if self._armed_deadline is None else max(now, self._armed_deadline)
+
+            self._source_id = None
+            self._armed_deadline = None
+
+            while not self._suspended and len(self._heap) > 0 and self._heap[0][0] <= due_by:
+                job = heapq.heappop(self._heap)[2]
+                # Reschedule before running so the job can cancel itself, a job run early still keeps its interval
+                self._push(job, max(now, job.deadline) + job.interval + random.uniform(0, job.jitter * job.interval))
+                due.append(job)
+
+        # Run outside the lock as jobs can talk to the device
+        for job in due:
+            if job.cancelled:
+                continue
+
+            if not job.threaded:
+                self._run(job)
+            elif job.running:
+                self._logger.debug("Scheduled job still running, skipping this run")
+            else:
+                job.running = True
+                self._spawn(lambda job=job: self._run(job))
+
+        with self._lock:
+            self._arm()
+
+        return False
+
+    def _run(self, job):
+        """
+        Run a job, logging any failure
+        """
+        try:
+            job.callback()
+        except Exception as err:
+            self._logger.exception("Scheduled job failed: {0}".format(err))
+        finally:
+            job.running = False
+
+    @staticmethod
+    def _spawn_thread(function):
+        thread = threading.Thread(target=function, name='razer-scheduler-job')
+        thread.daemon = True
+        thread.start()
+
+
+_SCHEDULER = None
+_SCHEDULER_LOCK = threading.Lock()
+
+
+def get_scheduler():
+    """
+    Get the daemon wide scheduler
+
+    :return: Scheduler
+    :rtype: Scheduler
+    """
+    global _SCHEDULER
+
+    with _SCHEDULER_LOCK:
+        if _SCHEDULER is None:
+            _SCHEDULER = Scheduler()
+
+        return _SCHEDULER
@@ -0,0 +1,106 @@
+import os
+import shutil
+import tempfile
+import unittest
+import unittest.mock
+
+import openrazer_daemon.hardware
+from openrazer_daemon.hardware.device_base import RazerDevice, parse_device_id
+
+# Synthetic devices per supported class, which puts a few hundred devices in the fake driver directory
+DEVICES_PER_CLASS = 4
+
+
+def touch(fname):
+    with open(fname, 'a'):
+        os.utime(fname, None)
+
+
+class DeviceIndexTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls._classes = openrazer_daemon.hardware.get_device_classes()
+        cls._index = openrazer_daemon.hardware.get_device_class_index(cls._classes)
+        cls._tmp_dir = tempfile.mkdtemp(prefix='razer_device_index_')
+        cls._expected = {}
+
+        for device_class in cls._classes:
+            for instance in range(DEVICES_PER_CLASS):
+                sys_name = '0003:{0:04X}:{1:04X}.{2:04X}'.format(device_class.USB_VID, device_class.USB_PID, instance)
+                os.makedirs(os.path.join(cls._tmp_dir, sys_name))
+                touch(os.path.join(cls._tmp_dir, sys_name, 'device_type'))
+                cls._expected[sys_name] = device_class
+
+        # Devices that should not match, other vendors and interfaces without driver files
+        for instance in range(DEVICES_PER_CLASS * 10):
+            os.makedirs(os.path.join(cls._tmp_dir, '0003:046D:C52B.{0:04X}'.format(instance)))
+        for device_class in cls._classes:
+            os.makedirs(os.path.join(cls._tmp_dir, '0003:{0:04X}:{1:04X}.{2:04X}'.format(device_class.USB_VID, device_class.USB_PID, DEVICES_PER_CLASS)))
+
+        cls._device_list = os.listdir(cls._tmp_dir)
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls._tmp_dir, ignore_errors=True)
+
+    def _enumerate_indexed(self):
+        result = {}
+
+        for sys_name in self._device_list:
+            device_class = openrazer_daemon.hardware.find_device_class(self._index, sys_name, os.path.join(self._tmp_dir, sys_name))
+            if device_class is not None:
+                result[sys_name] = device_class
+
+        return result
+
+    def _enumerate_all_classes(self):
+        result = {}
+
+        for sys_name in self._device_list:
+            for device_class in self._classes:
+                if device_class.match(sys_name, os.path.join(self._tmp_dir, sys_name)):
+                    result[sys_name] = device_class
+                    break
+
+        return result
+
+    def test_index_covers_all_classes(self):
+        self.assertEqual(len(self._index), len(self._classes))
+
+    def test_parse_device_id(self):
+        self.assertEqual(openrazer_daemon.hardware.parse_device_id('0003:1532:0203.0001'), (0x1532, 0x0203))
+        self.assertIsNone(openrazer_daemon.hardware.parse_device_id('0003:1532:0203'))
+        self.assertIsNone(openrazer_daemon.hardware.parse_device_id('0003:1532:020b.0001'))
+
+    def test_enumeration(self):
+        self.assertEqual(self._enumerate_indexed(), self._expected)
+        self.assertEqual(self._enumerate_all_classes(), self._expected)
+
+    def test_lookup_matches_indexed_class_only(self):
+        calls = []
+        original_match = RazerDevice.match.__func__
+
+        def match(cls, device_id, dev_path):
+            calls.append((cls, device_id))
+            return original_match(cls, device_id, dev_path)
+
+        with unittest.mock.patch.object(RazerDevice, 'match', classmethod(match)):
+            self.assertEqual(self._enumerate_indexed(), self._expected)
+
+        # Every Razer device is matched once, against the class indexed for its VID:PID, other vendors never get that far
+        self.assertEqual(len(calls), len(self._classes) * (DEVICES_PER_CLASS + 1))
+        self.assertEqual(len(set(device_id for _, device_id in calls)), len(calls))
+        for device_class, device_id in calls:
+            self.assertIs(device_class, self._index[parse_device_id(device_id)])
+
+    def test_group_interfaces(self):
+        devices = [
+            ('0003:1532:0203.0001', '/sys/a/0003:1532:0203.0001', '/sys/usb1/1-1'),
+            ('0003:1532:0203.0002', '/sys/a/0003:1532:0203.0002', '/sys/usb1/1-1'),
+            ('0003:1532:0203.0003', '/sys/a/0003:1532:0203.0003', '/sys/usb1/1-2'),
+            ('0003:1532:0203.0004', '/sys/a/0003:1532:0203.0004', None),
+        ]
+        groups = openrazer_daemon.hardware.group_interfaces(devices)
+
+        self.assertEqual(sorted(groups.keys()), ['/sys/usb1/1-1', '/sys/usb1/1-2'])
+        self.assertEqual([device_id for device_id, _ in groups['/sys/usb1/1-1']], ['0003:1532:0203.0001', '0003:1532:0203.0002'])
@@ -0,0 +1,269 @@
+import unittest
+import unittest.mock
+
+import openrazer_daemon.misc.battery_notifier
+import openrazer_daemon.misc.scheduler
+
+
+class FakeMainLoop(object):
+    """
+    Stands in for the clock and GLib timeouts, time only moves on advance()
+    """
+
+    def __init__(self):
+        self.now = 0.0
+        self.wakeups = 0
+        self.seconds_timeouts = 0
+        self.sources = {}
+        self._next_source_id = 1
+
+    def clock(self):
+        return self.now
+
+    def timeout_add(self, interval_ms, callback):
+        source_id = self._next_source_id
+        self._next_source_id += 1
+        self.sources[source_id] = (self.now + interval_ms / 1000.0, callback)
+
+        return source_id
+
+    def timeout_add_seconds(self, interval, callback):
+        self.seconds_timeouts += 1
+
+        return self.timeout_add(interval * 1000, callback)
+
+    def source_remove(self, source_id):
+        del self.sources[source_id]
+
+    def advance(self, seconds):
+        end = self.now + seconds
+
+        while len(self.sources) > 0:
+            source_id = min(self.sources, key=lambda key: self.sources[key][0])
+            deadline, callback = self.sources[source_id]
+            if deadline > end:
+                break
+
+            del self.sources[source_id]
+            self.now = max(self.now, deadline)
+            self.wakeups += 1
+            if callback():
+                self.sources[source_id] = (self.now, callback)
+
+        self.now = end
+
+
+class SchedulerTest(unittest.TestCase):
+    def setUp(self):
+        self._loop = FakeMainLoop()
+        # Worker threads are only started when the test says so
+        self._spawned = []
+        self._scheduler = openrazer_daemon.misc.scheduler.Scheduler(clock=self._loop.clock, timeout_add=self._loop.timeout_add, source_remove=self._loop.source_remove,
+                                                                    timeout_add_seconds=self._loop.timeout_add_seconds, spawn=self._spawned.append)
+        self._runs = []
+
+    def _job(self, name):
+        return lambda: self._runs.append((name, self._loop.now))
+
+    def test_no_wakeups_between_deadlines(self):
+        self._scheduler.add(self._job('battery'), 600, jitter=0)
+
+        self._loop.advance(599.9)
+        self.assertEqual(self._loop.wakeups, 0)
+        self.assertEqual(self._runs, [])
+
+        self._loop.advance(0.2)
+        self.assertEqual(self._loop.wakeups, 1)
+        self.assertEqual(self._runs, [('battery', 600)])
+
+        self._loop.advance(3600)
+        self.assertEqual(self._loop.wakeups, 7)
+        self.assertEqual(len(self._runs), 7)
+
+    def test_one_wakeup_per_deadline(self):
+        self._scheduler.add(self._job('fast'), 10, jitter=0)
+        self._scheduler.add(self._job('slow'), 25, jitter=0)
+
+        self._loop.advance(100)
+
+        # 10, 20, 25, 30, 40, 50, 60, 70, 75, 80, 90, 100, jobs sharing a deadline share the wakeup
+        self.assertEqual(self._loop.wakeups, 12)
+        self.assertEqual(len([run for run in self._runs if run[0] == 'fast']), 10)
+        self.assertEqual(len([run for run in self._runs if run[0] == 'slow']), 4)
+        self.assertEqual(len(self._loop.sources), 1)
+
+    def test_seconds_timeout(self):
+        self._scheduler.add(self._job('battery'), 600, jitter=0)
+        self.assertEqual(self._loop.seconds_timeouts, 1)
+
+        # Sub-second deadlines keep millisecond precision
+        self._scheduler.add(self._job('fast'), 0.5, jitter=0)
+        self.assertEqual(self._loop.seconds_timeouts, 1)
+
+        self._loop.advance(0.5)
+        self.assertEqual(self._runs, [('fast', 0.5)])
+
+    def test_early_wakeup(self):
+        job = self._scheduler.add(self._job('battery'), 600.5, jitter=0)
+
+        # The seconds timeout is armed for 600, the job runs then and its next deadline keeps the interval
+        self._loop.advance(600)
+        self.assertEqual(self._runs, [('battery', 600)])
+        self.assertEqual(job.deadline, 1201)
+
+    def test_threaded(self):
+        self._scheduler.add(self._job('battery'), 10, jitter=0, threaded=True)
+
+        self._loop.advance(10)
+        self.assertEqual(self._runs, [])
+        self.assertEqual(len(self._spawned), 1)
+
+        # Still running when due again, not doubled up
+        self._loop.advance(10)
+        self.assertEqual(len(self._spawned), 1)
+
+        self._spawned.pop()()
+        self.assertEqual(self._runs, [('battery', 20)])
+
+        self._loop.advance(10)
+        self.assertEqual(len(self._spawned), 1)
+
+    def test_delay(self):
+        self._scheduler.add(self._job('battery'), 600, delay=0, jitter=0)
+
+        self._loop.advance(0)
+        self.assertEqual(self._runs, [('battery', 0)])
+
+    def test_jitter(self):
+        job = self._scheduler.add(self._job('battery'), 100, jitter=0.1)
+
+        for _ in range(20):
+            previous = job.deadline
+            # Timeouts are armed in whole milliseconds
+            self._loop.advance(job.deadline - self._loop.now + 0.001)
+            self.assertGreaterEqual(job.deadline - previous, 100)
+            self.assertLessEqual(job.deadline - previous, 110.001)
+
+        self.assertEqual(self._loop.wakeups, 20)
+
+    def test_cancel(self):
+        job = self._scheduler.add(self._job('battery'), 10, jitter=0)
+        self._loop.advance(15)
+        job.cancel()
+
+        self.assertEqual(len(self._scheduler), 0)
+        self.assertEqual(len(self._loop.sources), 0)
+
+        self._loop.advance(100)
+        self.assertEqual(self._loop.wakeups, 1)
+        self.assertEqual(len(self._runs), 1)
+
+    def test_cancel_from_job(self):
+        jobs = []
+        jobs.append(self._scheduler.add(lambda: jobs[0].cancel(), 10, jitter=0))
+
+        self._loop.advance(100)
+        self.assertEqual(self._loop.wakeups, 1)
+        self.assertEqual(len(self._loop.sources), 0)
+
+    def test_suspend_resume(self):
+        self._scheduler.add(self._job('battery'), 10, jitter=0)
+        self._scheduler.suspend()
+
+        self._loop.advance(100)
+        self.assertEqual(self._loop.wakeups, 0)
+        self.assertEqual(len(self._loop.sources), 0)
+
+        # Overdue job runs once on resume, then keeps its interval
+        self._scheduler.resume()
+        self._loop.advance(0)
+        self.assertEqual(self._runs, [('battery', 100)])
+
+        self._loop.advance(10)
+        self.assertEqual(self._loop.wakeups, 2)
+
+    def test_failing_job(self):
+        def fail():
+            raise ValueError('Device went away')
+
+        self._scheduler.add(fail, 10, jitter=0)
+        self._scheduler.add(self._job('battery'), 10, jitter=0)
+
+        with self.assertLogs('razer.scheduler', level='ERROR'):
+            self._loop.advance(20)
+        self.assertEqual(len(self._runs), 2)
+
+    def test_battery_manager(self):
+        parent = unittest.mock.MagicMock()
+        parent.getBattery.return_value = 50.0
+
+        with unittest.mock.patch.object(openrazer_daemon.misc.battery_notifier, 'notify2', None):
+            manager = openrazer_daemon.misc.battery_notifier.BatteryManager(parent, 0, 'Razer Mamba', scheduler=self._scheduler)
+
+        manager.active = True
+        self._loop.advance(0)
+        self.assertEqual(parent.getBattery.call_count, 0)
+
+        # The battery is read on a worker thread, not the main loop
+        self.assertEqual(len(self._spawned), 1)
+        self._spawned.pop()()
+        self.assertEqual(parent.getBattery.call_count, 1)
+
+        # Nothing happens until the next battery check is due
+        self._loop.advance(openrazer_daemon.misc.battery_notifier.INTERVAL_FREQ - 1)
+        self.assertEqual(self._loop.wakeups, 1)
+
+        manager.close()
+        self.assertFalse(manager.active)
+        self.assertEqual(len(self._loop.sources), 0)
+
+    def test_battery_cancel_in_flight(self):
+        parent = unittest.mock.MagicMock()
+        parent.getBattery.return_value = 50.0
+        idle = []
+
+        with unittest.mock.patch.object(openrazer_daemon.misc.battery_notifier, 'notify2', unittest.mock.MagicMock()):
+            manager = openrazer_daemon.misc.battery_notifier.BatteryManager(parent, 0, 'Razer Mamba', scheduler=self._scheduler)
+        notification = manager._battery_notifier._notification
+
+        with unittest.mock.patch.object(openrazer_daemon.misc.battery_notifier.GLib, 'idle_add', lambda func, *args: idle.append((func, args))):
+            # Cancelled before the worker started, the device is not read and nothing is queued
+            manager.active = True
+            self._loop.advance(0)
+            manager.active = False
+            self._spawned.pop()()
+            self.assertEqual(parent.getBattery.call_count, 0)
+            self.assertEqual(idle, [])
+
+            # Cancelled while the worker is reading, nothing is queued for the main loop
+            def cancel_and_read():
+                manager.active = False
+                return 50.0
+
+            parent.getBattery.side_effect = cancel_and_read
+            manager.active = True
+            self._loop.advance(0)
+            self._spawned.pop()()
+            self.assertEqual(parent.getBattery.call_count, 1)
+            self.assertEqual(idle, [])
+            parent.getBattery.side_effect = None
+
+            # Cancelled after the reading was queued, the stale result is dropped on the main loop
+            manager.active = True
+            self._loop.advance(0)
+            self._spawned.pop()()
+            self.assertEqual(len(idle), 1)
+            manager.active = False
+            func, args = idle.pop()
+            self.assertFalse(func(*args))
+            notification.show.assert_not_called()
+
+            # A fresh run after reactivating still notifies
+            manager.active = True
+            self._loop.advance(0)
+            self._spawned.pop()()
+            func, args = idle.pop()
+            func(*args)
+            notification.show.assert_called_once()
+
+        manager.close()
@@ -25,6 +25,10 @@
 #include <linux/usb/input.h>
 #include <linux/hid.h>
 #include <linux/random.h>
+#include <linux/spinlock.h>
+#include <linux/completion.h>
+#include <linux/ktime.h>
+#include <linux/math64.h>
 
 #include "razerkraken_driver.h"
 #include "razercommon.h"
@@ -127,69 +131,171 @@ union razer_kraken_effect_byte get_kraken_effect_byte(void)
 }
 
 /**
- * Get the current effect
+ * Send a memory request and wait for the device to answer it
+ *
+ * The answer report does not echo the address, so answers are matched to
+ * requests by order. The device answers in order, so when a request times out
+ * its answer may still be on the way and would be taken for the answer to the
+ * next request. Timed out requests are counted in resp_stale, razer_raw_event
+ * drops that many reports, and the next request waits for them to drain
+ * before it goes out. An answer later than the drain wait is assumed lost.
+ *
+ * Copies request->length bytes of the answer into response.
+ *
+ * Device lock must be held
  */
-unsigned char get_current_effect(struct device *dev)
+static int razer_kraken_get_response_locked(struct razer_kraken_device *device, struct razer_kraken_request_report *request, unsigned char *response, unsigned int retries)
 {
-    struct razer_kraken_device *device = dev_get_drvdata(dev);
-    struct razer_kraken_request_report report = get_kraken_request_report(0x04, 0x00, 0x01, device->led_mode_address);
-    int is_mutex_locked = mutex_is_locked(&device->lock);
-    unsigned char result = 0;
+    unsigned int len = min_t(unsigned int, request->length, sizeof(device->data) - 1);
+    ktime_t start = ktime_get();
+    unsigned long flags;
+    unsigned int elapsed_us;
+    bool stale;
+    int retval = -ETIMEDOUT;
+
+    while(retries-- > 0) {
+        spin_lock_irqsave(&device->resp_lock, flags);
+        stale = device->resp_stale != 0;
+        reinit_completion(&device->resp_done);
+        spin_unlock_irqrestore(&device->resp_lock, flags);
+
+        // Let answers to timed out requests arrive and be dropped first
+        if(stale) {
+            wait_for_completion_timeout(&device->resp_done, msecs_to_jiffies(RAZER_KRAKEN_RESPONSE_TIMEOUT_MS));
+        }
 
-    // Lock if there isn't already a lock, otherwise skip, essentially emulate a rentrant lock
-    if(is_mutex_locked == 0) {
-        mutex_lock(&device->lock);
+        spin_lock_irqsave(&device->resp_lock, flags);
+        device->resp_stale = 0;
+        device->resp_pending = true;
+        reinit_completion(&device->resp_done);
+        spin_unlock_irqrestore(&device->resp_lock, flags);
+
+        retval = razer_kraken_send_control_msg(device->usb_dev, request, 1);
+        if(retval == 0 && wait_for_completion_timeout(&device->resp_done, msecs_to_jiffies(RAZER_KRAKEN_RESPONSE_TIMEOUT_MS)) == 0) {
+            retval = -ETIMEDOUT;
+        }
+
+        spin_lock_irqsave(&device->resp_lock, flags);
+        if(retval == -ETIMEDOUT && !device->resp_pending) {
+            // Answered between the timeout and taking the lock
+            retval = 0;
+        }
+        if(retval == 0) {
+            memcpy(&response[0], &device->data[1], len);
+        } else if(retval == -ETIMEDOUT) {
+            // Sent but not answered yet, the answer may still come
+            device->resp_stale++;
+        }
+        device->resp_pending = false;
+        spin_unlock_irqrestore(&device->resp_lock, flags);
+
+        if(retval == 0) {
+            break;
+        }
     }
 
-    device->data[0] = 0x00;
-    razer_kraken_send_control_msg(device->usb_dev, &report, 1);
-    msleep(25); // Sleep 20ms
+    elapsed_us = (unsigned int)ktime_us_delta(ktime_get(), start);
 
-    // Check for actual data
-    if(device->data[0] == 0x05) {
-        result = device->data[1];
+    device->resp_count++;
+    if(retval == 0) {
+        device->resp_total_us += elapsed_us;
+        device->resp_max_us = max(device->resp_max_us, elapsed_us);
     } else {
-        printk(KERN_CRIT "razerkraken: Did not manage to get report\n");
+        device->resp_timeouts++;
     }
 
-    // Unlock if there isn't already a lock (as there would be by now), otherwise skip as reusing existing lock
-    if(is_mutex_locked == 0) {
-        mutex_unlock(&device->lock);
-    }
+    dev_dbg(&device->usb_dev->dev, "request dest: %02x addr: %02x%02x len: %u took %uus (%d)\n",
+            request->destination, request->addr_h, request->addr_l, len, elapsed_us, retval);
 
-    return result;
+    return retval;
 }
 
-unsigned int get_rgb_from_addr(struct device *dev, unsigned short address, unsigned char len, char* buf)
+/**
+ * Write to device RAM, paced on the device acknowledging the write
+ *
+ * The device handles memory requests in order, so reading the address back
+ * completes once the write has been applied. Falls back to the razer len*15ms
+ * delay if the device does not answer.
+ *
+ * Device lock must be held
+ */
+static int razer_kraken_write_locked(struct razer_kraken_device *device, struct razer_kraken_request_report *report)
 {
-    struct razer_kraken_device *device = dev_get_drvdata(dev);
-    struct razer_kraken_request_report report = get_kraken_request_report(0x04, 0x00, len, address);
-    int is_mutex_locked = mutex_is_locked(&device->lock);
-    unsigned char written = 0;
+    struct razer_kraken_request_report ack_report = get_kraken_request_report(0x04, 0x00, report->length, (report->addr_h << 8) | report->addr_l);
+    unsigned char response[32];
+    int retval;
 
-    // Lock if there isn't already a lock, otherwise skip, essentially emulate a rentrant lock
-    if(is_mutex_locked == 0) {
-        mutex_lock(&device->lock);
+    retval = razer_kraken_send_control_msg(device->usb_dev, report, 1);
+    if(retval != 0) {
+        return retval;
+    }
+
+    if(razer_kraken_get_response_locked(device, &ack_report, &response[0], 1) != 0) {
+        msleep(report->length * 15);
     }
 
-    device->data[0] = 0x00;
-    razer_kraken_send_control_msg(device->usb_dev, &report, 1);
-    msleep(25); // Sleep 20ms
+    return 0;
+}
 
-    // Check for actual data
-    if(device->data[0] == 0x05) {
-        //printk(KERN_CRIT "razerkraken: Got %02x%02x%02x %02x\n", device->data[1], device->data[2], device->data[3], device->data[4]);
-        memcpy(&buf[0], &device->data[1], len);
-        written = len;
-    } else {
+/**
+ * Get the current effect
+ *
+ * Device lock must be held
+ */
+static unsigned char get_current_effect_locked(struct razer_kraken_device *device)
+{
+    struct razer_kraken_request_report report = get_kraken_request_report(0x04, 0x00, 0x01, device->led_mode_address);
+    unsigned char response[32];
+
+    if(razer_kraken_get_response_locked(device, &report, &response[0], RAZER_KRAKEN_RESPONSE_RETRIES) != 0) {
         printk(KERN_CRIT "razerkraken: Did not manage to get report\n");
+        return 0;
     }
 
-    // Unlock if there isn't already a lock (as there would be by now), otherwise skip as reusing existing lock
-    if(is_mutex_locked == 0) {
-        mutex_unlock(&device->lock);
+    return response[0];
+}
+
+/**
+ * Get the current effect
+ */
+unsigned char get_current_effect(struct device *dev)
+{
+    struct razer_kraken_device *device = dev_get_drvdata(dev);
+    unsigned char result;
+
+    mutex_lock(&device->lock);
+    result = get_current_effect_locked(device);
+    mutex_unlock(&device->lock);
+
+    return result;
+}
+
+/**
+ * Read len bytes of colour config from address into buf
+ *
+ * Device lock must be held
+ */
+static unsigned int get_rgb_from_addr_locked(struct razer_kraken_device *device, unsigned short address, unsigned char len, char* buf)
+{
+    struct razer_kraken_request_report report = get_kraken_request_report(0x04, 0x00, len, address);
+
+    if(razer_kraken_get_response_locked(device, &report, (unsigned char *)&buf[0], RAZER_KRAKEN_RESPONSE_RETRIES) != 0) {
+        printk(KERN_CRIT "razerkraken: Did not manage to get report\n");
+        return 0;
     }
 
+    return len;
+}
+
+unsigned int get_rgb_from_addr(struct device *dev, unsigned short address, unsigned char len, char* buf)
+{
+    struct razer_kraken_device *device = dev_get_drvdata(dev);
+    unsigned int written;
+
+    mutex_lock(&device->lock);
+    written = get_rgb_from_addr_locked(device, address, len, buf);
+    mutex_unlock(&device->lock);
+
     return written;
 }
 
@@ -272,9 +378,9 @@ static ssize_t razer_attr_write_mode_spectrum(struct device *dev, struct device_
 
     report.arguments[0] = effect_byte.value;
 
-    // Lock access to sending USB as adhering to the razer len*15ms delay
+    // Lock access to sending USB as writes are paced on the device acknowledging them
     mutex_lock(&device->lock);
-    razer_kraken_send_control_msg(device->usb_dev, &report, 0);
+    razer_kraken_write_locked(device, &report);
     mutex_unlock(&device->lock);
 
     return count;
@@ -297,9 +403,9 @@ static ssize_t razer_attr_write_mode_none(struct device *dev, struct device_attr
 
     report.arguments[0] = effect_byte.value;
 
-    // Lock access to sending USB as adhering to the razer len*15ms delay
+    // Lock access to sending USB as writes are paced on the device acknowledging them
     mutex_lock(&device->lock);
-    razer_kraken_send_control_msg(device->usb_dev, &report, 0);
+    razer_kraken_write_locked(device, &report);
     mutex_unlock(&device->lock);
 
     return count;
@@ -339,12 +445,12 @@ static ssize_t razer_attr_write_mode_static(struct device *dev, struct device_at
         switch(device->usb_pid) {
         case USB_DEVICE_ID_RAZER_KRAKEN:
         case USB_DEVICE_ID_RAZER_KRAKEN_V2:
-            razer_kraken_send_control_msg(device->usb_dev, &rgb_report, 0);
+            razer_kraken_write_locked(device, &rgb_report);
             break;
         }
 
         // Send Set static command
-        razer_kraken_send_control_msg(device->usb_dev, &effect_report, 0);
+        razer_kraken_write_locked(device, &effect_report);
         mutex_unlock(&device->lock);
 
     } else {
@@ -449,9 +555,9 @@ static ssize_t razer_attr_write_mode_breath(struct device *dev, struct device_at
 
         // Lock sending of the 2 commands
         mutex_lock(&device->lock);
-        razer_kraken_send_control_msg(device->usb_dev, &rgb_report, 0);
+        razer_kraken_write_locked(device, &rgb_report);
 
-        razer_kraken_send_control_msg(device->usb_dev, &effect_report, 0);
+        razer_kraken_write_locked(device, &effect_report);
         mutex_unlock(&device->lock);
     } else if(count == 6) {
         struct razer_kraken_request_report rgb_report  = get_kraken_request_report(0x04, 0x40, 0x03, device->breathing_address[1]);
@@ -472,11 +578,11 @@ static ssize_t razer_attr_write_mode_breath(struct device *dev, struct device_at
 
         // Lock sending of the 2 commands
         mutex_lock(&device->lock);
-        razer_kraken_send_control_msg(device->usb_dev, &rgb_report, 0);
+        razer_kraken_write_locked(device, &rgb_report);
 
-        razer_kraken_send_control_msg(device->usb_dev, &rgb_report2, 0);
+        razer_kraken_write_locked(device, &rgb_report2);
 
-        razer_kraken_send_control_msg(device->usb_dev, &effect_report, 0);
+        razer_kraken_write_locked(device, &effect_report);
         mutex_unlock(&device->lock);
 
     } else if(count == 9) {
@@ -502,13 +608,13 @@ static ssize_t razer_attr_write_mode_breath(struct device *dev, struct device_at
 
         // Lock sending of the 2 commands
         mutex_lock(&device->lock);
-        razer_kraken_send_control_msg(device->usb_dev, &rgb_report, 0);
+        razer_kraken_write_locked(device, &rgb_report);
 
-        razer_kraken_send_control_msg(device->usb_dev, &rgb_report2, 0);
+        razer_kraken_write_locked(device, &rgb_report2);
 
-        razer_kraken_send_control_msg(device->usb_dev, &rgb_report3, 0);
+        razer_kraken_write_locked(device, &rgb_report3);
 
-        razer_kraken_send_control_msg(device->usb_dev, &effect_report, 0);
+        razer_kraken_write_locked(device, &effect_report);
         mutex_unlock(&device->lock);
 
     } else {
@@ -526,8 +632,13 @@ static ssize_t razer_attr_write_mode_breath(struct device *dev, struct device_at
 static ssize_t razer_attr_read_mode_breath(struct device *dev, struct device_attribute *attr, char *buf)
 {
     struct razer_kraken_device *device = dev_get_drvdata(dev);
-    union razer_kraken_effect_byte effect_byte = (union razer_kraken_effect_byte)get_current_effect(dev);
+    union razer_kraken_effect_byte effect_byte;
     unsigned char num_colours = 1;
+    unsigned int written;
+
+    // Hold the lock across both requests so the effect can't change in between
+    mutex_lock(&device->lock);
+    effect_byte.value = get_current_effect_locked(device);
 
     if(effect_byte.bits.two_colour_breathing == 1) {
         num_colours = 2;
@@ -539,22 +650,25 @@ static ssize_t razer_attr_read_mode_breath(struct device *dev, struct device_att
     case USB_DEVICE_ID_RAZER_KRAKEN_V2:
         switch(num_colours) {
         case 3:
-            return get_rgb_from_addr(dev, device->breathing_address[2], 0x0C, buf);
+            written = get_rgb_from_addr_locked(device, device->breathing_address[2], 0x0C, buf);
             break;
         case 2:
-            return get_rgb_from_addr(dev, device->breathing_address[1], 0x08, buf);
+            written = get_rgb_from_addr_locked(device, device->breathing_address[1], 0x08, buf);
             break;
         default:
-            return get_rgb_from_addr(dev, device->breathing_address[0], 0x04, buf);
+            written = get_rgb_from_addr_locked(device, device->breathing_address[0], 0x04, buf);
             break;
         }
         break;
 
     case USB_DEVICE_ID_RAZER_KRAKEN:
     default:
-        return get_rgb_from_addr(dev, device->breathing_address[0], 0x04, buf);
+        written = get_rgb_from_addr_locked(device, device->breathing_address[0], 0x04, buf);
         break;
     }
+    mutex_unlock(&device->lock);
+
+    return written;
 }
 
 /**
@@ -566,20 +680,16 @@ static ssize_t razer_attr_read_get_serial(struct device *dev, struct device_attr
 {
     struct razer_kraken_device *device = dev_get_drvdata(dev);
     struct razer_kraken_request_report report = get_kraken_request_report(0x04, 0x20, 0x16, 0x7f00);
+    unsigned char response[32];
 
     // Basically some simple caching
     // Also skips going to device if it doesn't contain the serial
     if(device->serial[0] == '\0') {
 
         mutex_lock(&device->lock);
-        device->data[0] = 0x00;
-        razer_kraken_send_control_msg(device->usb_dev, &report, 1);
-        msleep(25); // Sleep 20ms
-
-        // Check for actual data
-        if(device->data[0] == 0x05) {
+        if(razer_kraken_get_response_locked(device, &report, &response[0], RAZER_KRAKEN_RESPONSE_RETRIES) == 0) {
             // Serial is present
-            memcpy(&device->serial[0], &device->data[1], 22);
+            memcpy(&device->serial[0], &response[0], 22);
             device->serial[22] = '\0';
         } else {
             printk(KERN_CRIT "razerkraken: Did not manage to get serial from device, using XX01 instead\n");
@@ -605,21 +715,17 @@ static ssize_t razer_attr_read_get_firmware_version(struct device *dev, struct d
 {
     struct razer_kraken_device *device = dev_get_drvdata(dev);
     struct razer_kraken_request_report report = get_kraken_request_report(0x04, 0x20, 0x02, 0x0030);
+    unsigned char response[32];
 
     // Basically some simple caching
     if(device->firmware_version[0] != 1) {
 
         mutex_lock(&device->lock);
-        device->data[0] = 0x00;
-        razer_kraken_send_control_msg(device->usb_dev, &report, 1);
-        msleep(25); // Sleep 20ms
-
-        // Check for actual data
-        if(device->data[0] == 0x05) {
-            // Serial is present
+        if(razer_kraken_get_response_locked(device, &report, &response[0], RAZER_KRAKEN_RESPONSE_RETRIES) == 0) {
+            // Version is present
             device->firmware_version[0] = 1;
-            device->firmware_version[1] = device->data[1];
-            device->firmware_version[2] = device->data[2];
+            device->firmware_version[1] = response[0];
+            device->firmware_version[2] = response[1];
         } else {
             printk(KERN_CRIT "razerkraken: Did not manage to get firmware version from device, using v9.99 instead\n");
             device->firmware_version[0] = 1;
@@ -644,6 +750,31 @@ static ssize_t razer_attr_read_matrix_current_effect(struct device *dev, struct
     return sprintf(buf, "%02x\n", current_effect);
 }
 
+/**
+ * Read device file "response_latency"
+ *
+ * Returns a string, round trip of memory requests in microseconds. Reads used to
+ * sleep a fixed 25000us before looking at the answer.
+ */
+static ssize_t razer_attr_read_response_latency(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct razer_kraken_device *device = dev_get_drvdata(dev);
+    unsigned int answered;
+    unsigned int avg_us = 0;
+    ssize_t len;
+
+    mutex_lock(&device->lock);
+    answered = device->resp_count - device->resp_timeouts;
+    if(answered != 0) {
+        avg_us = (unsigned int)div_u64(device->resp_total_us, answered);
+    }
+    len = sprintf(buf, "requests: %u timeouts: %u avg: %uus max: %uus\n",
+                  device->resp_count, device->resp_timeouts, avg_us, device->resp_max_us);
+    mutex_unlock(&device->lock);
+
+    return len;
+}
+
 /**
  * Write device file "device_mode"
  */
@@ -678,6 +809,7 @@ static DEVICE_ATTR(device_type,             0440, razer_attr_read_device_type,
 static DEVICE_ATTR(device_serial,           0440, razer_attr_read_get_serial,                 NULL);
 static DEVICE_ATTR(device_mode,             0660, razer_attr_read_device_mode,                razer_attr_write_device_mode);
 static DEVICE_ATTR(firmware_version,        0440, razer_attr_read_get_firmware_version,       NULL);
+static DEVICE_ATTR(response_latency,        0440, razer_attr_read_response_latency,           NULL);
 
 static DEVICE_ATTR(matrix_current_effect,	0440, razer_attr_read_matrix_current_effect,      NULL);
 static DEVICE_ATTR(matrix_effect_none,      0220, NULL,                                       razer_attr_write_mode_none);
@@ -693,6 +825,9 @@ void razer_kraken_init(struct razer_kraken_device *dev, struct usb_interface *in
 
     // Initialise mutex
     mutex_init(&dev->lock);
+    // Initialise pending request slot
+    spin_lock_init(&dev->resp_lock);
+    init_completion(&dev->resp_done);
     // Setup values
     dev->usb_dev = usb_dev;
     dev->usb_interface_protocol = intf->cur_altsetting->desc.bInterfaceProtocol;
@@ -748,6 +883,7 @@ static int razer_kraken_probe(struct hid_device *hdev, const struct hid_device_i
         CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_serial);                         // Get string of device serial
         CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_firmware_version);                      // Get string of device fw version
         CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_device_mode);                           // Get device mode
+        CREATE_DEVICE_FILE(&hdev->dev, &dev_attr_response_latency);                      // Get memory request round trip
 
         switch(dev->usb_pid) {
         case USB_DEVICE_ID_RAZER_KRAKEN_CLASSIC:
@@ -807,6 +943,7 @@ static void razer_kraken_disconnect(struct hid_device *hdev)
         device_remove_file(&hdev->dev, &dev_attr_device_serial);                         // Get string of device serial
         device_remove_file(&hdev->dev, &dev_attr_firmware_version);                      // Get string of device fw version
         device_remove_file(&hdev->dev, &dev_attr_device_mode);                           // Get device mode
+        device_remove_file(&hdev->dev, &dev_attr_response_latency);                      // Get memory request round trip
 
         switch(dev->usb_pid) {
         case USB_DEVICE_ID_RAZER_KRAKEN_CLASSIC:
@@ -836,11 +973,24 @@ static void razer_kraken_disconnect(struct hid_device *hdev)
 static int razer_raw_event(struct hid_device *hdev, struct hid_report *report, u8 *data, int size)
 {
     struct razer_kraken_device *device = dev_get_drvdata(&hdev->dev);
+    unsigned long flags;
 
     //printk(KERN_WARNING "razerkraken: Got raw message %d\n", size);
 
     if(size == 33) { // Should be a response to a Control packet
-        memcpy(&device->data[0], &data[0], size);
+        spin_lock_irqsave(&device->resp_lock, flags);
+        if(data[0] == 0x05 && device->resp_stale != 0) {
+            // Late answer to a timed out request, wake the drain once all are in
+            if(--device->resp_stale == 0 && !device->resp_pending) {
+                complete(&device->resp_done);
+            }
+        } else if(data[0] == 0x05 && device->resp_pending) {
+            // Only hand over memory access results while a request is waiting for one
+            memcpy(&device->data[0], &data[0], size);
+            device->resp_pending = false;
+            complete(&device->resp_done);
+        }
+        spin_unlock_irqrestore(&device->resp_lock, flags);
 
     } else {
         printk(KERN_WARNING "razerkraken: Got raw message, length: %d\n", size);
@@ -25,9 +25,27 @@
 
 // #define RAZER_KRAKEN_V2_REPORT_LEN ?
 
+// How long to wait for the device to answer a memory request, and how often to ask
+#define RAZER_KRAKEN_RESPONSE_TIMEOUT_MS 50
+#define RAZER_KRAKEN_RESPONSE_RETRIES 3
+
 struct razer_kraken_device {
     struct usb_device *usb_dev;
     struct mutex lock;
+
+    // Pending request slot, filled in by razer_raw_event
+    spinlock_t resp_lock;
+    struct completion resp_done;
+    bool resp_pending;         // A request is waiting for its answer
+    unsigned int resp_stale;   // Answers still owed to timed out requests, dropped when they arrive
+
+    // Round trip of memory requests, shown by "response_latency"
+    unsigned int resp_count;
+    unsigned int resp_timeouts;
+    u64 resp_total_us;
+    unsigned int resp_max_us;
+
+
     unsigned char usb_interface_protocol;
     unsigned short usb_pid;
     unsigned short usb_vid;
@@ -4188,6 +4188,55 @@ void dump_hal_spec(void *sel, _adapter *adapter)
 	DBG_871X_SEL(sel, "\n");
 }
 
+static const char *const _fwdl_path_str[] = {
+	"sync",
+	"async",
+};
+
+#define fwdl_path_str(path) (((path) >= FWDL_PATH_NUM) ? "unknown" : _fwdl_path_str[(path)])
+
+void rtw_hal_fwdl_stats_update(_adapter *adapter, u8 path, s32 status, u32 ms)
+{
+	struct fwdl_path_stats *stats;
+
+	if (path >= FWDL_PATH_NUM)
+		return;
+
+	stats = &GET_HAL_DATA(adapter)->fwdl_stats.path[path];
+	if (status != _SUCCESS) {
+		stats->fail_cnt++;
+		return;
+	}
+
+	stats->cnt++;
+	stats->last_ms = ms;
+	stats->total_ms += ms;
+	if (stats->cnt == 1 || ms < stats->min_ms)
+		stats->min_ms = ms;
+	if (ms > stats->max_ms)
+		stats->max_ms = ms;
+}
+
+void rtw_dump_fwdl_stats(void *sel, _adapter *adapter)
+{
+	struct fwdl_stats *fwdl_stats = &GET_HAL_DATA(adapter)->fwdl_stats;
+	struct fwdl_path_stats *stats;
+	u8 path;
+
+	DBG_871X_SEL_NL(sel, "fwdl_async:%u\n", adapter->registrypriv.fwdl_async);
+	DBG_871X_SEL_NL(sel, "FWDL last path:%s total:%ums fallback:%u\n"
+		, fwdl_path_str(fwdl_stats->last_path), fwdl_stats->last_total_ms, fwdl_stats->fallback_cnt);
+
+	for (path = 0; path < FWDL_PATH_NUM; path++) {
+		stats = &fwdl_stats->path[path];
+		if (!stats->cnt && !stats->fail_cnt)
+			continue;
+		DBG_871X_SEL_NL(sel, "%-5s cnt:%u fail:%u last:%ums min:%ums max:%ums avg:%ums\n"
+			, fwdl_path_str(path), stats->cnt, stats->fail_cnt, stats->last_ms
+			, stats->min_ms, stats->max_ms, stats->cnt ? stats->total_ms / stats->cnt : 0);
+	}
+}
+
 inline bool hal_chk_band_cap(_adapter *adapter, u8 cap)
 {
 	return (GET_HAL_SPEC(adapter)->band_cap & cap);
@@ -402,6 +402,24 @@ void	rtw_hal_free_xmit_priv(_adapter *padapter)
 	padapter->HalFunc.free_xmit_priv(padapter);
 }
 
+void	rtw_hal_dump_txdesc_tmpl(void *sel, _adapter *padapter)
+{
+	if (padapter->HalFunc.dump_txdesc_tmpl)
+		padapter->HalFunc.dump_txdesc_tmpl(sel, padapter);
+}
+
+void	rtw_hal_txdesc_tmpl_set(_adapter *padapter, u8 en, u8 verify)
+{
+	if (padapter->HalFunc.txdesc_tmpl_set)
+		padapter->HalFunc.txdesc_tmpl_set(padapter, en, verify);
+}
+
+void	rtw_hal_txdesc_tmpl_bench(_adapter *padapter, u32 cnt)
+{
+	if (padapter->HalFunc.txdesc_tmpl_bench)
+		padapter->HalFunc.txdesc_tmpl_bench(padapter, cnt);
+}
+
 s32	rtw_hal_init_recv_priv(_adapter *padapter)
 {
 	return padapter->HalFunc.init_recv_priv(padapter);
@@ -266,6 +266,68 @@ exit:
 	return ret;
 }
 
+#ifdef CONFIG_USB_HCI
+// same block split as _BlockWrite(), vendor req are pipelined
+static int
+_BlockWrite_async(
+	IN		struct usb_fwdl_async	*fwdl,
+	IN		u8			*buffer,
+	IN		u32			buffSize
+	)
+{
+	u32	offset = 0, len;
+
+	while (offset < buffSize)
+	{
+		len = buffSize - offset;
+		if (len >= 254)
+			len = 254;
+		else if (len >= 8)
+			len = 8;
+		else
+			len = 1;
+
+		if (usb_fwdl_async_write(fwdl, FW_8723B_START_ADDRESS + offset, len, buffer + offset) == _FAIL)
+			return _FAIL;
+		offset += len;
+	}
+
+	return _SUCCESS;
+}
+
+// page select is queued behind blocks of previous page, ep0 keeps them in order
+static int
+_WriteFW_async(
+	IN		PADAPTER		padapter,
+	IN		struct usb_fwdl_async	*fwdl,
+	IN		PVOID			buffer,
+	IN		u32			size
+	)
+{
+	u8	*bufferPtr = (u8*)buffer;
+	u32	page, offset, len;
+	u8	value8, u8Page;
+
+	value8 = rtw_read8(padapter, REG_MCUFWDL+2) & 0xF8;
+
+	for (page = 0, offset = 0; offset < size; page++, offset += len)
+	{
+		len = size - offset;
+		if (len > MAX_DLFW_PAGE_SIZE)
+			len = MAX_DLFW_PAGE_SIZE;
+
+		u8Page = value8 | (u8)(page & 0x07);
+		if (usb_fwdl_async_write(fwdl, REG_MCUFWDL+2, 1, &u8Page) == _FAIL)
+			return _FAIL;
+
+		if (_BlockWrite_async(fwdl, bufferPtr + offset, len) == _FAIL)
+			return _FAIL;
+	}
+
+	return _SUCCESS;
+}
+#endif // CONFIG_USB_HCI
+
 void _8051Reset8723(PADAPTER padapter)
 {
 	u8 cpu_rst;
@@ -331,6 +393,29 @@ exit:
 	return ret;
 }
 
+#ifdef CONFIG_USB_HCI
+//
+// checksum polling is issued right after the last block is submitted,
+// its first read completes behind the blocks still in flight
+//
+static s32 _WriteFW_pipelined(_adapter *adapter, PVOID buffer, u32 size)
+{
+	struct usb_fwdl_async fwdl;
+	s32 ret;
+
+	usb_fwdl_async_init(adapter_to_dvobj(adapter), &fwdl);
+
+	ret = _WriteFW_async(adapter, &fwdl, buffer, size);
+	if (ret == _SUCCESS)
+		ret = polling_fwdl_chksum(adapter, 5, 50);
+
+	if (usb_fwdl_async_flush(&fwdl, RTW_USB_CONTROL_MSG_TIMEOUT) == _FAIL)
+		ret = _FAIL;
+
+	return ret;
+}
+#endif // CONFIG_USB_HCI
+
 static s32 _FWFreeToGo(_adapter *adapter, u32 min_cnt, u32 timeout_ms)
 {
 	s32 ret = _FAIL;
@@ -416,7 +501,8 @@ s32 rtl8723b_FirmwareDownload(PADAPTER padapter)
 {
 	s32	rtStatus = _SUCCESS;
 	u8 write_fw = 0;
-	u32 fwdl_start_time;
+	u32 fwdl_start_time, write_start_time;
+	u8 path = FWDL_PATH_SYNC;
 	PHAL_DATA_TYPE	pHalData = GET_HAL_DATA(padapter);
 	u8			*FwImage;
 	u32			FwImageLen;
@@ -489,6 +575,11 @@ s32 rtl8723b_FirmwareDownload(PADAPTER padapter)
 		rtl8723b_FirmwareSelfReset(padapter);
 	}
 
+#ifdef CONFIG_USB_HCI
+	if (padapter->registrypriv.fwdl_async)
+		path = FWDL_PATH_ASYNC;
+#endif
+
 	_FWDownloadEnable(padapter, _TRUE);
 	fwdl_start_time = rtw_get_current_time();
 	while (!RTW_CANNOT_IO(padapter)
@@ -497,11 +588,25 @@ s32 rtl8723b_FirmwareDownload(PADAPTER padapter)
 		/* reset FWDL chksum */
 		rtw_write8(padapter, REG_MCUFWDL, rtw_read8(padapter, REG_MCUFWDL)|FWDL_ChkSum_rpt);
 
-		rtStatus = _WriteFW(padapter, pFirmwareBuf, FirmwareLen);
-		if (rtStatus != _SUCCESS)
+		write_start_time = rtw_get_current_time();
+#ifdef CONFIG_USB_HCI
+		if (path == FWDL_PATH_ASYNC) {
+			rtStatus = _WriteFW_pipelined(padapter, pFirmwareBuf, FirmwareLen);
+			rtw_hal_fwdl_stats_update(padapter, path, rtStatus, rtw_get_passing_time_ms(write_start_time));
+			if (rtStatus == _SUCCESS)
+				break;
+
+			// retry by vendor req one by one
+			path = FWDL_PATH_SYNC;
+			pHalData->fwdl_stats.fallback_cnt++;
 			continue;
+		}
+#endif
 
-		rtStatus = polling_fwdl_chksum(padapter, 5, 50);
+		rtStatus = _WriteFW(padapter, pFirmwareBuf, FirmwareLen);
+		if (rtStatus == _SUCCESS)
+			rtStatus = polling_fwdl_chksum(padapter, 5, 50);
+		rtw_hal_fwdl_stats_update(padapter, path, rtStatus, rtw_get_passing_time_ms(write_start_time));
 		if (rtStatus == _SUCCESS)
 			break;
 	}
@@ -514,10 +619,13 @@ s32 rtl8723b_FirmwareDownload(PADAPTER padapter)
 		goto fwdl_stat;
 
 fwdl_stat:
-	DBG_871X("FWDL %s. write_fw:%u, %dms\n"
+	pHalData->fwdl_stats.last_path = path;
+	pHalData->fwdl_stats.last_total_ms = rtw_get_passing_time_ms(fwdl_start_time);
+	DBG_871X("FWDL %s. path:%s write_fw:%u, %dms\n"
 		, (rtStatus == _SUCCESS)?"success":"fail"
+		, (path == FWDL_PATH_ASYNC)?"async":"sync"
 		, write_fw
-		, rtw_get_passing_time_ms(fwdl_start_time)
+		, pHalData->fwdl_stats.last_total_ms
 	);
 
 exit:
@@ -4123,6 +4231,28 @@ static void fill_txdesc_phy_8723b(PADAPTER padapter, struct pkt_attrib *pattrib,
 	}
 }
 
+static void fill_txdesc_offset_8723b(struct xmit_frame *pxmitframe, u8 *pbuf)
+{
+	u8 pkt_offset, offset;
+
+	pkt_offset = 0;
+	offset = TXDESC_SIZE;
+#ifdef CONFIG_USB_HCI
+	pkt_offset = pxmitframe->pkt_offset;
+	offset += (pxmitframe->pkt_offset >> 3);
+#endif // CONFIG_USB_HCI
+
+#ifdef CONFIG_TX_EARLY_MODE
+	if (pxmitframe->frame_tag == DATA_FRAMETAG) {
+		pkt_offset = 1;
+		offset += EARLY_MODE_INFO_SIZE;
+	}
+#endif // CONFIG_TX_EARLY_MODE
+
+	SET_TX_DESC_PKT_OFFSET_8723B(pbuf, pkt_offset);
+	SET_TX_DESC_OFFSET_8723B(pbuf, offset);
+}
+
 static void rtl8723b_fill_default_txdesc(
 	struct xmit_frame *pxmitframe,
 	u8 *pbuf)
@@ -4315,26 +4445,7 @@ static void rtl8723b_fill_default_txdesc(
 
 	SET_TX_DESC_PKT_SIZE_8723B(pbuf, pattrib->last_txcmdsz);
 
-	{
-		u8 pkt_offset, offset;
-
-		pkt_offset = 0;
-		offset = TXDESC_SIZE;
-#ifdef CONFIG_USB_HCI
-		pkt_offset = pxmitframe->pkt_offset;
-		offset += (pxmitframe->pkt_offset >> 3);
-#endif // CONFIG_USB_HCI
-
-#ifdef CONFIG_TX_EARLY_MODE
-		if (pxmitframe->frame_tag == DATA_FRAMETAG) {
-			pkt_offset = 1;
-			offset += EARLY_MODE_INFO_SIZE;
-		}
-#endif // CONFIG_TX_EARLY_MODE
-
-		SET_TX_DESC_PKT_OFFSET_8723B(pbuf, pkt_offset);
-		SET_TX_DESC_OFFSET_8723B(pbuf, offset);
-	}
+	fill_txdesc_offset_8723b(pxmitframe, pbuf);
 
 	if (bmcst) {
 		SET_TX_DESC_BMC_8723B(pbuf, 1);
@@ -4360,9 +4471,365 @@ static void rtl8723b_fill_default_txdesc(
  *		pxmitframe	xmitframe
  *		pbuf		where to fill tx desc
  */
+#ifdef CONFIG_USB_HCI
+//
+// unicast data frame to associated sta could use tx desc template,
+// others are built by rtl8723b_fill_default_txdesc() each time
+//
+static u8 txdesc_tmpl_applicable_8723b(struct xmit_frame *pxmitframe)
+{
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+
+	if (pxmitframe->frame_tag != DATA_FRAMETAG)
+		return _FALSE;
+	if (IS_MCAST(pattrib->ra) || !pattrib->psta)
+		return _FALSE;
+	if (pattrib->mac_id >= MACID_NUM_SW_LIMIT || pattrib->priority >= TXDESC_TMPL_TID_NUM)
+		return _FALSE;
+	if ((pattrib->ether_type == 0x888e) ||
+		(pattrib->ether_type == 0x0806) ||
+		(pattrib->ether_type == 0x88B4) ||
+		(pattrib->dhcp_pkt == 1) ||
+		(pattrib->icmp_pkt == 1))
+		return _FALSE;
+#ifdef CONFIG_AUTO_AP_MODE
+	if (pattrib->pctrl == _TRUE)
+		return _FALSE;
+#endif
+#ifdef CONFIG_XMIT_ACK
+	if (pxmitframe->ack_report)
+		return _FALSE;
+#endif
+
+	return _TRUE;
+}
+
+static void txdesc_tmpl_key_fill_8723b(PADAPTER padapter, struct pkt_attrib *pattrib, struct txdesc_tmpl_key_8723b *key)
+{
+	HAL_DATA_TYPE *pHalData = GET_HAL_DATA(padapter);
+
+	_rtw_memset(key, 0, sizeof(*key));
+	key->raid = pattrib->raid;
+	key->qsel = pattrib->qsel;
+	key->qos_en = pattrib->qos_en;
+	key->encrypt = pattrib->encrypt;
+	key->bswenc = pattrib->bswenc;
+	key->vcs_mode = pattrib->vcs_mode;
+	key->ampdu_en = pattrib->ampdu_en;
+	key->ampdu_spacing = pattrib->ampdu_spacing;
+	key->ht_en = pattrib->ht_en;
+	key->bwmode = pattrib->bwmode;
+	key->ldpc = pattrib->ldpc;
+	key->stbc = pattrib->stbc;
+	key->fw_ractrl = pHalData->fw_ractrl;
+	key->ini_rate = pHalData->INIDATA_RATE[pattrib->mac_id];
+	key->fix_rate = padapter->fix_rate;
+	key->data_fb = padapter->data_fb;
+	key->preamble_mode = padapter->mlmeextpriv.mlmext_info.preamble_mode;
+	key->cur_bw = pHalData->CurrentChannelBW;
+	key->sc40 = pHalData->nCur40MhzPrimeSC;
+	key->sc80 = pHalData->nCur80MhzPrimeSC;
+}
+
+// XOR of the two halfwords of dword, as rtl8723b_cal_txdesc_chksum() does
+#define txdesc_dw_chksum_8723b(desc, dw) \
+	(le16_to_cpu(*((u16 *)(desc) + (dw) * 2)) ^ le16_to_cpu(*((u16 *)(desc) + (dw) * 2 + 1)))
+
+static void txdesc_tmpl_save_8723b(struct txdesc_tmpl_8723b *tmpl, struct txdesc_tmpl_key_8723b *key, u8 *pbuf)
+{
+	u8 *desc = tmpl->desc;
+	u16 chksum = 0;
+	int i;
+
+	_rtw_memcpy(desc, pbuf, TXDESC_SIZE);
+
+	SET_TX_DESC_PKT_SIZE_8723B(desc, 0);
+	SET_TX_DESC_OFFSET_8723B(desc, 0);
+	SET_TX_DESC_PKT_OFFSET_8723B(desc, 0);
+	SET_TX_DESC_USB_TXAGG_NUM_8723B(desc, 0);
+	SET_TX_DESC_TX_DESC_CHECKSUM_8723B(desc, 0);
+	SET_TX_DESC_SEQ_8723B(desc, 0);
+
+	for (i = 0; i < 8; i++)
+		chksum ^= txdesc_dw_chksum_8723b(desc, i);
+
+	tmpl->chksum = chksum;
+	_rtw_memcpy(&tmpl->key, key, sizeof(*key));
+	tmpl->valid = 1;
+}
+
+// copy template then patch per frame fields, checksum updated by the patched dwords only
+static void fill_txdesc_by_tmpl_8723b(struct xmit_frame *pxmitframe, struct txdesc_tmpl_8723b *tmpl, u8 *pbuf)
+{
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+	u16 chksum;
+
+	_rtw_memcpy(pbuf, tmpl->desc, TXDESC_SIZE);
+
+	SET_TX_DESC_PKT_SIZE_8723B(pbuf, pattrib->last_txcmdsz);
+	fill_txdesc_offset_8723b(pxmitframe, pbuf);
+#ifdef CONFIG_USB_TX_AGGREGATION
+	SET_TX_DESC_USB_TXAGG_NUM_8723B(pbuf, pxmitframe->agg_num);
+#endif
+	SET_TX_DESC_SEQ_8723B(pbuf, pattrib->seqnum);
+
+	// per frame fields are in dword 0, 1, 7(upper half), seq(dword 9) is not covered by checksum
+	chksum = tmpl->chksum;
+	chksum ^= txdesc_dw_chksum_8723b(pbuf, 0) ^ txdesc_dw_chksum_8723b(tmpl->desc, 0);
+	chksum ^= txdesc_dw_chksum_8723b(pbuf, 1) ^ txdesc_dw_chksum_8723b(tmpl->desc, 1);
+	chksum ^= txdesc_dw_chksum_8723b(pbuf, 7) ^ txdesc_dw_chksum_8723b(tmpl->desc, 7);
+	SET_TX_DESC_TX_DESC_CHECKSUM_8723B(pbuf, chksum);
+}
+
+// return _TRUE if desc is filled from template
+static u8 txdesc_tmpl_fill_8723b(struct txdesc_tmpl_ctl_8723b *ctl, struct xmit_frame *pxmitframe, u8 *pbuf)
+{
+	PADAPTER padapter = pxmitframe->padapter;
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+	struct txdesc_tmpl_8723b *tmpl;
+	struct txdesc_tmpl_8723b snap;
+	struct txdesc_tmpl_key_8723b key;
+	u8 legacy[TXDESC_SIZE];
+	_irqL irqL;
+	u8 hit;
+
+	if (!ctl || !ctl->en)
+		return _FALSE;
+
+	if (!txdesc_tmpl_applicable_8723b(pxmitframe)) {
+		_enter_critical_bh(&ctl->lock, &irqL);
+		ctl->bypass_cnt++;
+		_exit_critical_bh(&ctl->lock, &irqL);
+		return _FALSE;
+	}
+
+	txdesc_tmpl_key_fill_8723b(padapter, pattrib, &key);
+	tmpl = &ctl->tmpl[pattrib->mac_id][pattrib->priority];
+
+	// take a consistent copy of the slot, desc is patched outside the lock
+	_enter_critical_bh(&ctl->lock, &irqL);
+	hit = tmpl->valid && _rtw_memcmp(&tmpl->key, &key, sizeof(key)) == _TRUE;
+	if (hit) {
+		_rtw_memcpy(&snap, tmpl, sizeof(snap));
+		ctl->hit_cnt++;
+	}
+	_exit_critical_bh(&ctl->lock, &irqL);
+
+	if (!hit) {
+		// rate adaptive, key or BA session changed, rebuild in frame's own buffer then publish
+		rtl8723b_fill_default_txdesc(pxmitframe, pbuf);
+		rtl8723b_cal_txdesc_chksum((struct tx_desc*)pbuf);
+		_enter_critical_bh(&ctl->lock, &irqL);
+		txdesc_tmpl_save_8723b(tmpl, &key, pbuf);
+		ctl->build_cnt++;
+		_exit_critical_bh(&ctl->lock, &irqL);
+		return _TRUE;
+	}
+
+	fill_txdesc_by_tmpl_8723b(pxmitframe, &snap, pbuf);
+
+	if (ctl->verify) {
+		rtl8723b_fill_default_txdesc(pxmitframe, legacy);
+		rtl8723b_cal_txdesc_chksum((struct tx_desc*)legacy);
+		if (_rtw_memcmp(legacy, pbuf, TXDESC_SIZE) == _FALSE) {
+			DBG_871X_LEVEL(_drv_warning_, "%s macid:%u tid:%u mismatch with legacy tx desc\n"
+				, __func__, pattrib->mac_id, pattrib->priority);
+			_rtw_memcpy(pbuf, legacy, TXDESC_SIZE);
+			_enter_critical_bh(&ctl->lock, &irqL);
+			tmpl->valid = 0;
+			ctl->mismatch_cnt++;
+			_exit_critical_bh(&ctl->lock, &irqL);
+		}
+	}
+
+	return _TRUE;
+}
+
+void rtl8723b_dump_txdesc_tmpl(void *sel, _adapter *padapter)
+{
+	struct txdesc_tmpl_ctl_8723b *ctl = GET_HAL_DATA(padapter)->txdesc_tmpl;
+	struct txdesc_tmpl_8723b *tmpl;
+	u32 cnt[4], bench[4];
+	_irqL irqL;
+	int i, j;
+
+	if (!ctl)
+		return;
+
+	_enter_critical_bh(&ctl->lock, &irqL);
+	cnt[0] = ctl->hit_cnt;
+	cnt[1] = ctl->build_cnt;
+	cnt[2] = ctl->bypass_cnt;
+	cnt[3] = ctl->mismatch_cnt;
+	bench[0] = ctl->bench_cnt;
+	bench[1] = ctl->bench_legacy_ms;
+	bench[2] = ctl->bench_tmpl_ms;
+	bench[3] = ctl->bench_mismatch;
+	_exit_critical_bh(&ctl->lock, &irqL);
+
+	DBG_871X_SEL_NL(sel, "en:%u verify:%u\n", ctl->en, ctl->verify);
+	DBG_871X_SEL_NL(sel, "hit:%u build:%u bypass:%u mismatch:%u\n"
+		, cnt[0], cnt[1], cnt[2], cnt[3]);
+	if (bench[0]) {
+		DBG_871X_SEL_NL(sel, "bench cnt:%u legacy:%ums tmpl:%ums mismatch:%u\n"
+			, bench[0], bench[1], bench[2], bench[3]);
+	}
+
+	DBG_871X_SEL_NL(sel, "%-5s %-3s %-4s %-4s %-7s %-5s %-8s %-6s\n"
+		, "macid", "tid", "raid", "qsel", "encrypt", "ampdu", "ini_rate", "chksum");
+	for (i = 0; i < MACID_NUM_SW_LIMIT; i++) {
+		for (j = 0; j < TXDESC_TMPL_TID_NUM; j++) {
+			tmpl = &ctl->tmpl[i][j];
+			if (!tmpl->valid)
+				continue;
+			DBG_871X_SEL_NL(sel, "%5d %3d %4u %4u %7u %5u     0x%02x 0x%04x\n"
+				, i, j, tmpl->key.raid, tmpl->key.qsel, tmpl->key.encrypt
+				, tmpl->key.ampdu_en, tmpl->key.ini_rate, tmpl->chksum);
+		}
+	}
+}
+
+void rtl8723b_txdesc_tmpl_set(_adapter *padapter, u8 en, u8 verify)
+{
+	struct txdesc_tmpl_ctl_8723b *ctl = GET_HAL_DATA(padapter)->txdesc_tmpl;
+	_irqL irqL;
+	int i, j;
+
+	if (!ctl)
+		return;
+
+	_enter_critical_bh(&ctl->lock, &irqL);
+	if (!en) {
+		for (i = 0; i < MACID_NUM_SW_LIMIT; i++)
+			for (j = 0; j < TXDESC_TMPL_TID_NUM; j++)
+				ctl->tmpl[i][j].valid = 0;
+	}
+	ctl->en = en;
+	ctl->verify = verify;
+	_exit_critical_bh(&ctl->lock, &irqL);
+}
+
+//
+// build tx desc of linked sta's BE data frames with varied size, seq, pkt offset
+// by legacy way and by template, compare byte by byte
+// template of scratch ctl is used, not to race with tx path
+//
+void rtl8723b_txdesc_tmpl_bench(_adapter *padapter, u32 cnt)
+{
+	struct txdesc_tmpl_ctl_8723b *ctl = GET_HAL_DATA(padapter)->txdesc_tmpl;
+	struct txdesc_tmpl_ctl_8723b *scratch = NULL;
+	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
+	struct sta_info *psta = NULL;
+	struct xmit_frame *pxmitframe = NULL;
+	struct pkt_attrib *pattrib;
+	u8 legacy[TXDESC_SIZE];
+	u8 desc[TXDESC_SIZE];
+	u32 start;
+	u32 legacy_ms, tmpl_ms, mismatch = 0;
+	_irqL irqL;
+	u32 i;
+
+	if (!ctl || !cnt)
+		return;
+	if (cnt > TXDESC_TMPL_BENCH_MAX)
+		cnt = TXDESC_TMPL_BENCH_MAX;
+
+	if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE)
+		psta = rtw_get_stainfo(&padapter->stapriv, get_bssid(pmlmepriv));
+	if (!psta) {
+		DBG_871X(FUNC_ADPT_FMT" no linked sta\n", FUNC_ADPT_ARG(padapter));
+		return;
+	}
+
+	scratch = (struct txdesc_tmpl_ctl_8723b *)rtw_zvmalloc(sizeof(*scratch));
+	pxmitframe = (struct xmit_frame *)rtw_zmalloc(sizeof(*pxmitframe));
+	if (!scratch || !pxmitframe)
+		goto exit;
+	_rtw_spinlock_init(&scratch->lock);
+	scratch->en = 1;
+
+	pxmitframe->padapter = padapter;
+	pxmitframe->frame_tag = DATA_FRAMETAG;
+	pxmitframe->agg_num = 1;
+	pattrib = &pxmitframe->attrib;
+	pattrib->psta = psta;
+	pattrib->mac_id = psta->mac_id;
+	pattrib->raid = psta->raid;
+	pattrib->qos_en = psta->qos_option;
+	pattrib->priority = 0;
+	pattrib->qsel = pattrib->priority;
+	pattrib->ether_type = 0x0800;
+	pattrib->encrypt = (u8)padapter->securitypriv.dot11PrivacyAlgrthm;
+	pattrib->bwmode = padapter->mlmeextpriv.cur_bwmode;
+	pattrib->ldpc = psta->ldpc;
+	pattrib->stbc = psta->stbc;
+#ifdef CONFIG_80211N_HT
+	pattrib->ht_en = psta->htpriv.ht_option;
+	pattrib->ch_offset = psta->htpriv.ch_offset;
+	pattrib->ampdu_en = (psta->htpriv.agg_enable_bitmap & BIT(0)) ? _TRUE : _FALSE;
+	pattrib->ampdu_spacing = psta->htpriv.rx_ampdu_min_spacing;
+#endif
+	_rtw_memcpy(pattrib->ra, psta->hwaddr, ETH_ALEN);
+
+	start = rtw_get_current_time();
+	for (i = 0; i < cnt; i++) {
+		pattrib->seqnum = i & 0xfff;
+		pattrib->last_txcmdsz = 64 + (i % 1400);
+		pxmitframe->pkt_offset = i & 0x1;
+		rtl8723b_fill_default_txdesc(pxmitframe, legacy);
+		rtl8723b_cal_txdesc_chksum((struct tx_desc*)legacy);
+	}
+	legacy_ms = rtw_get_passing_time_ms(start);
+
+	start = rtw_get_current_time();
+	for (i = 0; i < cnt; i++) {
+		pattrib->seqnum = i & 0xfff;
+		pattrib->last_txcmdsz = 64 + (i % 1400);
+		pxmitframe->pkt_offset = i & 0x1;
+		txdesc_tmpl_fill_8723b(scratch, pxmitframe, desc);
+	}
+	tmpl_ms = rtw_get_passing_time_ms(start);
+
+	for (i = 0; i < cnt; i++) {
+		pattrib->seqnum = i & 0xfff;
+		pattrib->last_txcmdsz = 64 + (i % 1400);
+		pxmitframe->pkt_offset = i & 0x1;
+		rtl8723b_fill_default_txdesc(pxmitframe, legacy);
+		rtl8723b_cal_txdesc_chksum((struct tx_desc*)legacy);
+		txdesc_tmpl_fill_8723b(scratch, pxmitframe, desc);
+		if (_rtw_memcmp(legacy, desc, TXDESC_SIZE) == _FALSE)
+			mismatch++;
+	}
+
+	_enter_critical_bh(&ctl->lock, &irqL);
+	ctl->bench_cnt = cnt;
+	ctl->bench_legacy_ms = legacy_ms;
+	ctl->bench_tmpl_ms = tmpl_ms;
+	ctl->bench_mismatch = mismatch;
+	_exit_critical_bh(&ctl->lock, &irqL);
+
+	DBG_871X(FUNC_ADPT_FMT" cnt:%u legacy:%ums tmpl:%ums mismatch:%u\n", FUNC_ADPT_ARG(padapter)
+		, cnt, legacy_ms, tmpl_ms, mismatch);
+
+exit:
+	if (pxmitframe)
+		rtw_mfree((u8 *)pxmitframe, sizeof(*pxmitframe));
+	if (scratch) {
+		_rtw_spinlock_free(&scratch->lock);
+		rtw_vmfree((u8 *)scratch, sizeof(*scratch));
+	}
+}
+#endif // CONFIG_USB_HCI
+
 void rtl8723b_update_txdesc(struct xmit_frame *pxmitframe, u8 *pbuf)
 {
 	PADAPTER padapter = pxmitframe->padapter;
+
+#ifdef CONFIG_USB_HCI
+	if (txdesc_tmpl_fill_8723b(GET_HAL_DATA(padapter)->txdesc_tmpl, pxmitframe, pbuf) == _TRUE)
+		return;
+#endif
+
 	rtl8723b_fill_default_txdesc(pxmitframe, pbuf);
 
 #if defined(CONFIG_USB_HCI) || defined(CONFIG_SDIO_HCI) || defined(CONFIG_GSPI_HCI)
@@ -26,17 +26,35 @@
 s32	rtl8723bu_init_xmit_priv(_adapter *padapter)
 {
 	struct xmit_priv	*pxmitpriv = &padapter->xmitpriv;
+	HAL_DATA_TYPE	*pHalData = GET_HAL_DATA(padapter);
 
 #ifdef PLATFORM_LINUX
 	tasklet_init(&pxmitpriv->xmit_tasklet,
 	     (void(*)(unsigned long))rtl8723bu_xmit_tasklet,
 	     (unsigned long)padapter);
 #endif
+
+	if (is_primary_adapter(padapter)) {
+		pHalData->txdesc_tmpl = (struct txdesc_tmpl_ctl_8723b *)rtw_zvmalloc(sizeof(struct txdesc_tmpl_ctl_8723b));
+		if (pHalData->txdesc_tmpl) {
+			_rtw_spinlock_init(&pHalData->txdesc_tmpl->lock);
+			pHalData->txdesc_tmpl->en = 1;
+		} else
+			DBG_871X("%s alloc txdesc_tmpl fail, build tx desc per frame\n", __func__);
+	}
+
 	return _SUCCESS;
 }
 
 void	rtl8723bu_free_xmit_priv(_adapter *padapter)
 {
+	HAL_DATA_TYPE	*pHalData = GET_HAL_DATA(padapter);
+
+	if (is_primary_adapter(padapter) && pHalData->txdesc_tmpl) {
+		_rtw_spinlock_free(&pHalData->txdesc_tmpl->lock);
+		rtw_vmfree((u8 *)pHalData->txdesc_tmpl, sizeof(struct txdesc_tmpl_ctl_8723b));
+		pHalData->txdesc_tmpl = NULL;
+	}
 }
 
 void _dbg_dump_tx_info(_adapter	*padapter,int frame_tag,struct tx_desc *ptxdesc)
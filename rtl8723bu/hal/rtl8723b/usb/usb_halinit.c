@@ -2388,6 +2388,9 @@ _func_enter_;
 
 	pHalFunc->init_xmit_priv = &rtl8723bu_init_xmit_priv;
 	pHalFunc->free_xmit_priv = &rtl8723bu_free_xmit_priv;
+	pHalFunc->dump_txdesc_tmpl = &rtl8723b_dump_txdesc_tmpl;
+	pHalFunc->txdesc_tmpl_set = &rtl8723b_txdesc_tmpl_set;
+	pHalFunc->txdesc_tmpl_bench = &rtl8723b_txdesc_tmpl_bench;
 
 	pHalFunc->init_recv_priv = &rtl8723bu_init_recv_priv;
 	pHalFunc->free_recv_priv = &rtl8723bu_free_recv_priv;
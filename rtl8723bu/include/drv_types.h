@@ -269,6 +269,8 @@ struct registry_priv
 	u8 fw_iol; //enable iol without other concern
 #endif
 
+	u8 fwdl_async; // USB: pipeline fw download vendor req
+
 #ifdef CONFIG_80211D
 	u8 enable80211d;
 #endif
@@ -293,6 +293,9 @@ void rtw_hal_config_rftype(PADAPTER  padapter);
 int hal_spec_init(_adapter *adapter);
 void dump_hal_spec(void *sel, _adapter *adapter);
 
+void rtw_hal_fwdl_stats_update(_adapter *adapter, u8 path, s32 status, u32 ms);
+void rtw_dump_fwdl_stats(void *sel, _adapter *adapter);
+
 bool hal_chk_band_cap(_adapter *adapter, u8 cap);
 bool hal_chk_bw_cap(_adapter *adapter, u8 cap);
 bool hal_chk_proto_cap(_adapter *adapter, u8 cap);
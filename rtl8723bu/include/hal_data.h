@@ -207,6 +207,28 @@ struct hal_iqk_reg_backup {
 	u32 reg_backup[MAX_RF_PATH][MAX_IQK_INFO_BACKUP_REG_NUM];
 };
 
+enum fwdl_path {
+	FWDL_PATH_SYNC = 0,	// vendor req one by one
+	FWDL_PATH_ASYNC,	// vendor req pipelined
+	FWDL_PATH_NUM,
+};
+
+struct fwdl_path_stats {
+	u32 cnt;
+	u32 fail_cnt;
+	u32 last_ms;	// write image + checksum polling
+	u32 min_ms;
+	u32 max_ms;
+	u32 total_ms;
+};
+
+struct fwdl_stats {
+	struct fwdl_path_stats path[FWDL_PATH_NUM];
+	u32 fallback_cnt;	// async path failed, retried by sync path
+	u32 last_total_ms;	// whole fw_dl including 8051 ready polling
+	u8 last_path;
+};
+
 typedef struct hal_com_data
 {
 	HAL_VERSION			VersionID;
@@ -223,6 +245,7 @@ typedef struct hal_com_data
 	u8	fw_ractrl;
 	u8	FwRsvdPageStartOffset; /* 2010.06.23. Added by tynli. Reserve page start offset except beacon in TxQ.*/
 	u8	LastHMEBoxNum;	/* H2C - for host message to fw */
+	struct fwdl_stats fwdl_stats;
 
 	/****** current WIFI_PHY values ******/
 	WIRELESS_MODE	CurrentWirelessMode;
@@ -527,6 +550,8 @@ typedef struct hal_com_data
 	u32			IntArray[3];//HISR0,HISR1,HSISR
 	u32			IntrMask[3];
 	u8			C2hArray[16];
+
+	struct txdesc_tmpl_ctl_8723b *txdesc_tmpl;
 	#ifdef CONFIG_USB_TX_AGGREGATION
 	u8			UsbTxAggMode;
 	u8			UsbTxAggDescNum;
@@ -232,6 +232,9 @@ struct hal_ops {
 	/*** xmit section ***/
 	s32	(*init_xmit_priv)(_adapter *padapter);
 	void	(*free_xmit_priv)(_adapter *padapter);
+	void	(*dump_txdesc_tmpl)(void *sel, _adapter *padapter);
+	void	(*txdesc_tmpl_set)(_adapter *padapter, u8 en, u8 verify);
+	void	(*txdesc_tmpl_bench)(_adapter *padapter, u32 cnt);
 	s32	(*hal_xmit)(_adapter *padapter, struct xmit_frame *pxmitframe);
 	/*
 	 * mgnt_xmit should be implemented to run in interrupt context
@@ -552,6 +555,9 @@ s32	rtw_hal_mgnt_xmit(_adapter *padapter, struct xmit_frame *pmgntframe);
 
 s32	rtw_hal_init_xmit_priv(_adapter *padapter);
 void	rtw_hal_free_xmit_priv(_adapter *padapter);
+void	rtw_hal_dump_txdesc_tmpl(void *sel, _adapter *padapter);
+void	rtw_hal_txdesc_tmpl_set(_adapter *padapter, u8 en, u8 verify);
+void	rtw_hal_txdesc_tmpl_bench(_adapter *padapter, u32 cnt);
 
 s32	rtw_hal_init_recv_priv(_adapter *padapter);
 void	rtw_hal_free_recv_priv(_adapter *padapter);
@@ -7845,6 +7845,24 @@ static int rtw_dbg_port(struct net_device *dev,
 					}
 					break;
 #endif //DBG_CMD_QUEUE
+				case 0x29://tx desc template, arg 0: dump, 1: set en(bit0)/verify(bit1) by extra_arg, 2: bench extra_arg frames
+					{
+						if (arg == 0)
+							rtw_hal_dump_txdesc_tmpl(RTW_DBGDUMP, padapter);
+						else if (arg == 1)
+							rtw_hal_txdesc_tmpl_set(padapter, extra_arg & BIT0 ? 1 : 0, extra_arg & BIT1 ? 1 : 0);
+						else if (arg == 2)
+							rtw_hal_txdesc_tmpl_bench(padapter, extra_arg);
+					}
+					break;
+				case 0x2a://fw download, arg 0: dump time of sync/async path, 1: path of next download by extra_arg(0:sync, 1:async)
+					{
+						if (arg == 0)
+							rtw_dump_fwdl_stats(RTW_DBGDUMP, padapter);
+						else if (arg == 1)
+							padapter->registrypriv.fwdl_async = extra_arg ? 1 : 0;
+					}
+					break;
 				case 0xaa:
 					{
 						if((extra_arg & 0x7F)> 0x3F) extra_arg = 0xFF;
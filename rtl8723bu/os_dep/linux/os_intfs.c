@@ -306,6 +306,10 @@ module_param(rtw_fw_iol, int, 0644);
 MODULE_PARM_DESC(rtw_fw_iol, "FW IOL. 0:Disable, 1:enable, 2:by usb speed");
 #endif //CONFIG_IOL
 
+static int rtw_fwdl_async = 1;
+module_param(rtw_fwdl_async, int, 0644);
+MODULE_PARM_DESC(rtw_fwdl_async, "USB fw download vendor req. 0:one by one, 1:pipelined");
+
 #ifdef CONFIG_TX_MCAST2UNI
 module_param(rtw_mc2u_disable, int, 0644);
 #endif	// CONFIG_TX_MCAST2UNI
@@ -569,6 +573,8 @@ _func_enter_;
 	registry_par->fw_iol = rtw_fw_iol;
 #endif
 
+	registry_par->fwdl_async = (u8)rtw_fwdl_async;
+
 #ifdef CONFIG_80211D
 	registry_par->enable80211d = (u8)rtw_80211d;
 #endif
@@ -3898,6 +3898,7 @@ int proc_get_ps_info(struct seq_file *m, void *v)
 	struct net_device *dev = m->private;
 	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
 	struct pwrctrl_priv *pwrpriv = adapter_to_pwrctl(padapter);
+	struct pwrseq_stats *pwrseq_stats = &GET_HAL_DATA(padapter)->pwrseq_stats;
 	u8 ips_mode = pwrpriv->ips_mode;
 	u8 lps_mode = pwrpriv->power_mgnt;
 	u8 lps_level = pwrpriv->lps_level;
@@ -3922,6 +3923,12 @@ int proc_get_ps_info(struct seq_file *m, void *v)
 	RTW_PRINT_SEL(m, " IPS mode: %s\n", str);
 	RTW_PRINT_SEL(m, " IPS enter count:%d, IPS leave count:%d\n",
 		      pwrpriv->ips_enter_cnts, pwrpriv->ips_leave_cnts);
+	RTW_PRINT_SEL(m, " IPS leave time last:%u ms, max:%u ms, avg:%u ms\n",
+		      pwrpriv->ips_leave_last_ms, pwrpriv->ips_leave_max_ms,
+		      pwrpriv->ips_leave_cnts ? pwrpriv->ips_leave_total_ms / pwrpriv->ips_leave_cnts : 0);
+	RTW_PRINT_SEL(m, " pwrseq run:%u compile:%u io:%u (op-by-op:%u)\n",
+		      pwrseq_stats->run_cnt, pwrseq_stats->compile_cnt,
+		      pwrseq_stats->io_cnt, pwrseq_stats->legacy_io_cnt);
 	RTW_PRINT_SEL(m, "------------------------------\n");
 	RTW_PRINT_SEL(m, "*LPS:\n");
 
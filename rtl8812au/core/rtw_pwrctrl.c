@@ -115,6 +115,7 @@ int _ips_leave(_adapter *padapter)
 {
 	struct pwrctrl_priv *pwrpriv = adapter_to_pwrctl(padapter);
 	int result = _SUCCESS;
+	u32 start;
 
 	if ((pwrpriv->rf_pwrstate == rf_off) && (!pwrpriv->bips_processing)) {
 		pwrpriv->bips_processing = _TRUE;
@@ -122,7 +123,12 @@ int _ips_leave(_adapter *padapter)
 		pwrpriv->ips_leave_cnts++;
 		RTW_INFO("==>ips_leave cnts:%d\n", pwrpriv->ips_leave_cnts);
 
+		start = rtw_get_current_time();
 		result = rtw_ips_pwr_up(padapter);
+		pwrpriv->ips_leave_last_ms = rtw_get_passing_time_ms(start);
+		pwrpriv->ips_leave_total_ms += pwrpriv->ips_leave_last_ms;
+		if (pwrpriv->ips_leave_last_ms > pwrpriv->ips_leave_max_ms)
+			pwrpriv->ips_leave_max_ms = pwrpriv->ips_leave_last_ms;
 		if (result == _SUCCESS)
 			pwrpriv->rf_pwrstate = rf_on;
 		RTW_PRINT("nolinked power save leave\n");
@@ -1969,6 +1975,9 @@ void rtw_init_pwrctrl_priv(PADAPTER padapter)
 	pwrctrlpriv->rf_pwrstate = rf_on;
 	pwrctrlpriv->ips_enter_cnts = 0;
 	pwrctrlpriv->ips_leave_cnts = 0;
+	pwrctrlpriv->ips_leave_last_ms = 0;
+	pwrctrlpriv->ips_leave_max_ms = 0;
+	pwrctrlpriv->ips_leave_total_ms = 0;
 	pwrctrlpriv->lps_enter_cnts = 0;
 	pwrctrlpriv->lps_leave_cnts = 0;
 	pwrctrlpriv->bips_processing = _FALSE;
@@ -34,11 +34,215 @@ Major Change History:
 
 --*/
 #include <HalPwrSeqCmd.h>
+#include <hal_data.h>
 
+#define PWRSEQ_CMD_MATCH(_cfg, _cut, _fab, _intf) \
+	((GET_PWR_CFG_FAB_MASK(_cfg) & (_fab)) && \
+	 (GET_PWR_CFG_CUT_MASK(_cfg) & (_cut)) && \
+	 (GET_PWR_CFG_INTF_MASK(_cfg) & (_intf)))
+
+static void pwrseq_op_from_cfg(struct pwrseq_op *op, WLAN_PWR_CFG *cfg)
+{
+	op->offset = GET_PWR_CFG_OFFSET(*cfg);
+	op->cmd = GET_PWR_CFG_CMD(*cfg);
+	op->base = GET_PWR_CFG_BASE(*cfg);
+	op->msk = GET_PWR_CFG_MASK(*cfg);
+	op->len = 1;
+	op->value[0] = GET_PWR_CFG_VALUE(*cfg);
+}
+
+/*
+ * Filter table by cut, fab and interface, and merge runs of full byte
+ * writes to consecutive MAC registers into one multi-byte write.
+ * Compiled script is kept in HAL data and reused on later calls, a table
+ * too long for the script is remembered as such and not compiled again.
+ */
+static struct pwrseq_script *pwrseq_compile(PADAPTER padapter,
+	u8 CutVersion, u8 FabVersion, u8 InterfaceType, WLAN_PWR_CFG PwrSeqCmd[])
+{
+	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(padapter);
+	struct pwrseq_script *script;
+	struct pwrseq_op *op = NULL;
+	WLAN_PWR_CFG *cfg;
+	u32 AryIdx;
+	u8 i;
+
+	for (i = 0; i < hal_data->pwrseq_script_num; i++) {
+		script = &hal_data->pwrseq_script[i];
+		if (script->table == PwrSeqCmd && script->cut == CutVersion
+			&& script->fab == FabVersion && script->intf == InterfaceType)
+			return script->oversize ? NULL : script;
+	}
+
+	if (hal_data->pwrseq_script_num >= PWRSEQ_SCRIPT_NUM)
+		return NULL;
+
+	script = &hal_data->pwrseq_script[hal_data->pwrseq_script_num];
+	script->table = PwrSeqCmd;
+	script->cut = CutVersion;
+	script->fab = FabVersion;
+	script->intf = InterfaceType;
+	script->oversize = _FALSE;
+	script->op_num = 0;
+
+	for (AryIdx = 0; ; AryIdx++) {
+		cfg = &PwrSeqCmd[AryIdx];
+
+		if (!PWRSEQ_CMD_MATCH(*cfg, CutVersion, FabVersion, InterfaceType))
+			continue;
+
+		if (GET_PWR_CFG_CMD(*cfg) == PWR_CMD_END)
+			break;
+
+		if (GET_PWR_CFG_CMD(*cfg) == PWR_CMD_WRITE) {
+			if (op && op->cmd == PWR_CMD_WRITE
+				&& op->base == PWR_BASEADDR_MAC && op->msk == 0xFF
+				&& GET_PWR_CFG_BASE(*cfg) == PWR_BASEADDR_MAC && GET_PWR_CFG_MASK(*cfg) == 0xFF
+				&& op->len < PWRSEQ_MERGE_MAX
+				&& GET_PWR_CFG_OFFSET(*cfg) == op->offset + op->len) {
+				op->value[op->len++] = GET_PWR_CFG_VALUE(*cfg);
+				continue;
+			}
+		} else if (GET_PWR_CFG_CMD(*cfg) != PWR_CMD_POLLING
+			&& GET_PWR_CFG_CMD(*cfg) != PWR_CMD_DELAY)
+			continue;
+
+		if (script->op_num >= PWRSEQ_SCRIPT_OP_NUM) {
+			RTW_WARN("%s: table %p exceeds %u ops, parse op by op\n"
+				, __func__, PwrSeqCmd, PWRSEQ_SCRIPT_OP_NUM);
+			script->oversize = _TRUE;
+			script->op_num = 0;
+			hal_data->pwrseq_script_num++;
+			return NULL;
+		}
+
+		op = &script->op[script->op_num++];
+		pwrseq_op_from_cfg(op, cfg);
+	}
+
+	hal_data->pwrseq_script_num++;
+	hal_data->pwrseq_stats.compile_cnt++;
+
+	return script;
+}
+
+static void pwrseq_write(PADAPTER padapter, struct pwrseq_op *op, struct pwrseq_stats *stats)
+{
+	u32 offset = op->offset;
+	u8 value;
+
+	stats->legacy_io_cnt += 2 * op->len;
+
+	if (op->len > 1) {
+		rtw_writeN(padapter, offset, op->len, op->value);
+		stats->io_cnt++;
+		return;
+	}
+
+#ifdef CONFIG_SDIO_HCI
+	/*  */
+	/* <Roger_Notes> We should deal with interface specific address mapping for some interfaces, e.g., SDIO interface */
+	/* 2011.07.07. */
+	/*  */
+	if (op->base == PWR_BASEADDR_SDIO) {
+		/* Read Back SDIO Local value */
+		value = SdioLocalCmd52Read1Byte(padapter, offset);
+
+		value &= ~(op->msk);
+		value |= (op->value[0] & op->msk);
+
+		/* Write Back SDIO Local value */
+		SdioLocalCmd52Write1Byte(padapter, offset, value);
+		stats->io_cnt += 2;
+		return;
+	}
+#endif
+
+#ifdef CONFIG_GSPI_HCI
+	if (op->base == PWR_BASEADDR_SDIO)
+		offset = SPI_LOCAL_OFFSET | offset;
+#endif
+
+	if (op->msk == 0xFF) {
+		/* whole byte is replaced, no need to read back */
+		value = op->value[0];
+	} else {
+		/* Read the value from system register */
+		value = rtw_read8(padapter, offset);
+		stats->io_cnt++;
+
+		value = value & (~(op->msk));
+		value = value | (op->value[0] & op->msk);
+	}
+
+	/* Write the value back to sytem register */
+	rtw_write8(padapter, offset, value);
+	stats->io_cnt++;
+}
+
+static u8 pwrseq_poll(PADAPTER padapter, struct pwrseq_op *op, struct pwrseq_stats *stats)
+{
+	u32 offset = op->offset;
+	u32 pollingCount = 0;
+	u32 maxPollingCnt = 5000;
+	u8 value;
+
+#ifdef CONFIG_GSPI_HCI
+	if (op->base == PWR_BASEADDR_SDIO)
+		offset = SPI_LOCAL_OFFSET | offset;
+#endif
+
+	do {
+#ifdef CONFIG_SDIO_HCI
+		if (op->base == PWR_BASEADDR_SDIO)
+			value = SdioLocalCmd52Read1Byte(padapter, offset);
+		else
+#endif
+			value = rtw_read8(padapter, offset);
+		stats->io_cnt++;
+		stats->legacy_io_cnt++;
+
+		value = value & op->msk;
+		if (value == (op->value[0] & op->msk))
+			return _TRUE;
+
+		rtw_udelay_os(10);
+	} while (pollingCount++ <= maxPollingCnt);
+
+	RTW_ERR("HalPwrSeqCmdParsing: Fail to polling Offset[%#x]=%02x\n", offset, value);
+
+	return _FALSE;
+}
+
+static u8 pwrseq_exec_op(PADAPTER padapter, struct pwrseq_op *op, struct pwrseq_stats *stats)
+{
+	switch (op->cmd) {
+	case PWR_CMD_WRITE:
+		pwrseq_write(padapter, op, stats);
+		break;
+
+	case PWR_CMD_POLLING:
+		return pwrseq_poll(padapter, op, stats);
+
+	case PWR_CMD_DELAY:
+		if (op->value[0] == PWRSEQ_DELAY_US)
+			rtw_udelay_os(op->offset);
+		else
+			rtw_udelay_os(op->offset * 1000);
+		break;
+
+	default:
+		break;
+	}
+
+	return _TRUE;
+}
 
 /*
  *	Description:
  *		This routine deal with the Power Configuration CMDs parsing for RTL8723/RTL8188E Series IC.
+ *		Table is compiled into a script on first use, and parsed op by op only
+ *		when it doesn't fit into the script cache.
  *
  *	Assumption:
  *		We should follow specific format which was released from HW SD.
@@ -52,110 +256,36 @@ u8 HalPwrSeqCmdParsing(
 	u8				InterfaceType,
 	WLAN_PWR_CFG	PwrSeqCmd[])
 {
-	WLAN_PWR_CFG	PwrCfgCmd = {0};
-	u8				bPollingBit = _FALSE;
-	u32				AryIdx = 0;
-	u8				value = 0;
-	u32				offset = 0;
-	u32				pollingCount = 0; /* polling autoload done. */
-	u32				maxPollingCnt = 5000;
+	struct pwrseq_stats *stats = &GET_HAL_DATA(padapter)->pwrseq_stats;
+	struct pwrseq_script *script;
+	struct pwrseq_op op;
+	u32 AryIdx;
+	u8 i;
 
-	do {
-		PwrCfgCmd = PwrSeqCmd[AryIdx];
+	stats->run_cnt++;
 
+	script = pwrseq_compile(padapter, CutVersion, FabVersion, InterfaceType, PwrSeqCmd);
+	if (script) {
+		for (i = 0; i < script->op_num; i++) {
+			if (pwrseq_exec_op(padapter, &script->op[i], stats) == _FALSE)
+				return _FALSE;
+		}
+		return _TRUE;
+	}
 
+	for (AryIdx = 0; ; AryIdx++) {
 		/* 2 Only Handle the command whose FAB, CUT, and Interface are matched */
-		if ((GET_PWR_CFG_FAB_MASK(PwrCfgCmd) & FabVersion) &&
-		    (GET_PWR_CFG_CUT_MASK(PwrCfgCmd) & CutVersion) &&
-		    (GET_PWR_CFG_INTF_MASK(PwrCfgCmd) & InterfaceType)) {
-			switch (GET_PWR_CFG_CMD(PwrCfgCmd)) {
-			case PWR_CMD_READ:
-				break;
-
-			case PWR_CMD_WRITE:
-				offset = GET_PWR_CFG_OFFSET(PwrCfgCmd);
-
-#ifdef CONFIG_SDIO_HCI
-				/*  */
-				/* <Roger_Notes> We should deal with interface specific address mapping for some interfaces, e.g., SDIO interface */
-				/* 2011.07.07. */
-				/*  */
-				if (GET_PWR_CFG_BASE(PwrCfgCmd) == PWR_BASEADDR_SDIO) {
-					/* Read Back SDIO Local value */
-					value = SdioLocalCmd52Read1Byte(padapter, offset);
-
-					value &= ~(GET_PWR_CFG_MASK(PwrCfgCmd));
-					value |= (GET_PWR_CFG_VALUE(PwrCfgCmd) & GET_PWR_CFG_MASK(PwrCfgCmd));
-
-					/* Write Back SDIO Local value */
-					SdioLocalCmd52Write1Byte(padapter, offset, value);
-				} else
-#endif
-				{
-#ifdef CONFIG_GSPI_HCI
-					if (GET_PWR_CFG_BASE(PwrCfgCmd) == PWR_BASEADDR_SDIO)
-						offset = SPI_LOCAL_OFFSET | offset;
-#endif
-					/* Read the value from system register */
-					value = rtw_read8(padapter, offset);
+		if (!PWRSEQ_CMD_MATCH(PwrSeqCmd[AryIdx], CutVersion, FabVersion, InterfaceType))
+			continue;
 
-					value = value & (~(GET_PWR_CFG_MASK(PwrCfgCmd)));
-					value = value | (GET_PWR_CFG_VALUE(PwrCfgCmd) & GET_PWR_CFG_MASK(PwrCfgCmd));
-
-					/* Write the value back to sytem register */
-					rtw_write8(padapter, offset, value);
-				}
-				break;
-
-			case PWR_CMD_POLLING:
-
-				bPollingBit = _FALSE;
-				offset = GET_PWR_CFG_OFFSET(PwrCfgCmd);
-#ifdef CONFIG_GSPI_HCI
-				if (GET_PWR_CFG_BASE(PwrCfgCmd) == PWR_BASEADDR_SDIO)
-					offset = SPI_LOCAL_OFFSET | offset;
-#endif
-				do {
-#ifdef CONFIG_SDIO_HCI
-					if (GET_PWR_CFG_BASE(PwrCfgCmd) == PWR_BASEADDR_SDIO)
-						value = SdioLocalCmd52Read1Byte(padapter, offset);
-					else
-#endif
-						value = rtw_read8(padapter, offset);
-
-					value = value & GET_PWR_CFG_MASK(PwrCfgCmd);
-					if (value == (GET_PWR_CFG_VALUE(PwrCfgCmd) & GET_PWR_CFG_MASK(PwrCfgCmd)))
-						bPollingBit = _TRUE;
-					else
-						rtw_udelay_os(10);
-
-					if (pollingCount++ > maxPollingCnt) {
-						RTW_ERR("HalPwrSeqCmdParsing: Fail to polling Offset[%#x]=%02x\n", offset, value);
-						return _FALSE;
-					}
-				} while (!bPollingBit);
-
-				break;
-
-			case PWR_CMD_DELAY:
-				if (GET_PWR_CFG_VALUE(PwrCfgCmd) == PWRSEQ_DELAY_US)
-					rtw_udelay_os(GET_PWR_CFG_OFFSET(PwrCfgCmd));
-				else
-					rtw_udelay_os(GET_PWR_CFG_OFFSET(PwrCfgCmd) * 1000);
-				break;
-
-			case PWR_CMD_END:
-				/* When this command is parsed, end the process */
-				return _TRUE;
-				break;
-
-			default:
-				break;
-			}
-		}
+		/* When this command is parsed, end the process */
+		if (GET_PWR_CFG_CMD(PwrSeqCmd[AryIdx]) == PWR_CMD_END)
+			break;
 
-		AryIdx++;/* Add Array Index */
-	} while (1);
+		pwrseq_op_from_cfg(&op, &PwrSeqCmd[AryIdx]);
+		if (pwrseq_exec_op(padapter, &op, stats) == _FALSE)
+			return _FALSE;
+	}
 
 	return _TRUE;
 }
@@ -435,6 +435,24 @@ void	rtw_hal_free_xmit_priv(_adapter *padapter)
 	padapter->hal_func.free_xmit_priv(padapter);
 }
 
+void rtw_hal_dump_txdesc_tmpl(void *sel, _adapter *padapter)
+{
+	if (padapter->hal_func.dump_txdesc_tmpl)
+		padapter->hal_func.dump_txdesc_tmpl(sel, padapter);
+}
+
+void rtw_hal_txdesc_tmpl_set(_adapter *padapter, u8 en, u8 verify)
+{
+	if (padapter->hal_func.txdesc_tmpl_set)
+		padapter->hal_func.txdesc_tmpl_set(padapter, en, verify);
+}
+
+void rtw_hal_txdesc_tmpl_bench(_adapter *padapter, u32 cnt)
+{
+	if (padapter->hal_func.txdesc_tmpl_bench)
+		padapter->hal_func.txdesc_tmpl_bench(padapter, cnt);
+}
+
 s32	rtw_hal_init_recv_priv(_adapter *padapter)
 {
 	return padapter->hal_func.init_recv_priv(padapter);
@@ -372,6 +372,66 @@ exit:
 	return ret;
 }
 
+#ifdef CONFIG_USB_HCI
+/* same block split as _BlockWrite_8812(), vendor req are pipelined */
+static int
+_BlockWrite_8812_async(
+	IN		struct usb_fwdl_async	*fwdl,
+	IN		u8			*buffer,
+	IN		u32			buffSize
+)
+{
+	u32	offset = 0, len;
+
+	while (offset < buffSize) {
+		len = buffSize - offset;
+		if (len >= MAX_REG_BOLCK_SIZE)
+			len = MAX_REG_BOLCK_SIZE;
+		else if (len >= 8)
+			len = 8;
+		else
+			len = 1;
+
+		if (usb_fwdl_async_write(fwdl, FW_START_ADDRESS + offset, len, buffer + offset) == _FAIL)
+			return _FAIL;
+		offset += len;
+	}
+
+	return _SUCCESS;
+}
+
+/* page select is queued behind blocks of previous page, ep0 keeps them in order */
+static int
+_WriteFW_8812_async(
+	IN		PADAPTER		padapter,
+	IN		struct usb_fwdl_async	*fwdl,
+	IN		void			*buffer,
+	IN		u32			size
+)
+{
+	u8	*bufferPtr = (u8 *)buffer;
+	u32	page, offset, len;
+	u8	value8, u8Page;
+
+	value8 = rtw_read8(padapter, REG_MCUFWDL + 2) & 0xF8;
+
+	for (page = 0, offset = 0; offset < size; page++, offset += len) {
+		len = size - offset;
+		if (len > MAX_DLFW_PAGE_SIZE)
+			len = MAX_DLFW_PAGE_SIZE;
+
+		u8Page = value8 | (u8)(page & 0x07);
+		if (usb_fwdl_async_write(fwdl, REG_MCUFWDL + 2, 1, &u8Page) == _FAIL)
+			return _FAIL;
+
+		if (_BlockWrite_8812_async(fwdl, bufferPtr + offset, len) == _FAIL)
+			return _FAIL;
+	}
+
+	return _SUCCESS;
+}
+#endif /* CONFIG_USB_HCI */
+
 void _8051Reset8812(PADAPTER padapter)
 {
 	u8 u1bTmp, u1bTmp2;
@@ -441,6 +501,29 @@ exit:
 	return ret;
 }
 
+#ifdef CONFIG_USB_HCI
+/*
+ * checksum polling is issued right after the last block is submitted,
+ * its first read completes behind the blocks still in flight
+ */
+static s32 _WriteFW_8812_pipelined(_adapter *adapter, void *buffer, u32 size)
+{
+	struct usb_fwdl_async fwdl;
+	s32 ret;
+
+	usb_fwdl_async_init(adapter_to_dvobj(adapter), &fwdl);
+
+	ret = _WriteFW_8812_async(adapter, &fwdl, buffer, size);
+	if (ret == _SUCCESS)
+		ret = polling_fwdl_chksum(adapter, 5, 50);
+
+	if (usb_fwdl_async_flush(&fwdl, RTW_USB_CONTROL_MSG_TIMEOUT) == _FAIL)
+		ret = _FAIL;
+
+	return ret;
+}
+#endif /* CONFIG_USB_HCI */
+
 static s32 _FWFreeToGo8812(_adapter *adapter, u32 min_cnt, u32 timeout_ms)
 {
 	s32 ret = _FAIL;
@@ -492,7 +575,8 @@ FirmwareDownload8812(
 {
 	s32	rtStatus = _SUCCESS;
 	u8	write_fw = 0;
-	u32 fwdl_start_time;
+	u32 fwdl_start_time, write_start_time;
+	u8 path = FWDL_PATH_SYNC;
 	PHAL_DATA_TYPE	pHalData = GET_HAL_DATA(Adapter);
 	struct pwrctrl_priv *pwrpriv = adapter_to_pwrctl(Adapter);
 	u8				*pFwImageFileName;
@@ -629,6 +713,11 @@ FirmwareDownload8812(
 		_8051Reset8812(Adapter);
 	}
 
+#ifdef CONFIG_USB_HCI
+	if (Adapter->registrypriv.fwdl_async)
+		path = FWDL_PATH_ASYNC;
+#endif
+
 	_FWDownloadEnable_8812(Adapter, _TRUE);
 	fwdl_start_time = rtw_get_current_time();
 	while (!RTW_CANNOT_IO(Adapter)
@@ -636,11 +725,25 @@ FirmwareDownload8812(
 		/* reset FWDL chksum */
 		rtw_write8(Adapter, REG_MCUFWDL, rtw_read8(Adapter, REG_MCUFWDL) | FWDL_ChkSum_rpt);
 
-		rtStatus = _WriteFW_8812(Adapter, pFirmwareBuf, FirmwareLen);
-		if (rtStatus != _SUCCESS)
+		write_start_time = rtw_get_current_time();
+#ifdef CONFIG_USB_HCI
+		if (path == FWDL_PATH_ASYNC) {
+			rtStatus = _WriteFW_8812_pipelined(Adapter, pFirmwareBuf, FirmwareLen);
+			rtw_hal_fwdl_stats_update(Adapter, path, rtStatus, rtw_get_passing_time_ms(write_start_time));
+			if (rtStatus == _SUCCESS)
+				break;
+
+			/* retry by vendor req one by one */
+			path = FWDL_PATH_SYNC;
+			pHalData->fwdl_stats.fallback_cnt++;
 			continue;
+		}
+#endif
 
-		rtStatus = polling_fwdl_chksum(Adapter, 5, 50);
+		rtStatus = _WriteFW_8812(Adapter, pFirmwareBuf, FirmwareLen);
+		if (rtStatus == _SUCCESS)
+			rtStatus = polling_fwdl_chksum(Adapter, 5, 50);
+		rtw_hal_fwdl_stats_update(Adapter, path, rtStatus, rtw_get_passing_time_ms(write_start_time));
 		if (rtStatus == _SUCCESS)
 			break;
 	}
@@ -653,10 +756,13 @@ FirmwareDownload8812(
 		goto fwdl_stat;
 
 fwdl_stat:
-	RTW_INFO("FWDL %s. write_fw:%u, %dms\n"
+	pHalData->fwdl_stats.last_path = path;
+	pHalData->fwdl_stats.last_total_ms = rtw_get_passing_time_ms(fwdl_start_time);
+	RTW_INFO("FWDL %s. path:%s write_fw:%u, %dms\n"
 		 , (rtStatus == _SUCCESS) ? "success" : "fail"
+		 , (path == FWDL_PATH_ASYNC) ? "async" : "sync"
 		 , write_fw
-		 , rtw_get_passing_time_ms(fwdl_start_time)
+		 , pHalData->fwdl_stats.last_total_ms
 		);
 
 exit:
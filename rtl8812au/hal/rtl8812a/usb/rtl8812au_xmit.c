@@ -37,42 +37,106 @@ s32	rtl8812au_init_xmit_priv(_adapter *padapter)
 	pHalData->bEarlyModeEnable = padapter->registrypriv.early_mode;
 #endif
 
+	if (is_primary_adapter(padapter)) {
+		pHalData->txdesc_tmpl = (struct txdesc_tmpl_ctl_8812 *)rtw_zvmalloc(sizeof(struct txdesc_tmpl_ctl_8812));
+		if (pHalData->txdesc_tmpl) {
+			_rtw_spinlock_init(&pHalData->txdesc_tmpl->lock);
+			pHalData->txdesc_tmpl->en = 1;
+		} else
+			RTW_WARN("%s alloc txdesc_tmpl fail, build tx desc per frame\n", __func__);
+	}
+
 	return _SUCCESS;
 }
 
 void	rtl8812au_free_xmit_priv(_adapter *padapter)
 {
+	HAL_DATA_TYPE	*pHalData = GET_HAL_DATA(padapter);
+
+	if (is_primary_adapter(padapter) && pHalData->txdesc_tmpl) {
+		_rtw_spinlock_free(&pHalData->txdesc_tmpl->lock);
+		rtw_vmfree((u8 *)pHalData->txdesc_tmpl, sizeof(struct txdesc_tmpl_ctl_8812));
+		pHalData->txdesc_tmpl = NULL;
+	}
 }
 
-static s32 update_txdesc(struct xmit_frame *pxmitframe, u8 *pmem, s32 sz , u8 bagg_pkt)
+/* tx desc max_agg_num (unit:2) of A-MPDU data frame, depends on frame size */
+static u8 txdesc_max_agg_num(_adapter *padapter, struct pkt_attrib *pattrib, s32 sz)
 {
-	int	pull = 0;
-	uint	qsel;
-	u8 data_rate, pwr_status, offset;
-	_adapter			*padapter = pxmitframe->padapter;
-	struct mlme_priv	*pmlmepriv = &padapter->mlmepriv;
-	struct pkt_attrib	*pattrib = &pxmitframe->attrib;
-	HAL_DATA_TYPE	*pHalData = GET_HAL_DATA(padapter);
-	u8	*ptxdesc =  pmem;
-	struct mlme_ext_priv	*pmlmeext = &padapter->mlmeextpriv;
-	struct mlme_ext_info	*pmlmeinfo = &(pmlmeext->mlmext_info);
-	sint	bmcst = IS_MCAST(pattrib->ra);
+	struct dvobj_priv	*pdvobjpriv = adapter_to_dvobj(padapter);
 	struct sta_info *psta = NULL;
 	u8 max_agg_num = 0;
 	u8 _max_ampdu_size = 0;
 	u8 ht_max_ampdu_size = 0;
 	u8 vht_max_ampdu_size = 0;
-	struct dvobj_priv	*pdvobjpriv = adapter_to_dvobj(padapter);
 
-#ifndef CONFIG_USE_USB_BUFFER_ALLOC_TX
-	if (padapter->registrypriv.mp_mode == 0) {
-		if ((PACKET_OFFSET_SZ != 0) && (!bagg_pkt) && (rtw_usb_bulk_size_boundary(padapter, TXDESC_SIZE + sz) == _FALSE)) {
-			ptxdesc = (pmem + PACKET_OFFSET_SZ);
-			/* RTW_INFO("==> non-agg-pkt,shift pointer...\n"); */
-			pull = 1;
-		}
+	if (padapter->driver_tx_max_agg_num != 0xFF) {
+		max_agg_num = padapter->driver_tx_max_agg_num; /* tx desc max_agg_num (unit:2)  */
+	} else {
+		psta = pattrib->psta;
+
+		ht_max_ampdu_size = psta->htpriv.ht_cap.ampdu_params_info & 0x3; /*get other side sta ht max rx ampdu size*/
+		/*RTW_INFO("%s, ht_max_ampdu_size=0x%02x\n", __func__, ht_max_ampdu_size);*/
+
+		vht_max_ampdu_size = psta->vhtpriv.ampdu_len;
+		/*RTW_INFO("%s, vht_max_ampdu_size=0x%02x\n", __func__, vht_max_ampdu_size);*/
+
+		if (vht_max_ampdu_size > ht_max_ampdu_size)
+			_max_ampdu_size = vht_max_ampdu_size;
+		else
+			_max_ampdu_size = ht_max_ampdu_size;
+
+		/* Calculate tx desc max_agg_num (unit:2)  */
+		if (_max_ampdu_size == MAX_AMPDU_FACTOR_1M)
+			max_agg_num = (1024 * 1024 / sz) / 2;
+		else if (_max_ampdu_size == MAX_AMPDU_FACTOR_512K)
+			max_agg_num = (512 * 1024 / sz) / 2;
+		else if (_max_ampdu_size == MAX_AMPDU_FACTOR_256K)
+			max_agg_num = (256 * 1024 / sz) / 2;
+		else if (_max_ampdu_size == MAX_AMPDU_FACTOR_128K)
+			max_agg_num = (128 * 1024 / sz) / 2;
+		else if (_max_ampdu_size == MAX_AMPDU_FACTOR_64K)
+			max_agg_num = (64 * 1024 / sz) / 2;
+		else if (_max_ampdu_size == MAX_AMPDU_FACTOR_32K)
+			max_agg_num = (32 * 1024 / sz)  / 2;
+		else if (_max_ampdu_size == MAX_AMPDU_FACTOR_16K)
+			max_agg_num = (16 * 1024 / sz)  / 2;
+		else if (_max_ampdu_size == MAX_AMPDU_FACTOR_8K)
+			max_agg_num = (8 * 1024 / sz) / 2;
+		/*RTW_INFO("%s, sz=%u , _max_ampdu_size=0x%02x\n", __func__, sz, _max_ampdu_size);*/
+		if (psta->max_agg_num_minimal_record == 0 || psta->max_agg_num_minimal_record > max_agg_num)
+			psta->max_agg_num_minimal_record = max_agg_num;
+		if (pdvobjpriv->traffic_stat.cur_tx_tp > 10 && pdvobjpriv->traffic_stat.cur_rx_tp > 10)
+			max_agg_num = psta->max_agg_num_minimal_record;
 	}
-#endif /* CONFIG_USE_USB_BUFFER_ALLOC_TX */
+	if (max_agg_num >= 0x1F)
+		max_agg_num = 0x1F;
+	/* RTW_INFO("%s, max_agg_num=0x%02x\n", __func__, max_agg_num); */
+
+	return max_agg_num;
+}
+
+static u8 txdesc_offset(u8 bagg_pkt)
+{
+	u8 offset = TXDESC_SIZE + OFFSET_SZ;
+
+#ifdef CONFIG_TX_EARLY_MODE
+	if (bagg_pkt) {
+		offset += EARLY_MODE_INFO_SIZE ;/* 0x28			 */
+	}
+#endif
+	return offset;
+}
+
+/* build whole tx desc from frame, mlme, sta and hal state, checksum excluded */
+static void fill_txdesc(struct xmit_frame *pxmitframe, u8 *ptxdesc, s32 sz, u8 bagg_pkt)
+{
+	_adapter			*padapter = pxmitframe->padapter;
+	struct pkt_attrib	*pattrib = &pxmitframe->attrib;
+	HAL_DATA_TYPE	*pHalData = GET_HAL_DATA(padapter);
+	struct mlme_ext_priv	*pmlmeext = &padapter->mlmeextpriv;
+	struct mlme_ext_info	*pmlmeinfo = &(pmlmeext->mlmext_info);
+	sint	bmcst = IS_MCAST(pattrib->ra);
 
 	_rtw_memset(ptxdesc, 0, TXDESC_SIZE);
 
@@ -84,28 +148,12 @@ static s32 update_txdesc(struct xmit_frame *pxmitframe, u8 *pmem, s32 sz , u8 ba
 	/* RTW_INFO("%s==> pkt_len=%d,bagg_pkt=%02x\n",__FUNCTION__,sz,bagg_pkt); */
 	SET_TX_DESC_PKT_SIZE_8812(ptxdesc, sz);
 
-	offset = TXDESC_SIZE + OFFSET_SZ;
-
-#ifdef CONFIG_TX_EARLY_MODE
-	if (bagg_pkt) {
-		offset += EARLY_MODE_INFO_SIZE ;/* 0x28			 */
-	}
-#endif
 	/* RTW_INFO("%s==>offset(0x%02x)\n",__FUNCTION__,offset); */
-	SET_TX_DESC_OFFSET_8812(ptxdesc, offset);
+	SET_TX_DESC_OFFSET_8812(ptxdesc, txdesc_offset(bagg_pkt));
 
 	if (bmcst)
 		SET_TX_DESC_BMC_8812(ptxdesc, 1);
 
-#ifndef CONFIG_USE_USB_BUFFER_ALLOC_TX
-	if (padapter->registrypriv.mp_mode == 0) {
-		if ((PACKET_OFFSET_SZ != 0) && (!bagg_pkt)) {
-			if ((pull) && (pxmitframe->pkt_offset > 0))
-				pxmitframe->pkt_offset = pxmitframe->pkt_offset - 1;
-		}
-	}
-#endif
-
 	/* RTW_INFO("%s, pkt_offset=0x%02x\n",__FUNCTION__,pxmitframe->pkt_offset); */
 	/* pkt_offset, unit:8 bytes padding */
 	if (pxmitframe->pkt_offset > 0)
@@ -154,49 +202,7 @@ static s32 update_txdesc(struct xmit_frame *pxmitframe, u8 *pmem, s32 sz , u8 ba
 
 			if (pattrib->ampdu_en == _TRUE) {
 				SET_TX_DESC_AGG_ENABLE_8812(ptxdesc, 1);
-				if (padapter->driver_tx_max_agg_num != 0xFF) {
-					max_agg_num = padapter->driver_tx_max_agg_num; /* tx desc max_agg_num (unit:2)  */
-				} else {
-					psta = pattrib->psta;
-
-					ht_max_ampdu_size = psta->htpriv.ht_cap.ampdu_params_info & 0x3; /*get other side sta ht max rx ampdu size*/
-					/*RTW_INFO("%s, ht_max_ampdu_size=0x%02x\n", __func__, ht_max_ampdu_size);*/
-
-					vht_max_ampdu_size = psta->vhtpriv.ampdu_len;
-					/*RTW_INFO("%s, vht_max_ampdu_size=0x%02x\n", __func__, vht_max_ampdu_size);*/
-
-					if (vht_max_ampdu_size > ht_max_ampdu_size)
-						_max_ampdu_size = vht_max_ampdu_size;
-					else
-						_max_ampdu_size = ht_max_ampdu_size;
-
-					/* Calculate tx desc max_agg_num (unit:2)  */
-					if (_max_ampdu_size == MAX_AMPDU_FACTOR_1M)
-						max_agg_num = (1024 * 1024 / sz) / 2;
-					else if (_max_ampdu_size == MAX_AMPDU_FACTOR_512K)
-						max_agg_num = (512 * 1024 / sz) / 2;
-					else if (_max_ampdu_size == MAX_AMPDU_FACTOR_256K)
-						max_agg_num = (256 * 1024 / sz) / 2;
-					else if (_max_ampdu_size == MAX_AMPDU_FACTOR_128K)
-						max_agg_num = (128 * 1024 / sz) / 2;
-					else if (_max_ampdu_size == MAX_AMPDU_FACTOR_64K)
-						max_agg_num = (64 * 1024 / sz) / 2;
-					else if (_max_ampdu_size == MAX_AMPDU_FACTOR_32K)
-						max_agg_num = (32 * 1024 / sz)  / 2;
-					else if (_max_ampdu_size == MAX_AMPDU_FACTOR_16K)
-						max_agg_num = (16 * 1024 / sz)  / 2;
-					else if (_max_ampdu_size == MAX_AMPDU_FACTOR_8K)
-						max_agg_num = (8 * 1024 / sz) / 2;
-					/*RTW_INFO("%s, sz=%u , _max_ampdu_size=0x%02x\n", __func__, sz, _max_ampdu_size);*/
-					if (psta->max_agg_num_minimal_record == 0 || psta->max_agg_num_minimal_record > max_agg_num)
-						psta->max_agg_num_minimal_record = max_agg_num;
-					if (pdvobjpriv->traffic_stat.cur_tx_tp > 10 && pdvobjpriv->traffic_stat.cur_rx_tp > 10)
-						max_agg_num = psta->max_agg_num_minimal_record;
-				}
-				if (max_agg_num >= 0x1F)
-					max_agg_num = 0x1F;
-				/* RTW_INFO("%s, max_agg_num=0x%02x\n", __func__, max_agg_num); */
-				SET_TX_DESC_MAX_AGG_NUM_8812(ptxdesc, max_agg_num);
+				SET_TX_DESC_MAX_AGG_NUM_8812(ptxdesc, txdesc_max_agg_num(padapter, pattrib, sz));
 				/* Set A-MPDU aggregation. */
 				SET_TX_DESC_AMPDU_DENSITY_8812(ptxdesc, pattrib->ampdu_spacing);
 			} else
@@ -329,11 +335,401 @@ static s32 update_txdesc(struct xmit_frame *pxmitframe, u8 *pmem, s32 sz , u8 ba
 	SET_TX_DESC_GID_8812(ptxdesc, pattrib->txbf_g_id);
 	SET_TX_DESC_PAID_8812(ptxdesc, pattrib->txbf_p_aid);
 #endif
+}
+
+/*
+ * unicast data frame to associated sta could use tx desc template
+ * others are built by fill_txdesc() each time
+ */
+static u8 txdesc_tmpl_applicable(struct xmit_frame *pxmitframe)
+{
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+
+	if ((pxmitframe->frame_tag & 0x0f) != DATA_FRAMETAG)
+		return _FALSE;
+	if (IS_MCAST(pattrib->ra) || !pattrib->psta)
+		return _FALSE;
+	if (pattrib->mac_id >= MACID_NUM_SW_LIMIT || pattrib->priority >= TXDESC_TMPL_TID_NUM)
+		return _FALSE;
+	if ((pattrib->ether_type == 0x888e) ||
+	    (pattrib->ether_type == 0x0806) ||
+	    (pattrib->ether_type == 0x88b4) ||
+	    (pattrib->dhcp_pkt == 1))
+		return _FALSE;
+#ifdef CONFIG_AUTO_AP_MODE
+	if (pattrib->pctrl == _TRUE)
+		return _FALSE;
+#endif
+#ifdef CONFIG_XMIT_ACK
+	if (pxmitframe->ack_report)
+		return _FALSE;
+#endif
+
+	return _TRUE;
+}
+
+static void txdesc_tmpl_key_fill(_adapter *padapter, struct pkt_attrib *pattrib, struct txdesc_tmpl_key_8812 *key)
+{
+	HAL_DATA_TYPE *pHalData = GET_HAL_DATA(padapter);
+
+	_rtw_memset(key, 0, sizeof(*key));
+#ifdef CONFIG_BEAMFORMING
+	key->txbf_p_aid = pattrib->txbf_p_aid;
+	key->txbf_g_id = pattrib->txbf_g_id;
+#endif
+	key->raid = pattrib->raid;
+	key->qsel = pattrib->qsel;
+	key->qos_en = pattrib->qos_en;
+	key->encrypt = pattrib->encrypt;
+	key->bswenc = pattrib->bswenc;
+	key->vcs_mode = pattrib->vcs_mode;
+	key->ampdu_en = pattrib->ampdu_en;
+	key->ampdu_spacing = pattrib->ampdu_spacing;
+	key->ht_en = pattrib->ht_en;
+	key->bwmode = pattrib->bwmode;
+	key->ldpc = pattrib->ldpc;
+	key->stbc = pattrib->stbc;
+	key->fw_ractrl = pHalData->fw_ractrl;
+	key->ini_rate = pHalData->INIDATA_RATE[pattrib->mac_id];
+	key->fix_rate = padapter->fix_rate;
+	key->data_fb = padapter->data_fb;
+	key->preamble_mode = padapter->mlmeextpriv.mlmext_info.preamble_mode;
+	key->cur_bw = pHalData->current_channel_bw;
+	key->sc40 = pHalData->nCur40MhzPrimeSC;
+	key->sc80 = pHalData->nCur80MhzPrimeSC;
+}
+
+/* XOR of the two halfwords of dword, as rtl8812a_cal_txdesc_chksum() does */
+#define txdesc_dw_chksum(desc, dw) \
+	(le16_to_cpu(*((u16 *)(desc) + (dw) * 2)) ^ le16_to_cpu(*((u16 *)(desc) + (dw) * 2 + 1)))
+
+static void txdesc_tmpl_save(struct txdesc_tmpl_8812 *tmpl, struct txdesc_tmpl_key_8812 *key, u8 *ptxdesc)
+{
+	u8 *desc = tmpl->desc;
+	u16 chksum = 0;
+	int i;
+
+	_rtw_memcpy(desc, ptxdesc, TXDESC_SIZE);
+
+	SET_TX_DESC_PKT_SIZE_8812(desc, 0);
+	SET_TX_DESC_OFFSET_8812(desc, 0);
+	SET_TX_DESC_PKT_OFFSET_8812(desc, 0);
+	SET_TX_DESC_MAX_AGG_NUM_8812(desc, 0);
+	SET_TX_DESC_USB_TXAGG_NUM_8812(desc, 0);
+	SET_TX_DESC_TX_DESC_CHECKSUM_8812(desc, 0);
+	SET_TX_DESC_SEQ_8812(desc, 0);
+
+	for (i = 0; i < 8; i++)
+		chksum ^= txdesc_dw_chksum(desc, i);
+
+	tmpl->chksum = chksum;
+	_rtw_memcpy(&tmpl->key, key, sizeof(*key));
+	tmpl->valid = 1;
+}
+
+/* copy template then patch per frame fields, checksum updated by the patched dwords only */
+static void fill_txdesc_by_tmpl(struct xmit_frame *pxmitframe, struct txdesc_tmpl_8812 *tmpl, u8 *ptxdesc, s32 sz, u8 bagg_pkt)
+{
+	_adapter *padapter = pxmitframe->padapter;
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+	u16 chksum;
+
+	_rtw_memcpy(ptxdesc, tmpl->desc, TXDESC_SIZE);
+
+	SET_TX_DESC_PKT_SIZE_8812(ptxdesc, sz);
+	SET_TX_DESC_OFFSET_8812(ptxdesc, txdesc_offset(bagg_pkt));
+	if (pxmitframe->pkt_offset > 0)
+		SET_TX_DESC_PKT_OFFSET_8812(ptxdesc, pxmitframe->pkt_offset);
+	if (pattrib->ampdu_en == _TRUE)
+		SET_TX_DESC_MAX_AGG_NUM_8812(ptxdesc, txdesc_max_agg_num(padapter, pattrib, sz));
+#ifdef CONFIG_USB_TX_AGGREGATION
+	if (pxmitframe->agg_num > 1)
+		SET_TX_DESC_USB_TXAGG_NUM_8812(ptxdesc, pxmitframe->agg_num);
+#endif
+	if (pattrib->qos_en)
+		SET_TX_DESC_SEQ_8812(ptxdesc, pattrib->seqnum);
+
+#ifdef CONFIG_ANTENNA_DIVERSITY
+	/* tx antenna may change frame by frame */
+	odm_set_tx_ant_by_tx_info(&GET_HAL_DATA(padapter)->odmpriv, ptxdesc, pattrib->mac_id);
 	rtl8812a_cal_txdesc_chksum(ptxdesc);
+#else
+	/* per frame fields are in dword 0, 1, 3, 7(upper half), seq is not covered by checksum */
+	chksum = tmpl->chksum;
+	chksum ^= txdesc_dw_chksum(ptxdesc, 0) ^ txdesc_dw_chksum(tmpl->desc, 0);
+	chksum ^= txdesc_dw_chksum(ptxdesc, 1) ^ txdesc_dw_chksum(tmpl->desc, 1);
+	chksum ^= txdesc_dw_chksum(ptxdesc, 3) ^ txdesc_dw_chksum(tmpl->desc, 3);
+	chksum ^= txdesc_dw_chksum(ptxdesc, 7) ^ txdesc_dw_chksum(tmpl->desc, 7);
+	SET_TX_DESC_TX_DESC_CHECKSUM_8812(ptxdesc, chksum);
+#endif
+}
+
+/* return _TRUE if desc is filled from template */
+static u8 txdesc_tmpl_fill(struct txdesc_tmpl_ctl_8812 *ctl, struct xmit_frame *pxmitframe, u8 *ptxdesc, s32 sz, u8 bagg_pkt)
+{
+	_adapter *padapter = pxmitframe->padapter;
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+	struct txdesc_tmpl_8812 *tmpl;
+	struct txdesc_tmpl_8812 snap;
+	struct txdesc_tmpl_key_8812 key;
+	u8 legacy[TXDESC_SIZE];
+	_irqL irqL;
+	u8 hit;
+
+	if (!ctl || !ctl->en)
+		return _FALSE;
+
+	if (!txdesc_tmpl_applicable(pxmitframe)) {
+		_enter_critical_bh(&ctl->lock, &irqL);
+		ctl->bypass_cnt++;
+		_exit_critical_bh(&ctl->lock, &irqL);
+		return _FALSE;
+	}
+
+	txdesc_tmpl_key_fill(padapter, pattrib, &key);
+	tmpl = &ctl->tmpl[pattrib->mac_id][pattrib->priority];
+
+	/* take a consistent copy of the slot, desc is patched outside the lock */
+	_enter_critical_bh(&ctl->lock, &irqL);
+	hit = tmpl->valid && _rtw_memcmp(&tmpl->key, &key, sizeof(key)) == _TRUE;
+	if (hit) {
+		_rtw_memcpy(&snap, tmpl, sizeof(snap));
+		ctl->hit_cnt++;
+	}
+	_exit_critical_bh(&ctl->lock, &irqL);
+
+	if (!hit) {
+		/* rate adaptive, key or BA session changed, rebuild in frame's own buffer then publish */
+		fill_txdesc(pxmitframe, ptxdesc, sz, bagg_pkt);
+		rtl8812a_cal_txdesc_chksum(ptxdesc);
+		_enter_critical_bh(&ctl->lock, &irqL);
+		txdesc_tmpl_save(tmpl, &key, ptxdesc);
+		ctl->build_cnt++;
+		_exit_critical_bh(&ctl->lock, &irqL);
+		return _TRUE;
+	}
+
+	fill_txdesc_by_tmpl(pxmitframe, &snap, ptxdesc, sz, bagg_pkt);
+
+	if (ctl->verify) {
+		fill_txdesc(pxmitframe, legacy, sz, bagg_pkt);
+		rtl8812a_cal_txdesc_chksum(legacy);
+		if (_rtw_memcmp(legacy, ptxdesc, TXDESC_SIZE) == _FALSE) {
+			RTW_WARN("%s macid:%u tid:%u mismatch with legacy tx desc\n"
+				, __func__, pattrib->mac_id, pattrib->priority);
+			_rtw_memcpy(ptxdesc, legacy, TXDESC_SIZE);
+			_enter_critical_bh(&ctl->lock, &irqL);
+			tmpl->valid = 0;
+			ctl->mismatch_cnt++;
+			_exit_critical_bh(&ctl->lock, &irqL);
+		}
+	}
+
+	return _TRUE;
+}
+
+static s32 update_txdesc(struct xmit_frame *pxmitframe, u8 *pmem, s32 sz , u8 bagg_pkt)
+{
+	int	pull = 0;
+	_adapter			*padapter = pxmitframe->padapter;
+	u8	*ptxdesc =  pmem;
+
+#ifndef CONFIG_USE_USB_BUFFER_ALLOC_TX
+	if (padapter->registrypriv.mp_mode == 0) {
+		if ((PACKET_OFFSET_SZ != 0) && (!bagg_pkt) && (rtw_usb_bulk_size_boundary(padapter, TXDESC_SIZE + sz) == _FALSE)) {
+			ptxdesc = (pmem + PACKET_OFFSET_SZ);
+			/* RTW_INFO("==> non-agg-pkt,shift pointer...\n"); */
+			pull = 1;
+		}
+	}
+
+	if (padapter->registrypriv.mp_mode == 0) {
+		if ((PACKET_OFFSET_SZ != 0) && (!bagg_pkt)) {
+			if ((pull) && (pxmitframe->pkt_offset > 0))
+				pxmitframe->pkt_offset = pxmitframe->pkt_offset - 1;
+		}
+	}
+#endif /* CONFIG_USE_USB_BUFFER_ALLOC_TX */
+
+	if (txdesc_tmpl_fill(GET_HAL_DATA(padapter)->txdesc_tmpl, pxmitframe, ptxdesc, sz, bagg_pkt) == _FALSE) {
+		fill_txdesc(pxmitframe, ptxdesc, sz, bagg_pkt);
+		rtl8812a_cal_txdesc_chksum(ptxdesc);
+	}
 	_dbg_dump_tx_info(padapter, pxmitframe->frame_tag, ptxdesc);
 	return pull;
 }
 
+void rtl8812au_dump_txdesc_tmpl(void *sel, _adapter *padapter)
+{
+	struct txdesc_tmpl_ctl_8812 *ctl = GET_HAL_DATA(padapter)->txdesc_tmpl;
+	struct txdesc_tmpl_8812 *tmpl;
+	u32 cnt[4], bench[4];
+	_irqL irqL;
+	int i, j;
+
+	if (!ctl)
+		return;
+
+	_enter_critical_bh(&ctl->lock, &irqL);
+	cnt[0] = ctl->hit_cnt;
+	cnt[1] = ctl->build_cnt;
+	cnt[2] = ctl->bypass_cnt;
+	cnt[3] = ctl->mismatch_cnt;
+	bench[0] = ctl->bench_cnt;
+	bench[1] = ctl->bench_legacy_ms;
+	bench[2] = ctl->bench_tmpl_ms;
+	bench[3] = ctl->bench_mismatch;
+	_exit_critical_bh(&ctl->lock, &irqL);
+
+	RTW_PRINT_SEL(sel, "en:%u verify:%u\n", ctl->en, ctl->verify);
+	RTW_PRINT_SEL(sel, "hit:%u build:%u bypass:%u mismatch:%u\n"
+		, cnt[0], cnt[1], cnt[2], cnt[3]);
+	if (bench[0]) {
+		RTW_PRINT_SEL(sel, "bench cnt:%u legacy:%ums tmpl:%ums mismatch:%u\n"
+			, bench[0], bench[1], bench[2], bench[3]);
+	}
+
+	RTW_PRINT_SEL(sel, "%-5s %-3s %-4s %-4s %-7s %-5s %-8s %-6s\n"
+		, "macid", "tid", "raid", "qsel", "encrypt", "ampdu", "ini_rate", "chksum");
+	for (i = 0; i < MACID_NUM_SW_LIMIT; i++) {
+		for (j = 0; j < TXDESC_TMPL_TID_NUM; j++) {
+			tmpl = &ctl->tmpl[i][j];
+			if (!tmpl->valid)
+				continue;
+			RTW_PRINT_SEL(sel, "%5d %3d %4u %4u %7u %5u     0x%02x 0x%04x\n"
+				, i, j, tmpl->key.raid, tmpl->key.qsel, tmpl->key.encrypt
+				, tmpl->key.ampdu_en, tmpl->key.ini_rate, tmpl->chksum);
+		}
+	}
+}
+
+void rtl8812au_txdesc_tmpl_set(_adapter *padapter, u8 en, u8 verify)
+{
+	struct txdesc_tmpl_ctl_8812 *ctl = GET_HAL_DATA(padapter)->txdesc_tmpl;
+	_irqL irqL;
+	int i, j;
+
+	if (!ctl)
+		return;
+
+	_enter_critical_bh(&ctl->lock, &irqL);
+	if (!en) {
+		for (i = 0; i < MACID_NUM_SW_LIMIT; i++)
+			for (j = 0; j < TXDESC_TMPL_TID_NUM; j++)
+				ctl->tmpl[i][j].valid = 0;
+	}
+	ctl->en = en;
+	ctl->verify = verify;
+	_exit_critical_bh(&ctl->lock, &irqL);
+}
+
+/*
+ * build tx desc of linked sta's BE data frames with varied size, seq, pkt offset
+ * by legacy way and by template, compare byte by byte
+ * template of scratch ctl is used, not to race with tx path
+ */
+void rtl8812au_txdesc_tmpl_bench(_adapter *padapter, u32 cnt)
+{
+	struct txdesc_tmpl_ctl_8812 *ctl = GET_HAL_DATA(padapter)->txdesc_tmpl;
+	struct txdesc_tmpl_ctl_8812 *scratch = NULL;
+	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
+	struct sta_info *psta = NULL;
+	struct xmit_frame *pxmitframe = NULL;
+	struct pkt_attrib *pattrib;
+	u8 legacy[TXDESC_SIZE];
+	u8 desc[TXDESC_SIZE];
+	systime start;
+	u32 legacy_ms, tmpl_ms, mismatch = 0;
+	_irqL irqL;
+	u32 i;
+
+	if (!ctl || !cnt)
+		return;
+	if (cnt > TXDESC_TMPL_BENCH_MAX)
+		cnt = TXDESC_TMPL_BENCH_MAX;
+
+	if (check_fwstate(pmlmepriv, WIFI_ASOC_STATE) == _TRUE)
+		psta = rtw_get_stainfo(&padapter->stapriv, get_bssid(pmlmepriv));
+	if (!psta) {
+		RTW_INFO(FUNC_ADPT_FMT" no linked sta\n", FUNC_ADPT_ARG(padapter));
+		return;
+	}
+
+	scratch = (struct txdesc_tmpl_ctl_8812 *)rtw_zvmalloc(sizeof(*scratch));
+	pxmitframe = (struct xmit_frame *)rtw_zmalloc(sizeof(*pxmitframe));
+	if (!scratch || !pxmitframe)
+		goto exit;
+	_rtw_spinlock_init(&scratch->lock);
+	scratch->en = 1;
+
+	pxmitframe->padapter = padapter;
+	pxmitframe->frame_tag = DATA_FRAMETAG;
+	pattrib = &pxmitframe->attrib;
+	pattrib->psta = psta;
+	pattrib->mac_id = psta->mac_id;
+	pattrib->raid = psta->raid;
+	pattrib->qos_en = psta->qos_option;
+	pattrib->priority = 0;
+	pattrib->qsel = pattrib->priority;
+	pattrib->ether_type = 0x0800;
+	pattrib->encrypt = (u8)padapter->securitypriv.dot11PrivacyAlgrthm;
+	pattrib->bwmode = padapter->mlmeextpriv.cur_bwmode;
+	pattrib->ldpc = psta->ldpc;
+	pattrib->stbc = psta->stbc;
+#ifdef CONFIG_80211N_HT
+	pattrib->ht_en = psta->htpriv.ht_option;
+	pattrib->ch_offset = psta->htpriv.ch_offset;
+	pattrib->ampdu_en = (psta->htpriv.agg_enable_bitmap & BIT(0)) ? _TRUE : _FALSE;
+	pattrib->ampdu_spacing = psta->htpriv.rx_ampdu_min_spacing;
+#endif
+	_rtw_memcpy(pattrib->ra, psta->hwaddr, ETH_ALEN);
+
+	start = rtw_get_current_time();
+	for (i = 0; i < cnt; i++) {
+		pattrib->seqnum = i & 0xfff;
+		pxmitframe->pkt_offset = i & 0x1;
+		fill_txdesc(pxmitframe, legacy, 64 + (i % 1400), _FALSE);
+		rtl8812a_cal_txdesc_chksum(legacy);
+	}
+	legacy_ms = rtw_get_passing_time_ms(start);
+
+	start = rtw_get_current_time();
+	for (i = 0; i < cnt; i++) {
+		pattrib->seqnum = i & 0xfff;
+		pxmitframe->pkt_offset = i & 0x1;
+		txdesc_tmpl_fill(scratch, pxmitframe, desc, 64 + (i % 1400), _FALSE);
+	}
+	tmpl_ms = rtw_get_passing_time_ms(start);
+
+	for (i = 0; i < cnt; i++) {
+		pattrib->seqnum = i & 0xfff;
+		pxmitframe->pkt_offset = i & 0x1;
+		fill_txdesc(pxmitframe, legacy, 64 + (i % 1400), _FALSE);
+		rtl8812a_cal_txdesc_chksum(legacy);
+		txdesc_tmpl_fill(scratch, pxmitframe, desc, 64 + (i % 1400), _FALSE);
+		if (_rtw_memcmp(legacy, desc, TXDESC_SIZE) == _FALSE)
+			mismatch++;
+	}
+
+	_enter_critical_bh(&ctl->lock, &irqL);
+	ctl->bench_cnt = cnt;
+	ctl->bench_legacy_ms = legacy_ms;
+	ctl->bench_tmpl_ms = tmpl_ms;
+	ctl->bench_mismatch = mismatch;
+	_exit_critical_bh(&ctl->lock, &irqL);
+
+	RTW_INFO(FUNC_ADPT_FMT" cnt:%u legacy:%ums tmpl:%ums mismatch:%u\n", FUNC_ADPT_ARG(padapter)
+		, cnt, legacy_ms, tmpl_ms, mismatch);
+
+exit:
+	if (pxmitframe)
+		rtw_mfree((u8 *)pxmitframe, sizeof(*pxmitframe));
+	if (scratch) {
+		_rtw_spinlock_free(&scratch->lock);
+		rtw_vmfree((u8 *)scratch, sizeof(*scratch));
+	}
+}
+
 
 #ifdef CONFIG_XMIT_THREAD_MODE
 /*
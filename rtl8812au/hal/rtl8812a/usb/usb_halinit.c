@@ -2557,6 +2557,9 @@ void rtl8812au_set_hal_ops(_adapter *padapter)
 
 	pHalFunc->init_xmit_priv = &rtl8812au_init_xmit_priv;
 	pHalFunc->free_xmit_priv = &rtl8812au_free_xmit_priv;
+	pHalFunc->dump_txdesc_tmpl = &rtl8812au_dump_txdesc_tmpl;
+	pHalFunc->txdesc_tmpl_set = &rtl8812au_txdesc_tmpl_set;
+	pHalFunc->txdesc_tmpl_bench = &rtl8812au_txdesc_tmpl_bench;
 
 	pHalFunc->init_recv_priv = &rtl8812au_init_recv_priv;
 	pHalFunc->free_recv_priv = &rtl8812au_free_recv_priv;
@@ -381,6 +381,8 @@ Hal_MappingOutPipe(
 );
 
 void rtw_dump_fw_info(void *sel, _adapter *adapter);
+void rtw_hal_fwdl_stats_update(_adapter *adapter, u8 path, s32 status, u32 ms);
+void rtw_dump_fwdl_stats(void *sel, _adapter *adapter);
 void rtw_restore_mac_addr(_adapter *adapter);/*set mac addr when hal_init for all iface*/
 void rtw_hal_dump_macaddr(void *sel, _adapter *adapter);
 
@@ -320,6 +320,62 @@ typedef struct hal_p2p_ps_para {
 	u32 noa_count_para;
 } HAL_P2P_PS_PARA, *PHAL_P2P_PS_PARA;
 
+/*
+ * Power sequence table filtered by cut/fab/interface and compiled once
+ * into ops, see HalPwrSeqCmdParsing()
+ */
+#define PWRSEQ_SCRIPT_NUM	8
+#define PWRSEQ_SCRIPT_OP_NUM	64
+#define PWRSEQ_MERGE_MAX	4
+
+struct pwrseq_op {
+	u16 offset;	/* delay time for PWR_CMD_DELAY */
+	u8 cmd;		/* PWR_CMD_WRITE/POLLING/DELAY */
+	u8 base;
+	u8 len;		/* bytes of value[], > 1 only for merged full byte writes */
+	u8 msk;
+	u8 value[PWRSEQ_MERGE_MAX];
+};
+
+struct pwrseq_script {
+	const void *table;
+	u8 cut;
+	u8 fab;
+	u8 intf;
+	u8 oversize;	/* too long for op[], always parsed op by op */
+	u8 op_num;
+	struct pwrseq_op op[PWRSEQ_SCRIPT_OP_NUM];
+};
+
+struct pwrseq_stats {
+	u32 run_cnt;
+	u32 compile_cnt;
+	u32 io_cnt;		/* register accesses issued */
+	u32 legacy_io_cnt;	/* accesses op-by-op parsing would issue */
+};
+
+enum fwdl_path {
+	FWDL_PATH_SYNC = 0,	/* vendor req one by one */
+	FWDL_PATH_ASYNC,	/* vendor req pipelined */
+	FWDL_PATH_NUM,
+};
+
+struct fwdl_path_stats {
+	u32 cnt;
+	u32 fail_cnt;
+	u32 last_ms;	/* write image + checksum polling */
+	u32 min_ms;
+	u32 max_ms;
+	u32 total_ms;
+};
+
+struct fwdl_stats {
+	struct fwdl_path_stats path[FWDL_PATH_NUM];
+	u32 fallback_cnt;	/* async path failed, retried by sync path */
+	u32 last_total_ms;	/* whole fw_dl including 8051 ready polling */
+	u8 last_path;
+};
+
 typedef struct hal_com_data {
 	HAL_VERSION			version_id;
 	RT_MULTI_FUNC		MultiFunc; /* For multi-function consideration. */
@@ -336,6 +392,7 @@ typedef struct hal_com_data {
 	u8	fw_ractrl;
 	u8	FwRsvdPageStartOffset; /* 2010.06.23. Added by tynli. Reserve page start offset except beacon in TxQ.*/
 	u8	LastHMEBoxNum;	/* H2C - for host message to fw */
+	struct fwdl_stats fwdl_stats;
 
 	/****** current WIFI_PHY values ******/
 	WIRELESS_MODE	CurrentWirelessMode;
@@ -686,6 +743,8 @@ typedef struct hal_com_data {
 	/* Interrupt relatd register information. */
 	u32			IntArray[3];/* HISR0,HISR1,HSISR */
 	u32			IntrMask[3];
+
+	struct txdesc_tmpl_ctl_8812 *txdesc_tmpl;
 #ifdef CONFIG_USB_TX_AGGREGATION
 	u8			UsbTxAggMode;
 	u8			UsbTxAggDescNum;
@@ -799,6 +858,10 @@ typedef struct hal_com_data {
 #endif /* CONFIG_BEAMFORMING */
 
 	u8 not_xmitframe_fw_dl; /*not use xmitframe to download fw*/
+
+	struct pwrseq_script pwrseq_script[PWRSEQ_SCRIPT_NUM];
+	u8 pwrseq_script_num;
+	struct pwrseq_stats pwrseq_stats;
 } HAL_DATA_COMMON, *PHAL_DATA_COMMON;
 
 
@@ -300,6 +300,10 @@ struct hal_ops {
 #ifdef CONFIG_XMIT_THREAD_MODE
 	s32(*xmit_thread_handler)(_adapter *padapter);
 #endif
+	/* optional, tx desc template of data frame */
+	void	(*dump_txdesc_tmpl)(void *sel, _adapter *padapter);
+	void	(*txdesc_tmpl_set)(_adapter *padapter, u8 en, u8 verify);
+	void	(*txdesc_tmpl_bench)(_adapter *padapter, u32 cnt);
 	void	(*run_thread)(_adapter *padapter);
 	void	(*cancel_thread)(_adapter *padapter);
 
@@ -657,6 +661,9 @@ s32	rtw_hal_mgnt_xmit(_adapter *padapter, struct xmit_frame *pmgntframe);
 
 s32	rtw_hal_init_xmit_priv(_adapter *padapter);
 void	rtw_hal_free_xmit_priv(_adapter *padapter);
+void rtw_hal_dump_txdesc_tmpl(void *sel, _adapter *padapter);
+void rtw_hal_txdesc_tmpl_set(_adapter *padapter, u8 en, u8 verify);
+void rtw_hal_txdesc_tmpl_bench(_adapter *padapter, u32 cnt);
 
 s32	rtw_hal_init_recv_priv(_adapter *padapter);
 void	rtw_hal_free_recv_priv(_adapter *padapter);
@@ -328,8 +328,65 @@ void fill_txdesc_force_bmc_camid(struct pkt_attrib *pattrib, u8 *ptxdesc);
 #endif
 
 #ifdef CONFIG_USB_HCI
+#define TXDESC_TMPL_TID_NUM	8
+#define TXDESC_TMPL_BENCH_MAX	100000
+
+/* update_txdesc() input the data frame tx desc depends on, except per frame fields */
+struct txdesc_tmpl_key_8812 {
+	u16 txbf_p_aid;
+	u16 txbf_g_id;
+	u8 raid;
+	u8 qsel;
+	u8 qos_en;
+	u8 encrypt;
+	u8 bswenc;
+	u8 vcs_mode;
+	u8 ampdu_en;
+	u8 ampdu_spacing;
+	u8 ht_en;
+	u8 bwmode;
+	u8 ldpc;
+	u8 stbc;
+	u8 fw_ractrl;
+	u8 ini_rate;
+	u8 fix_rate;
+	u8 data_fb;
+	u8 preamble_mode;
+	u8 cur_bw;
+	u8 sc40;
+	u8 sc80;
+};
+
+/* tx desc with pkt size, offset, pkt offset, max agg num, usb agg num, seq and checksum cleared */
+struct txdesc_tmpl_8812 {
+	struct txdesc_tmpl_key_8812 key;
+	u8 valid;
+	u16 chksum;	/* of desc */
+	u8 desc[TXDESC_SIZE];
+};
+
+struct txdesc_tmpl_ctl_8812 {
+	struct txdesc_tmpl_8812 tmpl[MACID_NUM_SW_LIMIT][TXDESC_TMPL_TID_NUM];
+	_lock lock;	/* tmpl[][], counters and bench results, xmit tasklet/thread and direct xmit race on them */
+	u8 en;
+	u8 verify;	/* compare with desc built by legacy way */
+
+	u32 hit_cnt;
+	u32 build_cnt;
+	u32 bypass_cnt;
+	u32 mismatch_cnt;
+
+	u32 bench_cnt;
+	u32 bench_legacy_ms;
+	u32 bench_tmpl_ms;
+	u32 bench_mismatch;
+};
+
 s32 rtl8812au_init_xmit_priv(PADAPTER padapter);
 void rtl8812au_free_xmit_priv(PADAPTER padapter);
+void rtl8812au_dump_txdesc_tmpl(void *sel, _adapter *padapter);
+void rtl8812au_txdesc_tmpl_set(_adapter *padapter, u8 en, u8 verify);
+void rtl8812au_txdesc_tmpl_bench(_adapter *padapter, u32 cnt);
 s32 rtl8812au_hal_xmit(PADAPTER padapter, struct xmit_frame *pxmitframe);
 s32 rtl8812au_mgnt_xmit(PADAPTER padapter, struct xmit_frame *pmgntframe);
 s32	 rtl8812au_hal_xmitframe_enqueue(_adapter *padapter, struct xmit_frame *pxmitframe);
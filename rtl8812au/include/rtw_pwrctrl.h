@@ -348,6 +348,9 @@ struct pwrctrl_priv {
 
 	uint	ips_enter_cnts;
 	uint	ips_leave_cnts;
+	u32	ips_leave_last_ms;
+	u32	ips_leave_max_ms;
+	u32	ips_leave_total_ms;
 	uint	lps_enter_cnts;
 	uint	lps_leave_cnts;
 
@@ -47,6 +47,7 @@
 #define usb_write_port_complete(purb, regs)	usb_write_port_complete(purb)
 #define usb_read_port_complete(purb, regs)	usb_read_port_complete(purb)
 #define usb_read_interrupt_complete(purb, regs)	usb_read_interrupt_complete(purb)
+#define usb_fwdl_async_complete(purb, regs)	usb_fwdl_async_complete(purb)
 #endif
 
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 12))
@@ -70,6 +71,22 @@ int usb_async_write16(struct intf_hdl *pintfhdl, u32 addr, u16 val);
 int usb_async_write32(struct intf_hdl *pintfhdl, u32 addr, u32 val);
 #endif /* CONFIG_USB_SUPPORT_ASYNC_VDN_REQ */
 
+#define USB_FWDL_ASYNC_INFLIGHT	8	/* fw download vendor req kept in flight on ep0 */
+
+/* pipelined fw download, vendor req on ep0 complete in submitted order */
+struct usb_fwdl_async {
+	struct dvobj_priv *dvobj;
+	struct usb_anchor anchor;
+	wait_queue_head_t wq;	/* submit window only, not for lifetime */
+	ATOMIC_T pending;
+	int status;	/* of first failed vendor req */
+	u32 submit_cnt;
+};
+
+void usb_fwdl_async_init(struct dvobj_priv *dvobj, struct usb_fwdl_async *fwdl);
+int usb_fwdl_async_write(struct usb_fwdl_async *fwdl, u32 addr, u16 len, u8 *pdata);
+int usb_fwdl_async_flush(struct usb_fwdl_async *fwdl, u32 timeout_ms);
+
 unsigned int ffaddr2pipehdl(struct dvobj_priv *pdvobj, u32 addr);
 
 void usb_read_mem(struct intf_hdl *pintfhdl, u32 addr, u32 cnt, u8 *rmem);
@@ -434,6 +434,10 @@ module_param(rtw_fw_iol, int, 0644);
 MODULE_PARM_DESC(rtw_fw_iol, "FW IOL. 0:Disable, 1:enable, 2:by usb speed");
 #endif /* CONFIG_IOL */
 
+static int rtw_fwdl_async = 1;
+module_param(rtw_fwdl_async, int, 0644);
+MODULE_PARM_DESC(rtw_fwdl_async, "USB fw download vendor req. 0:one by one, 1:pipelined");
+
 #ifdef CONFIG_FILE_FWIMG
 char *rtw_fw_file_path = "/system/etc/firmware/rtlwifi/FW_NIC.BIN";
 module_param(rtw_fw_file_path, charp, 0644);
@@ -925,6 +929,8 @@ uint loadparam(_adapter *padapter)
 	registry_par->fw_iol = rtw_fw_iol;
 #endif
 
+	registry_par->fwdl_async = (u8)rtw_fwdl_async;
+
 #ifdef CONFIG_80211D
 	registry_par->enable80211d = (u8)rtw_80211d;
 #endif
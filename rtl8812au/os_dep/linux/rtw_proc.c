@@ -401,6 +401,43 @@ static int proc_get_fw_info(struct seq_file *m, void *v)
 	rtw_dump_fw_info(m, adapter);
 	return 0;
 }
+static int proc_get_fwdl_async(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	RTW_PRINT_SEL(m, "fwdl_async:%u\n", adapter->registrypriv.fwdl_async);
+	rtw_dump_fwdl_stats(m, adapter);
+	return 0;
+}
+
+static ssize_t proc_set_fwdl_async(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32];
+	u8 fwdl_async;
+	int num;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		/* path used by next fw download, 0:sync, 1:async */
+		num = sscanf(tmp, "%hhu", &fwdl_async);
+		if (num == 1)
+			adapter->registrypriv.fwdl_async = fwdl_async ? 1 : 0;
+	}
+
+	return count;
+}
+
 static int proc_get_mac_reg_dump(struct seq_file *m, void *v)
 {
 	struct net_device *dev = m->private;
@@ -608,6 +645,49 @@ static int proc_get_rx_info_msg(struct seq_file *m, void *v)
 	rtw_hal_set_odm_var(padapter, HAL_ODM_RX_Dframe_INFO, m, _FALSE);
 	return 0;
 }
+static int proc_get_txdesc_tmpl(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	rtw_hal_dump_txdesc_tmpl(m, adapter);
+	return 0;
+}
+
+static ssize_t proc_set_txdesc_tmpl(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32] = {0};
+	char cmd[8] = {0};
+	u32 val1 = 0, val2 = 0;
+	int num;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		/* en <0|1> [verify], bench <cnt> */
+		num = sscanf(tmp, "%7s %u %u", cmd, &val1, &val2);
+		if (num < 2)
+			goto exit;
+
+		if (strcmp(cmd, "en") == 0)
+			rtw_hal_txdesc_tmpl_set(adapter, val1 ? 1 : 0, val2 ? 1 : 0);
+		else if (strcmp(cmd, "bench") == 0)
+			rtw_hal_txdesc_tmpl_bench(adapter, val1);
+	}
+
+exit:
+	return count;
+}
+
 static int proc_get_tx_info_msg(struct seq_file *m, void *v)
 {
 	_irqL irqL;
@@ -2385,6 +2465,7 @@ static const struct rtw_proc_hdl adapter_proc_hdls[] = {
 #endif /* CONFIG_SDIO_HCI */
 
 	RTW_PROC_HDL_SSEQ("fwdl_test_case", NULL, proc_set_fwdl_test_case),
+	RTW_PROC_HDL_SSEQ("fwdl_async", proc_get_fwdl_async, proc_set_fwdl_async),
 	RTW_PROC_HDL_SSEQ("del_rx_ampdu_test_case", NULL, proc_set_del_rx_ampdu_test_case),
 	RTW_PROC_HDL_SSEQ("wait_hiq_empty", NULL, proc_set_wait_hiq_empty),
 
@@ -2444,6 +2525,7 @@ static const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("trx_info_debug", proc_get_trx_info_debug, NULL),
 	RTW_PROC_HDL_SSEQ("linked_info_dump", proc_get_linked_info_dump, proc_set_linked_info_dump),
 	RTW_PROC_HDL_SSEQ("tx_info_msg", proc_get_tx_info_msg, NULL),
+	RTW_PROC_HDL_SSEQ("txdesc_tmpl", proc_get_txdesc_tmpl, proc_set_txdesc_tmpl),
 	RTW_PROC_HDL_SSEQ("rx_info_msg", proc_get_rx_info_msg, proc_set_rx_info_msg),
 #ifdef CONFIG_GPIO_API
 	RTW_PROC_HDL_SSEQ("gpio_info", proc_get_gpio, proc_set_gpio),
@@ -227,6 +227,140 @@ exit:
 
 #endif /* CONFIG_USB_SUPPORT_ASYNC_VDN_REQ */
 
+struct rtw_fwdl_async_data {
+	u8 data[VENDOR_CMD_MAX_DATA_LEN];
+	struct usb_ctrlrequest dr;
+	struct usb_fwdl_async *fwdl;
+};
+
+void usb_fwdl_async_init(struct dvobj_priv *dvobj, struct usb_fwdl_async *fwdl)
+{
+	_rtw_memset(fwdl, 0, sizeof(*fwdl));
+	fwdl->dvobj = dvobj;
+	init_usb_anchor(&fwdl->anchor);
+	init_waitqueue_head(&fwdl->wq);
+	ATOMIC_SET(&fwdl->pending, 0);
+}
+
+static void usb_fwdl_async_complete(struct urb *purb, struct pt_regs *regs)
+{
+	struct rtw_fwdl_async_data *buf = (struct rtw_fwdl_async_data *)purb->context;
+	struct usb_fwdl_async *fwdl = buf->fwdl;
+
+	if (!fwdl->status) {
+		if (purb->status)
+			fwdl->status = purb->status;
+		else if (purb->actual_length != purb->transfer_buffer_length)
+			fwdl->status = -EIO;
+	}
+
+	rtw_mfree((u8 *)buf, sizeof(*buf));
+	ATOMIC_DEC(&fwdl->pending);
+	wake_up(&fwdl->wq);
+}
+
+/*
+ * submit a vendor req write without waiting for its completion,
+ * blocks only when USB_FWDL_ASYNC_INFLIGHT of them are not completed yet
+ */
+int usb_fwdl_async_write(struct usb_fwdl_async *fwdl, u32 addr, u16 len, u8 *pdata)
+{
+	_adapter *padapter = dvobj_get_primary_adapter(fwdl->dvobj);
+	struct usb_device *udev = fwdl->dvobj->pusbdev;
+	struct rtw_fwdl_async_data *buf;
+	struct usb_ctrlrequest *dr;
+	struct urb *urb;
+	int rc;
+
+	if (fwdl->status)
+		return _FAIL;
+
+	if (RTW_CANNOT_IO(padapter)) {
+		fwdl->status = -EPERM;
+		return _FAIL;
+	}
+
+	if (len > VENDOR_CMD_MAX_DATA_LEN) {
+		fwdl->status = -EINVAL;
+		return _FAIL;
+	}
+
+	if (!wait_event_timeout(fwdl->wq, ATOMIC_READ(&fwdl->pending) < USB_FWDL_ASYNC_INFLIGHT
+		, msecs_to_jiffies(RTW_USB_CONTROL_MSG_TIMEOUT))) {
+		fwdl->status = -ETIMEDOUT;
+		return _FAIL;
+	}
+
+	buf = (struct rtw_fwdl_async_data *)rtw_zmalloc(sizeof(*buf));
+	if (!buf) {
+		fwdl->status = -ENOMEM;
+		return _FAIL;
+	}
+
+	urb = usb_alloc_urb(0, GFP_KERNEL);
+	if (!urb) {
+		rtw_mfree((u8 *)buf, sizeof(*buf));
+		fwdl->status = -ENOMEM;
+		return _FAIL;
+	}
+
+	buf->fwdl = fwdl;
+	_rtw_memcpy(buf->data, pdata, len);
+
+	dr = &buf->dr;
+	dr->bRequestType = REALTEK_USB_VENQT_WRITE;
+	dr->bRequest = REALTEK_USB_VENQT_CMD_REQ;
+	dr->wValue = cpu_to_le16((u16)(addr & 0x0000ffff));
+	dr->wIndex = cpu_to_le16(0);
+	dr->wLength = cpu_to_le16(len);
+
+	usb_fill_control_urb(urb, udev, usb_sndctrlpipe(udev, 0), (unsigned char *)dr, buf->data, len,
+		usb_fwdl_async_complete, buf);
+
+	usb_anchor_urb(urb, &fwdl->anchor);
+	ATOMIC_INC(&fwdl->pending);
+
+	rc = usb_submit_urb(urb, GFP_KERNEL);
+	if (rc < 0) {
+		usb_unanchor_urb(urb);
+		ATOMIC_DEC(&fwdl->pending);
+		rtw_mfree((u8 *)buf, sizeof(*buf));
+		fwdl->status = rc;
+		if (rc == -ESHUTDOWN || rc == -ENODEV)
+			rtw_set_surprise_removed(padapter);
+	} else
+		fwdl->submit_cnt++;
+
+	/* urb is freed after completion, anchor holds its reference */
+	usb_free_urb(urb);
+
+	return rc < 0 ? _FAIL : _SUCCESS;
+}
+
+/*
+ * wait for all submitted vendor req, return _FAIL if any of them failed
+ *
+ * waits on the anchor instead of pending: usbcore holds off the anchor
+ * wakeup until the completion handler has returned, so the caller may
+ * release fwdl (usually on its stack) as soon as this returns
+ */
+int usb_fwdl_async_flush(struct usb_fwdl_async *fwdl, u32 timeout_ms)
+{
+	if (!usb_wait_anchor_empty_timeout(&fwdl->anchor, timeout_ms)) {
+		usb_kill_anchored_urbs(&fwdl->anchor);
+		usb_wait_anchor_empty_timeout(&fwdl->anchor, RTW_USB_CONTROL_MSG_TIMEOUT);
+		if (!fwdl->status)
+			fwdl->status = -ETIMEDOUT;
+	}
+
+	if (fwdl->status) {
+		RTW_INFO("%s submit:%u status:%d\n", __func__, fwdl->submit_cnt, fwdl->status);
+		return _FAIL;
+	}
+
+	return _SUCCESS;
+}
+
 unsigned int ffaddr2pipehdl(struct dvobj_priv *pdvobj, u32 addr)
 {
 	unsigned int pipe = 0, ep_num = 0;
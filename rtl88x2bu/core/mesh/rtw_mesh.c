@@ -713,7 +713,7 @@ u8 rtw_mesh_select_operating_ch(_adapter *adapter)
 			&& rtw_mesh_cto_mgate_network_filter(adapter, scanned)
 			#endif
 		) {
-			int ch_set_idx = rtw_chset_search_ch(rfctl->channel_set, scanned->network.Configuration.DSConfig);
+			int ch_set_idx = rtw_rfctl_search_ch(rfctl, scanned->network.Configuration.DSConfig);
 
 			if (ch_set_idx >= 0
 				&& !CH_IS_NON_OCP(&rfctl->channel_set[ch_set_idx])
@@ -2369,139 +2369,58 @@ static void rtw_mpath_tx_queue_flush(_adapter *adapter)
 	}
 }
 
-#ifdef PLATFORM_LINUX /* 3.10 ~ 4.13 checked */
-#if defined(CONFIG_SLUB)
-#include <linux/slub_def.h>
-#elif defined(CONFIG_SLAB)
-#include <linux/slab_def.h>
-#endif
-typedef struct kmem_cache rtw_mcache;
-#endif
-
-rtw_mcache *rtw_mcache_create(const char *name, size_t size)
-{
-#ifdef PLATFORM_LINUX /* 3.10 ~ 4.13 checked */
-	return kmem_cache_create(name, size, 0, 0, NULL);
-#else
-	#error "TBD\n";
-#endif
-}
-
-void rtw_mcache_destroy(rtw_mcache *s)
-{
-#ifdef PLATFORM_LINUX /* 3.10 ~ 4.13 checked */
-	kmem_cache_destroy(s);
-#else
-	#error "TBD\n";
-#endif
-}
-
-void *_rtw_mcache_alloc(rtw_mcache *cachep)
-{
-#ifdef PLATFORM_LINUX /* 3.10 ~ 4.13 checked */
-	return kmem_cache_alloc(cachep, GFP_ATOMIC);
-#else
-	#error "TBD\n";
-#endif
-}
-
-void _rtw_mcache_free(rtw_mcache *cachep, void *objp)
-{
-#ifdef PLATFORM_LINUX /* 3.10 ~ 4.13 checked */
-	kmem_cache_free(cachep, objp);
-#else
-	#error "TBD\n";
-#endif
-}
-
-#ifdef DBG_MEM_ALLOC
-inline void *dbg_rtw_mcache_alloc(rtw_mcache *cachep, const enum mstat_f flags, const char *func, const int line)
-{
-	void *p;
-	u32 sz = cachep->size;
-
-	if (match_mstat_sniff_rules(flags, sz))
-		RTW_INFO("DBG_MEM_ALLOC %s:%d %s(%u)\n", func, line, __func__, sz);
-
-	p = _rtw_mcache_alloc(cachep);
-
-	rtw_mstat_update(
-		flags
-		, p ? MSTAT_ALLOC_SUCCESS : MSTAT_ALLOC_FAIL
-		, sz
-	);
-
-	return p;
-}
-
-inline void dbg_rtw_mcache_free(rtw_mcache *cachep, void *pbuf, const enum mstat_f flags, const char *func, const int line)
-{
-	u32 sz = cachep->size;
-
-	if (match_mstat_sniff_rules(flags, sz))
-		RTW_INFO("DBG_MEM_ALLOC %s:%d %s(%u)\n", func, line, __func__, sz);
-
-	_rtw_mcache_free(cachep, pbuf);
-
-	rtw_mstat_update(
-		flags
-		, MSTAT_FREE
-		, sz
-	);
-}
-
-#define rtw_mcache_alloc(cachep) dbg_rtw_mcache_alloc(cachep, MSTAT_TYPE_PHY, __FUNCTION__, __LINE__)
-#define rtw_mcache_free(cachep, objp) dbg_rtw_mcache_free(cachep, objp, MSTAT_TYPE_PHY, __FUNCTION__, __LINE__)
-#else
-#define rtw_mcache_alloc(cachep) _rtw_mcache_alloc(cachep)
-#define rtw_mcache_free(cachep, objp) _rtw_mcache_free(cachep, objp)
-#endif /* DBG_MEM_ALLOC */
-
 /* Mesh Received Cache */
 #define RTW_MRC_BUCKETS			256 /* must be a power of 2 */
-#define RTW_MRC_QUEUE_MAX_LEN	4
+#define RTW_MRC_WAYS			4 /* fixed slots per bucket */
 #define RTW_MRC_TIMEOUT_MS		(3 * 1000)
+/* time wheel, entry expires after RTW_MRC_TICK_NUM ~ RTW_MRC_TICK_NUM + 1 ticks */
+#define RTW_MRC_TICK_MS			500
+#define RTW_MRC_TICK_NUM		(RTW_MRC_TIMEOUT_MS / RTW_MRC_TICK_MS)
 
 /**
  * struct rtw_mrc_entry - entry in the Mesh Received Cache
  *
  * @seqnum: mesh sequence number of the frame
- * @exp_time: expiration time of the entry
+ * @tick: time wheel tick when the entry is added, 0 for empty
  * @msa: mesh source address of the frame
- * @list: hashtable list pointer
  *
  * The Mesh Received Cache keeps track of the latest received frames that
  * have been received by a mesh interface and discards received frames
  * that are found in the cache.
+ * Entries are indexed by hash of (mSA, seqnum) into fixed slots of a bucket.
+ * An entry older than RTW_MRC_TICK_NUM ticks is treated as free, so the whole
+ * generation of a tick expires when the wheel moves on without any walk.
  */
 struct rtw_mrc_entry {
-	rtw_hlist_node list;
-	systime exp_time;
 	u32 seqnum;
+	u32 tick;
 	u8 msa[ETH_ALEN];
 };
 
 struct rtw_mrc {
-	rtw_hlist_head bucket[RTW_MRC_BUCKETS];
+	struct rtw_mrc_entry bucket[RTW_MRC_BUCKETS][RTW_MRC_WAYS];
 	u32 idx_mask;
-	rtw_mcache *cache;
+
+	u32 lookup_cnt;
+	u32 probe_cnt; /* entries compared by lookups */
+	u32 hit_cnt;
+	u32 del_qlen; /* valid entry replaced cause by bucket full */
 };
 
+static void rtw_mrc_reset(struct rtw_mrc *mrc)
+{
+	_rtw_memset(mrc, 0, sizeof(struct rtw_mrc));
+	mrc->idx_mask = RTW_MRC_BUCKETS - 1;
+}
+
 static int rtw_mrc_init(_adapter *adapter)
 {
 	struct rtw_mesh_info *minfo = &adapter->mesh_info;
-	char cache_name[IFNAMSIZ + 8 + 1];
-	int i;
 
-	minfo->mrc = rtw_malloc(sizeof(struct rtw_mrc));
+	minfo->mrc = rtw_vmalloc(sizeof(struct rtw_mrc));
 	if (!minfo->mrc)
 		return -ENOMEM;
-	minfo->mrc->idx_mask = RTW_MRC_BUCKETS - 1;
-	for (i = 0; i < RTW_MRC_BUCKETS; i++)
-		rtw_hlist_head_init(&minfo->mrc->bucket[i]);
-
-	sprintf(cache_name, "rtw_mrc_%s", ADPT_ARG(adapter));
-	minfo->mrc->cache = rtw_mcache_create(cache_name, sizeof(struct rtw_mrc_entry));
+	rtw_mrc_reset(minfo->mrc);
 
 	return 0;
 }
@@ -2510,24 +2429,74 @@ static void rtw_mrc_free(_adapter *adapter)
 {
 	struct rtw_mesh_info *minfo = &adapter->mesh_info;
 	struct rtw_mrc *mrc = minfo->mrc;
-	struct rtw_mrc_entry *p;
-	rtw_hlist_node *np, *n;
-	int i;
 
 	if (!mrc)
 		return;
 
-	for (i = 0; i < RTW_MRC_BUCKETS; i++) {
-		rtw_hlist_for_each_entry_safe(p, np, n, &mrc->bucket[i], list) {
-			rtw_hlist_del(&p->list);
-			rtw_mcache_free(mrc->cache, p);
+	rtw_vmfree(mrc, sizeof(struct rtw_mrc));
+	minfo->mrc = NULL;
+}
+
+static inline u32 rtw_mrc_hash(const u8 *msa, u32 seq)
+{
+	u32 h = seq * 0x9E3779B1;
+	int i;
+
+	for (i = 0; i < ETH_ALEN; i++)
+		h = (h ^ msa[i]) * 0x01000193;
+
+	return h ^ (h >> 16);
+}
+
+/* tick 0 is reserved for empty entry */
+static inline u32 rtw_mrc_cur_tick(void)
+{
+	return rtw_systime_to_ms(rtw_get_current_time()) / RTW_MRC_TICK_MS + 1;
+}
+
+static int _rtw_mrc_check(struct rtw_mrc *mrc, const u8 *msa, u32 seq, u32 tick)
+{
+	struct rtw_mrc_entry *bucket, *p, *victim = NULL;
+	u8 victim_valid = _FALSE;
+	u32 idx;
+	int i;
+
+	idx = rtw_mrc_hash(msa, seq) & mrc->idx_mask;
+	bucket = mrc->bucket[idx];
+	mrc->lookup_cnt++;
+
+	for (i = 0; i < RTW_MRC_WAYS; i++) {
+		p = &bucket[i];
+
+		if (!p->tick || tick - p->tick > RTW_MRC_TICK_NUM) {
+			/* empty or expired */
+			if (!victim || victim_valid) {
+				victim = p;
+				victim_valid = _FALSE;
+			}
+			continue;
+		}
+
+		mrc->probe_cnt++;
+		if (seq == p->seqnum && _rtw_memcmp(msa, p->msa, ETH_ALEN) == _TRUE) {
+			mrc->hit_cnt++;
+			return -1;
+		}
+
+		/* keep the oldest one as replacement candidate */
+		if (!victim || (victim_valid && (s32)(p->tick - victim->tick) < 0)) {
+			victim = p;
+			victim_valid = _TRUE;
 		}
 	}
 
-	rtw_mcache_destroy(mrc->cache);
+	if (victim_valid)
+		mrc->del_qlen++;
 
-	rtw_mfree(mrc, sizeof(struct rtw_mrc));
-	minfo->mrc = NULL;
+	victim->seqnum = seq;
+	victim->tick = tick;
+	_rtw_memcpy(victim->msa, msa, ETH_ALEN);
+	return 0;
 }
 
 /**
@@ -2545,41 +2514,77 @@ static void rtw_mrc_free(_adapter *adapter)
  */
 static int rtw_mrc_check(_adapter *adapter, const u8 *msa, u32 seq)
 {
-	struct rtw_mesh_info *minfo = &adapter->mesh_info;
-	struct rtw_mrc *mrc = minfo->mrc;
-	int entries = 0;
-	u8 idx;
-	struct rtw_mrc_entry *p;
-	rtw_hlist_node *np, *n;
-	u8 timeout;
+	struct rtw_mrc *mrc = adapter->mesh_info.mrc;
 
 	if (!mrc)
 		return -1;
 
-	idx = seq & mrc->idx_mask;
-	rtw_hlist_for_each_entry_safe(p, np, n, &mrc->bucket[idx], list) {
-		++entries;
-		timeout = rtw_time_after(rtw_get_current_time(), p->exp_time);
-		if (timeout || entries == RTW_MRC_QUEUE_MAX_LEN) {
-			if (!timeout)
-				minfo->mshstats.mrc_del_qlen++;
-
-			rtw_hlist_del(&p->list);
-			rtw_mcache_free(mrc->cache, p);
-			--entries;
-		} else if ((seq == p->seqnum) && _rtw_memcmp(msa, p->msa, ETH_ALEN) == _TRUE)
-			return -1;
+	return _rtw_mrc_check(mrc, msa, seq, rtw_mrc_cur_tick());
+}
+
+static void dump_mrc_stats(void *sel, struct rtw_mrc *mrc)
+{
+	u32 avg_probe_x100;
+
+	if (!mrc)
+		return;
+
+	avg_probe_x100 = mrc->lookup_cnt ? (u32)rtw_division64((u64)mrc->probe_cnt * 100, mrc->lookup_cnt) : 0;
+
+	RTW_PRINT_SEL(sel, "mrc_lookup:%u\n", mrc->lookup_cnt);
+	RTW_PRINT_SEL(sel, "mrc_hit:%u\n", mrc->hit_cnt);
+	RTW_PRINT_SEL(sel, "mrc_probe_avg:%u.%02u\n", avg_probe_x100 / 100, avg_probe_x100 % 100);
+	RTW_PRINT_SEL(sel, "mrc_del_qlen:%u\n", mrc->del_qlen);
+}
+
+#define MRC_BENCH_SRC_NUM	64
+#define MRC_BENCH_SEQ_NUM	2048
+#define MRC_BENCH_DUP_NUM	3 /* copies of each frame from different neighbors */
+#define MRC_BENCH_FRAME_PER_TICK	2048
+
+/*
+ * Synthetic broadcast flood: MRC_BENCH_SRC_NUM sources interleave their
+ * sequence numbers and each frame is received MRC_BENCH_DUP_NUM times.
+ * Runs on a private cache with a simulated wheel clock.
+ */
+void rtw_mrc_bench(void *sel)
+{
+	struct rtw_mrc *mrc;
+	u8 msa[ETH_ALEN] = {0x02, 0xe0, 0x4c, 0x00, 0x00, 0x00};
+	u32 frames = 0, drops = 0, tick = 1;
+	u32 seq, src, dup;
+	systime start;
+	u32 ms;
+
+	mrc = rtw_vmalloc(sizeof(struct rtw_mrc));
+	if (!mrc) {
+		RTW_PRINT_SEL(sel, "mrc bench: no memory\n");
+		return;
 	}
+	rtw_mrc_reset(mrc);
+
+	start = rtw_get_current_time();
+	for (seq = 0; seq < MRC_BENCH_SEQ_NUM; seq++) {
+		for (dup = 0; dup < MRC_BENCH_DUP_NUM; dup++) {
+			for (src = 0; src < MRC_BENCH_SRC_NUM; src++) {
+				msa[4] = (u8)(src >> 8);
+				msa[5] = (u8)src;
+				if (_rtw_mrc_check(mrc, msa, seq, tick))
+					drops++;
+				if (++frames % MRC_BENCH_FRAME_PER_TICK == 0)
+					tick++;
+			}
+		}
+	}
+	ms = rtw_get_passing_time_ms(start);
 
-	p = rtw_mcache_alloc(mrc->cache);
-	if (!p)
-		return 0;
+	RTW_PRINT_SEL(sel, "%u sources, %u frames, %u ticks\n", MRC_BENCH_SRC_NUM, frames, tick);
+	RTW_PRINT_SEL(sel, "drop:%u expected:%u\n", drops
+		, MRC_BENCH_SRC_NUM * MRC_BENCH_SEQ_NUM * (MRC_BENCH_DUP_NUM - 1));
+	RTW_PRINT_SEL(sel, "%u ms, %u lookups/ms\n", ms, ms ? frames / ms : 0);
+	dump_mrc_stats(sel, mrc);
 
-	p->seqnum = seq;
-	p->exp_time = rtw_get_current_time() + rtw_ms_to_systime(RTW_MRC_TIMEOUT_MS);
-	_rtw_memcpy(p->msa, msa, ETH_ALEN);
-	rtw_hlist_add_head(&p->list, &mrc->bucket[idx]);
-	return 0;
+	rtw_vmfree(mrc, sizeof(struct rtw_mrc));
 }
 
 static int rtw_mesh_decache(_adapter *adapter, const u8 *msa, u32 seq)
@@ -3624,7 +3629,11 @@ void dump_mesh_stats(void *sel, _adapter *adapter)
 	RTW_PRINT_SEL(sel, "drop_congestion:%u\n", stats->dropped_frames_congestion);
 	RTW_PRINT_SEL(sel, "drop_dup:%u\n", stats->dropped_frames_duplicate);
 
-	RTW_PRINT_SEL(sel, "mrc_del_qlen:%u\n", stats->mrc_del_qlen);
+	dump_mrc_stats(sel, minfo->mrc);
+
+	RTW_PRINT_SEL(sel, "fwd_cache_hit:%u\n", stats->fwd_cache_hit);
+	RTW_PRINT_SEL(sel, "fwd_cache_miss:%u\n", stats->fwd_cache_miss);
+	RTW_PRINT_SEL(sel, "fwd_cache_bypass:%u\n", stats->fwd_cache_bypass);
 }
 #endif /* CONFIG_RTW_MESH */
 
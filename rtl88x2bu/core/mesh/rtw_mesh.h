@@ -333,7 +333,9 @@ struct rtw_mesh_stats {
 	u32 dropped_frames_congestion;/* Not forwarded due to congestion */
 	u32 dropped_frames_duplicate;
 
-	u32 mrc_del_qlen; /* MRC entry deleted cause by queue length limit */
+	u32 fwd_cache_hit;	/* forwarded frames tx with cached attrib */
+	u32 fwd_cache_miss;	/* cacheable forwarded frames tx with full update_attrib */
+	u32 fwd_cache_bypass;	/* forwarded frames never served by cache: ARP, EAPOL, DHCP, ICMP... */
 };
 
 struct rtw_mrc;
@@ -373,6 +375,9 @@ struct rtw_mesh_info {
 
 	struct rtw_mesh_stats mshstats;
 
+	/* bumped to invalidate all the forwarding caches of mesh paths */
+	ATOMIC_T fwd_cache_gen;
+
 	_queue mpath_tx_queue;
 	u32 mpath_tx_queue_len;
 	struct tasklet_struct mpath_tx_tasklet;
@@ -492,6 +497,7 @@ int rtw_mesh_rx_msdu_act_check(union recv_frame *rframe
 	, struct xmit_frame **fwd_frame, _list *b2u_list);
 
 void dump_mesh_stats(void *sel, _adapter *adapter);
+void rtw_mrc_bench(void *sel);
 
 #if defined(PLATFORM_LINUX) && (LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 32))
 #define rtw_lockdep_assert_held(l) lockdep_assert_held(l)
@@ -922,6 +922,7 @@ static void rtw_hwmp_perr_frame_process(_adapter *adapter,
 		    (!(path->flags & RTW_MESH_PATH_SN_VALID) ||
 		    RTW_SN_GT(target_sn, path->sn)  || target_sn == 0)) {
 			path->flags &= ~RTW_MESH_PATH_ACTIVE;
+			rtw_mesh_path_fwd_cache_invalidate(path);
 			if (target_sn != 0)
 				path->sn = target_sn;
 			else
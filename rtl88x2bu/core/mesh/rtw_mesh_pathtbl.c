@@ -110,6 +110,7 @@ void rtw_mesh_path_assign_nexthop(struct rtw_mesh_path *mpath, struct sta_info *
 	_list *list, *head;
 
 	rtw_rcu_assign_pointer(mpath->next_hop, sta);
+	rtw_mesh_path_fwd_cache_invalidate(mpath);
 
 	enter_critical_bh(&mpath->frame_queue.lock);
 	head = &mpath->frame_queue.queue;
@@ -613,6 +614,7 @@ void rtw_mesh_plink_broken(struct sta_info *sta)
 		    !(mpath->flags & RTW_MESH_PATH_FIXED)) {
 			enter_critical_bh(&mpath->state_lock);
 			mpath->flags &= ~RTW_MESH_PATH_ACTIVE;
+			rtw_mesh_path_fwd_cache_invalidate(mpath);
 			++mpath->sn;
 			exit_critical_bh(&mpath->state_lock);
 			rtw_mesh_path_error_tx(adapter,
@@ -978,6 +980,125 @@ void rtw_mesh_path_fix_nexthop(struct rtw_mesh_path *mpath, struct sta_info *nex
 	rtw_mesh_path_tx_pending(mpath);
 }
 
+/**
+ * rtw_mesh_fwd_cache_flush - invalidate forwarding caches of all mesh paths
+ *
+ * @adapter: mesh interface
+ *
+ * Used when state shared by all the cached attribs (e.g. keys) is changed.
+ */
+void rtw_mesh_fwd_cache_flush(_adapter *adapter)
+{
+	ATOMIC_INC(&adapter->mesh_info.fwd_cache_gen);
+}
+
+/**
+ * rtw_mesh_fwd_cache_apply - fill attrib of a forwarded frame from the cache
+ *
+ * @adapter: mesh interface
+ * @attrib: attrib with the mesh addressing, TTL and sequence already set
+ *
+ * The per frame fields set by the forwarding decision are kept, all the
+ * others are copied from the template cached in the mesh path of mDA.
+ *
+ * Returns: _TRUE if the cached template is valid and has been applied
+ */
+bool rtw_mesh_fwd_cache_apply(_adapter *adapter, struct pkt_attrib *attrib)
+{
+	struct rtw_mesh_info *minfo = &adapter->mesh_info;
+	struct rtw_mesh_path *mpath;
+	struct rtw_mesh_fwd_cache *cache;
+	struct sta_info *next_hop;
+	u8 dst[ETH_ALEN], src[ETH_ALEN], mda[ETH_ALEN], msa[ETH_ALEN];
+	u8 mesh_frame_mode, mfwd_ttl;
+	u32 mseq;
+	bool hit = _FALSE;
+
+	rtw_rcu_read_lock();
+	mpath = rtw_mesh_path_lookup(adapter, attrib->mda);
+	if (!mpath)
+		goto exit;
+
+	cache = &mpath->fwd_cache;
+
+	enter_critical_bh(&mpath->state_lock);
+	next_hop = rtw_rcu_dereference(mpath->next_hop);
+	if (!cache->valid
+		|| !(mpath->flags & RTW_MESH_PATH_ACTIVE)
+		|| !next_hop || cache->next_hop != next_hop
+		|| cache->gen != ATOMIC_READ(&minfo->fwd_cache_gen)
+		|| cache->agg_bitmap != next_hop->htpriv.agg_enable_bitmap
+		|| _rtw_memcmp(attrib->ra, next_hop->cmn.mac_addr, ETH_ALEN) == _FALSE
+	) {
+		exit_critical_bh(&mpath->state_lock);
+		goto exit;
+	}
+
+	_rtw_memcpy(dst, attrib->dst, ETH_ALEN);
+	_rtw_memcpy(src, attrib->src, ETH_ALEN);
+	_rtw_memcpy(mda, attrib->mda, ETH_ALEN);
+	_rtw_memcpy(msa, attrib->msa, ETH_ALEN);
+	mesh_frame_mode = attrib->mesh_frame_mode;
+	mfwd_ttl = attrib->mfwd_ttl;
+	mseq = attrib->mseq;
+
+	_rtw_memcpy(attrib, &cache->attrib, sizeof(struct pkt_attrib));
+	exit_critical_bh(&mpath->state_lock);
+
+	_rtw_memcpy(attrib->dst, dst, ETH_ALEN);
+	_rtw_memcpy(attrib->src, src, ETH_ALEN);
+	_rtw_memcpy(attrib->mda, mda, ETH_ALEN);
+	_rtw_memcpy(attrib->msa, msa, ETH_ALEN);
+	attrib->mesh_frame_mode = mesh_frame_mode;
+	attrib->mfwd_ttl = mfwd_ttl;
+	attrib->mseq = mseq;
+	hit = _TRUE;
+
+exit:
+	rtw_rcu_read_unlock();
+	return hit;
+}
+
+/**
+ * rtw_mesh_fwd_cache_update - save attrib of a forwarded frame as template
+ *
+ * @adapter: mesh interface
+ * @attrib: attrib just resolved by update_attrib()
+ */
+void rtw_mesh_fwd_cache_update(_adapter *adapter, struct pkt_attrib *attrib)
+{
+	struct rtw_mesh_info *minfo = &adapter->mesh_info;
+	struct rtw_mesh_path *mpath;
+	struct rtw_mesh_fwd_cache *cache;
+	struct sta_info *next_hop;
+
+	/* frames needing per packet tracking are not cached */
+	if (!attrib->psta
+		|| rtw_st_ctl_chk_reg_s_proto(&attrib->psta->st_ctl, 0x06) == _TRUE)
+		return;
+
+	rtw_rcu_read_lock();
+	mpath = rtw_mesh_path_lookup(adapter, attrib->mda);
+	if (!mpath)
+		goto exit;
+
+	cache = &mpath->fwd_cache;
+
+	enter_critical_bh(&mpath->state_lock);
+	next_hop = rtw_rcu_dereference(mpath->next_hop);
+	if ((mpath->flags & RTW_MESH_PATH_ACTIVE) && next_hop == attrib->psta) {
+		_rtw_memcpy(&cache->attrib, attrib, sizeof(struct pkt_attrib));
+		cache->next_hop = next_hop;
+		cache->agg_bitmap = next_hop->htpriv.agg_enable_bitmap;
+		cache->gen = ATOMIC_READ(&minfo->fwd_cache_gen);
+		cache->valid = 1;
+	}
+	exit_critical_bh(&mpath->state_lock);
+
+exit:
+	rtw_rcu_read_unlock();
+}
+
 int rtw_mesh_pathtbl_init(_adapter *adapter)
 {
 	struct rtw_mesh_table *tbl_path, *tbl_mpp;
@@ -52,6 +52,26 @@ enum rtw_mesh_path_flags {
 	RTW_MESH_PATH_DELETED =	BIT(6),
 };
 
+/**
+ * struct rtw_mesh_fwd_cache - prebuilt tx state for frames forwarded to a path
+ *
+ * @attrib: pkt_attrib resolved by update_attrib() for a frame forwarded to
+ *	this destination, used as template for the following forwarded frames
+ * @next_hop: the next hop @attrib was resolved with
+ * @agg_bitmap: agg_enable_bitmap of @next_hop when @attrib was resolved
+ * @gen: value of rtw_mesh_info.fwd_cache_gen when @attrib was resolved
+ * @valid: @attrib can be used as template
+ *
+ * Protected by the state_lock of the mesh path.
+ */
+struct rtw_mesh_fwd_cache {
+	struct pkt_attrib attrib;
+	struct sta_info *next_hop;
+	u8 agg_bitmap;
+	int gen;
+	u8 valid;
+};
+
 /**
  * struct rtw_mesh_path - mesh path structure
  *
@@ -82,6 +102,7 @@ enum rtw_mesh_path_flags {
  * @last_preq_to_root: Timestamp of last PREQ sent to root
  * @is_root: the destination station of this path is a root node
  * @is_gate: the destination station of this path is a mesh gate
+ * @fwd_cache: tx template for frames forwarded to this destination
  *
  *
  * The dst address is unique in the mesh path table. Since the mesh_path is
@@ -116,6 +137,7 @@ struct rtw_mesh_path {
 	bool is_root;
 	bool is_gate;
 	bool gate_asked;
+	struct rtw_mesh_fwd_cache fwd_cache;
 };
 
 /**
@@ -189,5 +211,15 @@ static inline void rtw_mesh_path_activate(struct rtw_mesh_path *mpath)
 
 void rtw_mesh_path_flush_by_iface(_adapter *adapter);
 
+/* mpath->state_lock must be held */
+static inline void rtw_mesh_path_fwd_cache_invalidate(struct rtw_mesh_path *mpath)
+{
+	mpath->fwd_cache.valid = 0;
+}
+
+void rtw_mesh_fwd_cache_flush(_adapter *adapter);
+bool rtw_mesh_fwd_cache_apply(_adapter *adapter, struct pkt_attrib *attrib);
+void rtw_mesh_fwd_cache_update(_adapter *adapter, struct pkt_attrib *attrib);
+
 #endif /* __RTW_MESH_PATHTBL_H_ */
 
@@ -31,6 +31,7 @@ void init_mlme_ap_info(_adapter *padapter)
 	struct mlme_priv *pmlmepriv = &(padapter->mlmepriv);
 
 	_rtw_spinlock_init(&pmlmepriv->bcn_update_lock);
+	pmlmepriv->probersp.dedup_ms = RTW_PROBERSP_DEDUP_MS;
 
 	/* pmlmeext->bstart_bss = _FALSE; */
 
@@ -1398,7 +1399,7 @@ static void rtw_ap_check_scan(_adapter *padapter)
 
 		pnetwork = LIST_CONTAINOR(plist, struct wlan_network, list);
 
-		if (rtw_chset_search_ch(adapter_to_chset(padapter), pnetwork->network.Configuration.DSConfig) >= 0
+		if (rtw_rfctl_search_ch(adapter_to_rfctl(padapter), pnetwork->network.Configuration.DSConfig) >= 0
 		    && rtw_mlme_band_check(padapter, pnetwork->network.Configuration.DSConfig) == _TRUE
 		    && _TRUE == rtw_validate_ssid(&(pnetwork->network.Ssid))) {
 			delta_time = (u32) rtw_get_passing_time_ms(pnetwork->last_scanned);
@@ -1507,6 +1508,7 @@ void start_bss_network(_adapter *padapter, struct createbss_parm *parm)
 		/* inform this request comes from upper layer */
 		req_ch = 0;
 		_rtw_memcpy(pnetwork_mlmeext, pnetwork, pnetwork->Length);
+		rtw_probersp_tmpl_invalidate(padapter);
 	}
 
 	bcn_interval = (u16)pnetwork->Configuration.BeaconPeriod;
@@ -3083,8 +3085,12 @@ void _update_beacon(_adapter *padapter, u8 ie_id, u8 *oui, u8 tx, const char *ta
 		break;
 	}
 
-	if (updated)
+	if (updated) {
 		pmlmepriv->update_bcn = _TRUE;
+		/* TIM is meaningless in probe response, keep template across DTIM updates */
+		if (ie_id != _TIM_IE_)
+			rtw_probersp_tmpl_clear(padapter);
+	}
 
 	_exit_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
 
@@ -3990,6 +3996,7 @@ void stop_ap_mode(_adapter *padapter)
 		rtw_warn_on(1);
 
 	pmlmepriv->update_bcn = _FALSE;
+	rtw_probersp_tmpl_invalidate(padapter);
 	/*pmlmeext->bstart_bss = _FALSE;*/
 	padapter->netif_up = _FALSE;
 	/* _rtw_spinlock_free(&pmlmepriv->bcn_update_lock); */
@@ -579,6 +579,110 @@ static void _sounding_update_min_period(PADAPTER adapter, u16 period, u8 leave)
 	}
 }
 
+/*
+ * Adaptive sounding scheduler
+ *
+ * Each BFee gets a priority from its recent TX throughput, how much its TX
+ * rate moves between two updates and the variance of its RSSI. The priority
+ * sets the BFee's own sound_period, so busy or moving stations are sounded
+ * often and static ones rarely. Each sounding period only the top-N due
+ * BFees by priority are sounded, the rest stay due for the next period.
+ * BFees without traffic are not sounded at all.
+ */
+static u16 _sounding_sched_prio(u16 tp, u16 rate_drift, u16 rssi_var)
+{
+	u32 traffic, mobility, rssi;
+
+	/* 0 ~ 100 each, mobility counts double since a stale matrix is worse than none */
+	traffic = rtw_min(tp, 200) / 2;
+	mobility = rtw_min((u32)rate_drift * 10 / 16, 100);
+	rssi = rtw_min((u32)rssi_var * 4, 100);
+
+	return (u16)(traffic + 2 * mobility + rssi);
+}
+
+static u16 _sounding_sched_period(u16 prio)
+{
+	u32 span = BF_SOUND_PERIOD_MAX - BF_SOUND_PERIOD_MIN;
+
+	if (prio > BF_SCHED_PRIO_MAX)
+		prio = BF_SCHED_PRIO_MAX;
+
+	return (u16)(BF_SOUND_PERIOD_MAX - span * prio / BF_SCHED_PRIO_MAX);
+}
+
+/* Feed one statistic sample of a BFee, return the new priority */
+static u16 _sounding_sched_update(struct beamformee_entry *bfee, u16 tp, u8 tx_rate, u8 rssi)
+{
+	u16 diff;
+	u32 dev;
+
+	diff = (tx_rate > bfee->sched_last_rate) ? tx_rate - bfee->sched_last_rate : bfee->sched_last_rate - tx_rate;
+	if (bfee->sched_last_rate == 0)
+		diff = 0;
+	bfee->sched_last_rate = tx_rate;
+	bfee->sched_rate_drift = (bfee->sched_rate_drift * 3 + diff * 16) / 4;
+
+	if (bfee->sched_rssi_avg == 0)
+		bfee->sched_rssi_avg = rssi * 16;
+	dev = (rssi * 16 > bfee->sched_rssi_avg) ? rssi * 16 - bfee->sched_rssi_avg : bfee->sched_rssi_avg - rssi * 16;
+	dev /= 16;
+	bfee->sched_rssi_avg = (bfee->sched_rssi_avg * 3 + rssi * 16) / 4;
+	bfee->sched_rssi_var = (u16)rtw_min((bfee->sched_rssi_var * 3 + dev * dev) / 4, 0xFFFF);
+
+	bfee->sched_tp = tp;
+	bfee->sched_prio = _sounding_sched_prio(tp, bfee->sched_rate_drift, bfee->sched_rssi_var);
+
+	return bfee->sched_prio;
+}
+
+/*
+ * Rough airtime of one sounding sequence in us:
+ * NDPA(6M) + SIFS + NDP + SIFS + CSI report(24M), and for every extra MU
+ * BFee a BF report poll(6M) + SIFS + CSI report + SIFS.
+ */
+static u32 _sounding_airtime(enum channel_width bw, u8 sta_num)
+{
+	u32 rpt_len, rpt_us, t;
+
+	rpt_len = 250 << rtw_min((u32)bw, (u32)CHANNEL_WIDTH_80);
+	rpt_us = 20 + 4 * ((22 + 8 * rpt_len + 95) / 96);
+
+	t = 52 + 16 + 60 + 16 + rpt_us;
+	if (sta_num > 1)
+		t += (sta_num - 1) * (48 + 16 + rpt_us + 16);
+
+	return t;
+}
+
+static void _sounding_account(PADAPTER adapter, struct beamformee_entry *bfee, u32 airtime)
+{
+	struct beamforming_info *info = GET_BEAMFORM_INFO(adapter);
+	systime now = rtw_get_current_time();
+
+	if (bfee->last_sound_time)
+		bfee->sound_interval = rtw_get_time_interval_ms(bfee->last_sound_time, now);
+	bfee->last_sound_time = now;
+	bfee->sound_cnt++;
+	bfee->sound_airtime += airtime;
+	info->sound_airtime += airtime;
+}
+
+static void _sounding_sched_reset(struct beamformee_entry *bfee)
+{
+	bfee->sched_idle = _FALSE;
+	bfee->sched_tp = 0;
+	bfee->sched_last_rate = 0;
+	bfee->sched_rate_drift = 0;
+	bfee->sched_rssi_avg = 0;
+	bfee->sched_rssi_var = 0;
+	bfee->sched_prio = 0;
+	bfee->last_sound_time = 0;
+	bfee->sound_interval = 0;
+	bfee->sound_cnt = 0;
+	bfee->sound_airtime = 0;
+}
+
 static void _sounding_init(struct sounding_info *sounding)
 {
 	_rtw_memset(sounding->su_sounding_list, 0xFF, MAX_NUM_BEAMFORMEE_SU);
@@ -590,14 +694,12 @@ static void _sounding_init(struct sounding_info *sounding)
 	sounding->sound_remain_cnt_per_period = 0;
 }
 
-static void _sounding_reset_vars(PADAPTER adapter)
+static void _sounding_reset_vars(struct beamforming_info *info)
 {
-	struct beamforming_info	*info;
 	struct sounding_info *sounding;
 	u8 idx;
 
 
-	info = GET_BEAMFORM_INFO(adapter);
 	sounding = &info->sounding_info;
 
 	_rtw_memset(sounding->su_sounding_list, 0xFF, MAX_NUM_BEAMFORMEE_SU);
@@ -621,20 +723,21 @@ static void _sounding_reset_vars(PADAPTER adapter)
  *	-1	Fail to prepare sounding list, because no beamformee need to souding
  *	-2	Fail to prepare sounding list, because beamformee state not ready
  *
+ * Only info is touched, _bf_sched_sim_run() runs it on scratch entries.
  */
-static int _sounding_get_list(PADAPTER adapter)
+static int _sounding_get_list(struct beamforming_info *info, u8 *su_num)
 {
-	struct beamforming_info	*info;
 	struct sounding_info *sounding;
 	struct beamformee_entry *bfee;
-	u8 i, mu_idx = 0, su_idx = 0, not_ready = 0;
+	u8 cand[MAX_BEAMFORMEE_ENTRY_NUM];
+	u8 cand_num = 0, picked = 0, top_n;
+	u8 i, j, k, mu_idx = 0, su_idx = 0, not_ready = 0;
 	int ret = 0;
 
 
-	info = GET_BEAMFORM_INFO(adapter);
 	sounding = &info->sounding_info;
 
-	/* Add MU BFee list first because MU priority is higher than SU */
+	/* Collect due BFees, ordered by scheduler priority */
 	for (i = 0; i < MAX_BEAMFORMEE_ENTRY_NUM; i++) {
 		bfee = &info->bfee_entry[i];
 		if (bfee->used == _FALSE)
@@ -657,6 +760,34 @@ static int _sounding_get_list(PADAPTER adapter)
 				continue;
 		}
 
+		/* No traffic, SoundCnt stays 0 so it is due as soon as traffic is back */
+		if ((bfee->sched_idle == _TRUE) && (bfee->bDeleteSounding == _FALSE))
+			continue;
+
+		for (j = cand_num; j > 0; j--) {
+			if (info->bfee_entry[cand[j - 1]].sched_prio >= bfee->sched_prio)
+				break;
+			cand[j] = cand[j - 1];
+		}
+		cand[j] = i;
+		cand_num++;
+	}
+
+	top_n = info->sched_top_n ? info->sched_top_n : MAX_BEAMFORMEE_ENTRY_NUM;
+
+	/* Add MU BFee list first because MU priority is higher than SU */
+	for (k = 0; k < cand_num; k++) {
+		i = cand[k];
+		bfee = &info->bfee_entry[i];
+
+		/* MU BFees share one NDPA, the MU group takes a single slot */
+		if ((bfee->bDeleteSounding == _FALSE) && (picked >= top_n)
+		    && !((bfee->cap & BEAMFORMEE_CAP_VHT_MU) && mu_idx)) {
+			/* SoundCnt stays 0, sound it next period */
+			info->sched_defer_cnt++;
+			continue;
+		}
+
 		/*
 		 * <tynli_Note>
 		 *	If the STA supports MU BFee capability then we add it to MUSoundingList directly
@@ -674,6 +805,8 @@ static int _sounding_get_list(PADAPTER adapter)
 				bfee->bCandidateSoundingPeer = _TRUE;
 				bfee->SoundCnt = GetInitSoundCnt(bfee->sound_period, sounding->min_sounding_period);
 				sounding->mu_sounding_list[mu_idx] = i;
+				if (mu_idx == 0)
+					picked++;
 				mu_idx++;
 			}
 		} else if (bfee->cap & (BEAMFORMEE_CAP_VHT_SU|BEAMFORMEE_CAP_HT_EXPLICIT)) {
@@ -692,11 +825,13 @@ static int _sounding_get_list(PADAPTER adapter)
 				bfee->SoundCnt = GetInitSoundCnt(bfee->sound_period, sounding->min_sounding_period);
 				sounding->su_sounding_list[su_idx] = i;
 				su_idx++;
+				picked++;
 			}
 		}
 	}
 
 	sounding->candidate_mu_bfee_cnt = mu_idx;
+	*su_num = su_idx;
 
 	if (su_idx + mu_idx == 0) {
 		ret = -1;
@@ -704,8 +839,6 @@ static int _sounding_get_list(PADAPTER adapter)
 			ret = -2;
 	}
 
-	RTW_INFO("-%s: There are %d SU and %d MU BFees in this sounding period\n", __FUNCTION__, su_idx, mu_idx);
-
 	return ret;
 }
 
@@ -714,8 +847,9 @@ static void _sounding_handler(PADAPTER adapter)
 	struct beamforming_info	*info;
 	struct sounding_info *sounding;
 	struct beamformee_entry *bfee;
-	u8 su_idx, i;
+	u8 su_idx, su_num = 0, i;
 	u32 timeout_period = 0;
+	u32 airtime;
 	u8 set_timer = _FALSE;
 	int ret = 0;
 	static u16 wait_cnt = 0;
@@ -737,10 +871,12 @@ static void _sounding_handler(PADAPTER adapter)
 		RTW_INFO("%s: Sounding start\n", __FUNCTION__);
 
 		/* Init Var */
-		_sounding_reset_vars(adapter);
+		_sounding_reset_vars(info);
 
 		/* Get the sounding list of this sounding period */
-		ret = _sounding_get_list(adapter);
+		ret = _sounding_get_list(info, &su_num);
+		RTW_INFO("%s: There are %d SU and %d MU BFees in this sounding period\n"
+			, __FUNCTION__, su_num, sounding->candidate_mu_bfee_cnt);
 		if (ret == -1) {
 			wait_cnt = 0;
 			sounding->state = SOUNDING_STATE_NONE;
@@ -810,6 +946,7 @@ static void _sounding_handler(PADAPTER adapter)
 			_send_vht_ndpa_packet(adapter, bfee->mac_addr, bfee->aid, bfee->sound_bw);
 		else if (bfee->cap & BEAMFORMEE_CAP_HT_EXPLICIT)
 			_send_ht_ndpa_packet(adapter, bfee->mac_addr, bfee->sound_bw);
+		_sounding_account(adapter, bfee, _sounding_airtime(bfee->sound_bw, 1));
 
 		/* Set sounding timeout timer */
 		_set_timer(&info->sounding_timeout_timer, SU_SOUNDING_TIMEOUT);
@@ -826,9 +963,13 @@ static void _sounding_handler(PADAPTER adapter)
 		RTW_DBG("%s: Set to SOUNDING_STATE_MU_START\n", __FUNCTION__);
 
 		/* Update MU BFee info */
+		bfee = &info->bfee_entry[sounding->mu_sounding_list[0]];
+		airtime = _sounding_airtime(bfee->sound_bw, sounding->candidate_mu_bfee_cnt)
+			/ sounding->candidate_mu_bfee_cnt;
 		for (i = 0; i < sounding->candidate_mu_bfee_cnt; i++) {
 			bfee = &info->bfee_entry[sounding->mu_sounding_list[i]];
 			bfee->sounding = _TRUE;
+			_sounding_account(adapter, bfee, airtime);
 		}
 
 		/* Send MU NDPA */
@@ -1212,7 +1353,8 @@ static struct beamformee_entry *_bfee_add_entry(PADAPTER adapter,
 	_rtw_memcpy(bfee->mac_addr, sta->cmn.mac_addr, ETH_ALEN);
 	bfee->txbf = _FALSE;
 	bfee->sounding = _FALSE;
-	bfee->sound_period = 40;
+	bfee->sound_period = BF_SOUND_PERIOD_DEF;
+	_sounding_sched_reset(bfee);
 	_sounding_update_min_period(adapter, bfee->sound_period, _FALSE);
 	bfee->SoundCnt = GetInitSoundCnt(bfee->sound_period, info->sounding_info.min_sounding_period);
 	bfee->cap = bf_cap;
@@ -1806,6 +1948,10 @@ void rtw_bf_init(PADAPTER adapter)
 	info->TargetSUBFee = NULL;
 
 	info->sounding_running = 0;
+
+	info->sched_top_n = BF_SCHED_TOP_N_DEF;
+	info->sched_defer_cnt = 0;
+	info->sound_airtime = 0;
 }
 
 void rtw_bf_cmd_hdl(PADAPTER adapter, u8 type, u8 *pbuf)
@@ -1929,6 +2075,10 @@ void rtw_bf_update_traffic(PADAPTER adapter)
 	u32 time;
 	systime last_timestamp;
 	u8 set_timer = _FALSE;
+	u8 update_period = _FALSE;
+	u8 idle;
+	u16 period;
+	s8 rssi;
 
 
 	info = GET_BEAMFORM_INFO(adapter);
@@ -1965,6 +2115,32 @@ void rtw_bf_update_traffic(PADAPTER adapter)
 			tx_rate[i] = rtw_get_current_tx_rate(adapter, sta);
 			RTW_INFO("%s: BFee idx(%d), MadId(%d), TxTP=%lld bytes (%d Mbps), txrate=%d\n",
 				 __FUNCTION__, i, bfee->mac_id, tx_bytes, tp[i], tx_rate[i]);
+
+			rssi = sta->cmn.rssi_stat.rssi;
+			_sounding_sched_update(bfee, tp[i], tx_rate[i], (rssi > 0) ? rssi : 0);
+
+			idle = (tx_bytes == 0)
+				&& (sta->sta_xmitpriv.be_q.qcnt + sta->sta_xmitpriv.bk_q.qcnt
+				    + sta->sta_xmitpriv.vi_q.qcnt + sta->sta_xmitpriv.vo_q.qcnt) == 0;
+			if ((bfee->sched_idle == _TRUE) && (idle == _FALSE))
+				set_timer = _TRUE;
+			bfee->sched_idle = idle ? _TRUE : _FALSE;
+
+			period = idle ? BF_SOUND_PERIOD_MAX : _sounding_sched_period(bfee->sched_prio);
+			if (period != bfee->sound_period) {
+				bfee->sound_period = period;
+				update_period = _TRUE;
+			}
+		}
+	}
+
+	if (_TRUE == update_period) {
+		_sounding_update_min_period(adapter, 0, _TRUE);
+		for (i = 0; i < MAX_BEAMFORMEE_ENTRY_NUM; i++) {
+			bfee = &info->bfee_entry[i];
+			if ((_TRUE == bfee->used) && sounding->min_sounding_period
+			    && (bfee->SoundCnt > GetInitSoundCnt(bfee->sound_period, sounding->min_sounding_period)))
+				bfee->SoundCnt = GetInitSoundCnt(bfee->sound_period, sounding->min_sounding_period);
 		}
 	}
 
@@ -2002,6 +2178,203 @@ void rtw_bf_update_traffic(PADAPTER adapter)
 	}
 }
 
+void rtw_bf_dump_sched(void *sel, PADAPTER adapter)
+{
+	struct beamforming_info *info;
+	struct beamformee_entry *bfee;
+	u8 i;
+
+
+	info = GET_BEAMFORM_INFO(adapter);
+
+	RTW_PRINT_SEL(sel, "min_sounding_period:%u ms, top_n:%u, defer_cnt:%u, airtime:%llu us\n"
+		, info->sounding_info.min_sounding_period, info->sched_top_n
+		, info->sched_defer_cnt, info->sound_airtime);
+
+	RTW_PRINT_SEL(sel, "%-3s %-17s %-2s %-4s %-5s %-5s %-5s %-4s %-6s %-8s %-8s %-10s\n"
+		, "idx", "addr", "mu", "idle", "tp", "drift", "rssiv", "prio"
+		, "period", "interval", "cnt", "airtime");
+
+	for (i = 0; i < MAX_BEAMFORMEE_ENTRY_NUM; i++) {
+		bfee = &info->bfee_entry[i];
+		if (bfee->used == _FALSE)
+			continue;
+
+		RTW_PRINT_SEL(sel, "%3u "MAC_FMT" %2u %4u %5u %5u %5u %4u %6u %8u %8u %10llu\n"
+			, i, MAC_ARG(bfee->mac_addr)
+			, (bfee->cap & BEAMFORMEE_CAP_VHT_MU) ? 1 : 0
+			, bfee->sched_idle, bfee->sched_tp, bfee->sched_rate_drift / 16
+			, bfee->sched_rssi_var, bfee->sched_prio, bfee->sound_period
+			, bfee->sound_interval, bfee->sound_cnt, bfee->sound_airtime);
+	}
+}
+
+void rtw_bf_set_sched_top_n(PADAPTER adapter, u8 top_n)
+{
+	GET_BEAMFORM_INFO(adapter)->sched_top_n = top_n;
+}
+
+/*
+ * Deterministic simulation of the scheduler policy.
+ * Four synthetic SU BFees (static idle, static busy, moving busy, moving
+ * light) in a scratch beamforming_info are fed 2 second statistic samples,
+ * and each 2 seconds of sounding periods are replayed through
+ * _sounding_get_list(). The resulting priority, period and sounding count
+ * of each BFee are checked against the policy.
+ */
+#define BF_SIM_STA_NUM	4
+enum {
+	BF_SIM_STATIC_IDLE,
+	BF_SIM_STATIC_BUSY,
+	BF_SIM_MOVING_BUSY,
+	BF_SIM_MOVING_LIGHT,
+};
+
+struct bf_sim_result {
+	u32 sound_cnt[BF_SIM_STA_NUM];
+	u32 airtime[BF_SIM_STA_NUM];
+	u32 defer_cnt;
+	u8 max_picked;
+};
+
+static void _bf_sched_sim_run(struct beamforming_info *info, u32 rounds, u8 top_n, struct bf_sim_result *res)
+{
+	static const u16 sim_tp[BF_SIM_STA_NUM] = {0, 150, 150, 10};
+	static const u8 sim_moving[BF_SIM_STA_NUM] = {0, 0, 1, 1};
+	struct beamformee_entry *sim = info->bfee_entry;
+	struct sounding_info *sounding = &info->sounding_info;
+	u32 seed = 1, r, t;
+	u16 min_period;
+	u8 i, idx, picked;
+
+	_rtw_memset(info, 0, sizeof(*info));
+	_rtw_memset(res, 0, sizeof(*res));
+
+	info->sched_top_n = top_n;
+	for (i = 0; i < BF_SIM_STA_NUM; i++) {
+		sim[i].used = _TRUE;
+		sim[i].state = BEAMFORM_ENTRY_HW_STATE_ADDED;
+		sim[i].cap = BEAMFORMEE_CAP_VHT_SU;
+		sim[i].bApplySounding = _TRUE;
+	}
+
+	for (r = 0; r < rounds; r++) {
+		min_period = BF_SOUND_PERIOD_MAX;
+		for (i = 0; i < BF_SIM_STA_NUM; i++) {
+			u8 rate = 40, rssi = 60;
+
+			seed = seed * 1103515245 + 12345;
+			if (sim_moving[i]) {
+				rate = 30 + (seed >> 16) % 10;
+				rssi = 40 + (seed >> 8) % 20;
+			} else
+				rssi += (seed >> 16) % 2;
+
+			_sounding_sched_update(&sim[i], sim_tp[i], rate, rssi);
+			sim[i].sched_idle = sim_tp[i] ? _FALSE : _TRUE;
+			sim[i].sound_period = sim[i].sched_idle ? BF_SOUND_PERIOD_MAX : _sounding_sched_period(sim[i].sched_prio);
+			if (sim[i].sound_period < min_period)
+				min_period = sim[i].sound_period;
+		}
+
+		sounding->min_sounding_period = min_period;
+
+		for (t = 0; t < 2000; t += min_period) {
+			_sounding_reset_vars(info);
+			picked = 0;
+			_sounding_get_list(info, &picked);
+
+			for (i = 0; i < MAX_NUM_BEAMFORMEE_SU; i++) {
+				idx = sounding->su_sounding_list[i];
+				if (idx >= BF_SIM_STA_NUM)
+					continue;
+				res->sound_cnt[idx]++;
+				res->airtime[idx] += _sounding_airtime(CHANNEL_WIDTH_80, 1);
+			}
+
+			if (picked > res->max_picked)
+				res->max_picked = picked;
+		}
+	}
+
+	res->defer_cnt = info->sched_defer_cnt;
+}
+
+/* Higher priority must never get a longer period or fewer soundings */
+static u8 _bf_sched_sim_ordered(struct beamformee_entry *sim, u32 *sound_cnt)
+{
+	u8 i, j;
+
+	for (i = 0; i < BF_SIM_STA_NUM; i++) {
+		for (j = 0; j < BF_SIM_STA_NUM; j++) {
+			if (sim[i].sched_idle || sim[j].sched_idle || sim[i].sched_prio <= sim[j].sched_prio)
+				continue;
+			if (sim[i].sound_period > sim[j].sound_period || sound_cnt[i] < sound_cnt[j])
+				return _FALSE;
+		}
+	}
+
+	return _TRUE;
+}
+
+void rtw_bf_sched_sim(void *sel, u32 rounds)
+{
+	static const char *const name[BF_SIM_STA_NUM] = {"static_idle", "static_busy", "moving_busy", "moving_light"};
+	struct beamforming_info *info;
+	struct beamformee_entry *sim;
+	struct bf_sim_result *res;
+	u32 fail_cnt = 0;
+	u8 i, ok;
+
+	/* the EWMAs need a few samples to settle before the order is meaningful */
+	if (rounds < 10)
+		rounds = 10;
+
+	info = rtw_zmalloc(sizeof(*info));
+	res = rtw_zmalloc(sizeof(*res));
+	if (!info || !res) {
+		RTW_PRINT_SEL(sel, "FAIL\n");
+		goto exit;
+	}
+	sim = info->bfee_entry;
+
+	_bf_sched_sim_run(info, rounds, BF_SCHED_TOP_N_DEF, res);
+
+	RTW_PRINT_SEL(sel, "bf sched sim: %u rounds of 2s, top_n:%u\n", rounds, BF_SCHED_TOP_N_DEF);
+	for (i = 0; i < BF_SIM_STA_NUM; i++)
+		RTW_PRINT_SEL(sel, "%-12s prio:%3u period:%3u ms sounds:%6u airtime:%8u us\n"
+			, name[i], sim[i].sched_prio, sim[i].sound_period, res->sound_cnt[i], res->airtime[i]);
+
+	ok = _TRUE;
+	for (i = 0; i < BF_SIM_STA_NUM; i++)
+		if (sim[i].sound_period < BF_SOUND_PERIOD_MIN || sim[i].sound_period > BF_SOUND_PERIOD_MAX)
+			ok = _FALSE;
+	rtw_selftest_chk(sel, "period within min~max", ok, &fail_cnt);
+
+	rtw_selftest_chk(sel, "idle not sounded", res->sound_cnt[BF_SIM_STATIC_IDLE] == 0
+		&& sim[BF_SIM_STATIC_IDLE].sound_period == BF_SOUND_PERIOD_MAX, &fail_cnt);
+	rtw_selftest_chk(sel, "moving above static", sim[BF_SIM_MOVING_BUSY].sched_prio > sim[BF_SIM_STATIC_BUSY].sched_prio
+		&& sim[BF_SIM_MOVING_BUSY].sound_period < sim[BF_SIM_STATIC_BUSY].sound_period, &fail_cnt);
+	rtw_selftest_chk(sel, "busy above light", sim[BF_SIM_MOVING_BUSY].sched_prio > sim[BF_SIM_MOVING_LIGHT].sched_prio
+		&& sim[BF_SIM_MOVING_BUSY].sound_period < sim[BF_SIM_MOVING_LIGHT].sound_period, &fail_cnt);
+	rtw_selftest_chk(sel, "sounding follows prio", _bf_sched_sim_ordered(sim, res->sound_cnt), &fail_cnt);
+	rtw_selftest_chk(sel, "top_n respected", res->max_picked <= BF_SCHED_TOP_N_DEF, &fail_cnt);
+
+	/* one slot for three busy BFees, the rest must be deferred */
+	_bf_sched_sim_run(info, rounds, 1, res);
+	rtw_selftest_chk(sel, "top_n 1 defers", res->max_picked == 1 && res->defer_cnt > 0
+		&& res->sound_cnt[BF_SIM_STATIC_IDLE] == 0, &fail_cnt);
+	rtw_selftest_chk(sel, "top_n 1 follows prio", _bf_sched_sim_ordered(sim, res->sound_cnt), &fail_cnt);
+
+	rtw_selftest_result(sel, fail_cnt);
+
+exit:
+	if (res)
+		rtw_mfree(res, sizeof(*res));
+	if (info)
+		rtw_mfree(info, sizeof(*info));
+}
+
 #else /* !RTW_BEAMFORMING_VERSION_2 */
 
 #if (BEAMFORMING_SUPPORT == 0) /*for diver defined beamforming*/
@@ -2490,8 +2490,9 @@ u8 traffic_status_watchdog(_adapter *padapter, u8 from_timer)
 
 #ifdef CONFIG_TDLS
 #ifdef CONFIG_TDLS_AUTOSETUP
-		/* TDLS_WATCHDOG_PERIOD * 2sec, periodically send */
-		if (hal_chk_wl_func(padapter, WL_FUNC_TDLS) == _TRUE) {
+		/* TDLS_WATCHDOG_PERIOD * 2sec, periodically send, traffic driven manager replaces it when on */
+		if (hal_chk_wl_func(padapter, WL_FUNC_TDLS) == _TRUE
+			&& ptdlsinfo->auto_ctl.enable == _FALSE) {
 			if ((ptdlsinfo->watchdog_count % TDLS_WATCHDOG_PERIOD) == 0) {
 				_rtw_memcpy(txmgmt.peer, baddr, ETH_ALEN);
 				issue_tdls_dis_req(padapter, &txmgmt);
@@ -2499,6 +2500,7 @@ u8 traffic_status_watchdog(_adapter *padapter, u8 from_timer)
 			ptdlsinfo->watchdog_count++;
 		}
 #endif /* CONFIG_TDLS_AUTOSETUP */
+		rtw_tdls_auto_watchdog(padapter);
 #endif /* CONFIG_TDLS */
 
 #ifdef CONFIG_LPS
@@ -2699,6 +2701,10 @@ void rtw_iface_dynamic_chk_wk_hdl(_adapter *padapter)
 	linked_status_chk(padapter, 0);
 	traffic_status_watchdog(padapter, 0);
 
+	#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+	rtw_lstats_fold(padapter);
+	#endif
+
 	/* for debug purpose */
 	_linked_info_dump(padapter);
 
@@ -3516,7 +3522,7 @@ u8 rtw_dfs_master_hdl(_adapter *adapter)
 	}
 
 	if (!rfctl->dbg_dfs_master_fake_radar_detect_cnt
-		&& rtw_odm_radar_detect(adapter) != _TRUE)
+		&& rtw_radar_evt_poll(adapter) != _TRUE)
 		goto cac_status_chk;
 
 	if (!rfctl->dbg_dfs_master_fake_radar_detect_cnt
@@ -621,6 +621,19 @@ void dump_sec_cam_cache(void *sel, _adapter *adapter)
 
 }
 
+/* one line of a self test report, @fail_cnt is increased on failure */
+void rtw_selftest_chk(void *sel, const char *name, u8 ok, u32 *fail_cnt)
+{
+	RTW_PRINT_SEL(sel, "%-28s %s\n", name, ok ? "PASS" : "FAIL");
+	if (!ok)
+		(*fail_cnt)++;
+}
+
+void rtw_selftest_result(void *sel, u32 fail_cnt)
+{
+	RTW_PRINT_SEL(sel, "%s\n", fail_cnt ? "FAIL" : "PASS");
+}
+
 #ifdef CONFIG_PROC_DEBUG
 ssize_t proc_set_write_reg(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
 {
@@ -1029,6 +1042,61 @@ ssize_t proc_set_roam_tgt_addr(struct file *file, const char __user *buffer, siz
 
 	return count;
 }
+
+int proc_get_roam_pred(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	rtw_roam_pred_dump(m, adapter);
+
+	return 0;
+}
+
+ssize_t proc_set_roam_pred(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	char tmp[256] = {0};
+	u8 rssi[64];
+	u8 num = 0;
+	u32 val;
+	char *p;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp) - 1) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		/* lead <ms> (0: off), replay <rssi> <rssi> ... or test */
+		if (sscanf(tmp, "lead %u", &val) == 1) {
+			adapter->mlmepriv.roam_pred.lead_ms = val;
+			RTW_INFO("roam_pred lead_ms = %u\n", val);
+		} else if (strncmp(tmp, "replay", 6) == 0) {
+			p = tmp + 6;
+			while (num < ARRAY_SIZE(rssi)) {
+				while (*p == ' ' || *p == ',')
+					p++;
+				if (sscanf(p, "%u", &val) != 1)
+					break;
+				rssi[num++] = (u8)rtw_min(val, 100);
+				while (*p >= '0' && *p <= '9')
+					p++;
+			}
+			rtw_roam_pred_replay(RTW_DBGDUMP, adapter, rssi, num);
+		} else if (strncmp(tmp, "test", 4) == 0)
+			rtw_roam_pred_test(RTW_DBGDUMP);
+		else
+			RTW_INFO("invalid roam_pred parameter!\n");
+	}
+
+	return count;
+}
 #endif /* CONFIG_LAYER2_ROAMING */
 
 #ifdef CONFIG_RTW_80211R
@@ -1758,6 +1826,47 @@ ssize_t proc_set_bmc_tx_rate(struct file *file, const char __user *buffer, size_
 }
 #endif /*CONFIG_AP_MODE*/
 
+#if defined(CONFIG_AP_MODE) && defined(CONFIG_NATIVEAP_MLME)
+int proc_get_probersp(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	rtw_probersp_dump(m, adapter);
+
+	return 0;
+}
+
+ssize_t proc_set_probersp(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32] = {0};
+	u32 val;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp) - 1) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		/* dedup <ms> (0: off) or bench <num> */
+		if (sscanf(tmp, "dedup %u", &val) == 1) {
+			adapter->mlmepriv.probersp.dedup_ms = val;
+			RTW_INFO("probersp dedup_ms = %u\n", val);
+		} else if (sscanf(tmp, "bench %u", &val) == 1)
+			rtw_probersp_bench(RTW_DBGDUMP, adapter, rtw_min(val, 100000));
+		else
+			RTW_INFO("invalid probersp parameter!\n");
+	}
+
+	return count;
+}
+#endif /* defined(CONFIG_AP_MODE) && defined(CONFIG_NATIVEAP_MLME) */
+
 
 int proc_get_tx_power_offset(struct seq_file *m, void *v)
 {
@@ -3358,6 +3467,47 @@ ssize_t proc_set_txbf_cap(struct file *file, const char __user *buffer, size_t c
 
 	return count;
 }
+
+#ifdef RTW_BEAMFORMING_VERSION_2
+int proc_get_bf_sched(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+
+	rtw_bf_dump_sched(m, padapter);
+
+	return 0;
+}
+
+ssize_t proc_set_bf_sched(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32];
+	u32 val;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		/* top_n <n> (0: no limit) or sim <rounds> */
+		if (sscanf(tmp, "top_n %u", &val) == 1) {
+			rtw_bf_set_sched_top_n(padapter, (u8)rtw_min(val, 0xFF));
+			RTW_INFO("bf sched top_n = %u\n", val);
+		} else if (sscanf(tmp, "sim %u", &val) == 1)
+			rtw_bf_sched_sim(RTW_DBGDUMP, rtw_min(val, 1000));
+		else
+			RTW_INFO("invalid bf_sched parameter!\n");
+	}
+
+	return count;
+}
+#endif /* RTW_BEAMFORMING_VERSION_2 */
 #endif
 #endif /* CONFIG_80211N_HT */
 
@@ -3519,6 +3669,7 @@ int proc_get_rtkm_info(struct seq_file *m, void *v)
 	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
 	struct recv_priv	*precvpriv = &padapter->recvpriv;
 	struct recv_buf *precvbuf;
+	struct rtkm_stats stats;
 
 	precvbuf = (struct recv_buf *)precvpriv->precv_buf;
 
@@ -3526,14 +3677,97 @@ int proc_get_rtkm_info(struct seq_file *m, void *v)
 	RTW_PRINT_SEL(m, "MAX_RTKM_NR_PREALLOC_RECV_SKB: %d\n", rtw_rtkm_get_nr_recv_skb());
 	RTW_PRINT_SEL(m, "MAX_RTKM_RECVBUF_SZ: %d\n", rtw_rtkm_get_buff_size());
 
+	rtw_rtkm_get_stats(&stats);
+	RTW_PRINT_SEL(m, "============[Pool Info]============\n");
+	RTW_PRINT_SEL(m, "target:%u max:%u total:%u free:%u lent:%u in_use_max:%u\n"
+		, stats.target, stats.max, stats.total, stats.free, stats.lent, stats.in_use_max);
+	RTW_PRINT_SEL(m, "alloc:%u alloc_fail:%u pcpu_hit:%u\n"
+		, stats.alloc_cnt, stats.alloc_fail_cnt, stats.pcpu_hit_cnt);
+	RTW_PRINT_SEL(m, "free:%u free_reject:%u adopt:%u\n"
+		, stats.free_cnt, stats.free_reject_cnt, stats.adopt_cnt);
+	RTW_PRINT_SEL(m, "refill:%u refill_skb:%u refill_fail:%u\n"
+		, stats.refill_cnt, stats.refill_skb_cnt, stats.refill_fail_cnt);
+	RTW_PRINT_SEL(m, "shrink:%u shrink_skb:%u\n"
+		, stats.shrink_cnt, stats.shrink_skb_cnt);
+
 	RTW_PRINT_SEL(m, "============[Driver Info]============\n");
 	RTW_PRINT_SEL(m, "NR_PREALLOC_RECV_SKB: %d\n", NR_PREALLOC_RECV_SKB);
 	RTW_PRINT_SEL(m, "MAX_RECVBUF_SZ: %d\n", precvbuf->alloc_sz);
 
 	return 0;
 }
+
+ssize_t proc_set_rtkm_info(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	char tmp[32];
+	u32 round, burst, fail;
+	int ret;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		/* stress <round> <burst> */
+		int num = sscanf(tmp, "stress %u %u", &round, &burst);
+
+		if (num != 2) {
+			RTW_INFO("invalid rtkm_info parameter!\n");
+			return count;
+		}
+
+		ret = rtw_rtkm_stress(round, burst, &fail);
+		RTW_INFO("rtkm stress round:%u burst:%u alloc_fail:%u %s\n"
+			, round, burst, fail, ret == _SUCCESS ? "PASS" : "FAIL");
+	}
+
+	return count;
+}
 #endif /* CONFIG_PREALLOC_RX_SKB_BUFFER */
 
+#ifdef CONFIG_RTW_80211K
+int proc_get_rm_bcn_cache(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+
+	rm_dump_bcn_cache(m, padapter);
+
+	return 0;
+}
+
+ssize_t proc_set_rm_bcn_cache(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32];
+	u32 ms;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		/* <fresh_ms> (0: always scan) */
+		if (sscanf(tmp, "%u", &ms) == 1) {
+			rm_set_bcn_cache_fresh_ms(padapter, ms);
+			RTW_INFO("rm bcn cache fresh_ms = %u\n", padapter->rmpriv.bcn_cache_fresh_ms);
+		} else
+			RTW_INFO("invalid rm_bcn_cache parameter!\n");
+	}
+
+	return count;
+}
+#endif /* CONFIG_RTW_80211K */
+
 #ifdef DBG_MEMORY_LEAK
 #include <asm/atomic.h>
 extern atomic_t _malloc_cnt;;
@@ -3823,7 +4057,7 @@ ssize_t proc_set_sreset(struct file *file, const char __user *buffer, size_t cou
 		int num = sscanf(tmp, "%d", &trigger_point);
 
 		if (trigger_point == SRESET_TGP_NULL)
-			rtw_hal_sreset_reset(padapter);
+			sreset_inject_fault(padapter, SRESET_TIER_FULL, 0);
 		else if (trigger_point == SRESET_TGP_INFO)
 			psrtpriv->dbg_sreset_ctrl = _TRUE;
 		else
@@ -3833,6 +4067,48 @@ ssize_t proc_set_sreset(struct file *file, const char __user *buffer, size_t cou
 	return count;
 
 }
+
+int proc_get_sreset_tier(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+
+	sreset_dump_tier_stat(m, padapter);
+
+	return 0;
+}
+
+/*
+ * echo "<tier> [fail_tier_bitmap]" > sreset_tier
+ * tier: 0:light, 1:medium, 2:full, 3:auto
+ */
+ssize_t proc_set_sreset_tier(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32];
+	u8 tier = SRESET_TIER_NUM, fail_tier = 0;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		int num = sscanf(tmp, "%hhu %hhx", &tier, &fail_tier);
+
+		if (num < 1)
+			return count;
+
+		sreset_inject_fault(padapter, tier, fail_tier);
+	}
+
+	return count;
+}
 #endif /* DBG_CONFIG_ERROR_DETECT */
 
 #ifdef CONFIG_PCI_HCI
@@ -4614,6 +4890,77 @@ ssize_t proc_set_tdls_enable(struct file *file, const char __user *buffer, size_
 	return count;
 }
 
+int proc_get_tdls_auto(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+
+	rtw_tdls_auto_dump(m, padapter);
+
+	return 0;
+}
+
+int proc_get_tdls_auto_test(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+
+	rtw_tdls_auto_test(m, padapter);
+
+	return 0;
+}
+
+ssize_t proc_set_tdls_auto(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+	struct tdls_auto_ctl *actl = &padapter->tdlsinfo.auto_ctl;
+	char tmp[64] = {0};
+	u32 enable, setup_kbps, setup_period, teardown_kbps, teardown_period, rssi_margin, backoff_period;
+	int num;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp) - 1) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (!buffer || copy_from_user(tmp, buffer, count))
+		goto exit;
+
+	num = sscanf(tmp, "%u %u %u %u %u %u %u", &enable, &setup_kbps, &setup_period
+		, &teardown_kbps, &teardown_period, &rssi_margin, &backoff_period);
+
+	/* periods are counts of watchdog runs, at least one */
+	if ((num >= 3 && setup_period == 0)
+		|| (num >= 5 && teardown_period == 0)
+		|| (num >= 7 && backoff_period == 0)
+	) {
+		RTW_WARN(FUNC_ADPT_FMT" period can't be 0\n", FUNC_ADPT_ARG(padapter));
+		return -EINVAL;
+	}
+
+	if (num >= 1)
+		actl->enable = enable ? _TRUE : _FALSE;
+	if (num >= 2)
+		actl->setup_kbps = setup_kbps;
+	if (num >= 3)
+		actl->setup_period = rtw_min(setup_period, 0xFF);
+	if (num >= 4)
+		actl->teardown_kbps = teardown_kbps;
+	if (num >= 5)
+		actl->teardown_period = rtw_min(teardown_period, 0xFF);
+	if (num >= 6)
+		actl->rssi_margin = rtw_min(rssi_margin, 100);
+	if (num >= 7)
+		actl->backoff_period = rtw_min(backoff_period, 0xFF);
+
+exit:
+	return count;
+}
+
 static int proc_tdls_display_tdls_function_info(struct seq_file *m)
 {
 	struct net_device *dev = m->private;
@@ -24,6 +24,139 @@ MODULE_VERSION("DRIVERVERSION");
 struct sk_buff_head rtk_skb_mem_q;
 struct u8 *rtk_buf_mem[NR_RECVBUFF];
 
+/*
+ * The pool starts with rtkm_nr_skb buffers and grows toward rtkm_max_nr_skb
+ * when driver finds it empty. Refill is done from workqueue with GFP_KERNEL
+ * once free count drops under low watermark, and surplus over the observed
+ * high-water occupancy is given back through shrinker after idle period.
+ * A small per-CPU cache in front of the shared queue serves free/alloc
+ * pairs of the same RX tasklet without touching the queue lock.
+ *
+ * total counts skb held by pool plus lent ones. Any big enough skb freed
+ * back while nothing is lent was not from pool, it is adopted and counted
+ * in total, or refused when pool is already at target.
+ */
+static int rtkm_nr_skb = MAX_RTKM_NR_PREALLOC_RECV_SKB;
+module_param(rtkm_nr_skb, int, 0444);
+MODULE_PARM_DESC(rtkm_nr_skb, "Initial and minimum number of preallocated RX skb");
+
+static int rtkm_max_nr_skb = MAX_RTKM_NR_PREALLOC_RECV_SKB_MAX;
+module_param(rtkm_max_nr_skb, int, 0444);
+MODULE_PARM_DESC(rtkm_max_nr_skb, "Maximum number of preallocated RX skb");
+
+#define RTKM_GROW_STEP		4
+#define RTKM_IDLE_MS		30000
+#define RTKM_PCPU_CACHE_NR	2
+
+struct rtkm_pcpu_cache {
+	u8 cnt;
+	struct sk_buff *skb[RTKM_PCPU_CACHE_NR];
+};
+
+/* updated from RX tasklets on several CPUs, workqueue and shrinker */
+struct rtkm_pool_cnt {
+	atomic_t alloc;
+	atomic_t alloc_fail;
+	atomic_t pcpu_hit;
+	atomic_t free;
+	atomic_t free_reject;
+	atomic_t adopt;
+	atomic_t refill;
+	atomic_t refill_skb;
+	atomic_t refill_fail;
+	atomic_t shrink;
+	atomic_t shrink_skb;
+};
+
+struct rtkm_pool {
+	spinlock_t lock;	/* protects target, pool_low and last_empty_time */
+	u32 target;		/* number of skb pool tries to hold */
+	u32 pool_low;		/* lowest free count since last shrink */
+	unsigned long last_empty_time;	/* jiffies */
+	atomic_t total;		/* skb owned by pool, free or lent to driver */
+	atomic_t lent;		/* skb handed out and not freed back yet */
+
+	struct rtkm_pcpu_cache __percpu *pcpu;
+	_workitem refill_work;
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 12, 0))
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(6, 7, 0))
+	struct shrinker *shrinker;
+#else
+	struct shrinker shrinker;
+#endif
+	u8 shrinker_registered;
+#endif
+
+	struct rtkm_pool_cnt cnt;
+};
+
+static struct rtkm_pool rtkm_pool;
+
+static u32 rtkm_free_cnt(void)
+{
+	return skb_queue_len(&rtk_skb_mem_q);
+}
+
+static struct sk_buff *rtkm_skb_alloc(gfp_t gfp)
+{
+	struct sk_buff *pskb;
+	SIZE_PTR tmpaddr = 0;
+	SIZE_PTR alignment = 0;
+
+	pskb = __dev_alloc_skb(MAX_RTKM_RECVBUF_SZ + RECVBUFF_ALIGN_SZ, gfp);
+	if (pskb) {
+		tmpaddr = (SIZE_PTR)pskb->data;
+		alignment = tmpaddr & (RECVBUFF_ALIGN_SZ - 1);
+		skb_reserve(pskb, (RECVBUFF_ALIGN_SZ - alignment));
+	}
+
+	return pskb;
+}
+
+static void rtkm_refill_work_hdl(_workitem *work)
+{
+	struct rtkm_pool *pool = &rtkm_pool;
+	struct sk_buff *pskb;
+
+	atomic_inc(&pool->cnt.refill);
+
+	while (atomic_read(&pool->total) < pool->target) {
+		pskb = rtkm_skb_alloc(GFP_KERNEL);
+		if (!pskb) {
+			atomic_inc(&pool->cnt.refill_fail);
+			break;
+		}
+
+		skb_queue_tail(&rtk_skb_mem_q, pskb);
+		atomic_inc(&pool->total);
+		atomic_inc(&pool->cnt.refill_skb);
+	}
+}
+
+static void rtkm_check_watermark(u8 empty)
+{
+	struct rtkm_pool *pool = &rtkm_pool;
+	_irqL irqL;
+	u32 free_cnt = rtkm_free_cnt();
+	u8 refill = _FALSE;
+
+	_enter_critical(&pool->lock, &irqL);
+	if (free_cnt < pool->pool_low)
+		pool->pool_low = free_cnt;
+
+	if (empty) {
+		pool->last_empty_time = jiffies;
+		if (pool->target < rtkm_max_nr_skb)
+			pool->target = rtw_min(pool->target + RTKM_GROW_STEP, (u32)rtkm_max_nr_skb);
+		refill = _TRUE;
+	} else if (free_cnt <= pool->target / 4)
+		refill = _TRUE;
+	_exit_critical(&pool->lock, &irqL);
+
+	if (refill == _TRUE && atomic_read(&pool->total) < pool->target)
+		_set_workitem(&pool->refill_work);
+}
+
 struct u8	*rtw_get_buf_premem(int index)
 {
 	printk("%s, rtk_buf_mem index : %d\n", __func__, index);
@@ -38,13 +171,16 @@ EXPORT_SYMBOL(rtw_rtkm_get_buff_size);
 
 u8 rtw_rtkm_get_nr_recv_skb(void)
 {
-	return MAX_RTKM_NR_PREALLOC_RECV_SKB;
+	return rtkm_pool.target;
 }
 EXPORT_SYMBOL(rtw_rtkm_get_nr_recv_skb);
 
 struct sk_buff *rtw_alloc_skb_premem(u16 in_size)
 {
+	struct rtkm_pool *pool = &rtkm_pool;
+	struct rtkm_pcpu_cache *cache;
 	struct sk_buff *skb = NULL;
+	unsigned long flags;
 
 	if (in_size > MAX_RTKM_RECVBUF_SZ) {
 		pr_info("warning %s: driver buffer size(%d) > rtkm buffer size(%d)\n", __func__, in_size, MAX_RTKM_RECVBUF_SZ);
@@ -52,39 +188,314 @@ struct sk_buff *rtw_alloc_skb_premem(u16 in_size)
 		return skb;
 	}
 
-	skb = skb_dequeue(&rtk_skb_mem_q);
+	local_irq_save(flags);
+	cache = this_cpu_ptr(pool->pcpu);
+	if (cache->cnt)
+		skb = cache->skb[--cache->cnt];
+	local_irq_restore(flags);
 
-	printk("%s, rtk_skb_mem_q len : %d\n", __func__, skb_queue_len(&rtk_skb_mem_q));
+	if (skb) {
+		atomic_inc(&pool->cnt.pcpu_hit);
+		goto exit;
+	}
 
+	skb = skb_dequeue(&rtk_skb_mem_q);
+	if (!skb)
+		atomic_inc(&pool->cnt.alloc_fail);
+	rtkm_check_watermark(skb ? _FALSE : _TRUE);
+
+exit:
+	if (skb) {
+		atomic_inc(&pool->lent);
+		atomic_inc(&pool->cnt.alloc);
+	}
 	return skb;
 }
 EXPORT_SYMBOL(rtw_alloc_skb_premem);
 
 int rtw_free_skb_premem(struct sk_buff *pskb)
 {
+	struct rtkm_pool *pool = &rtkm_pool;
+	struct rtkm_pcpu_cache *cache;
+	unsigned long flags;
+	u8 cached = _FALSE;
+
 	if (!pskb)
 		return -1;
 
-	if (skb_queue_len(&rtk_skb_mem_q) >= MAX_RTKM_NR_PREALLOC_RECV_SKB)
+	/* only buffers fitting the pool size can be reused for RX, never a lent one */
+	if (skb_end_offset(pskb) < MAX_RTKM_RECVBUF_SZ) {
+		atomic_inc(&pool->cnt.free_reject);
 		return -1;
+	}
 
-	skb_queue_tail(&rtk_skb_mem_q, pskb);
+	if (atomic_dec_if_positive(&pool->lent) < 0) {
+		/* nothing lent, skb is not from pool */
+		if (atomic_read(&pool->total) >= pool->target
+			|| skb_queue_len(&rtk_skb_mem_q) >= rtkm_max_nr_skb) {
+			atomic_inc(&pool->cnt.free_reject);
+			return -1;
+		}
+		atomic_inc(&pool->total);
+		atomic_inc(&pool->cnt.adopt);
+	} else if (atomic_read(&pool->total) > pool->target
+		|| skb_queue_len(&rtk_skb_mem_q) >= rtkm_max_nr_skb) {
+		/* pool has shrunk since this skb was lent */
+		atomic_dec(&pool->total);
+		atomic_inc(&pool->cnt.free_reject);
+		return -1;
+	}
 
-	printk("%s, rtk_skb_mem_q len : %d\n", __func__, skb_queue_len(&rtk_skb_mem_q));
+	local_irq_save(flags);
+	cache = this_cpu_ptr(pool->pcpu);
+	if (cache->cnt < RTKM_PCPU_CACHE_NR) {
+		cache->skb[cache->cnt++] = pskb;
+		cached = _TRUE;
+	}
+	local_irq_restore(flags);
+
+	if (cached == _FALSE)
+		skb_queue_tail(&rtk_skb_mem_q, pskb);
+
+	atomic_inc(&pool->cnt.free);
 
 	return 0;
 }
 EXPORT_SYMBOL(rtw_free_skb_premem);
 
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 12, 0))
+static u32 rtkm_shrink_surplus(void)
+{
+	struct rtkm_pool *pool = &rtkm_pool;
+	_irqL irqL;
+	u32 keep, free_cnt = rtkm_free_cnt();
+	u32 surplus = 0;
+
+	_enter_critical(&pool->lock, &irqL);
+	if (jiffies_to_msecs(jiffies - pool->last_empty_time) >= RTKM_IDLE_MS) {
+		/* keep what was in use at peak, but never under initial size */
+		keep = pool->target - rtw_min(pool->pool_low, pool->target);
+		keep = max_t(u32, keep, rtkm_nr_skb);
+		if (atomic_read(&pool->total) > keep)
+			surplus = rtw_min((u32)atomic_read(&pool->total) - keep, free_cnt);
+	}
+	_exit_critical(&pool->lock, &irqL);
+
+	return surplus;
+}
+
+static unsigned long rtkm_shrink_count(struct shrinker *shrink, struct shrink_control *sc)
+{
+	return rtkm_shrink_surplus();
+}
+
+static unsigned long rtkm_shrink_scan(struct shrinker *shrink, struct shrink_control *sc)
+{
+	struct rtkm_pool *pool = &rtkm_pool;
+	struct sk_buff *pskb;
+	_irqL irqL;
+	unsigned long freed = 0;
+	u32 surplus = rtkm_shrink_surplus();
+
+	while (freed < sc->nr_to_scan && freed < surplus) {
+		pskb = skb_dequeue(&rtk_skb_mem_q);
+		if (!pskb)
+			break;
+		dev_kfree_skb_any(pskb);
+		atomic_dec(&pool->total);
+		freed++;
+	}
+
+	if (freed) {
+		_enter_critical(&pool->lock, &irqL);
+		pool->target = max_t(u32, atomic_read(&pool->total), rtkm_nr_skb);
+		pool->pool_low = rtkm_free_cnt();
+		_exit_critical(&pool->lock, &irqL);
+		atomic_inc(&pool->cnt.shrink);
+		atomic_add(freed, &pool->cnt.shrink_skb);
+	}
+
+	return freed ? freed : SHRINK_STOP;
+}
+
+static int rtkm_shrinker_register(struct rtkm_pool *pool)
+{
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(6, 7, 0))
+	pool->shrinker = shrinker_alloc(0, "rtkm");
+	if (!pool->shrinker)
+		return -ENOMEM;
+	pool->shrinker->count_objects = rtkm_shrink_count;
+	pool->shrinker->scan_objects = rtkm_shrink_scan;
+	pool->shrinker->seeks = DEFAULT_SEEKS;
+	shrinker_register(pool->shrinker);
+#else
+	int ret;
+
+	pool->shrinker.count_objects = rtkm_shrink_count;
+	pool->shrinker.scan_objects = rtkm_shrink_scan;
+	pool->shrinker.seeks = DEFAULT_SEEKS;
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(6, 0, 0))
+	ret = register_shrinker(&pool->shrinker, "rtkm");
+#else
+	ret = register_shrinker(&pool->shrinker);
+#endif
+	if (ret)
+		return ret;
+#endif
+	pool->shrinker_registered = _TRUE;
+	return 0;
+}
+
+static void rtkm_shrinker_unregister(struct rtkm_pool *pool)
+{
+	if (pool->shrinker_registered == _FALSE)
+		return;
+
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(6, 7, 0))
+	shrinker_free(pool->shrinker);
+#else
+	unregister_shrinker(&pool->shrinker);
+#endif
+	pool->shrinker_registered = _FALSE;
+}
+#endif /* LINUX_VERSION_CODE >= 3.12 */
+
+void rtw_rtkm_get_stats(struct rtkm_stats *stats)
+{
+	struct rtkm_pool *pool = &rtkm_pool;
+	struct rtkm_pcpu_cache *cache;
+	int cpu;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->alloc_cnt = atomic_read(&pool->cnt.alloc);
+	stats->alloc_fail_cnt = atomic_read(&pool->cnt.alloc_fail);
+	stats->pcpu_hit_cnt = atomic_read(&pool->cnt.pcpu_hit);
+	stats->free_cnt = atomic_read(&pool->cnt.free);
+	stats->free_reject_cnt = atomic_read(&pool->cnt.free_reject);
+	stats->adopt_cnt = atomic_read(&pool->cnt.adopt);
+	stats->refill_cnt = atomic_read(&pool->cnt.refill);
+	stats->refill_skb_cnt = atomic_read(&pool->cnt.refill_skb);
+	stats->refill_fail_cnt = atomic_read(&pool->cnt.refill_fail);
+	stats->shrink_cnt = atomic_read(&pool->cnt.shrink);
+	stats->shrink_skb_cnt = atomic_read(&pool->cnt.shrink_skb);
+
+	stats->target = pool->target;
+	stats->max = rtkm_max_nr_skb;
+	stats->total = atomic_read(&pool->total);
+	stats->lent = atomic_read(&pool->lent);
+	stats->free = rtkm_free_cnt();
+	for_each_possible_cpu(cpu) {
+		cache = per_cpu_ptr(pool->pcpu, cpu);
+		stats->free += cache->cnt;
+	}
+	stats->in_use_max = pool->target - rtw_min(pool->pool_low, pool->target);
+}
+EXPORT_SYMBOL(rtw_rtkm_get_stats);
+
+/*
+ * Stress pool with RX like bursts: take up to burst skb as RX path does
+ * under load, return them, and drive shrinker scan between bursts as
+ * memory pressure would. Alloc failures are returned in alloc_fail.
+ * Returns _SUCCESS if pool bookkeeping is consistent afterwards: every skb
+ * taken was freed back, total stays within [rtkm_nr_skb, rtkm_max_nr_skb]
+ * unless refill failed, and the last round, run after pool has grown,
+ * gets all skb it asks for.
+ */
+int rtw_rtkm_stress(u32 round, u32 burst, u32 *alloc_fail)
+{
+	struct rtkm_pool *pool = &rtkm_pool;
+	struct sk_buff **skbs;
+	u32 refill_fail = atomic_read(&pool->cnt.refill_fail);
+	u32 fail = 0, last_fail = 0, lost = 0;
+	u32 r, i, got, total;
+	int ret = _SUCCESS;
+
+	*alloc_fail = 0;
+	burst = rtw_min(burst, (u32)rtkm_max_nr_skb);
+	skbs = kcalloc(burst, sizeof(struct sk_buff *), GFP_KERNEL);
+	if (!skbs)
+		return _FAIL;
+
+	for (r = 0; r < round; r++) {
+		got = 0;
+		for (i = 0; i < burst; i++) {
+			skbs[got] = rtw_alloc_skb_premem(MAX_RTKM_RECVBUF_SZ);
+			if (skbs[got])
+				got++;
+			else
+				fail++;
+		}
+		if (r == round - 1)
+			last_fail = burst - got;
+
+		for (i = 0; i < got; i++) {
+			if (rtw_free_skb_premem(skbs[i]) != 0) {
+				dev_kfree_skb_any(skbs[i]);
+				lost++;
+			}
+		}
+
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 12, 0))
+		if (r & 1) {
+			struct shrink_control sc = {
+				.gfp_mask = GFP_KERNEL,
+				.nr_to_scan = burst,
+			};
+
+			rtkm_shrink_scan(NULL, &sc);
+		}
+#endif
+		/* let refill work run as it would between RX bursts */
+		flush_work(&pool->refill_work);
+		cond_resched();
+	}
+
+	kfree(skbs);
+	*alloc_fail = fail;
+
+	total = atomic_read(&pool->total);
+	if (total > rtkm_max_nr_skb) {
+		pr_info("rtkm stress: total:%u over max:%d\n", total, rtkm_max_nr_skb);
+		ret = _FAIL;
+	}
+	if (total < rtkm_nr_skb && atomic_read(&pool->cnt.refill_fail) == refill_fail) {
+		pr_info("rtkm stress: total:%u under initial:%d without refill failure\n", total, rtkm_nr_skb);
+		ret = _FAIL;
+	}
+	/* rejected frees are only expected when a shrink scan ran in between */
+	if (lost && round < 2) {
+		pr_info("rtkm stress: %u skb rejected on free without shrink\n", lost);
+		ret = _FAIL;
+	}
+	if (round > 1 && burst <= pool->target && last_fail
+		&& atomic_read(&pool->cnt.refill_fail) == refill_fail) {
+		pr_info("rtkm stress: last round alloc_fail:%u with target:%u\n", last_fail, pool->target);
+		ret = _FAIL;
+	}
+
+	return ret;
+}
+EXPORT_SYMBOL(rtw_rtkm_stress);
+
 static int __init rtw_mem_init(void)
 {
+	struct rtkm_pool *pool = &rtkm_pool;
 	int i;
-	SIZE_PTR tmpaddr = 0;
-	SIZE_PTR alignment = 0;
 	struct sk_buff *pskb = NULL;
 
 	printk("%s\n", __func__);
-	pr_info("MAX_RTKM_NR_PREALLOC_RECV_SKB: %d\n", MAX_RTKM_NR_PREALLOC_RECV_SKB);
+
+	if (rtkm_nr_skb < 1)
+		rtkm_nr_skb = 1;
+	/* rtw_rtkm_get_nr_recv_skb() reports target in u8 */
+	if (rtkm_nr_skb > 0xFF)
+		rtkm_nr_skb = 0xFF;
+	if (rtkm_max_nr_skb < rtkm_nr_skb)
+		rtkm_max_nr_skb = rtkm_nr_skb;
+	if (rtkm_max_nr_skb > 0xFF)
+		rtkm_max_nr_skb = 0xFF;
+
+	pr_info("rtkm_nr_skb: %d, rtkm_max_nr_skb: %d\n", rtkm_nr_skb, rtkm_max_nr_skb);
 	pr_info("MAX_RTKM_RECVBUF_SZ: %d\n", MAX_RTKM_RECVBUF_SZ);
 
 #ifdef CONFIG_USE_USB_BUFFER_ALLOC_RX
@@ -94,19 +505,34 @@ static int __init rtw_mem_init(void)
 
 	skb_queue_head_init(&rtk_skb_mem_q);
 
-	for (i = 0; i < MAX_RTKM_NR_PREALLOC_RECV_SKB; i++) {
-		pskb = __dev_alloc_skb(MAX_RTKM_RECVBUF_SZ + RECVBUFF_ALIGN_SZ, in_interrupt() ? GFP_ATOMIC : GFP_KERNEL);
-		if (pskb) {
-			tmpaddr = (SIZE_PTR)pskb->data;
-			alignment = tmpaddr & (RECVBUFF_ALIGN_SZ - 1);
-			skb_reserve(pskb, (RECVBUFF_ALIGN_SZ - alignment));
+	memset(pool, 0, sizeof(*pool));
+	spin_lock_init(&pool->lock);
+	atomic_set(&pool->total, 0);
+	atomic_set(&pool->lent, 0);
+	pool->target = rtkm_nr_skb;
+	pool->last_empty_time = jiffies;
+	_init_workitem(&pool->refill_work, rtkm_refill_work_hdl, NULL);
+
+	pool->pcpu = alloc_percpu(struct rtkm_pcpu_cache);
+	if (!pool->pcpu)
+		return -ENOMEM;
 
+	for (i = 0; i < rtkm_nr_skb; i++) {
+		pskb = rtkm_skb_alloc(in_interrupt() ? GFP_ATOMIC : GFP_KERNEL);
+		if (pskb) {
 			skb_queue_tail(&rtk_skb_mem_q, pskb);
+			atomic_inc(&pool->total);
 		} else
 			printk("%s, alloc skb memory fail!\n", __func__);
 
 		pskb = NULL;
 	}
+	pool->pool_low = rtkm_free_cnt();
+
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 12, 0))
+	if (rtkm_shrinker_register(pool))
+		printk("%s, register shrinker fail!\n", __func__);
+#endif
 
 	printk("%s, rtk_skb_mem_q len : %d\n", __func__, skb_queue_len(&rtk_skb_mem_q));
 
@@ -116,6 +542,22 @@ static int __init rtw_mem_init(void)
 
 static void __exit rtw_mem_exit(void)
 {
+	struct rtkm_pool *pool = &rtkm_pool;
+	struct rtkm_pcpu_cache *cache;
+	int cpu;
+
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 12, 0))
+	rtkm_shrinker_unregister(pool);
+#endif
+	_cancel_workitem_sync(&pool->refill_work);
+
+	for_each_possible_cpu(cpu) {
+		cache = per_cpu_ptr(pool->pcpu, cpu);
+		while (cache->cnt)
+			dev_kfree_skb_any(cache->skb[--cache->cnt]);
+	}
+	free_percpu(pool->pcpu);
+
 	if (skb_queue_len(&rtk_skb_mem_q))
 		printk("%s, rtk_skb_mem_q len : %d\n", __func__, skb_queue_len(&rtk_skb_mem_q));
 
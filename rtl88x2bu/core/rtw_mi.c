@@ -313,6 +313,8 @@ inline void rtw_mi_status_merge(struct mi_state *d, struct mi_state *a)
 
 void dump_mi_status(void *sel, struct dvobj_priv *dvobj)
 {
+	_adapter *primary = dvobj_get_primary_adapter(dvobj);
+
 	RTW_PRINT_SEL(sel, "== dvobj-iface_state ==\n");
 	RTW_PRINT_SEL(sel, "sta_num:%d\n", DEV_STA_NUM(dvobj));
 	RTW_PRINT_SEL(sel, "linking_sta_num:%d\n", DEV_STA_LG_NUM(dvobj));
@@ -342,6 +344,12 @@ void dump_mi_status(void *sel, struct dvobj_priv *dvobj)
 	#endif
 	RTW_PRINT_SEL(sel, "mgmt_tx_num:%d\n", DEV_MGMT_TX_NUM(dvobj));
 #endif
+	RTW_PRINT_SEL(sel, "ifbmp linked:0x%02x linking:0x%02x survey:0x%02x ap:0x%02x wps:0x%02x\n"
+		, rtw_mi_get_fwstate_ifbmp(primary, _FW_LINKED)
+		, rtw_mi_get_fwstate_ifbmp(primary, _FW_UNDER_LINKING)
+		, rtw_mi_get_fwstate_ifbmp(primary, _FW_UNDER_SURVEY)
+		, rtw_mi_get_fwstate_ifbmp(primary, WIFI_AP_STATE)
+		, rtw_mi_get_fwstate_ifbmp(primary, WIFI_UNDER_WPS));
 	RTW_PRINT_SEL(sel, "union_ch:%d\n", DEV_U_CH(dvobj));
 	RTW_PRINT_SEL(sel, "union_bw:%d\n", DEV_U_BW(dvobj));
 	RTW_PRINT_SEL(sel, "union_offset:%d\n", DEV_U_OFFSET(dvobj));
@@ -354,6 +362,30 @@ void dump_dvobj_mi_status(void *sel, const char *fun_name, _adapter *adapter)
 	dump_mi_status(sel, adapter_to_dvobj(adapter));
 }
 
+/*
+* sync this iface's bit of fwstate_ifbmp with its fw_state
+* caller holds only this iface's pmlmepriv->lock, other ifaces update their own
+* bits concurrently, so only touch own bit and with atomic bitops
+*/
+static void _rtw_mi_update_fwstate_ifbmp(_adapter *adapter)
+{
+	struct dvobj_priv *dvobj = adapter_to_dvobj(adapter);
+	u32 fw_state = (u32)get_fwstate(&adapter->mlmepriv);
+	unsigned long mask = BIT(adapter->iface_id);
+	int b;
+
+	for (b = 0; b < MI_FWSTATE_BIT_NUM; b++) {
+		/* own bit is only written here, skip the atomic op when unchanged */
+		if (!(fw_state & BIT(b)) == !(dvobj->fwstate_ifbmp[b] & mask))
+			continue;
+
+		if (fw_state & BIT(b))
+			rtw_set_bit(adapter->iface_id, &dvobj->fwstate_ifbmp[b]);
+		else
+			rtw_clear_bit(adapter->iface_id, &dvobj->fwstate_ifbmp[b]);
+	}
+}
+
 inline void rtw_mi_update_iface_status(struct mlme_priv *pmlmepriv, sint state)
 {
 	_adapter *adapter = container_of(pmlmepriv, _adapter, mlmepriv);
@@ -364,6 +396,8 @@ inline void rtw_mi_update_iface_status(struct mlme_priv *pmlmepriv, sint state)
 	u8 u_ch, u_offset, u_bw;
 	_adapter *iface;
 
+	_rtw_mi_update_fwstate_ifbmp(adapter);
+
 	if (state == WIFI_MONITOR_STATE
 		|| state == 0xFFFFFFFF
 	)
@@ -963,17 +997,82 @@ static u8 _rtw_mi_check_fwstate(_adapter *padapter, void *data)
 #endif
 	return ret;
 }
-u8 rtw_mi_check_fwstate(_adapter *padapter, sint state)
+
+/*
+* return bitmap of ifaces (bit i for padapters[i]) having any bit of @state
+* in fw_state, no adapter up check
+*/
+inline u8 rtw_mi_get_fwstate_ifbmp(_adapter *adapter, sint state)
 {
-	sint in_data = state;
+	struct dvobj_priv *dvobj = adapter_to_dvobj(adapter);
+	u32 bits = (u32)state;
+	u8 ifbmp = 0;
+	int b;
+
+	for (b = 0; bits; b++, bits >>= 1) {
+		if (bits & BIT0)
+			ifbmp |= (u8)dvobj->fwstate_ifbmp[b];
+	}
 
-	return _rtw_mi_process(padapter, _FALSE, &in_data, _rtw_mi_check_fwstate);
+	return ifbmp;
 }
-u8 rtw_mi_buddy_check_fwstate(_adapter *padapter, sint state)
+
+/* same result as _rtw_mi_process() with _rtw_mi_check_fwstate() */
+static u8 _rtw_mi_check_fwstate_by_ifbmp(_adapter *padapter, bool exclude_self, sint state)
 {
-	sint in_data = state;
+	struct dvobj_priv *dvobj = adapter_to_dvobj(padapter);
+	_adapter *iface;
+	u8 ifbmp;
+	u8 ret = 0;
+	int i;
+
+	if (state == WIFI_FW_NULL_STATE) {
+		/* not tracked by ifbmp */
+		return _rtw_mi_process(padapter, exclude_self, &state, _rtw_mi_check_fwstate);
+	}
+
+	ifbmp = rtw_mi_get_fwstate_ifbmp(padapter, state);
+	if (exclude_self)
+		ifbmp &= ~BIT(padapter->iface_id);
+
+	for (i = 0; ifbmp && i < dvobj->iface_nums; i++) {
+		if (!(ifbmp & BIT(i)))
+			continue;
+		ifbmp &= ~BIT(i);
+
+		iface = dvobj->padapters[i];
+		if (iface && rtw_is_adapter_up(iface)) {
+			#ifdef DBG_DUMP_FW_STATE
+			rtw_dbg_dump_fwstate(iface, state);
+			#endif
+			ret++;
+		}
+	}
+
+#ifdef DBG_MI_FWSTATE_IFBMP
+	{
+		u8 scan_ret = _rtw_mi_process(padapter, exclude_self, &state, _rtw_mi_check_fwstate);
+
+		if (scan_ret != ret) {
+			RTW_WARN(FUNC_ADPT_FMT" state:0x%08x exclude_self:%d ifbmp:%u scan:%u mismatch\n"
+				, FUNC_ADPT_ARG(padapter), state, exclude_self, ret, scan_ret);
+			dump_mi_status(RTW_DBGDUMP, dvobj);
+			rtw_warn_on(1);
+			ret = scan_ret;
+		}
+	}
+#endif
+
+	return ret;
+}
 
-	return _rtw_mi_process(padapter, _TRUE, &in_data, _rtw_mi_check_fwstate);
+u8 rtw_mi_check_fwstate(_adapter *padapter, sint state)
+{
+	return _rtw_mi_check_fwstate_by_ifbmp(padapter, _FALSE, state);
+}
+u8 rtw_mi_buddy_check_fwstate(_adapter *padapter, sint state)
+{
+	return _rtw_mi_check_fwstate_by_ifbmp(padapter, _TRUE, state);
 }
 
 static u8 _rtw_mi_traffic_statistics(_adapter *padapter , void *data)
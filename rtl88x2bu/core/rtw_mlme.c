@@ -128,6 +128,7 @@ sint	_rtw_init_mlme_priv(_adapter *padapter)
 	pmlmepriv->roam_scan_int_ms = RTW_ROAM_SCAN_INTERVAL_MS;
 	pmlmepriv->roam_rssi_threshold = RTW_ROAM_RSSI_THRESHOLD;
 	pmlmepriv->need_to_roam = _FALSE;
+	pmlmepriv->roam_pred.lead_ms = RTW_ROAM_PRED_LEAD_MS;
 #endif /* CONFIG_LAYER2_ROAMING */
 
 #ifdef CONFIG_RTW_80211R
@@ -169,6 +170,7 @@ void rtw_free_mlme_priv_ie_data(struct mlme_priv *pmlmepriv)
 #if defined(CONFIG_AP_MODE) && defined (CONFIG_NATIVEAP_MLME)
 	rtw_buf_free(&pmlmepriv->assoc_req, &pmlmepriv->assoc_req_len);
 	rtw_buf_free(&pmlmepriv->assoc_rsp, &pmlmepriv->assoc_rsp_len);
+	rtw_buf_free(&pmlmepriv->probersp.body, &pmlmepriv->probersp.body_len);
 	rtw_free_mlme_ie_data(&pmlmepriv->wps_beacon_ie, &pmlmepriv->wps_beacon_ie_len);
 	rtw_free_mlme_ie_data(&pmlmepriv->wps_probe_req_ie, &pmlmepriv->wps_probe_req_ie_len);
 	rtw_free_mlme_ie_data(&pmlmepriv->wps_probe_resp_ie, &pmlmepriv->wps_probe_resp_ie_len);
@@ -599,6 +601,10 @@ void rtw_free_network_nolock(_adapter *padapter, struct wlan_network *pnetwork)
 void rtw_free_network_queue(_adapter *dev, u8 isfreeall)
 {
 	_rtw_free_network_queue(dev, isfreeall);
+#ifdef CONFIG_RTW_80211K
+	if (isfreeall)
+		rm_bcn_cache_flush(dev);
+#endif
 }
 
 struct wlan_network *_rtw_find_network(_queue *scanned_queue, const u8 *addr)
@@ -1373,20 +1379,16 @@ void rtw_surveydone_event_callback(_adapter	*adapter, u8 *pbuf)
 			}
 		}
 	} else {
+#ifdef CONFIG_LAYER2_ROAMING
 		if (rtw_chk_roam_flags(adapter, RTW_ROAM_ACTIVE)) {
 			if (check_fwstate(pmlmepriv, WIFI_STATION_STATE)
 			    && check_fwstate(pmlmepriv, _FW_LINKED)) {
-				if (rtw_select_roaming_candidate(pmlmepriv) == _SUCCESS) {
-#ifdef CONFIG_RTW_80211R
-					rtw_ft_start_roam(adapter,
-						(u8 *)pmlmepriv->roam_network->network.MacAddress);
-#else
-					receive_disconnect(adapter, pmlmepriv->cur_network.network.MacAddress
-						, WLAN_REASON_ACTIVE_ROAM, _FALSE);
-#endif
-				}
+				rtw_roam_pred_rank(adapter);
+				if (rtw_select_roaming_candidate(pmlmepriv) == _SUCCESS)
+					rtw_roam_kick(adapter);
 			}
 		}
+#endif
 	}
 
 	/* RTW_INFO("scan complete in %dms\n",rtw_get_passing_time_ms(pmlmepriv->scan_start_time)); */
@@ -1601,6 +1603,9 @@ void rtw_indicate_connect(_adapter *padapter)
 		rtw_os_indicate_connect(padapter);
 	}
 
+#ifdef CONFIG_LAYER2_ROAMING
+	rtw_roam_pred_link_chg(padapter, _TRUE);
+#endif
 	rtw_set_to_roam(padapter, 0);
 #ifdef CONFIG_INTEL_WIDI
 	if (padapter->mlmepriv.widi_state == INTEL_WIDI_STATE_ROAMING) {
@@ -1669,6 +1674,9 @@ void rtw_indicate_disconnect(_adapter *padapter, u16 reason, u8 locally_generate
 	   ) {
 
 		rtw_os_indicate_disconnect(padapter, reason, locally_generated);
+#ifdef CONFIG_LAYER2_ROAMING
+		rtw_roam_pred_link_chg(padapter, _FALSE);
+#endif
 
 		/* set ips_deny_time to avoid enter IPS before LPS leave */
 		rtw_set_ips_deny(padapter, 3000);
@@ -3014,6 +3022,474 @@ exit:
 	return;
 }
 
+#ifdef CONFIG_LAYER2_ROAMING
+#define ROAM_PRED_ETA_NONE	0xFFFFFFFF
+
+static void rtw_roam_pred_feed(struct roam_pred_info *pred, u8 rssi)
+{
+	s32 val = (s32)rssi << 4;
+	s32 prev;
+
+	if (pred->samples == 0) {
+		pred->ewma = val;
+		pred->slope = 0;
+	} else {
+		prev = pred->ewma;
+		pred->ewma += (val - pred->ewma) / 4;
+		pred->slope += ((pred->ewma - prev) - pred->slope) / 2;
+	}
+
+	if (pred->samples < 0xFF)
+		pred->samples++;
+}
+
+/*
+* ms until the signal reaches @th at the current slope. The 1/4 EWMA trails
+* a ramp by 3 ticks, so project it 3 ticks ahead to estimate the signal.
+*/
+static u32 rtw_roam_pred_eta_ms(struct roam_pred_info *pred, u8 th)
+{
+	s32 th_q4 = (s32)th << 4;
+	s32 level;
+
+	if (pred->ewma <= th_q4)
+		return 0;
+
+	if (pred->samples < 3 || pred->slope >= 0)
+		return ROAM_PRED_ETA_NONE;
+
+	level = pred->ewma + 3 * pred->slope;
+	if (level <= th_q4)
+		return 0;
+
+	return (u32)((level - th_q4) / -pred->slope) * RTW_ROAM_PRED_TICK_MS;
+}
+
+#define ROAM_PRED_NO_SCAN	0xFFFFFFFF
+
+/*
+* Shared by rtw_roam_pred_tick and the replay: scan once the crossing of @th
+* is predicted within @lead_ms and the last bg scan is at least @scan_int_ms
+* old. @since_scan_ms is ROAM_PRED_NO_SCAN before the first bg scan.
+*/
+static u8 rtw_roam_pred_want_scan(struct roam_pred_info *pred, u8 th
+	, u32 lead_ms, u32 scan_int_ms, u32 since_scan_ms, u32 *eta_ms)
+{
+	*eta_ms = rtw_roam_pred_eta_ms(pred, th);
+
+	if (lead_ms == 0 || *eta_ms > lead_ms)
+		return _FALSE;
+
+	if (since_scan_ms != ROAM_PRED_NO_SCAN && since_scan_ms < scan_int_ms)
+		return _FALSE;
+
+	return _TRUE;
+}
+
+static void rtw_roam_pred_add_ch(struct sitesurvey_parm *pparm, u8 ch)
+{
+	int i;
+
+	if (ch == 0 || pparm->ch_num >= RTW_CHANNEL_SCAN_AMOUNT)
+		return;
+
+	for (i = 0; i < pparm->ch_num; i++)
+		if (pparm->ch[i].hw_value == ch)
+			return;
+
+	pparm->ch[pparm->ch_num].hw_value = ch;
+	pparm->ch[pparm->ch_num].flags = RTW_IEEE80211_CHAN_PASSIVE_SCAN;
+	pparm->ch_num++;
+}
+
+/*
+* Partial scan list for the predictor: neighbor report channels when known,
+* otherwise channels other BSSes of the current ESS were last seen on.
+*/
+static u8 rtw_roam_pred_scan_list_set(_adapter *padapter, struct sitesurvey_parm *pparm)
+{
+	_irqL irqL;
+	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
+	_queue *queue = &pmlmepriv->scanned_queue;
+	_list *plist, *phead;
+	struct wlan_network *pnetwork;
+#if defined(CONFIG_RTW_WNM) || defined(CONFIG_RTW_80211K)
+	struct roam_nb_info *pnb = &pmlmepriv->nb_info;
+	u8 i;
+#endif
+
+	rtw_init_sitesurvey_parm(padapter, pparm);
+
+#if defined(CONFIG_RTW_WNM) || defined(CONFIG_RTW_80211K)
+	/* nb_rpt_valid is left for the roam scan itself */
+	for (i = 0; i < pnb->nb_rpt_ch_list_num; i++)
+		rtw_roam_pred_add_ch(pparm, pnb->nb_rpt_ch_list[i].hw_value);
+	if (pparm->ch_num)
+		return _TRUE;
+#endif
+
+	_enter_critical_bh(&queue->lock, &irqL);
+	phead = get_list_head(queue);
+	plist = get_next(phead);
+
+	while (rtw_end_of_queue_search(phead, plist) == _FALSE) {
+		pnetwork = LIST_CONTAINOR(plist, struct wlan_network, list);
+		plist = get_next(plist);
+
+		if (pnetwork == pmlmepriv->cur_network_scanned)
+			continue;
+		if (is_same_ess(&pnetwork->network, &pmlmepriv->cur_network.network) == _FALSE)
+			continue;
+
+		rtw_roam_pred_add_ch(pparm, pnetwork->network.Configuration.DSConfig);
+	}
+
+	_exit_critical_bh(&queue->lock, &irqL);
+
+	return pparm->ch_num ? _TRUE : _FALSE;
+}
+
+/* caller has to lock pmlmepriv->lock, roam_network is the target */
+void rtw_roam_kick(_adapter *adapter)
+{
+	struct mlme_priv *pmlmepriv = &adapter->mlmepriv;
+
+	pmlmepriv->roam_pred.kick_time = rtw_get_current_time();
+
+#ifdef CONFIG_RTW_80211R
+	rtw_ft_start_roam(adapter,
+		(u8 *)pmlmepriv->roam_network->network.MacAddress);
+#else
+	receive_disconnect(adapter, pmlmepriv->cur_network.network.MacAddress
+		, WLAN_REASON_ACTIVE_ROAM, _FALSE);
+#endif
+}
+
+/*
+* Fed with signal_strength_data.avg_val by linked_status_chk. While above
+* roam_rssi_threshold and trending down, issue a partial background scan
+* once the crossing is predicted within lead_ms so that the candidate
+* table is warm when the threshold is actually crossed.
+*/
+void rtw_roam_pred_tick(_adapter *adapter, u8 rssi)
+{
+	struct mlme_priv *pmlmepriv = &adapter->mlmepriv;
+	struct roam_pred_info *pred = &pmlmepriv->roam_pred;
+	u32 eta_ms, since_ms;
+
+	rtw_roam_pred_feed(pred, rssi);
+
+	if (rssi < pmlmepriv->roam_rssi_threshold) {
+		if (pred->cross_time == 0)
+			pred->cross_time = rtw_get_current_time();
+		return;
+	}
+
+	if (pred->kick_time == 0)
+		pred->cross_time = 0;
+
+	since_ms = pred->bg_scan_time ?
+		rtw_get_passing_time_ms(pred->bg_scan_time) : ROAM_PRED_NO_SCAN;
+	if (!rtw_roam_pred_want_scan(pred, pmlmepriv->roam_rssi_threshold
+		, pred->lead_ms, pmlmepriv->roam_scan_int_ms, since_ms, &eta_ms))
+		return;
+
+	RTW_INFO(FUNC_ADPT_FMT" rssi:%u ewma:%d crossing %u in ~%ums, bg scan\n"
+		, FUNC_ADPT_ARG(adapter), rssi, pred->ewma >> 4
+		, pmlmepriv->roam_rssi_threshold, eta_ms);
+
+	pred->bg_scan_time = rtw_get_current_time();
+	pred->bg_scan_cnt++;
+	rtw_drv_scan_by_self(adapter, RTW_AUTO_SCAN_REASON_ROAM_PRED);
+}
+
+/*
+* Threshold just crossed: roam straight away when the candidate table is
+* still within roam_scanr_exp_ms instead of scanning first.
+*/
+u8 rtw_roam_pred_warm_roam(_adapter *adapter)
+{
+	_irqL irqL;
+	struct mlme_priv *pmlmepriv = &adapter->mlmepriv;
+	struct roam_pred_info *pred = &pmlmepriv->roam_pred;
+	u8 ret = _FALSE;
+
+	if (pred->kick_time || pred->cand_num == 0
+		|| rtw_get_passing_time_ms(pred->cand_time) >= pmlmepriv->roam_scanr_exp_ms)
+		return _FALSE;
+
+	_enter_critical_bh(&pmlmepriv->lock, &irqL);
+
+	if (check_fwstate(pmlmepriv, _FW_UNDER_SURVEY | _FW_UNDER_LINKING) == _FALSE
+		&& rtw_select_roaming_candidate(pmlmepriv) == _SUCCESS) {
+		pred->warm_roam_cnt++;
+		rtw_roam_kick(adapter);
+		ret = _TRUE;
+	}
+
+	_exit_critical_bh(&pmlmepriv->lock, &irqL);
+
+	return ret;
+}
+
+/* rebuild the ranked candidate table from scanned_queue, on scan done */
+void rtw_roam_pred_rank(_adapter *adapter)
+{
+	_irqL irqL;
+	struct mlme_priv *pmlmepriv = &adapter->mlmepriv;
+	struct roam_pred_info *pred = &pmlmepriv->roam_pred;
+	_queue *queue = &pmlmepriv->scanned_queue;
+	_list *plist, *phead;
+	struct wlan_network *pnetwork;
+	struct roam_cand *cand;
+	int i, j;
+
+	pred->cand_num = 0;
+
+	_enter_critical_bh(&queue->lock, &irqL);
+	phead = get_list_head(queue);
+	plist = get_next(phead);
+
+	while (rtw_end_of_queue_search(phead, plist) == _FALSE) {
+		pnetwork = LIST_CONTAINOR(plist, struct wlan_network, list);
+		plist = get_next(plist);
+
+		if (pnetwork == pmlmepriv->cur_network_scanned)
+			continue;
+		if (is_same_ess(&pnetwork->network, &pmlmepriv->cur_network.network) == _FALSE)
+			continue;
+		if (rtw_is_desired_network(adapter, pnetwork) == _FALSE)
+			continue;
+		if (rtw_get_passing_time_ms(pnetwork->last_scanned) >= pmlmepriv->roam_scanr_exp_ms)
+			continue;
+#ifdef CONFIG_RTW_80211R
+		if (rtw_ft_chk_flags(adapter, RTW_FT_PEER_EN)
+			&& rtw_ft_chk_roaming_candidate(adapter, pnetwork) == _FALSE)
+			continue;
+#endif
+
+		/* strongest first */
+		for (i = 0; i < pred->cand_num; i++)
+			if (pnetwork->network.Rssi > pred->cand[i].rssi)
+				break;
+		if (i >= RTW_ROAM_CAND_NUM)
+			continue;
+
+		j = (pred->cand_num < RTW_ROAM_CAND_NUM) ? pred->cand_num : RTW_ROAM_CAND_NUM - 1;
+		for (; j > i; j--)
+			pred->cand[j] = pred->cand[j - 1];
+
+		cand = &pred->cand[i];
+		_rtw_memcpy(cand->addr, pnetwork->network.MacAddress, ETH_ALEN);
+		cand->ch = pnetwork->network.Configuration.DSConfig;
+		cand->rssi = (s8)pnetwork->network.Rssi;
+
+		if (pred->cand_num < RTW_ROAM_CAND_NUM)
+			pred->cand_num++;
+	}
+
+	_exit_critical_bh(&queue->lock, &irqL);
+
+	pred->cand_time = rtw_get_current_time();
+}
+
+void rtw_roam_pred_link_chg(_adapter *adapter, u8 connected)
+{
+	struct roam_pred_info *pred = &adapter->mlmepriv.roam_pred;
+	u32 gap_ms, ttr_ms;
+
+	if (pred->kick_time) {
+		if (connected) {
+			gap_ms = rtw_get_passing_time_ms(pred->kick_time);
+			ttr_ms = pred->cross_time ?
+				rtw_get_passing_time_ms(pred->cross_time) : gap_ms;
+
+			pred->roam_cnt++;
+			pred->gap_ms_last = gap_ms;
+			if (gap_ms > pred->gap_ms_max)
+				pred->gap_ms_max = gap_ms;
+			pred->ttr_ms_last = ttr_ms;
+			if (ttr_ms > pred->ttr_ms_max)
+				pred->ttr_ms_max = ttr_ms;
+
+			RTW_INFO(FUNC_ADPT_FMT" roam done, time_to_roam:%ums gap:%ums\n"
+				, FUNC_ADPT_ARG(adapter), ttr_ms, gap_ms);
+		} else
+			pred->roam_fail_cnt++;
+	}
+
+	/* new link, new trend */
+	pred->ewma = 0;
+	pred->slope = 0;
+	pred->samples = 0;
+	pred->bg_scan_time = 0;
+	pred->cand_num = 0;
+	pred->cross_time = 0;
+	pred->kick_time = 0;
+}
+
+void rtw_roam_pred_dump(void *sel, _adapter *adapter)
+{
+	struct mlme_priv *pmlmepriv = &adapter->mlmepriv;
+	struct roam_pred_info *pred = &pmlmepriv->roam_pred;
+	u32 eta_ms;
+	int i;
+
+	eta_ms = rtw_roam_pred_eta_ms(pred, pmlmepriv->roam_rssi_threshold);
+
+	RTW_PRINT_SEL(sel, "rssi_threshold:%u lead_ms:%u\n"
+		, pmlmepriv->roam_rssi_threshold, pred->lead_ms);
+	RTW_PRINT_SEL(sel, "ewma:%d slope_x100:%d eta_ms:%d samples:%u\n"
+		, pred->ewma >> 4, pred->slope * 100 / 16
+		, eta_ms == ROAM_PRED_ETA_NONE ? -1 : (int)eta_ms, pred->samples);
+	RTW_PRINT_SEL(sel, "bg_scan:%u roam:%u warm_roam:%u fail:%u\n"
+		, pred->bg_scan_cnt, pred->roam_cnt, pred->warm_roam_cnt, pred->roam_fail_cnt);
+	RTW_PRINT_SEL(sel, "time_to_roam_ms last:%u max:%u\n"
+		, pred->ttr_ms_last, pred->ttr_ms_max);
+	RTW_PRINT_SEL(sel, "loss_window_ms last:%u max:%u\n"
+		, pred->gap_ms_last, pred->gap_ms_max);
+
+	if (pred->cand_num == 0)
+		return;
+
+	RTW_PRINT_SEL(sel, "candidates (age:%ums)\n", rtw_get_passing_time_ms(pred->cand_time));
+	for (i = 0; i < pred->cand_num; i++)
+		RTW_PRINT_SEL(sel, "%d "MAC_FMT" ch:%3u rssi:%d\n", i
+			, MAC_ARG(pred->cand[i].addr), pred->cand[i].ch, pred->cand[i].rssi);
+}
+
+struct roam_pred_replay_rst {
+	int cross;
+	int first_scan;
+	u32 scan_cnt;
+	u32 min_scan_gap_ms;
+};
+
+/* run an rssi sequence through the predictor, no scan is issued, trace to @sel if given */
+static void rtw_roam_pred_replay_run(void *sel, const u8 *rssi, u8 num, u8 th
+	, u32 lead_ms, u32 scan_int_ms, struct roam_pred_replay_rst *rst)
+{
+	struct roam_pred_info sim;
+	u32 eta_ms, since_ms;
+	int i, last_scan = -1;
+	u8 scan;
+	const char *act;
+
+	_rtw_memset(&sim, 0, sizeof(sim));
+	rst->cross = -1;
+	rst->first_scan = -1;
+	rst->scan_cnt = 0;
+	rst->min_scan_gap_ms = 0xFFFFFFFF;
+
+	if (sel)
+		RTW_PRINT_SEL(sel, "%3s %4s %4s %10s %6s\n", "idx", "rssi", "ewma", "slope_x100", "eta_ms");
+
+	for (i = 0; i < num; i++) {
+		act = "";
+		rtw_roam_pred_feed(&sim, rssi[i]);
+		since_ms = last_scan < 0 ?
+			ROAM_PRED_NO_SCAN : (u32)(i - last_scan) * RTW_ROAM_PRED_TICK_MS;
+		scan = rtw_roam_pred_want_scan(&sim, th, lead_ms, scan_int_ms, since_ms, &eta_ms);
+
+		if (rssi[i] < th) {
+			if (rst->cross < 0) {
+				rst->cross = i;
+				act = " cross";
+			}
+		} else if (scan) {
+			if (since_ms < rst->min_scan_gap_ms)
+				rst->min_scan_gap_ms = since_ms;
+			last_scan = i;
+			if (rst->first_scan < 0)
+				rst->first_scan = i;
+			rst->scan_cnt++;
+			act = " bg_scan";
+		}
+
+		if (sel)
+			RTW_PRINT_SEL(sel, "%3d %4u %4d %10d %6d%s\n", i, rssi[i]
+				, sim.ewma >> 4, sim.slope * 100 / 16
+				, eta_ms == ROAM_PRED_ETA_NONE ? -1 : (int)eta_ms, act);
+	}
+}
+
+void rtw_roam_pred_replay(void *sel, _adapter *adapter, const u8 *rssi, u8 num)
+{
+	struct mlme_priv *pmlmepriv = &adapter->mlmepriv;
+	struct roam_pred_replay_rst rst;
+	u8 th = pmlmepriv->roam_rssi_threshold;
+
+	rtw_roam_pred_replay_run(sel, rssi, num, th, pmlmepriv->roam_pred.lead_ms
+		, pmlmepriv->roam_scan_int_ms, &rst);
+
+	if (rst.cross < 0)
+		RTW_PRINT_SEL(sel, "no crossing of %u\n", th);
+	else if (rst.first_scan >= 0 && rst.first_scan < rst.cross)
+		RTW_PRINT_SEL(sel, "first bg scan %ums ahead of crossing\n"
+			, (rst.cross - rst.first_scan) * RTW_ROAM_PRED_TICK_MS);
+	else
+		RTW_PRINT_SEL(sel, "crossed %u without prediction\n", th);
+}
+
+/*
+ * Replay scripted sequences with fixed parameters (threshold 70, lead 4s,
+ * scan interval 10s) so the result does not depend on the proc tunables
+ */
+#define ROAM_PRED_TEST_TH	70
+#define ROAM_PRED_TEST_LEAD_MS	4000
+#define ROAM_PRED_TEST_INT_MS	10000
+#define ROAM_PRED_TEST_LEN	30
+void rtw_roam_pred_test(void *sel)
+{
+	struct roam_pred_replay_rst rst;
+	u8 rssi[ROAM_PRED_TEST_LEN];
+	u32 scan_cnt, fail_cnt = 0;
+	int i;
+
+	/* steady decline of 2 per tick from 90 */
+	for (i = 0; i < ROAM_PRED_TEST_LEN; i++)
+		rssi[i] = 90 - 2 * i;
+	rtw_roam_pred_replay_run(NULL, rssi, ROAM_PRED_TEST_LEN, ROAM_PRED_TEST_TH
+		, ROAM_PRED_TEST_LEAD_MS, ROAM_PRED_TEST_INT_MS, &rst);
+	rtw_selftest_chk(sel, "decline scans before cross", rst.cross >= 0
+		&& rst.first_scan >= 0 && rst.first_scan < rst.cross, &fail_cnt);
+
+	/* flat and noisy above the threshold */
+	for (i = 0; i < ROAM_PRED_TEST_LEN; i++)
+		rssi[i] = 80 + (i % 3);
+	rtw_roam_pred_replay_run(NULL, rssi, ROAM_PRED_TEST_LEN, ROAM_PRED_TEST_TH
+		, ROAM_PRED_TEST_LEAD_MS, ROAM_PRED_TEST_INT_MS, &rst);
+	rtw_selftest_chk(sel, "flat never scans", rst.cross < 0 && rst.scan_cnt == 0, &fail_cnt);
+
+	/* rising from just above the threshold */
+	for (i = 0; i < ROAM_PRED_TEST_LEN; i++)
+		rssi[i] = 72 + i;
+	rtw_roam_pred_replay_run(NULL, rssi, ROAM_PRED_TEST_LEN, ROAM_PRED_TEST_TH
+		, ROAM_PRED_TEST_LEAD_MS, ROAM_PRED_TEST_INT_MS, &rst);
+	rtw_selftest_chk(sel, "rising never scans", rst.scan_cnt == 0, &fail_cnt);
+
+	/* slow decline of 1 per tick, eta stays within a longer lead for several ticks */
+	for (i = 0; i < ROAM_PRED_TEST_LEN; i++)
+		rssi[i] = 90 - i;
+	rtw_roam_pred_replay_run(NULL, rssi, ROAM_PRED_TEST_LEN, ROAM_PRED_TEST_TH
+		, ROAM_PRED_TEST_LEAD_MS * 3, 0, &rst);
+	scan_cnt = rst.scan_cnt;
+	rtw_roam_pred_replay_run(NULL, rssi, ROAM_PRED_TEST_LEN, ROAM_PRED_TEST_TH
+		, ROAM_PRED_TEST_LEAD_MS * 3, ROAM_PRED_TEST_INT_MS / 2, &rst);
+	rtw_selftest_chk(sel, "scans rate limited", rst.scan_cnt >= 2 && rst.scan_cnt < scan_cnt
+		&& rst.min_scan_gap_ms >= ROAM_PRED_TEST_INT_MS / 2, &fail_cnt);
+
+	/* lead 0 turns the predictor off */
+	for (i = 0; i < ROAM_PRED_TEST_LEN; i++)
+		rssi[i] = 90 - 2 * i;
+	rtw_roam_pred_replay_run(NULL, rssi, ROAM_PRED_TEST_LEN, ROAM_PRED_TEST_TH
+		, 0, ROAM_PRED_TEST_INT_MS, &rst);
+	rtw_selftest_chk(sel, "lead 0 never scans", rst.scan_cnt == 0, &fail_cnt);
+
+	rtw_selftest_result(sel, fail_cnt);
+}
+#endif /* CONFIG_LAYER2_ROAMING */
+
 void rtw_drv_scan_by_self(_adapter *padapter, u8 reason)
 {
 	struct sitesurvey_parm parm;
@@ -3074,6 +3550,15 @@ void rtw_drv_scan_by_self(_adapter *padapter, u8 reason)
 		goto exit;
 #endif
 
+#ifdef CONFIG_LAYER2_ROAMING
+	/* partial scan only, never fall back to a full one */
+	if (reason == RTW_AUTO_SCAN_REASON_ROAM_PRED) {
+		if (rtw_roam_pred_scan_list_set(padapter, &parm))
+			rtw_set_802_11_bssid_list_scan(padapter, &parm);
+		goto exit;
+	}
+#endif
+
 	rtw_set_802_11_bssid_list_scan(padapter, NULL);
 exit:
 	return;
@@ -3369,7 +3854,7 @@ static int rtw_check_roaming_candidate(struct mlme_priv *mlme
 	int updated = _FALSE;
 	_adapter *adapter = container_of(mlme, _adapter, mlmepriv);
 
-	if (rtw_chset_search_ch(adapter_to_chset(adapter), competitor->network.Configuration.DSConfig) < 0)
+	if (rtw_rfctl_search_ch(adapter_to_rfctl(adapter), competitor->network.Configuration.DSConfig) < 0)
 		goto exit;
 
 #if defined(CONFIG_RTW_REPEATER_SON) &&  (!defined(CONFIG_RTW_REPEATER_SON_ROOT))
@@ -3541,7 +4026,7 @@ static int rtw_check_join_candidate(struct mlme_priv *mlme
 	int updated = _FALSE;
 	_adapter *adapter = container_of(mlme, _adapter, mlmepriv);
 
-	if (rtw_chset_search_ch(adapter_to_chset(adapter), competitor->network.Configuration.DSConfig) < 0)
+	if (rtw_rfctl_search_ch(adapter_to_rfctl(adapter), competitor->network.Configuration.DSConfig) < 0)
 		goto exit;
 
 #if defined(CONFIG_RTW_REPEATER_SON) &&  (!defined(CONFIG_RTW_REPEATER_SON_ROOT))
@@ -780,6 +780,7 @@ void rtw_txpwr_init_regd(struct rf_ctl_t *rfctl)
 	};
 
 release_lock:
+	_rtw_txpwr_lmt_tbl_build(rfctl);
 	_exit_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
 }
 #endif /* CONFIG_TXPWR_LIMIT */
@@ -789,6 +790,7 @@ void rtw_rfctl_init(_adapter *adapter)
 	struct rf_ctl_t *rfctl = adapter_to_rfctl(adapter);
 
 	rfctl->max_chan_nums = init_channel_set(adapter, rfctl->ChannelPlan, rfctl->channel_set);
+	rtw_chset_map_build(&rfctl->ch_map, rfctl->channel_set);
 	init_channel_list(adapter, rfctl->channel_set, &rfctl->channel_list);
 
 	_rtw_mutex_init(&rfctl->offch_mutex);
@@ -803,6 +805,7 @@ void rtw_rfctl_init(_adapter *adapter)
 
 #ifdef CONFIG_DFS_MASTER
 	rfctl->cac_start_time = rfctl->cac_end_time = RTW_CAC_STOPPED;
+	rtw_radar_evt_init(&rfctl->radar_evt);
 
 	/* TODO: dfs_master_timer */
 #endif
@@ -1143,6 +1146,193 @@ u32 rtw_force_stop_cac(_adapter *adapter, u32 timeout_ms)
 
 	return pass_ms;
 }
+
+void rtw_radar_evt_init(struct radar_evt_ctl *ctl)
+{
+	int i;
+
+	_rtw_memset(ctl, 0, sizeof(*ctl));
+
+	/* default patterns take phydm decision as is */
+	for (i = 0; i < RADAR_EVT_REGION_NUM; i++)
+		ctl->pattern[i].confirm_num = 1;
+}
+
+/*
+* check phydm radar detect result of one poll against region pattern
+* pulse counts are accumulated over RADAR_EVT_PULSE_HIST polls because phydm
+* decides on the pulse flag latched 2 polls before
+*/
+u8 rtw_radar_evt_classify(const struct radar_pattern *pattern, struct radar_cls_state *cls, struct radar_evt *evt, u32 now_ms)
+{
+	u16 short_sum = 0, long_sum = 0;
+	u8 i;
+
+	cls->short_hist[cls->hist_idx] = evt->short_pulse;
+	cls->long_hist[cls->hist_idx] = evt->long_pulse;
+	cls->hist_idx = (cls->hist_idx + 1) % RADAR_EVT_PULSE_HIST;
+	for (i = 0; i < RADAR_EVT_PULSE_HIST; i++) {
+		short_sum += cls->short_hist[i];
+		long_sum += cls->long_hist[i];
+	}
+
+	if (evt->flags & (RADAR_EVT_F_TRI_SHORT | RADAR_EVT_F_TRI_LONG)) {
+		if (!cls->trig_active) {
+			cls->trig_active = 1;
+			cls->first_trig_ms = now_ms;
+		}
+		cls->last_trig_ms = now_ms;
+	} else if (cls->trig_active && now_ms - cls->last_trig_ms > RADAR_EVT_IDLE_MS)
+		cls->trig_active = 0;
+
+	if (!(evt->flags & RADAR_EVT_F_DETECTED)) {
+		if (!(evt->flags & (RADAR_EVT_F_TRI_SHORT | RADAR_EVT_F_TRI_LONG)))
+			return RADAR_EVT_NONE;
+		if (!(evt->flags & RADAR_EVT_F_TRI_SHORT) && (evt->flags & RADAR_EVT_F_LONG_FILTERED))
+			return RADAR_EVT_REJ_REGION;
+		if (evt->flags & (RADAR_EVT_F_FA_MASKED | RADAR_EVT_F_HIST_MASKED))
+			return RADAR_EVT_REJ_MASK;
+		return RADAR_EVT_RAW;
+	}
+
+	if ((pattern->min_short_pulse || pattern->min_long_pulse)
+		&& !(pattern->min_short_pulse && short_sum >= pattern->min_short_pulse)
+		&& !(pattern->min_long_pulse && long_sum >= pattern->min_long_pulse))
+		return RADAR_EVT_REJ_PULSE;
+
+	if (!cls->cand_num || now_ms - cls->first_cand_ms > pattern->window_ms) {
+		cls->cand_num = 0;
+		cls->first_cand_ms = now_ms;
+	}
+	cls->cand_num++;
+	if (cls->cand_num < pattern->confirm_num)
+		return RADAR_EVT_PENDING;
+
+	cls->cand_num = 0;
+	cls->delay_ms = cls->trig_active ? now_ms - cls->first_trig_ms : 0;
+	cls->trig_active = 0;
+
+	return RADAR_EVT_CONFIRMED;
+}
+
+/* run phydm radar detect, record and classify the result, return _TRUE if radar is confirmed */
+bool rtw_radar_evt_poll(_adapter *adapter)
+{
+	struct rf_ctl_t *rfctl = adapter_to_rfctl(adapter);
+	struct radar_evt_ctl *ctl = &rfctl->radar_evt;
+	struct radar_evt evt;
+	u8 region = rtw_odm_get_dfs_domain(adapter);
+
+	rtw_odm_radar_detect(adapter);
+	rtw_odm_radar_detect_get_evt(adapter, &evt);
+
+	evt.time = rtw_get_current_time();
+	evt.ch = rfctl->radar_detect_ch;
+	evt.bw = rfctl->radar_detect_bw;
+	evt.offset = rfctl->radar_detect_offset;
+	evt.region = region;
+	if (region >= RADAR_EVT_REGION_NUM)
+		region = PHYDM_DFS_DOMAIN_UNKNOWN;
+
+	evt.result = rtw_radar_evt_classify(&ctl->pattern[region], &ctl->cls, &evt, rtw_systime_to_ms(evt.time));
+
+	ctl->poll_cnt++;
+	if (evt.result == RADAR_EVT_NONE)
+		return _FALSE;
+
+	ctl->trig_cnt++;
+	if (evt.result == RADAR_EVT_CONFIRMED) {
+		ctl->confirm_cnt++;
+		RTW_INFO(FUNC_ADPT_FMT" radar confirmed, ch:%u, delay:%ums\n"
+			, FUNC_ADPT_ARG(adapter), evt.ch, ctl->cls.delay_ms);
+	} else if (evt.result >= RADAR_EVT_REJ_MASK)
+		ctl->reject_cnt++;
+
+	ctl->ring[ctl->ring_idx] = evt;
+	ctl->ring_idx = (ctl->ring_idx + 1) % RADAR_EVT_RING_NUM;
+	if (ctl->ring_num < RADAR_EVT_RING_NUM)
+		ctl->ring_num++;
+
+	return evt.result == RADAR_EVT_CONFIRMED;
+}
+
+/* feed recorded poll results at DFS_MASTER_TIMER_MS interval to classifier with a scratch state */
+void rtw_radar_evt_replay(struct radar_evt_ctl *ctl, u8 region, int truth_idx, struct radar_evt *trace, u16 num)
+{
+	struct radar_replay_rst *rst = &ctl->replay;
+	struct radar_cls_state cls;
+	u16 i;
+
+	if (region >= RADAR_EVT_REGION_NUM)
+		region = PHYDM_DFS_DOMAIN_UNKNOWN;
+
+	_rtw_memset(&cls, 0, sizeof(cls));
+	_rtw_memset(rst, 0, sizeof(*rst));
+	rst->region = region;
+	rst->sample_num = num;
+	rst->truth_idx = truth_idx;
+	rst->delay_ms = -1;
+
+	for (i = 0; i < num; i++) {
+		trace[i].result = rtw_radar_evt_classify(&ctl->pattern[region], &cls, &trace[i], i * DFS_MASTER_TIMER_MS);
+		if (trace[i].result != RADAR_EVT_CONFIRMED)
+			continue;
+
+		rst->confirm_num++;
+		if (truth_idx < 0 || i < truth_idx)
+			rst->false_alarm++;
+		else if (rst->delay_ms < 0)
+			rst->delay_ms = (i - truth_idx) * DFS_MASTER_TIMER_MS;
+	}
+}
+
+static const char *const _radar_evt_result_str[] = {
+	"NONE",
+	"RAW",
+	"PENDING",
+	"CONFIRMED",
+	"REJ_MASK",
+	"REJ_REGION",
+	"REJ_PULSE",
+};
+
+#define radar_evt_result_str(result) \
+	(((result) < ARRAY_SIZE(_radar_evt_result_str)) ? _radar_evt_result_str[(result)] : "UNKNOWN")
+
+void dump_radar_evt(void *sel, struct rf_ctl_t *rfctl)
+{
+	struct radar_evt_ctl *ctl = &rfctl->radar_evt;
+	struct radar_replay_rst *rst = &ctl->replay;
+	struct radar_evt *evt;
+	int i;
+	u8 idx;
+
+	RTW_PRINT_SEL(sel, "poll:%u trig:%u confirm:%u reject:%u last_delay:%ums\n"
+		, ctl->poll_cnt, ctl->trig_cnt, ctl->confirm_cnt, ctl->reject_cnt, ctl->cls.delay_ms);
+
+	RTW_PRINT_SEL(sel, "%-6s %-9s %-8s %-11s %-9s\n"
+		, "region", "min_short", "min_long", "confirm_num", "window_ms");
+	for (i = 0; i < RADAR_EVT_REGION_NUM; i++) {
+		RTW_PRINT_SEL(sel, "%6d %9u %8u %11u %9u\n", i
+			, ctl->pattern[i].min_short_pulse, ctl->pattern[i].min_long_pulse
+			, ctl->pattern[i].confirm_num, ctl->pattern[i].window_ms);
+	}
+
+	if (rst->sample_num) {
+		RTW_PRINT_SEL(sel, "replay region:%u sample:%u truth_idx:%d confirm:%u false_alarm:%u delay:%dms\n"
+			, rst->region, rst->sample_num, rst->truth_idx, rst->confirm_num, rst->false_alarm, rst->delay_ms);
+	}
+
+	RTW_PRINT_SEL(sel, "%-10s %3s %2s %6s %6s %5s %5s %5s %-10s\n"
+		, "ago_ms", "ch", "bw", "offset", "region", "short", "long", "fa", "flags");
+	for (i = 0; i < ctl->ring_num; i++) {
+		idx = (ctl->ring_idx + RADAR_EVT_RING_NUM - 1 - i) % RADAR_EVT_RING_NUM;
+		evt = &ctl->ring[idx];
+		RTW_PRINT_SEL(sel, "%10u %3u %2u %6u %6u %5u %5u %5u 0x%02x %s\n"
+			, rtw_get_passing_time_ms(evt->time), evt->ch, evt->bw, evt->offset, evt->region
+			, evt->short_pulse, evt->long_pulse, evt->fa, evt->flags, radar_evt_result_str(evt->result));
+	}
+}
 #endif /* CONFIG_DFS_MASTER */
 
 /* choose channel with shortest waiting (non ocp + cac) time */
@@ -1416,6 +1606,138 @@ int rtw_chset_search_ch(RT_CHANNEL_INFO *ch_set, const u32 ch)
 	return -1;
 }
 
+void rtw_chset_map_build(struct chset_map *map, RT_CHANNEL_INFO *ch_set)
+{
+	u8 ch;
+	int i;
+
+	_rtw_memset(map, 0, sizeof(struct chset_map));
+
+	for (i = 0; i < MAX_CHANNEL_NUM && ch_set[i].ChannelNum != 0; i++) {
+		ch = ch_set[i].ChannelNum;
+		if (ch >= CHSET_MAP_CH_NUM) {
+			rtw_warn_on(1);
+			continue;
+		}
+
+		map->idx[ch] = i + 1;
+		if (ch_set[i].ScanType == SCAN_PASSIVE)
+			map->passive_bmp[ch / 8] |= BIT(ch % 8);
+		if (rtw_is_dfs_ch(ch))
+			map->dfs_bmp[ch / 8] |= BIT(ch % 8);
+	}
+}
+
+/*
+ * Same result as rtw_chset_search_ch() on the channel_set @map is built from
+ */
+inline int rtw_chset_map_search_ch(struct chset_map *map, const u32 ch)
+{
+	if (ch >= CHSET_MAP_CH_NUM)
+		return -1;
+
+	return (int)map->idx[ch] - 1;
+}
+
+inline bool rtw_chset_map_is_passive(struct chset_map *map, const u32 ch)
+{
+	if (ch >= CHSET_MAP_CH_NUM)
+		return _FALSE;
+
+	return (map->passive_bmp[ch / 8] & BIT(ch % 8)) ? _TRUE : _FALSE;
+}
+
+inline bool rtw_chset_map_is_dfs(struct chset_map *map, const u32 ch)
+{
+	if (ch >= CHSET_MAP_CH_NUM)
+		return _FALSE;
+
+	return (map->dfs_bmp[ch / 8] & BIT(ch % 8)) ? _TRUE : _FALSE;
+}
+
+void rtw_chset_map_set_active(struct chset_map *map, RT_CHANNEL_INFO *ch_set, const u32 ch)
+{
+	int idx = rtw_chset_map_search_ch(map, ch);
+
+	if (idx < 0)
+		return;
+
+	ch_set[idx].ScanType = SCAN_ACTIVE;
+	map->passive_bmp[ch / 8] &= ~BIT(ch % 8);
+}
+
+/*
+ * Build channel_set and map of every valid channel plan into temporary
+ * buffers and compare map lookup with rtw_chset_search_ch() for ch 0~255,
+ * then the same for the current channel_set and its map
+ */
+void rtw_chset_map_test(void *sel, _adapter *adapter)
+{
+	RT_CHANNEL_INFO *ch_set;
+	struct chset_map *map;
+	u32 plan_cnt = 0, fail_cnt = 0, cur_fail_cnt = 0;
+	u8 chset_num;
+	int plan, ch, idx;
+
+	ch_set = rtw_zmalloc(sizeof(RT_CHANNEL_INFO) * MAX_CHANNEL_NUM);
+	map = rtw_zmalloc(sizeof(struct chset_map));
+	if (!ch_set || !map) {
+		RTW_PRINT_SEL(sel, "FAIL: alloc\n");
+		goto exit;
+	}
+
+	for (plan = 0; plan < 0xFF; plan++) {
+		if (!rtw_is_channel_plan_valid(plan))
+			continue;
+
+		chset_num = init_channel_set(adapter, plan, ch_set);
+		rtw_chset_map_build(map, ch_set);
+		plan_cnt++;
+
+		for (ch = 0; ch <= 0xFF; ch++) {
+			idx = rtw_chset_search_ch(ch_set, ch);
+
+			if (rtw_chset_map_search_ch(map, ch) != idx
+				|| (idx >= 0 && rtw_chset_map_is_passive(map, ch) != (ch_set[idx].ScanType == SCAN_PASSIVE))
+				|| (idx >= 0 && rtw_chset_map_is_dfs(map, ch) != (rtw_is_dfs_ch(ch) ? _TRUE : _FALSE))
+			) {
+				RTW_PRINT_SEL(sel, "chplan:0x%02x ch:%u idx:%d map_idx:%d mismatch\n"
+					, plan, ch, idx, rtw_chset_map_search_ch(map, ch));
+				fail_cnt++;
+			}
+		}
+
+		if (chset_num == 0)
+			RTW_PRINT_SEL(sel, "chplan:0x%02x empty chset\n", plan);
+	}
+
+	RTW_PRINT_SEL(sel, "chplan num:%u, mismatch:%u\n", plan_cnt, fail_cnt);
+
+	/* current channel_set, catches paths rewriting it without rebuilding the map */
+	for (ch = 0; ch <= 0xFF; ch++) {
+		if (rtw_rfctl_search_ch(adapter_to_rfctl(adapter), ch) != rtw_chset_search_ch(adapter_to_chset(adapter), ch)) {
+			RTW_PRINT_SEL(sel, "cur ch:%u idx:%d map_idx:%d mismatch\n"
+				, ch, rtw_chset_search_ch(adapter_to_chset(adapter), ch), rtw_rfctl_search_ch(adapter_to_rfctl(adapter), ch));
+			cur_fail_cnt++;
+		}
+	}
+	RTW_PRINT_SEL(sel, "cur chset mismatch:%u\n", cur_fail_cnt);
+
+	if (fail_cnt || cur_fail_cnt) {
+		RTW_PRINT_SEL(sel, "FAIL\n");
+		RTW_WARN(FUNC_ADPT_FMT" chset map mismatch, chplan:%u cur:%u\n"
+			, FUNC_ADPT_ARG(adapter), fail_cnt, cur_fail_cnt);
+		rtw_warn_on(1);
+	} else
+		RTW_PRINT_SEL(sel, "PASS\n");
+
+exit:
+	if (ch_set)
+		rtw_mfree(ch_set, sizeof(RT_CHANNEL_INFO) * MAX_CHANNEL_NUM);
+	if (map)
+		rtw_mfree(map, sizeof(struct chset_map));
+}
+
 /*
  * Check if the @param ch, bw, offset is valid for the given @param ch_set
  * @ch_set: the given channel set
@@ -2145,6 +2467,11 @@ _non_rc_device:
 			|| (ielen == 0 && pmlmeinfo->hidden_ssid_mode))
 			goto exit;
 
+		/* one reply per wildcard probe burst from the same station */
+		if (ielen == 0 && MLME_IS_AP(padapter)
+			&& rtw_probersp_dedup_chk(padapter, get_sa(pframe)) == _TRUE)
+			goto exit;
+
 		#ifdef CONFIG_RTW_MESH
 		if (MLME_IS_MESH(padapter)) {
 			p = rtw_get_ie(pframe + WLAN_HDR_A3_LEN + _PROBEREQ_IE_OFFSET_, WLAN_EID_MESH_ID, (int *)&ielen,
@@ -6786,7 +7113,7 @@ unsigned int on_action_public_p2p(union recv_frame *precv_frame)
 									u8 operatingch_info[5] = { 0x00 };
 									if (rtw_get_p2p_attr_content(merged_p2pie, merged_p2p_ielen, P2P_ATTR_OPERATING_CH, operatingch_info,
 										&attr_contentlen)) {
-										if (rtw_chset_search_ch(adapter_to_chset(padapter), (u32)operatingch_info[4]) >= 0) {
+										if (rtw_rfctl_search_ch(adapter_to_rfctl(padapter), (u32)operatingch_info[4]) >= 0) {
 											/*	The operating channel is acceptable for this device. */
 											pwdinfo->rx_invitereq_info.operation_ch[0] = operatingch_info[4];
 #ifdef CONFIG_P2P_OP_CHK_SOCIAL_CH
@@ -8496,6 +8823,462 @@ _issue_bcn:
 
 }
 
+#if defined(CONFIG_AP_MODE) && defined (CONFIG_NATIVEAP_MLME)
+/*
+* Build AP probe response body (fixed fields + IEs) from cur_network into pbody
+* return length of body
+*/
+static u32 build_ap_probersp_body(_adapter *padapter, u8 *pbody)
+{
+	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
+	WLAN_BSSID_EX *cur_network = &padapter->mlmeextpriv.mlmext_info.network;
+	u8 *pframe = pbody;
+	uint pktlen = 0;
+	u8 *pwps_ie;
+	uint wps_ielen;
+
+	pwps_ie = rtw_get_wps_ie(cur_network->IEs + _FIXED_IE_LENGTH_, cur_network->IELength - _FIXED_IE_LENGTH_, NULL, &wps_ielen);
+
+	/* inerset & update wps_probe_resp_ie */
+	if ((pmlmepriv->wps_probe_resp_ie != NULL) && pwps_ie && (wps_ielen > 0)) {
+		uint wps_offset, remainder_ielen;
+		u8 *premainder_ie;
+
+		wps_offset = (uint)(pwps_ie - cur_network->IEs);
+
+		premainder_ie = pwps_ie + wps_ielen;
+
+		remainder_ielen = cur_network->IELength - wps_offset - wps_ielen;
+
+		_rtw_memcpy(pframe, cur_network->IEs, wps_offset);
+		pframe += wps_offset;
+		pktlen += wps_offset;
+
+		wps_ielen = (uint)pmlmepriv->wps_probe_resp_ie[1];/* to get ie data len */
+		if ((wps_offset + wps_ielen + 2) <= MAX_IE_SZ) {
+			_rtw_memcpy(pframe, pmlmepriv->wps_probe_resp_ie, wps_ielen + 2);
+			pframe += wps_ielen + 2;
+			pktlen += wps_ielen + 2;
+		}
+
+		if ((wps_offset + wps_ielen + 2 + remainder_ielen) <= MAX_IE_SZ) {
+			_rtw_memcpy(pframe, premainder_ie, remainder_ielen);
+			pframe += remainder_ielen;
+			pktlen += remainder_ielen;
+		}
+	} else {
+		_rtw_memcpy(pframe, cur_network->IEs, cur_network->IELength);
+		pframe += cur_network->IELength;
+		pktlen += cur_network->IELength;
+	}
+
+	/* retrieve SSID IE from cur_network->Ssid */
+	{
+		u8 *ssid_ie;
+		sint ssid_ielen;
+		sint ssid_ielen_diff;
+		u8 buf[MAX_IE_SZ];
+		u8 *ies = pbody;
+
+		ssid_ie = rtw_get_ie(ies + _FIXED_IE_LENGTH_, _SSID_IE_, &ssid_ielen,
+			     (pframe - ies) - _FIXED_IE_LENGTH_);
+
+		ssid_ielen_diff = cur_network->Ssid.SsidLength - ssid_ielen;
+
+		if (ssid_ie &&  cur_network->Ssid.SsidLength) {
+			uint remainder_ielen;
+			u8 *remainder_ie;
+			remainder_ie = ssid_ie + 2;
+			remainder_ielen = (pframe - remainder_ie);
+
+			if (remainder_ielen > MAX_IE_SZ) {
+				RTW_WARN(FUNC_ADPT_FMT" remainder_ielen > MAX_IE_SZ\n", FUNC_ADPT_ARG(padapter));
+				remainder_ielen = MAX_IE_SZ;
+			}
+
+			_rtw_memcpy(buf, remainder_ie, remainder_ielen);
+			_rtw_memcpy(remainder_ie + ssid_ielen_diff, buf, remainder_ielen);
+			*(ssid_ie + 1) = cur_network->Ssid.SsidLength;
+			_rtw_memcpy(ssid_ie + 2, cur_network->Ssid.Ssid, cur_network->Ssid.SsidLength);
+
+			pframe += ssid_ielen_diff;
+			pktlen += ssid_ielen_diff;
+		}
+	}
+#ifdef CONFIG_APPEND_VENDOR_IE_ENABLE
+	{
+		u32 vendor_ielen = rtw_build_vendor_ie(padapter , pframe , WIFI_PROBERESP_VENDOR_IE_BIT);
+
+		pframe += vendor_ielen;
+		pktlen += vendor_ielen;
+	}
+#endif
+
+	return pktlen;
+}
+
+/*
+* Caller must hold bcn_update_lock
+*/
+void rtw_probersp_tmpl_clear(_adapter *adapter)
+{
+	struct probersp_tmpl_info *tmpl = &adapter->mlmepriv.probersp;
+
+	rtw_buf_free(&tmpl->body, &tmpl->body_len);
+}
+
+void rtw_probersp_tmpl_invalidate(_adapter *adapter)
+{
+	struct mlme_priv *pmlmepriv = &adapter->mlmepriv;
+	_irqL irqL;
+
+	_enter_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+	rtw_probersp_tmpl_clear(adapter);
+	_exit_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+}
+
+/*
+* Copy cached probe response body into pbody, rebuild cache first if stale
+* return length of body
+*/
+static u32 probersp_tmpl_get(_adapter *padapter, u8 *pbody)
+{
+	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
+	struct probersp_tmpl_info *tmpl = &pmlmepriv->probersp;
+	WLAN_BSSID_EX *cur_network = &padapter->mlmeextpriv.mlmext_info.network;
+	_irqL irqL;
+	u32 len;
+
+	_enter_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+
+	if (tmpl->body
+		&& tmpl->ielen == cur_network->IELength
+		&& tmpl->ch == cur_network->Configuration.DSConfig
+	) {
+		len = tmpl->body_len;
+		_rtw_memcpy(pbody, tmpl->body, len);
+		tmpl->hit_cnt++;
+	} else {
+		len = build_ap_probersp_body(padapter, pbody);
+		rtw_buf_update(&tmpl->body, &tmpl->body_len, pbody, len);
+		tmpl->ielen = cur_network->IELength;
+		tmpl->ch = cur_network->Configuration.DSConfig;
+		tmpl->build_cnt++;
+	}
+	tmpl->rsp_cnt++;
+
+	_exit_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+
+	return len;
+}
+
+/*
+* Return _TRUE if a wildcard probe from sa was already answered within dedup_ms
+*/
+bool rtw_probersp_dedup_chk(_adapter *adapter, const u8 *sa)
+{
+	struct probersp_tmpl_info *tmpl = &adapter->mlmepriv.probersp;
+	struct probersp_dedup_ent *ent;
+	int i;
+
+	if (tmpl->dedup_ms == 0)
+		return _FALSE;
+
+	for (i = 0; i < RTW_PROBERSP_DEDUP_NUM; i++) {
+		ent = &tmpl->dedup[i];
+		if (ent->time == 0 || _rtw_memcmp(ent->addr, sa, ETH_ALEN) == _FALSE)
+			continue;
+		if (rtw_get_passing_time_ms(ent->time) < tmpl->dedup_ms) {
+			tmpl->dedup_cnt++;
+			return _TRUE;
+		}
+		ent->time = rtw_get_current_time();
+		return _FALSE;
+	}
+
+	ent = &tmpl->dedup[tmpl->dedup_idx];
+	_rtw_memcpy(ent->addr, sa, ETH_ALEN);
+	ent->time = rtw_get_current_time();
+	tmpl->dedup_idx = (tmpl->dedup_idx + 1) % RTW_PROBERSP_DEDUP_NUM;
+
+	return _FALSE;
+}
+
+void rtw_probersp_dump(void *sel, _adapter *adapter)
+{
+	struct probersp_tmpl_info *tmpl = &adapter->mlmepriv.probersp;
+
+	RTW_PRINT_SEL(sel, "tmpl_len:%u ch:%u ielen:%u\n"
+		, tmpl->body ? tmpl->body_len : 0, tmpl->ch, tmpl->ielen);
+	RTW_PRINT_SEL(sel, "dedup_ms:%u\n", tmpl->dedup_ms);
+	RTW_PRINT_SEL(sel, "rsp:%u hit:%u build:%u dedup_drop:%u\n"
+		, tmpl->rsp_cnt, tmpl->hit_cnt, tmpl->build_cnt, tmpl->dedup_cnt);
+}
+
+/*
+* Reference for the bench: the AP branch of issue_probersp() as it was
+* before the template, minus the per-frame RSON IE. Keep it as is, it is
+* what build_ap_probersp_body() and the template are checked against.
+* Caller must hold bcn_update_lock
+*/
+static u32 probersp_body_legacy(_adapter *padapter, u8 *pframe)
+{
+	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
+	WLAN_BSSID_EX *cur_network = &padapter->mlmeextpriv.mlmext_info.network;
+	u8 *ies = pframe;
+	u32 pktlen = 0;
+	u8 *pwps_ie;
+	uint wps_ielen;
+
+	pwps_ie = rtw_get_wps_ie(cur_network->IEs + _FIXED_IE_LENGTH_, cur_network->IELength - _FIXED_IE_LENGTH_, NULL, &wps_ielen);
+
+	if ((pmlmepriv->wps_probe_resp_ie != NULL) && pwps_ie && (wps_ielen > 0)) {
+		uint wps_offset, remainder_ielen;
+		u8 *premainder_ie;
+
+		wps_offset = (uint)(pwps_ie - cur_network->IEs);
+		premainder_ie = pwps_ie + wps_ielen;
+		remainder_ielen = cur_network->IELength - wps_offset - wps_ielen;
+
+		_rtw_memcpy(pframe, cur_network->IEs, wps_offset);
+		pframe += wps_offset;
+		pktlen += wps_offset;
+
+		wps_ielen = (uint)pmlmepriv->wps_probe_resp_ie[1];
+		if ((wps_offset + wps_ielen + 2) <= MAX_IE_SZ) {
+			_rtw_memcpy(pframe, pmlmepriv->wps_probe_resp_ie, wps_ielen + 2);
+			pframe += wps_ielen + 2;
+			pktlen += wps_ielen + 2;
+		}
+
+		if ((wps_offset + wps_ielen + 2 + remainder_ielen) <= MAX_IE_SZ) {
+			_rtw_memcpy(pframe, premainder_ie, remainder_ielen);
+			pframe += remainder_ielen;
+			pktlen += remainder_ielen;
+		}
+	} else {
+		_rtw_memcpy(pframe, cur_network->IEs, cur_network->IELength);
+		pframe += cur_network->IELength;
+		pktlen += cur_network->IELength;
+	}
+
+	{
+		u8 *ssid_ie;
+		sint ssid_ielen;
+		sint ssid_ielen_diff;
+		u8 buf[MAX_IE_SZ];
+
+		ssid_ie = rtw_get_ie(ies + _FIXED_IE_LENGTH_, _SSID_IE_, &ssid_ielen,
+			     (pframe - ies) - _FIXED_IE_LENGTH_);
+
+		ssid_ielen_diff = cur_network->Ssid.SsidLength - ssid_ielen;
+
+		if (ssid_ie &&  cur_network->Ssid.SsidLength) {
+			uint remainder_ielen;
+			u8 *remainder_ie;
+
+			remainder_ie = ssid_ie + 2;
+			remainder_ielen = (pframe - remainder_ie);
+			if (remainder_ielen > MAX_IE_SZ)
+				remainder_ielen = MAX_IE_SZ;
+
+			_rtw_memcpy(buf, remainder_ie, remainder_ielen);
+			_rtw_memcpy(remainder_ie + ssid_ielen_diff, buf, remainder_ielen);
+			*(ssid_ie + 1) = cur_network->Ssid.SsidLength;
+			_rtw_memcpy(ssid_ie + 2, cur_network->Ssid.Ssid, cur_network->Ssid.SsidLength);
+
+			pframe += ssid_ielen_diff;
+			pktlen += ssid_ielen_diff;
+		}
+	}
+#ifdef CONFIG_APPEND_VENDOR_IE_ENABLE
+	pktlen += rtw_build_vendor_ie(padapter , pframe , WIFI_PROBERESP_VENDOR_IE_BIT);
+#endif
+
+	return pktlen;
+}
+
+/* compare what the template path serves against the legacy builder, byte for byte */
+static u8 rtw_probersp_bench_cmp(_adapter *adapter, u8 *legacy_buf, u8 *tmpl_buf)
+{
+	struct mlme_priv *pmlmepriv = &adapter->mlmepriv;
+	_irqL irqL;
+	u32 legacy_len, tmpl_len;
+
+	_enter_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+	legacy_len = probersp_body_legacy(adapter, legacy_buf);
+	_exit_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+
+	tmpl_len = probersp_tmpl_get(adapter, tmpl_buf);
+
+	return legacy_len == tmpl_len && _rtw_memcmp(legacy_buf, tmpl_buf, legacy_len) == _TRUE;
+}
+
+/*
+* Last IE with a body other than SSID, which the body builder rewrites,
+* the stale case flips a bit in it. NULL if there is none
+*/
+static u8 *rtw_probersp_bench_ie(WLAN_BSSID_EX *cur_network)
+{
+	u8 *ie = cur_network->IEs + _FIXED_IE_LENGTH_;
+	u8 *end = cur_network->IEs + cur_network->IELength;
+	u8 *last = NULL;
+
+	while (ie + 2 <= end && ie + 2 + ie[1] <= end) {
+		if (ie[0] != _SSID_IE_ && ie[1] > 0)
+			last = ie;
+		ie += 2 + ie[1];
+	}
+
+	return last;
+}
+
+/*
+* Flip a bit of one IE without changing IELength or the channel, so only
+* _update_beacon() can tell the template is stale, check the next copy
+* follows the change, then restore the IE the same way
+*/
+static u8 rtw_probersp_bench_stale(_adapter *adapter, u8 *legacy_buf, u8 *tmpl_buf)
+{
+	struct mlme_priv *pmlmepriv = &adapter->mlmepriv;
+	WLAN_BSSID_EX *cur_network = &adapter->mlmeextpriv.mlmext_info.network;
+	_irqL irqL;
+	u8 *ie;
+	u8 ok;
+
+	probersp_tmpl_get(adapter, tmpl_buf);
+
+	_enter_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+	ie = rtw_probersp_bench_ie(cur_network);
+	if (ie)
+		ie[2 + ie[1] - 1] ^= 0x01;
+	_exit_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+
+	if (!ie)
+		return _TRUE;
+
+	_update_beacon(adapter, 0xFF, NULL, _FALSE, "probersp bench");
+	ok = rtw_probersp_bench_cmp(adapter, legacy_buf, tmpl_buf);
+
+	_enter_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+	ie[2 + ie[1] - 1] ^= 0x01;
+	_exit_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+	_update_beacon(adapter, 0xFF, NULL, _FALSE, "probersp bench");
+
+	return ok && rtw_probersp_bench_cmp(adapter, legacy_buf, tmpl_buf);
+}
+
+/*
+* Wildcard probes from a made up SA: the second within dedup_ms is
+* dropped, one after the window is answered again. dedup_ms is forced to
+* the default for the check and the test entry is dropped afterwards
+*/
+static u8 rtw_probersp_bench_dedup(_adapter *adapter)
+{
+	struct probersp_tmpl_info *tmpl = &adapter->mlmepriv.probersp;
+	u8 sa[ETH_ALEN] = {0x02, 0xe0, 0x4c, 0xfe, 0xfe, 0x01};
+	u32 dedup_ms = tmpl->dedup_ms;
+	u32 dedup_cnt = tmpl->dedup_cnt;
+	u8 ok;
+	int i;
+
+	tmpl->dedup_ms = RTW_PROBERSP_DEDUP_MS;
+	ok = rtw_probersp_dedup_chk(adapter, sa) == _FALSE
+		&& rtw_probersp_dedup_chk(adapter, sa) == _TRUE;
+	rtw_msleep_os(RTW_PROBERSP_DEDUP_MS + 10);
+	ok = ok && rtw_probersp_dedup_chk(adapter, sa) == _FALSE;
+
+	for (i = 0; i < RTW_PROBERSP_DEDUP_NUM; i++) {
+		if (_rtw_memcmp(tmpl->dedup[i].addr, sa, ETH_ALEN) == _TRUE)
+			tmpl->dedup[i].time = 0;
+	}
+	tmpl->dedup_cnt = dedup_cnt;
+	tmpl->dedup_ms = dedup_ms;
+
+	return ok;
+}
+
+/*
+* Synthetic probe flood: time num body generations with the legacy
+* per-request build versus the template copy, nothing is transmitted.
+* Then check the template against the legacy builder when freshly built,
+* when cached, after a same-length IE change through _update_beacon(), and
+* check the wildcard dedup window.
+*/
+void rtw_probersp_bench(void *sel, _adapter *adapter, u32 num)
+{
+	struct mlme_priv *pmlmepriv = &adapter->mlmepriv;
+	struct probersp_tmpl_info *tmpl = &pmlmepriv->probersp;
+	WLAN_BSSID_EX *cur_network = &adapter->mlmeextpriv.mlmext_info.network;
+	_irqL irqL;
+	systime start;
+	u32 build_ms, tmpl_ms;
+	u32 hit_cnt, fail_cnt = 0;
+	u8 *buf, *buf2 = NULL;
+	u32 i;
+
+	if (!MLME_IS_AP(adapter) || adapter->mlmeextpriv.bstart_bss == _FALSE
+		|| cur_network->IELength > MAX_IE_SZ) {
+		RTW_PRINT_SEL(sel, "not in AP mode\n");
+		return;
+	}
+
+	buf = rtw_malloc(MAX_XMIT_EXTBUF_SZ);
+	if (buf)
+		buf2 = rtw_malloc(MAX_XMIT_EXTBUF_SZ);
+	if (!buf2) {
+		RTW_PRINT_SEL(sel, "FAIL\n");
+		goto exit;
+	}
+
+	start = rtw_get_current_time();
+	for (i = 0; i < num; i++) {
+		_enter_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+		probersp_body_legacy(adapter, buf);
+		_exit_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+	}
+	build_ms = rtw_get_passing_time_ms(start);
+
+	_enter_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+	hit_cnt = tmpl->hit_cnt;
+	_exit_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+
+	start = rtw_get_current_time();
+	for (i = 0; i < num; i++)
+		probersp_tmpl_get(adapter, buf);
+	tmpl_ms = rtw_get_passing_time_ms(start);
+
+	_enter_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+	hit_cnt = tmpl->hit_cnt - hit_cnt;
+	_exit_critical_bh(&pmlmepriv->bcn_update_lock, &irqL);
+
+	RTW_PRINT_SEL(sel, "num:%u\n", num);
+	RTW_PRINT_SEL(sel, "build: %u ms, %u rsp/s, %u ns/rsp\n", build_ms
+		, build_ms ? (u32)rtw_division64((u64)num * 1000, build_ms) : 0
+		, num ? (u32)rtw_division64((u64)build_ms * 1000000, num) : 0);
+	RTW_PRINT_SEL(sel, "tmpl: %u ms, %u rsp/s, %u ns/rsp\n", tmpl_ms
+		, tmpl_ms ? (u32)rtw_division64((u64)num * 1000, tmpl_ms) : 0
+		, num ? (u32)rtw_division64((u64)tmpl_ms * 1000000, num) : 0);
+
+	/* only the first copy may rebuild, unless a beacon update raced the loop */
+	rtw_selftest_chk(sel, "copies served by template", num == 0 || hit_cnt >= num - 1, &fail_cnt);
+
+	rtw_probersp_tmpl_invalidate(adapter);
+	rtw_selftest_chk(sel, "new template equals legacy", rtw_probersp_bench_cmp(adapter, buf, buf2), &fail_cnt);
+	rtw_selftest_chk(sel, "cached copy equals legacy", rtw_probersp_bench_cmp(adapter, buf, buf2), &fail_cnt);
+	rtw_selftest_chk(sel, "same-length IE change not stale", rtw_probersp_bench_stale(adapter, buf, buf2), &fail_cnt);
+	rtw_selftest_chk(sel, "dedup window", rtw_probersp_bench_dedup(adapter), &fail_cnt);
+
+	rtw_selftest_result(sel, fail_cnt);
+
+exit:
+	if (buf2)
+		rtw_mfree(buf2, MAX_XMIT_EXTBUF_SZ);
+	if (buf)
+		rtw_mfree(buf, MAX_XMIT_EXTBUF_SZ);
+}
+#endif /* defined(CONFIG_AP_MODE) && defined (CONFIG_NATIVEAP_MLME) */
+
 void issue_probersp(_adapter *padapter, unsigned char *da, u8 is_valid_p2p_probereq)
 {
 	struct xmit_frame			*pmgntframe;
@@ -8506,8 +9289,6 @@ void issue_probersp(_adapter *padapter, unsigned char *da, u8 is_valid_p2p_probe
 	unsigned char					*mac, *bssid;
 	struct xmit_priv	*pxmitpriv = &(padapter->xmitpriv);
 #if defined(CONFIG_AP_MODE) && defined (CONFIG_NATIVEAP_MLME)
-	u8 *pwps_ie;
-	uint wps_ielen;
 	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
 #endif /* #if defined (CONFIG_AP_MODE) && defined (CONFIG_NATIVEAP_MLME) */
 	struct mlme_ext_priv	*pmlmeext = &(padapter->mlmeextpriv);
@@ -8568,79 +9349,13 @@ void issue_probersp(_adapter *padapter, unsigned char *da, u8 is_valid_p2p_probe
 
 #if defined(CONFIG_AP_MODE) && defined (CONFIG_NATIVEAP_MLME)
 	if ((pmlmeinfo->state & 0x03) == WIFI_FW_AP_STATE) {
-		pwps_ie = rtw_get_wps_ie(cur_network->IEs + _FIXED_IE_LENGTH_, cur_network->IELength - _FIXED_IE_LENGTH_, NULL, &wps_ielen);
-
-		/* inerset & update wps_probe_resp_ie */
-		if ((pmlmepriv->wps_probe_resp_ie != NULL) && pwps_ie && (wps_ielen > 0)) {
-			uint wps_offset, remainder_ielen;
-			u8 *premainder_ie;
-
-			wps_offset = (uint)(pwps_ie - cur_network->IEs);
-
-			premainder_ie = pwps_ie + wps_ielen;
-
-			remainder_ielen = cur_network->IELength - wps_offset - wps_ielen;
-
-			_rtw_memcpy(pframe, cur_network->IEs, wps_offset);
-			pframe += wps_offset;
-			pattrib->pktlen += wps_offset;
-
-			wps_ielen = (uint)pmlmepriv->wps_probe_resp_ie[1];/* to get ie data len */
-			if ((wps_offset + wps_ielen + 2) <= MAX_IE_SZ) {
-				_rtw_memcpy(pframe, pmlmepriv->wps_probe_resp_ie, wps_ielen + 2);
-				pframe += wps_ielen + 2;
-				pattrib->pktlen += wps_ielen + 2;
-			}
-
-			if ((wps_offset + wps_ielen + 2 + remainder_ielen) <= MAX_IE_SZ) {
-				_rtw_memcpy(pframe, premainder_ie, remainder_ielen);
-				pframe += remainder_ielen;
-				pattrib->pktlen += remainder_ielen;
-			}
-		} else {
-			_rtw_memcpy(pframe, cur_network->IEs, cur_network->IELength);
-			pframe += cur_network->IELength;
-			pattrib->pktlen += cur_network->IELength;
-		}
+		u32 body_len = probersp_tmpl_get(padapter, pframe);
 
-		/* retrieve SSID IE from cur_network->Ssid */
-		{
-			u8 *ssid_ie;
-			sint ssid_ielen;
-			sint ssid_ielen_diff;
-			u8 buf[MAX_IE_SZ];
-			u8 *ies = pmgntframe->buf_addr + TXDESC_OFFSET + sizeof(struct rtw_ieee80211_hdr_3addr);
-
-			ssid_ie = rtw_get_ie(ies + _FIXED_IE_LENGTH_, _SSID_IE_, &ssid_ielen,
-				     (pframe - ies) - _FIXED_IE_LENGTH_);
-
-			ssid_ielen_diff = cur_network->Ssid.SsidLength - ssid_ielen;
-
-			if (ssid_ie &&  cur_network->Ssid.SsidLength) {
-				uint remainder_ielen;
-				u8 *remainder_ie;
-				remainder_ie = ssid_ie + 2;
-				remainder_ielen = (pframe - remainder_ie);
-
-				if (remainder_ielen > MAX_IE_SZ) {
-					RTW_WARN(FUNC_ADPT_FMT" remainder_ielen > MAX_IE_SZ\n", FUNC_ADPT_ARG(padapter));
-					remainder_ielen = MAX_IE_SZ;
-				}
-
-				_rtw_memcpy(buf, remainder_ie, remainder_ielen);
-				_rtw_memcpy(remainder_ie + ssid_ielen_diff, buf, remainder_ielen);
-				*(ssid_ie + 1) = cur_network->Ssid.SsidLength;
-				_rtw_memcpy(ssid_ie + 2, cur_network->Ssid.Ssid, cur_network->Ssid.SsidLength);
+		pframe += body_len;
+		pattrib->pktlen += body_len;
 
-				pframe += ssid_ielen_diff;
-				pattrib->pktlen += ssid_ielen_diff;
-			}
-		}
 #ifdef CONFIG_RTW_REPEATER_SON
-		rtw_rson_append_ie(padapter, pframe, &pattrib->pktlen);
-#endif
-#ifdef CONFIG_APPEND_VENDOR_IE_ENABLE
-		pattrib->pktlen += rtw_build_vendor_ie(padapter , pframe , WIFI_PROBERESP_VENDOR_IE_BIT);
+		pframe += rtw_rson_append_ie(padapter, pframe, &pattrib->pktlen) + 2;
 #endif
 	} else
 #endif
@@ -11969,6 +12684,9 @@ static void process_80211d(PADAPTER padapter, WLAN_BSSID_EX *bssid)
 			}
 		}
 
+		/* channel_set rewritten above, lookup map must follow */
+		rtw_chset_map_build(&rfctl->ch_map, rfctl->channel_set);
+
 		pmlmeext->update_channel_plan_by_ap_done = 1;
 
 #ifdef CONFIG_RTW_DEBUG
@@ -12020,7 +12738,9 @@ void report_survey_event(_adapter *padapter, union recv_frame *precv_frame)
 	struct cmd_priv *pcmdpriv;
 	/* u8 *pframe = precv_frame->u.hdr.rx_data; */
 	/* uint len = precv_frame->u.hdr.len; */
+	struct rf_ctl_t *rfctl = adapter_to_rfctl(padapter);
 	RT_CHANNEL_INFO *chset = adapter_to_chset(padapter);
+	u8 ch;
 	int ch_set_idx = -1;
 
 	if (!padapter)
@@ -12067,14 +12787,15 @@ void report_survey_event(_adapter *padapter, union recv_frame *precv_frame)
 	process_80211d(padapter, &psurvey_evt->bss);
 #endif
 
-	ch_set_idx = rtw_chset_search_ch(chset, psurvey_evt->bss.Configuration.DSConfig);
+	ch = psurvey_evt->bss.Configuration.DSConfig;
+	ch_set_idx = rtw_rfctl_search_ch(rfctl, ch);
 	if (ch_set_idx >= 0) {
 		if (psurvey_evt->bss.InfrastructureMode == Ndis802_11Infrastructure) {
-			if (chset[ch_set_idx].ScanType == SCAN_PASSIVE
-				&& !rtw_is_dfs_ch(psurvey_evt->bss.Configuration.DSConfig)
+			if (rtw_chset_map_is_passive(&rfctl->ch_map, ch)
+				&& !rtw_chset_map_is_dfs(&rfctl->ch_map, ch)
 			) {
-				RTW_INFO("%s: change ch:%d to active\n", __func__, psurvey_evt->bss.Configuration.DSConfig);
-				chset[ch_set_idx].ScanType = SCAN_ACTIVE;
+				RTW_INFO("%s: change ch:%d to active\n", __func__, ch);
+				rtw_chset_map_set_active(&rfctl->ch_map, chset, ch);
 			}
 			#ifdef CONFIG_DFS
 			if (psurvey_evt->bss.Ssid.SsidLength == 0
@@ -13061,12 +13782,14 @@ void linked_status_chk(_adapter *padapter, u8 from_timer)
 #elif defined(CONFIG_LAYER2_ROAMING)
 		if (rtw_chk_roam_flags(padapter, RTW_ROAM_ACTIVE)) {
 			RTW_INFO("signal_strength_data.avg_val = %d\n", precvpriv->signal_strength_data.avg_val);
+			rtw_roam_pred_tick(padapter, precvpriv->signal_strength_data.avg_val);
 			if (precvpriv->signal_strength_data.avg_val < pmlmepriv->roam_rssi_threshold) {
 #ifdef CONFIG_RTW_80211K
 				rtw_roam_nb_discover(padapter, _FALSE);
 #endif
 				pmlmepriv->need_to_roam = _TRUE;
-				rtw_drv_scan_by_self(padapter, RTW_AUTO_SCAN_REASON_ROAM);
+				if (rtw_roam_pred_warm_roam(padapter) == _FALSE)
+					rtw_drv_scan_by_self(padapter, RTW_AUTO_SCAN_REASON_ROAM);
 			} else
 				pmlmepriv->need_to_roam = _FALSE;
 		}
@@ -14625,7 +15348,7 @@ static int rtw_scan_ch_decision(_adapter *padapter, struct rtw_ieee80211_channel
 		if (rtw_mlme_band_check(padapter, in[i].hw_value) == _FALSE)
 			continue;
 
-		set_idx = rtw_chset_search_ch(rfctl->channel_set, in[i].hw_value);
+		set_idx = rtw_rfctl_search_ch(rfctl, in[i].hw_value);
 		if (set_idx >= 0) {
 			if (j >= out_num) {
 				RTW_PRINT(FUNC_ADPT_FMT" out_num:%u not enough\n",
@@ -14754,7 +15477,7 @@ static u8 sitesurvey_pick_ch_behavior(_adapter *padapter, u8 *ch, RT_SCAN_TYPE *
 		* The driver is in the find phase, it should go through the social channel.
 		*/
 		scan_ch = pwdinfo->social_chan[ss->channel_idx];
-		ch_set_idx = rtw_chset_search_ch(rfctl->channel_set, scan_ch);
+		ch_set_idx = rtw_rfctl_search_ch(rfctl, scan_ch);
 		if (ch_set_idx >= 0)
 			scan_type = rfctl->channel_set[ch_set_idx].ScanType;
 		else
@@ -14769,7 +15492,7 @@ static u8 sitesurvey_pick_ch_behavior(_adapter *padapter, u8 *ch, RT_SCAN_TYPE *
 			&& pmlmeext->sitesurvey_res.ssid_num
 			&& rtw_is_dfs_ch(ss->ch[ss->channel_idx - 1].hw_value)
 		) {
-			ch_set_idx = rtw_chset_search_ch(rfctl->channel_set, ss->ch[ss->channel_idx - 1].hw_value);
+			ch_set_idx = rtw_rfctl_search_ch(rfctl, ss->ch[ss->channel_idx - 1].hw_value);
 			if (ch_set_idx != -1 && rfctl->channel_set[ch_set_idx].hidden_bss_cnt) {
 				ss->channel_idx--;
 				ss->dfs_ch_ssid_scan = 1;
@@ -15234,8 +15957,17 @@ u8 sitesurvey_cmd_hdl(_adapter *padapter, u8 *pbuf)
 #endif /* DBG_CHECK_FW_PS_STATE */
 
 	/* increase channel idx */
-	if (mlmeext_chk_scan_state(pmlmeext, SCAN_PROCESS))
+	if (mlmeext_chk_scan_state(pmlmeext, SCAN_PROCESS)) {
+#ifdef CONFIG_RTW_80211K
+		if (ss->channel_idx < ss->ch_num
+			#ifdef CONFIG_P2P
+			&& rtw_p2p_chk_state(pwdinfo, P2P_STATE_NONE)
+			#endif
+		)
+			rm_scan_ch_done(padapter, &ss->ch[ss->channel_idx]);
+#endif
 		ss->channel_idx++;
+	}
 
 	/* update scan state to next state (assigned by previous cmd hdl) */
 	if (mlmeext_scan_state(pmlmeext) != mlmeext_scan_next_state(pmlmeext))
@@ -16517,6 +17249,7 @@ u8 set_chplan_hdl(_adapter *padapter, unsigned char *pbuf)
 	rfctl->ChannelPlan = setChannelPlan_param->channel_plan;
 
 	rfctl->max_chan_nums = init_channel_set(padapter, rfctl->ChannelPlan, rfctl->channel_set);
+	rtw_chset_map_build(&rfctl->ch_map, rfctl->channel_set);
 	init_channel_list(padapter, rfctl->channel_set, &rfctl->channel_list);
 #ifdef CONFIG_TXPWR_LIMIT
 	rtw_txpwr_init_regd(rfctl);
@@ -171,6 +171,27 @@ void rtw_odm_adaptivity_parm_msg(void *sel, _adapter *adapter)
 	);
 }
 
+void rtw_odm_watchdog_io_msg(void *sel, _adapter *adapter)
+{
+	struct dm_struct *odm = adapter_to_phydm(adapter);
+
+	RTW_PRINT_SEL(sel, "%-12s %-14s %-12s %-11s\n"
+		, "fa_snapshot", "watchdog_io", "fa_io", "io_total");
+	RTW_PRINT_SEL(sel, "%-12d %-14u %-12u %-11u\n"
+		, odm->fa_snapshot_en
+		, odm->watchdog_io_cnt
+		, odm->fa_io_cnt
+		, odm->io_cnt
+	);
+}
+
+void rtw_odm_watchdog_io_set(_adapter *adapter, u8 fa_snapshot_en)
+{
+	struct dm_struct *odm = adapter_to_phydm(adapter);
+
+	odm->fa_snapshot_en = fa_snapshot_en ? true : false;
+}
+
 void rtw_odm_adaptivity_parm_set(_adapter *adapter, s8 th_l2h_ini, s8 th_edcca_hl_diff, s8 th_l2h_ini_mode2, s8 th_edcca_hl_diff_mode2, u8 edcca_enable)
 {
 	struct dm_struct *odm = adapter_to_phydm(adapter);
@@ -258,6 +279,31 @@ inline BOOLEAN rtw_odm_radar_detect(_adapter *adapter)
 {
 	return phydm_radar_detect(adapter_to_phydm(adapter));
 }
+
+/* fill pulse counts and flags of last rtw_odm_radar_detect() */
+void rtw_odm_radar_detect_get_evt(_adapter *adapter, struct radar_evt *evt)
+{
+	struct phydm_radar_rpt rpt;
+
+	phydm_radar_detect_get_rpt(adapter_to_phydm(adapter), &rpt);
+
+	evt->short_pulse = rpt.short_pulse_cnt_inc;
+	evt->long_pulse = rpt.long_pulse_cnt_inc;
+	evt->fa = rpt.fa_count_inc;
+	evt->flags = 0;
+	if (rpt.tri_short_pulse)
+		evt->flags |= RADAR_EVT_F_TRI_SHORT;
+	if (rpt.tri_long_pulse)
+		evt->flags |= RADAR_EVT_F_TRI_LONG;
+	if (rpt.long_pulse_filtered)
+		evt->flags |= RADAR_EVT_F_LONG_FILTERED;
+	if (rpt.fa_masked)
+		evt->flags |= RADAR_EVT_F_FA_MASKED;
+	if (rpt.hist_masked)
+		evt->flags |= RADAR_EVT_F_HIST_MASKED;
+	if (rpt.detected)
+		evt->flags |= RADAR_EVT_F_DETECTED;
+}
 #endif /* CONFIG_DFS_MASTER */
 
 void rtw_odm_parse_rx_phy_status_chinfo(union recv_frame *rframe, u8 *phys)
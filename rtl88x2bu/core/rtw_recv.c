@@ -639,7 +639,7 @@ union recv_frame *decryptor(_adapter *padapter, union recv_frame *precv_frame)
 #ifdef CONFIG_WAPI_SUPPORT
 		case _SMS4_:
 			DBG_COUNTER(padapter->rx_logs.core_rx_post_decrypt_wapi);
-			rtw_sms4_decrypt(padapter, (u8 *)precv_frame);
+			res = rtw_sms4_decrypt(padapter, (u8 *)precv_frame);
 			break;
 #endif
 		default:
@@ -1125,6 +1125,9 @@ void count_rx_stats(_adapter *padapter, union recv_frame *prframe, struct sta_in
 			/*record rx packets for every tid*/
 			pstats->rx_data_qos_pkts[pattrib->priority]++;
 		}
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+		rtw_lstats_count(&padapter->lstats, 0, pattrib->priority, is_ra_bmc, 1);
+#endif
 #ifdef CONFIG_DYNAMIC_SOML
 		rtw_dyn_soml_byte_update(padapter, pattrib->data_rate, sz);
 #endif
@@ -1953,6 +1956,10 @@ sint validate_recv_mgnt_frame(PADAPTER padapter, union recv_frame *precv_frame)
 	if (psta) {
 		psta->sta_stats.last_rx_time = rtw_get_current_time();
 		psta->sta_stats.rx_mgnt_pkts++;
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+		rtw_lstats_count_mgmt_rx(&padapter->lstats
+			, get_frame_sub_type(precv_frame->u.hdr.rx_data) == WIFI_ACTION);
+#endif
 		if (get_frame_sub_type(precv_frame->u.hdr.rx_data) == WIFI_BEACON)
 			psta->sta_stats.rx_beacon_pkts++;
 		else if (get_frame_sub_type(precv_frame->u.hdr.rx_data) == WIFI_PROBEREQ)
@@ -2236,7 +2243,7 @@ sint validate_recv_frame(_adapter *adapter, union recv_frame *precv_frame)
 
 #ifdef CONFIG_FIND_BEST_CHANNEL
 	if (pmlmeext->sitesurvey_res.state == SCAN_PROCESS) {
-		int ch_set_idx = rtw_chset_search_ch(rfctl->channel_set, rtw_get_oper_ch(adapter));
+		int ch_set_idx = rtw_rfctl_search_ch(rfctl, rtw_get_oper_ch(adapter));
 		if (ch_set_idx >= 0)
 			rfctl->channel_set[ch_set_idx].rx_count++;
 	}
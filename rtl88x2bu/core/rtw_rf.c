@@ -1632,6 +1632,195 @@ inline struct txpwr_lmt_ent *rtw_txpwr_lmt_get_by_name(struct rf_ctl_t *rfctl, c
 	return ent;
 }
 
+/*
+* get txpwr limit absolute value of regd_name from txpwr_lmt_list
+* min value of all regds is used for WW regd or WW limit
+* MAX_POWER_INDEX is returned when NO limit
+* txpwr_lmt_mutex must be held
+*/
+s8 _rtw_txpwr_lmt_get_from_list(struct rf_ctl_t *rfctl, const char *regd_name
+	, u8 band, u8 bw, u8 tlrs, u8 ntx_idx, u8 ch_idx)
+{
+	struct txpwr_lmt_ent *ent = NULL;
+	_list *cur, *head;
+	u8 is_ww_regd = 0;
+	s8 lmt = MAX_POWER_INDEX;
+
+	if (!regd_name || rfctl->txpwr_regd_num == 0
+		|| strcmp(regd_name, regd_str(TXPWR_LMT_NONE)) == 0)
+		goto exit;
+
+	if (strcmp(regd_name, regd_str(TXPWR_LMT_WW)) == 0)
+		is_ww_regd = 1;
+
+	if (!is_ww_regd) {
+		ent = _rtw_txpwr_lmt_get_by_name(rfctl, regd_name);
+		if (!ent)
+			goto exit;
+	}
+
+	if (band == BAND_ON_2_4G) {
+		if (!is_ww_regd) {
+			lmt = ent->lmt_2g[bw][tlrs][ch_idx][ntx_idx];
+			if (lmt != -MAX_POWER_INDEX)
+				goto exit;
+		}
+
+		/* search for min value for WW regd or WW limit */
+		lmt = MAX_POWER_INDEX;
+		head = &rfctl->txpwr_lmt_list;
+		cur = get_next(head);
+		while ((rtw_end_of_queue_search(head, cur)) == _FALSE) {
+			ent = LIST_CONTAINOR(cur, struct txpwr_lmt_ent, list);
+			cur = get_next(cur);
+			if (ent->lmt_2g[bw][tlrs][ch_idx][ntx_idx] != -MAX_POWER_INDEX)
+				lmt = rtw_min(lmt, ent->lmt_2g[bw][tlrs][ch_idx][ntx_idx]);
+		}
+	}
+	#ifdef CONFIG_IEEE80211_BAND_5GHZ
+	else if (band == BAND_ON_5G) {
+		if (!is_ww_regd) {
+			lmt = ent->lmt_5g[bw][tlrs - 1][ch_idx][ntx_idx];
+			if (lmt != -MAX_POWER_INDEX)
+				goto exit;
+		}
+
+		/* search for min value for WW regd or WW limit */
+		lmt = MAX_POWER_INDEX;
+		head = &rfctl->txpwr_lmt_list;
+		cur = get_next(head);
+		while ((rtw_end_of_queue_search(head, cur)) == _FALSE) {
+			ent = LIST_CONTAINOR(cur, struct txpwr_lmt_ent, list);
+			cur = get_next(cur);
+			if (ent->lmt_5g[bw][tlrs - 1][ch_idx][ntx_idx] != -MAX_POWER_INDEX)
+				lmt = rtw_min(lmt, ent->lmt_5g[bw][tlrs - 1][ch_idx][ntx_idx]);
+		}
+	}
+	#endif
+
+exit:
+	return lmt;
+}
+
+static void rtw_txpwr_lmt_tbl_free_rcu_callback(rtw_rcu_head *head)
+{
+	struct txpwr_lmt_tbl *tbl;
+
+	tbl = container_of(head, struct txpwr_lmt_tbl, rcu);
+	rtw_mfree(tbl, sizeof(struct txpwr_lmt_tbl));
+}
+
+static void _rtw_txpwr_lmt_tbl_swap(struct rf_ctl_t *rfctl, struct txpwr_lmt_tbl *tbl)
+{
+	struct txpwr_lmt_tbl *old;
+
+	old = rtw_rcu_dereference_protected(rfctl->txpwr_lmt_tbl, 1);
+	rtw_rcu_assign_pointer(rfctl->txpwr_lmt_tbl, tbl);
+	if (old)
+		call_rcu(&old->rcu, rtw_txpwr_lmt_tbl_free_rcu_callback);
+}
+
+/*
+* compile txpwr limit of current regd_name into txpwr_lmt_tbl
+* must be called after any change of regd_name or txpwr_lmt_list
+* txpwr_lmt_mutex must be held
+*/
+void _rtw_txpwr_lmt_tbl_build(struct rf_ctl_t *rfctl)
+{
+	struct txpwr_lmt_tbl *tbl = NULL;
+	u8 bw, tlrs, ch_idx, ntx_idx;
+
+	if (!rfctl->regd_name)
+		goto swap;
+
+	tbl = (struct txpwr_lmt_tbl *)rtw_zmalloc(sizeof(struct txpwr_lmt_tbl));
+	if (!tbl) {
+		RTW_ERR("%s alloc fail\n", __func__);
+		goto swap;
+	}
+
+	tbl->regd_name = rfctl->regd_name;
+
+	for (bw = 0; bw < MAX_2_4G_BANDWIDTH_NUM; bw++)
+		for (tlrs = 0; tlrs < TXPWR_LMT_RS_NUM_2G; tlrs++)
+			for (ch_idx = 0; ch_idx < CENTER_CH_2G_NUM; ch_idx++)
+				for (ntx_idx = 0; ntx_idx < MAX_TX_COUNT; ntx_idx++)
+					tbl->lmt_2g[bw][tlrs][ch_idx][ntx_idx] = _rtw_txpwr_lmt_get_from_list(rfctl
+						, tbl->regd_name, BAND_ON_2_4G, bw, tlrs, ntx_idx, ch_idx);
+	#ifdef CONFIG_IEEE80211_BAND_5GHZ
+	for (bw = 0; bw < MAX_5G_BANDWIDTH_NUM; bw++)
+		for (tlrs = 0; tlrs < TXPWR_LMT_RS_NUM_5G; tlrs++)
+			for (ch_idx = 0; ch_idx < CENTER_CH_5G_ALL_NUM; ch_idx++)
+				for (ntx_idx = 0; ntx_idx < MAX_TX_COUNT; ntx_idx++)
+					tbl->lmt_5g[bw][tlrs][ch_idx][ntx_idx] = _rtw_txpwr_lmt_get_from_list(rfctl
+						, tbl->regd_name, BAND_ON_5G, bw, tlrs + 1, ntx_idx, ch_idx);
+	#endif
+
+swap:
+	_rtw_txpwr_lmt_tbl_swap(rfctl, tbl);
+}
+
+/* compare txpwr_lmt_tbl with the value got from txpwr_lmt_list */
+void dump_txpwr_lmt_tbl_chk(void *sel, _adapter *adapter)
+{
+	struct rf_ctl_t *rfctl = adapter_to_rfctl(adapter);
+	struct txpwr_lmt_tbl *tbl;
+	_irqL irqL;
+	u8 bw, tlrs, ch_idx, ntx_idx;
+	s8 lmt, list_lmt;
+	u32 cnt = 0, diff_cnt = 0;
+
+	_enter_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
+
+	tbl = rtw_rcu_dereference_protected(rfctl->txpwr_lmt_tbl, 1);
+	if (!tbl) {
+		RTW_PRINT_SEL(sel, "no txpwr_lmt_tbl, regd_name:%s\n"
+			, rfctl->regd_name ? rfctl->regd_name : "N/A");
+		goto release_lock;
+	}
+
+	RTW_PRINT_SEL(sel, "regd_name:%s, tbl regd_name:%s\n"
+		, rfctl->regd_name ? rfctl->regd_name : "N/A", tbl->regd_name);
+
+	for (bw = 0; bw < MAX_2_4G_BANDWIDTH_NUM; bw++)
+		for (tlrs = 0; tlrs < TXPWR_LMT_RS_NUM_2G; tlrs++)
+			for (ch_idx = 0; ch_idx < CENTER_CH_2G_NUM; ch_idx++)
+				for (ntx_idx = 0; ntx_idx < MAX_TX_COUNT; ntx_idx++) {
+					lmt = tbl->lmt_2g[bw][tlrs][ch_idx][ntx_idx];
+					list_lmt = _rtw_txpwr_lmt_get_from_list(rfctl, rfctl->regd_name
+						, BAND_ON_2_4G, bw, tlrs, ntx_idx, ch_idx);
+					cnt++;
+					if (lmt == list_lmt)
+						continue;
+					diff_cnt++;
+					RTW_PRINT_SEL(sel, "[%s][%s][%s][%uT][%u] tbl:%d list:%d\n"
+						, band_str(BAND_ON_2_4G), ch_width_str(bw), txpwr_lmt_rs_str(tlrs)
+						, ntx_idx + 1, ch_idx + 1, lmt, list_lmt);
+				}
+	#ifdef CONFIG_IEEE80211_BAND_5GHZ
+	for (bw = 0; bw < MAX_5G_BANDWIDTH_NUM; bw++)
+		for (tlrs = 0; tlrs < TXPWR_LMT_RS_NUM_5G; tlrs++)
+			for (ch_idx = 0; ch_idx < CENTER_CH_5G_ALL_NUM; ch_idx++)
+				for (ntx_idx = 0; ntx_idx < MAX_TX_COUNT; ntx_idx++) {
+					lmt = tbl->lmt_5g[bw][tlrs][ch_idx][ntx_idx];
+					list_lmt = _rtw_txpwr_lmt_get_from_list(rfctl, rfctl->regd_name
+						, BAND_ON_5G, bw, tlrs + 1, ntx_idx, ch_idx);
+					cnt++;
+					if (lmt == list_lmt)
+						continue;
+					diff_cnt++;
+					RTW_PRINT_SEL(sel, "[%s][%s][%s][%uT][%u] tbl:%d list:%d\n"
+						, band_str(BAND_ON_5G), ch_width_str(bw), txpwr_lmt_rs_str(tlrs + 1)
+						, ntx_idx + 1, center_ch_5g_all[ch_idx], lmt, list_lmt);
+				}
+	#endif
+
+	RTW_PRINT_SEL(sel, "%u entries checked, %u diff\n", cnt, diff_cnt);
+
+release_lock:
+	_exit_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
+}
+
 void rtw_txpwr_lmt_list_free(struct rf_ctl_t *rfctl)
 {
 	struct txpwr_lmt_ent *ent;
@@ -1652,6 +1841,7 @@ void rtw_txpwr_lmt_list_free(struct rf_ctl_t *rfctl)
 		rtw_vmfree((u8 *)ent, sizeof(struct txpwr_lmt_ent) + strlen(ent->regd_name) + 1);
 	}
 	rfctl->txpwr_regd_num = 0;
+	_rtw_txpwr_lmt_tbl_swap(rfctl, NULL);
 
 	_exit_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
 }
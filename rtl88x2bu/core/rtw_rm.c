@@ -466,16 +466,12 @@ int ready_for_scan(struct rm_obj *prm)
 	return _SUCCESS;
 }
 
-int rm_sitesurvey(struct rm_obj *prm)
+static u8 rm_set_meas_ch_set(struct rm_obj *prm)
 {
-	int meas_ch_num=0;
-	u8 ch_num=0, op_class=0, val8;
+	u8 ch_num=0, op_class=0;
 	struct rtw_ieee80211_channel *pch_set;
-	struct sitesurvey_parm parm;
 
 
-	RTW_INFO("RM: rmid=%x %s\n",prm->rmid, __func__);
-
 	pch_set = &prm->q.ch_set[0];
 
 	_rtw_memset(pch_set, 0,
@@ -494,12 +490,213 @@ int rm_sitesurvey(struct rm_obj *prm)
 		ch_num = prm->q.ch_num;
 
 	/* get means channel */
-	meas_ch_num = rm_get_ch_set(pch_set, op_class, ch_num);
-	prm->q.ch_set_ch_amount = meas_ch_num;
+	prm->q.ch_set_ch_amount = rm_get_ch_set(pch_set, op_class, ch_num);
+
+	return prm->q.ch_set_ch_amount;
+}
+
+/*
+ * A dwell answers a request if it is recent enough and collected the same
+ * kind of frames: an active request needs probe responses, and one for a
+ * specific SSID needs that SSID probed, hidden BSSs don't answer wildcard.
+ * prm may be NULL to check the age only
+ */
+static bool rm_ch_scan_fresh(_adapter *padapter, u8 ch, struct rm_obj *prm)
+{
+	struct rm_priv *prmpriv = &padapter->rmpriv;
+	struct rm_ch_dwell *dwell;
+	NDIS_802_11_SSID *ssid;
+	int idx;
+
+
+	if (prmpriv->bcn_cache_fresh_ms == 0)
+		return _FALSE;
+
+	idx = rtw_rfctl_search_ch(adapter_to_rfctl(padapter), ch);
+	if (idx < 0 || prmpriv->ch_dwell[idx].time == 0)
+		return _FALSE;
+	dwell = &prmpriv->ch_dwell[idx];
+
+	if (rtw_get_passing_time_ms(dwell->time) >= prmpriv->bcn_cache_fresh_ms)
+		return _FALSE;
+
+	if (prm == NULL || prm->q.m_mode != bcn_req_active)
+		return _TRUE;
+
+	if (dwell->active == _FALSE)
+		return _FALSE;
+
+	ssid = &prm->q.opt.bcn.ssid;
+	if (ssid->SsidLength == 0)
+		return _TRUE;
+
+	return (dwell->ssid.SsidLength == ssid->SsidLength
+		&& _rtw_memcmp(dwell->ssid.Ssid, ssid->Ssid, ssid->SsidLength) == _TRUE);
+}
+
+/*
+ * Beacon request planner: channels dwelled on within bcn_cache_fresh_ms
+ * with a matching scan mode and SSID are answered from scanned_queue, only
+ * the stale ones are copied to pscan_ch (may be NULL) for an off-channel scan.
+ * return the number of stale channels
+ */
+u8 rm_bcn_cache_plan(struct rm_obj *prm, struct rtw_ieee80211_channel *pscan_ch)
+{
+	_adapter *padapter = prm->psta->padapter;
+	u8 i, meas_ch_num, scan_ch_num = 0;
+
+
+	meas_ch_num = rm_set_meas_ch_set(prm);
+
+	for (i = 0; i < meas_ch_num; i++) {
+		if (rm_ch_scan_fresh(padapter, prm->q.ch_set[i].hw_value, prm))
+			continue;
+		if (pscan_ch)
+			pscan_ch[scan_ch_num] = prm->q.ch_set[i];
+		scan_ch_num++;
+	}
+
+	return scan_ch_num;
+}
+
+/* called on every completed channel dwell of a site survey */
+void rm_scan_ch_done(_adapter *padapter, struct rtw_ieee80211_channel *ch)
+{
+	struct rm_priv *prmpriv = &padapter->rmpriv;
+	struct ss_res *ss = &padapter->mlmeextpriv.sitesurvey_res;
+	struct rm_ch_dwell *dwell;
+	int idx;
+
+
+	idx = rtw_rfctl_search_ch(adapter_to_rfctl(padapter), ch->hw_value);
+	if (idx < 0)
+		return;
+	dwell = &prmpriv->ch_dwell[idx];
+
+	dwell->time = rtw_get_current_time();
+	/* same condition site_survey() sends probe requests on */
+	dwell->active = (ss->scan_mode == SCAN_ACTIVE
+		&& !(ch->flags & RTW_IEEE80211_CHAN_PASSIVE_SCAN)) ? _TRUE : _FALSE;
+	/* several SSIDs in one scan are not tracked, count it as wildcard */
+	if (dwell->active == _TRUE && ss->ssid_num == 1)
+		_rtw_memcpy(&dwell->ssid, &ss->ssid[0], sizeof(dwell->ssid));
+	else
+		_rtw_memset(&dwell->ssid, 0, sizeof(dwell->ssid));
+}
+
+/* scanned_queue was emptied, nothing can be served from it */
+void rm_bcn_cache_flush(_adapter *padapter)
+{
+	struct rm_priv *prmpriv = &padapter->rmpriv;
+
+
+	_rtw_memset(prmpriv->ch_dwell, 0, sizeof(prmpriv->ch_dwell));
+}
+
+void rm_set_bcn_cache_fresh_ms(_adapter *padapter, u32 ms)
+{
+	struct rm_priv *prmpriv = &padapter->rmpriv;
+
+
+	/* older entries are aged out of scanned_queue on next scan */
+	if (ms >= SCANQUEUE_LIFETIME)
+		ms = SCANQUEUE_LIFETIME - 1;
+
+	prmpriv->bcn_cache_fresh_ms = ms;
+}
+
+static void rm_bcn_cache_account(struct rm_obj *prm)
+{
+	struct rm_priv *prmpriv = &prm->psta->padapter->rmpriv;
+	u32 lat_ms;
+
+
+	lat_ms = rtw_get_passing_time_ms(prm->meas_req_time);
+
+	prmpriv->bcn_rep_cnt++;
+	if (prm->bcn_scan_ch_num == 0)
+		prmpriv->bcn_rep_cached_cnt++;
+
+	prmpriv->bcn_lat_ms_last = lat_ms;
+	prmpriv->bcn_lat_ms_sum += lat_ms;
+	if (lat_ms > prmpriv->bcn_lat_ms_max)
+		prmpriv->bcn_lat_ms_max = lat_ms;
+}
+
+void rm_dump_bcn_cache(void *sel, _adapter *padapter)
+{
+	struct rm_priv *prmpriv = &padapter->rmpriv;
+	RT_CHANNEL_INFO *chset = adapter_to_chset(padapter);
+	struct rm_ch_dwell *dwell;
+	u32 ch_total;
+	int i;
+
+
+	ch_total = prmpriv->bcn_ch_cached_cnt + prmpriv->bcn_ch_scanned_cnt;
+
+	RTW_PRINT_SEL(sel, "fresh_ms=%u\n", prmpriv->bcn_cache_fresh_ms);
+	RTW_PRINT_SEL(sel, "reports=%u, cache_only=%u (%u%%)\n"
+		, prmpriv->bcn_rep_cnt, prmpriv->bcn_rep_cached_cnt
+		, prmpriv->bcn_rep_cnt ?
+			prmpriv->bcn_rep_cached_cnt * 100 / prmpriv->bcn_rep_cnt : 0);
+	RTW_PRINT_SEL(sel, "channels cached=%u, scanned=%u (%u%% cached)\n"
+		, prmpriv->bcn_ch_cached_cnt, prmpriv->bcn_ch_scanned_cnt
+		, ch_total ? prmpriv->bcn_ch_cached_cnt * 100 / ch_total : 0);
+	RTW_PRINT_SEL(sel, "latency_ms last=%u, avg=%u, max=%u\n"
+		, prmpriv->bcn_lat_ms_last
+		, prmpriv->bcn_rep_cnt ?
+			(u32)rtw_division64(prmpriv->bcn_lat_ms_sum, prmpriv->bcn_rep_cnt) : 0
+		, prmpriv->bcn_lat_ms_max);
+
+	RTW_PRINT_SEL(sel, "%3s %8s %4s %s\n", "ch", "age_ms", "mode", "ssid");
+	for (i = 0; i < MAX_CHANNEL_NUM && chset[i].ChannelNum != 0; i++) {
+		dwell = &prmpriv->ch_dwell[i];
+		if (dwell->time == 0)
+			continue;
+		RTW_PRINT_SEL(sel, "%3u %8u %4s \"%.*s\"%s\n", chset[i].ChannelNum
+			, (u32)rtw_get_passing_time_ms(dwell->time)
+			, dwell->active ? "A" : "P"
+			, (int)rtw_min(dwell->ssid.SsidLength, (u32)WLAN_SSID_MAXLEN), dwell->ssid.Ssid
+			, rm_ch_scan_fresh(padapter, chset[i].ChannelNum, NULL) ? "" : " stale");
+	}
+}
+
+int rm_sitesurvey(struct rm_obj *prm)
+{
+	_adapter *padapter = prm->psta->padapter;
+	struct rm_priv *prmpriv = &padapter->rmpriv;
+	int meas_ch_num=0;
+	struct sitesurvey_parm parm;
+
+
+	RTW_INFO("RM: rmid=%x %s\n",prm->rmid, __func__);
 
 	_rtw_memset(&parm, 0, sizeof(struct sitesurvey_parm));
-	_rtw_memcpy(parm.ch, pch_set,
-		sizeof(struct rtw_ieee80211_channel) * MAX_OP_CHANNEL_SET_NUM);
+
+	if (prm->q.m_type == bcn_req) {
+		meas_ch_num = rm_bcn_cache_plan(prm, parm.ch);
+		prm->bcn_scan_ch_num = meas_ch_num;
+		prmpriv->bcn_ch_scanned_cnt += meas_ch_num;
+		prmpriv->bcn_ch_cached_cnt +=
+			prm->q.ch_set_ch_amount - meas_ch_num;
+
+		RTW_INFO("RM: rmid=%x bcn_req %u/%u ch from scan cache\n",
+			prm->rmid, prm->q.ch_set_ch_amount - meas_ch_num,
+			prm->q.ch_set_ch_amount);
+
+		if (meas_ch_num == 0) {
+			_rm_post_event(padapter, prm->rmid, RM_EV_survey_done);
+			return _SUCCESS;
+		}
+		/*
+		 * stale channels go through a normal site survey, traffic is
+		 * served in between by CONFIG_SCAN_BACKOP like any other scan
+		 */
+	} else {
+		meas_ch_num = rm_set_meas_ch_set(prm);
+		_rtw_memcpy(parm.ch, prm->q.ch_set,
+			sizeof(struct rtw_ieee80211_channel) * MAX_OP_CHANNEL_SET_NUM);
+	}
 
 	_rtw_memcpy(&parm.ssid[0], &prm->q.opt.bcn.ssid, IW_ESSID_MAX_SIZE);
 
@@ -1456,7 +1653,7 @@ static int retrieve_scan_result(struct rm_obj *prm)
 		* report network if requested channel set contains
 		* the channel matchs selected network
 		*/
-		if (rtw_chset_search_ch(adapter_to_chset(padapter),
+		if (rtw_rfctl_search_ch(adapter_to_rfctl(padapter),
 			pbss->Configuration.DSConfig) == 0)
 			goto next;
 
@@ -1564,6 +1761,7 @@ int issue_beacon_rep(struct rm_obj *prm)
 
 
 	pkt_num = retrieve_scan_result(prm);
+	rm_bcn_cache_account(prm);
 
 	if (pkt_num == 0) {
 		issue_null_reply(prm);
@@ -1877,7 +2075,7 @@ int retrieve_radio_meas_result(struct rm_obj *prm)
 	u8 val8;
 
 
-	ch = rtw_chset_search_ch(adapter_to_chset(prm->psta->padapter),
+	ch = rtw_rfctl_search_ch(adapter_to_rfctl(prm->psta->padapter),
 		prm->q.ch_num);
 
 	if ((ch == -1) || (ch >= MAX_CHANNEL_NUM)) {
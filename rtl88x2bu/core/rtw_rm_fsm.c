@@ -116,6 +116,7 @@ int rtw_init_rm(_adapter *padapter)
 		/*| BIT(RM_ANT_CAP_EN - 32)*/;
 
 	prmpriv->enable = _TRUE;
+	prmpriv->bcn_cache_fresh_ms = RM_BCN_CACHE_FRESH_MS;
 
 	/* clock timer */
 	rtw_init_timer(&prmpriv->rm_timer,
@@ -620,6 +621,9 @@ static int rm_state_do_meas(struct rm_obj *prm, enum RM_EV_ID evid)
 
 	switch (evid) {
 	case RM_EV_state_in:
+		prm->meas_req_time = rtw_get_current_time();
+		prm->bcn_scan_ch_num = 0;
+
 		if (prm->q.action_code == RM_ACT_RADIO_MEAS_REQ) {
 			switch (prm->q.m_type) {
 			case bcn_req:
@@ -630,6 +634,12 @@ static int rm_state_do_meas(struct rm_obj *prm, enum RM_EV_ID evid)
 						RM_EV_survey_done);
 					return _SUCCESS;
 				}
+				/* all channels fresh, no need to wait for idle */
+				if (rm_bcn_cache_plan(prm, NULL) == 0) {
+					_rm_post_event(padapter, prm->rmid,
+						RM_EV_start_meas);
+					return _SUCCESS;
+				}
 				break;
 			case ch_load_req:
 			case noise_histo_req:
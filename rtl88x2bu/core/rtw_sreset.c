@@ -17,6 +17,35 @@
 #include <hal_data.h>
 #include <rtw_sreset.h>
 
+/* per station state which has to survive a silent reset */
+struct sreset_sta_snap {
+	struct sta_info *sta;
+	u8 mac_id;
+	u8 tx_agg_bmp;
+	u8 tx_agg_candidate;
+	u16 rx_ba_bmp;
+};
+
+struct sreset_snapshot {
+	u8 cam_num;
+	u8 cam_id[SEC_CAM_ENT_NUM_SW_LIMIT];
+	struct sec_cam_bmp cam_used;
+	struct sec_cam_ent cam_cache[SEC_CAM_ENT_NUM_SW_LIMIT];
+	u8 cam_restored;
+
+	u8 sta_num;
+	struct sreset_sta_snap sta[MACID_NUM_SW_LIMIT];
+};
+
+static const char *const _sreset_tier_str[] = {
+	"LIGHT",
+	"MEDIUM",
+	"FULL",
+	"UNKNOWN",
+};
+
+#define sreset_tier_str(tier) (((tier) >= SRESET_TIER_NUM) ? _sreset_tier_str[SRESET_TIER_NUM] : _sreset_tier_str[(tier)])
+
 void sreset_init_value(_adapter *padapter)
 {
 #if defined(DBG_CONFIG_ERROR_DETECT)
@@ -28,6 +57,14 @@ void sreset_init_value(_adapter *padapter)
 	psrtpriv->Wifi_Error_Status = WIFI_STATUS_SUCCESS;
 	psrtpriv->last_tx_time = 0;
 	psrtpriv->last_tx_complete_time = 0;
+	psrtpriv->cur_tier = SRESET_TIER_FULL;
+	psrtpriv->snap = NULL;
+	psrtpriv->last_case = 0;
+	psrtpriv->last_tier = SRESET_TIER_NUM;
+	psrtpriv->last_reset_time = 0;
+	psrtpriv->rehang_cnt = 0;
+	psrtpriv->dbg_force_tier = SRESET_TIER_NUM;
+	psrtpriv->dbg_fail_tier = 0;
 #endif
 }
 void sreset_reset_value(_adapter *padapter)
@@ -110,6 +147,7 @@ void sreset_restore_security_station(_adapter *padapter)
 	struct sta_info *psta;
 	struct security_priv *psecuritypriv = &(padapter->securitypriv);
 	struct mlme_ext_info	*pmlmeinfo = &padapter->mlmeextpriv.mlmext_info;
+	struct sreset_priv *psrtpriv = &GET_HAL_DATA(padapter)->srestpriv;
 
 	{
 		u8 val8;
@@ -126,6 +164,10 @@ void sreset_restore_security_station(_adapter *padapter)
 		rtw_hal_set_hwreg(padapter, HW_VAR_SEC_CFG, (u8 *)(&val8));
 	}
 
+	/* keys are already written back from snapshot */
+	if (psrtpriv->snap && psrtpriv->snap->cam_restored)
+		return;
+
 	if ((padapter->securitypriv.dot11PrivacyAlgrthm == _TKIP_) ||
 	    (padapter->securitypriv.dot11PrivacyAlgrthm == _AES_)) {
 		psta = rtw_get_stainfo(pstapriv, get_bssid(mlmepriv));
@@ -271,7 +313,9 @@ void sreset_start_adapter(_adapter *padapter)
 
 	RTW_INFO(FUNC_ADPT_FMT"\n", FUNC_ADPT_ARG(padapter));
 
-	if (check_fwstate(pmlmepriv, _FW_LINKED))
+	/* light tier keeps MAC setting, no need to rebuild link */
+	if (check_fwstate(pmlmepriv, _FW_LINKED)
+		&& GET_HAL_DATA(padapter)->srestpriv.cur_tier != SRESET_TIER_LIGHT)
 		sreset_restore_network_status(padapter);
 
 	/* TODO: OS and HCI independent */
@@ -285,6 +329,255 @@ void sreset_start_adapter(_adapter *padapter)
 	rtw_netif_wake_queue(padapter->pnetdev);
 }
 
+#ifdef DBG_CONFIG_ERROR_RESET
+static struct sreset_snapshot *sreset_snapshot_take(_adapter *padapter)
+{
+	struct dvobj_priv *dvobj = adapter_to_dvobj(padapter);
+	struct cam_ctl_t *cam_ctl = dvobj_to_sec_camctl(dvobj);
+	struct macid_ctl_t *macid_ctl = dvobj_to_macidctl(dvobj);
+	struct sreset_snapshot *snap;
+	struct sreset_sta_snap *sta_snap;
+	struct sta_info *psta;
+	_irqL irqL;
+	u8 i, tid;
+
+	snap = (struct sreset_snapshot *)rtw_zmalloc(sizeof(struct sreset_snapshot));
+	if (!snap) {
+		RTW_WARN("%s: alloc snapshot fail\n", __func__);
+		return NULL;
+	}
+
+	_enter_critical_bh(&cam_ctl->lock, &irqL);
+	_rtw_memcpy(&snap->cam_used, &cam_ctl->used, sizeof(struct sec_cam_bmp));
+	_rtw_memcpy(snap->cam_cache, dvobj->cam_cache, sizeof(struct sec_cam_ent) * SEC_CAM_ENT_NUM_SW_LIMIT);
+	_exit_critical_bh(&cam_ctl->lock, &irqL);
+	snap->cam_num = rtw_get_sec_camid(padapter, SEC_CAM_ENT_NUM_SW_LIMIT, snap->cam_id);
+
+	_enter_critical_bh(&macid_ctl->lock, &irqL);
+	for (i = 0; i < macid_ctl->num && i < MACID_NUM_SW_LIMIT; i++) {
+		psta = macid_ctl->sta[i];
+		if (!psta || !rtw_macid_is_used(macid_ctl, i) || rtw_macid_is_bmc(macid_ctl, i))
+			continue;
+
+		sta_snap = &snap->sta[snap->sta_num++];
+		sta_snap->sta = psta;
+		sta_snap->mac_id = i;
+		#ifdef CONFIG_80211N_HT
+		sta_snap->tx_agg_bmp = psta->htpriv.agg_enable_bitmap;
+		sta_snap->tx_agg_candidate = psta->htpriv.candidate_tid_bitmap;
+		#endif
+		for (tid = 0; tid < TID_NUM; tid++)
+			if (psta->recvreorder_ctrl[tid].enable)
+				sta_snap->rx_ba_bmp |= BIT(tid);
+	}
+	_exit_critical_bh(&macid_ctl->lock, &irqL);
+
+	return snap;
+}
+
+static void sreset_snapshot_restore_cam(_adapter *padapter, struct sreset_snapshot *snap)
+{
+	struct dvobj_priv *dvobj = adapter_to_dvobj(padapter);
+	struct cam_ctl_t *cam_ctl = dvobj_to_sec_camctl(dvobj);
+	_irqL irqL;
+	u8 i;
+
+	_enter_critical_bh(&cam_ctl->lock, &irqL);
+	_rtw_memcpy(&cam_ctl->used, &snap->cam_used, sizeof(struct sec_cam_bmp));
+	_rtw_memcpy(dvobj->cam_cache, snap->cam_cache, sizeof(struct sec_cam_ent) * SEC_CAM_ENT_NUM_SW_LIMIT);
+	_exit_critical_bh(&cam_ctl->lock, &irqL);
+
+	for (i = 0; i < snap->cam_num; i++)
+		write_cam_from_cache(padapter, snap->cam_id[i]);
+
+	snap->cam_restored = _TRUE;
+}
+
+static void sreset_snapshot_restore_sta(_adapter *padapter, struct sreset_snapshot *snap)
+{
+	struct macid_ctl_t *macid_ctl = adapter_to_macidctl(padapter);
+	struct sreset_sta_snap *sta_snap;
+	struct recv_reorder_ctrl *preorder_ctrl;
+	struct sta_info *psta;
+	u8 i, tid;
+
+	for (i = 0; i < snap->sta_num; i++) {
+		sta_snap = &snap->sta[i];
+		psta = sta_snap->sta;
+
+		/* station left during reset */
+		if (macid_ctl->sta[sta_snap->mac_id] != psta)
+			continue;
+
+		#ifdef CONFIG_80211N_HT
+		psta->htpriv.agg_enable_bitmap = sta_snap->tx_agg_bmp;
+		psta->htpriv.candidate_tid_bitmap = sta_snap->tx_agg_candidate;
+		#endif
+
+		for (tid = 0; tid < TID_NUM; tid++) {
+			if (!(sta_snap->rx_ba_bmp & BIT(tid)))
+				continue;
+			preorder_ctrl = &psta->recvreorder_ctrl[tid];
+			preorder_ctrl->enable = _TRUE;
+			/* frames in flushed RX DMA are lost, resync window by next frame */
+			preorder_ctrl->indicate_seq = 0xffff;
+		}
+
+		rtw_hal_update_ra_mask(psta);
+	}
+}
+
+static u8 sreset_select_tier(struct sreset_priv *psrtpriv)
+{
+	u8 tier;
+
+	if (psrtpriv->dbg_force_tier < SRESET_TIER_NUM)
+		return psrtpriv->dbg_force_tier;
+
+	switch (psrtpriv->self_dect_case) {
+	case 1: /* tx hang */
+	case 2: /* rx hang */
+	case 5: /* rx dma error */
+		tier = SRESET_TIER_LIGHT;
+		break;
+	case 4: /* tx dma error */
+		tier = SRESET_TIER_MEDIUM;
+		break;
+	case 3: /* fw hang */
+	default:
+		tier = SRESET_TIER_FULL;
+		break;
+	}
+
+	/* the last reset didn't cure it, don't retry the same tier */
+	if (psrtpriv->self_dect_case != 0
+		&& psrtpriv->self_dect_case == psrtpriv->last_case
+		&& psrtpriv->last_tier < SRESET_TIER_NUM
+		&& rtw_get_passing_time_ms(psrtpriv->last_reset_time) < SRESET_REHANG_MS
+	) {
+		psrtpriv->rehang_cnt++;
+		if (tier <= psrtpriv->last_tier)
+			tier = rtw_min(psrtpriv->last_tier + 1, SRESET_TIER_FULL);
+		RTW_INFO("%s: case %u again within %u ms, start from %s tier\n", __func__
+			, psrtpriv->self_dect_case, SRESET_REHANG_MS, sreset_tier_str(tier));
+	}
+
+	return tier;
+}
+
+static void sreset_hang_status_latch(_adapter *padapter)
+{
+	struct sreset_priv *psrtpriv = &GET_HAL_DATA(padapter)->srestpriv;
+
+	psrtpriv->hang_txdma_status = rtw_read32(padapter, REG_TXDMA_STATUS);
+	psrtpriv->hang_rxdma_status = rtw_read32(padapter, REG_RXDMA_STATUS);
+
+	RTW_INFO("%s: case:%u txdma:0x%08x rxdma:0x%08x\n", __func__
+		, psrtpriv->self_dect_case, psrtpriv->hang_txdma_status, psrtpriv->hang_rxdma_status);
+}
+
+static void sreset_stop_trx(_adapter *padapter)
+{
+	u32 val32;
+
+	rtw_intf_stop(padapter);
+
+	/* DMA error flags are write 1 clear */
+	val32 = rtw_read32(padapter, REG_TXDMA_STATUS);
+	if (val32 != 0 && val32 != 0xeaeaeaea)
+		rtw_write32(padapter, REG_TXDMA_STATUS, val32);
+	val32 = rtw_read32(padapter, REG_RXDMA_STATUS);
+	if (val32 != 0 && val32 != 0xeaeaeaea)
+		rtw_write32(padapter, REG_RXDMA_STATUS, val32);
+}
+
+static void sreset_start_trx(_adapter *padapter)
+{
+	RTW_ENABLE_FUNC(padapter, DF_RX_BIT);
+	RTW_ENABLE_FUNC(padapter, DF_TX_BIT);
+	rtw_intf_start(padapter);
+}
+
+static u8 sreset_do_tier(_adapter *padapter, u8 tier)
+{
+	u8 ret = _TRUE;
+
+	switch (tier) {
+	case SRESET_TIER_LIGHT:
+		sreset_stop_trx(padapter);
+		sreset_start_trx(padapter);
+		break;
+	case SRESET_TIER_MEDIUM:
+		sreset_stop_trx(padapter);
+		ret = rtw_hal_sreset_mac_reinit(padapter);
+		sreset_start_trx(padapter);
+		break;
+	case SRESET_TIER_FULL:
+	default:
+#ifdef CONFIG_IPS
+		_ips_enter(padapter);
+		_ips_leave(padapter);
+#endif
+		break;
+	}
+
+	return ret;
+}
+
+static u8 sreset_tier_check(_adapter *padapter, u8 tier)
+{
+	struct sreset_priv *psrtpriv = &GET_HAL_DATA(padapter)->srestpriv;
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	u32 txdma_status, rxdma_status;
+
+	if (psrtpriv->dbg_fail_tier & BIT(tier)) {
+		RTW_INFO("%s: %s tier fail by injection\n", __func__, sreset_tier_str(tier));
+		return _FALSE;
+	}
+
+	if (RTW_CANNOT_RUN(padapter))
+		return _FALSE;
+
+	/*
+	 * flags were cleared by sreset_stop_trx(), let TRX run for a while so
+	 * a DMA engine which is still broken can flag the error again
+	 */
+	rtw_msleep_os(SRESET_SETTLE_MS);
+
+	txdma_status = rtw_read32(padapter, REG_TXDMA_STATUS);
+	rxdma_status = rtw_read32(padapter, REG_RXDMA_STATUS);
+	if (txdma_status != 0 || rxdma_status != 0) {
+		RTW_INFO("%s: %s tier txdma:0x%08x rxdma:0x%08x (before reset 0x%08x 0x%08x)\n", __func__
+			, sreset_tier_str(tier), txdma_status, rxdma_status
+			, psrtpriv->hang_txdma_status, psrtpriv->hang_rxdma_status);
+		return _FALSE;
+	}
+
+	/* tx hang was detected by xmit buffers never coming back */
+	if (psrtpriv->self_dect_case == 1
+		&& (pxmitpriv->free_xmitbuf_cnt == 0 || pxmitpriv->free_xmit_extbuf_cnt == 0)
+	) {
+		RTW_INFO("%s: %s tier xmitbuf still exhausted\n", __func__, sreset_tier_str(tier));
+		return _FALSE;
+	}
+
+	return _TRUE;
+}
+
+static void sreset_tier_stat_update(struct sreset_priv *psrtpriv, u8 tier, u8 ok, u32 ms)
+{
+	struct sreset_tier_stat *stat = &psrtpriv->tier_stat[tier];
+
+	stat->try_cnt++;
+	if (ok)
+		stat->ok_cnt++;
+	stat->last_ms = ms;
+	stat->total_ms += ms;
+	if (ms > stat->max_ms)
+		stat->max_ms = ms;
+}
+#endif /* DBG_CONFIG_ERROR_RESET */
+
 void sreset_reset(_adapter *padapter)
 {
 #ifdef DBG_CONFIG_ERROR_RESET
@@ -295,8 +588,11 @@ void sreset_reset(_adapter *padapter)
 	struct xmit_priv	*pxmitpriv = &padapter->xmitpriv;
 	_irqL irqL;
 	systime start = rtw_get_current_time();
+	systime tier_start = start;
 	struct dvobj_priv *psdpriv = padapter->dvobj;
 	struct debug_priv *pdbgpriv = &psdpriv->drv_dbg;
+	struct sreset_snapshot *snap;
+	u8 tier, ok = _FALSE;
 
 	RTW_INFO("%s\n", __FUNCTION__);
 
@@ -312,21 +608,106 @@ void sreset_reset(_adapter *padapter)
 	psrtpriv->silent_reset_inprogress = _TRUE;
 	pwrpriv->change_rfpwrstate = rf_off;
 
+	sreset_hang_status_latch(padapter);
+	tier = sreset_select_tier(psrtpriv);
+	snap = sreset_snapshot_take(padapter);
+	psrtpriv->snap = snap;
+
 	rtw_mi_sreset_adapter_hdl(padapter, _FALSE);/*sreset_stop_adapter*/
-#ifdef CONFIG_IPS
-	_ips_enter(padapter);
-	_ips_leave(padapter);
-#endif
+
+	/* try from the cheapest tier, escalate if hardware is still unhealthy */
+	for (; tier < SRESET_TIER_NUM; tier++) {
+		psrtpriv->cur_tier = tier;
+		tier_start = rtw_get_current_time();
+
+		ok = sreset_do_tier(padapter, tier);
+		if (ok == _TRUE)
+			ok = sreset_tier_check(padapter, tier);
+		if (ok == _TRUE)
+			break;
+
+		sreset_tier_stat_update(psrtpriv, tier, _FALSE, rtw_get_passing_time_ms(tier_start));
+		RTW_WARN("%s: %s tier fail\n", __FUNCTION__, sreset_tier_str(tier));
+	}
+	if (tier >= SRESET_TIER_NUM)
+		tier = SRESET_TIER_FULL;
+
+	/* light tier doesn't touch MAC, CAM is still valid */
+	if (snap && tier != SRESET_TIER_LIGHT)
+		sreset_snapshot_restore_cam(padapter, snap);
+
 	rtw_mi_sreset_adapter_hdl(padapter, _TRUE);/*sreset_start_adapter*/
 
+	if (snap)
+		sreset_snapshot_restore_sta(padapter, snap);
+
+	if (ok == _TRUE)
+		sreset_tier_stat_update(psrtpriv, tier, _TRUE, rtw_get_passing_time_ms(tier_start));
+
+	psrtpriv->snap = NULL;
+	if (snap)
+		rtw_mfree((u8 *)snap, sizeof(struct sreset_snapshot));
+
+	psrtpriv->last_case = psrtpriv->self_dect_case;
+	psrtpriv->last_tier = tier;
+	psrtpriv->last_reset_time = rtw_get_current_time();
+	psrtpriv->self_dect_case = 0;
+
+	psrtpriv->dbg_force_tier = SRESET_TIER_NUM;
+	psrtpriv->dbg_fail_tier = 0;
 	psrtpriv->silent_reset_inprogress = _FALSE;
 
 	_exit_pwrlock(&pwrpriv->lock);
 
-	RTW_INFO("%s done in %d ms\n", __FUNCTION__, rtw_get_passing_time_ms(start));
+	RTW_INFO("%s done by %s tier in %d ms\n", __FUNCTION__, sreset_tier_str(tier), rtw_get_passing_time_ms(start));
 	pdbgpriv->dbg_sreset_cnt++;
 
 	psrtpriv->self_dect_fw = _FALSE;
 	psrtpriv->rx_cnt = 0;
 #endif
 }
+
+void sreset_dump_tier_stat(void *sel, _adapter *padapter)
+{
+#if defined(DBG_CONFIG_ERROR_DETECT)
+	struct sreset_priv *psrtpriv = &GET_HAL_DATA(padapter)->srestpriv;
+	struct sreset_tier_stat *stat;
+	u8 tier;
+
+	RTW_PRINT_SEL(sel, "%-7s %8s %8s %5s %8s %8s %8s\n"
+		, "tier", "try", "ok", "rate", "last_ms", "max_ms", "avg_ms");
+
+	for (tier = 0; tier < SRESET_TIER_NUM; tier++) {
+		stat = &psrtpriv->tier_stat[tier];
+		RTW_PRINT_SEL(sel, "%-7s %8u %8u %4u%% %8u %8u %8u\n"
+			, sreset_tier_str(tier), stat->try_cnt, stat->ok_cnt
+			, stat->try_cnt ? stat->ok_cnt * 100 / stat->try_cnt : 0
+			, stat->last_ms, stat->max_ms
+			, stat->try_cnt ? stat->total_ms / stat->try_cnt : 0);
+	}
+
+	RTW_PRINT_SEL(sel, "last_tier:%s\n", sreset_tier_str(psrtpriv->cur_tier));
+	RTW_PRINT_SEL(sel, "last_case:%u rehang_cnt:%u\n", psrtpriv->last_case, psrtpriv->rehang_cnt);
+	RTW_PRINT_SEL(sel, "hang txdma:0x%08x rxdma:0x%08x\n"
+		, psrtpriv->hang_txdma_status, psrtpriv->hang_rxdma_status);
+#endif
+}
+
+/*
+ * Start a silent reset from @tier (SRESET_TIER_NUM for auto selection),
+ * tiers set in @fail_tier bitmap would be reported as failed to test escalation.
+ */
+void sreset_inject_fault(_adapter *padapter, u8 tier, u8 fail_tier)
+{
+#if defined(DBG_CONFIG_ERROR_DETECT)
+	struct sreset_priv *psrtpriv = &GET_HAL_DATA(GET_PRIMARY_ADAPTER(padapter))->srestpriv;
+
+	psrtpriv->dbg_force_tier = tier > SRESET_TIER_NUM ? SRESET_TIER_NUM : tier;
+	psrtpriv->dbg_fail_tier = fail_tier;
+
+	RTW_INFO("%s: tier:%s fail_tier:0x%x\n", __func__
+		, sreset_tier_str(psrtpriv->dbg_force_tier), psrtpriv->dbg_fail_tier);
+
+	rtw_hal_sreset_reset(padapter);
+#endif
+}
@@ -32,6 +32,7 @@ inline void rtw_tdls_set_link_established(_adapter *adapter, bool en)
 void rtw_reset_tdls_info(_adapter *padapter)
 {
 	struct tdls_info *ptdlsinfo = &padapter->tdlsinfo;
+	_irqL irqL;
 
 	ptdlsinfo->ap_prohibited = _FALSE;
 
@@ -59,6 +60,11 @@ void rtw_reset_tdls_info(_adapter *padapter)
 	ptdlsinfo->watchdog_count = 0;
 	ptdlsinfo->dev_discovered = _FALSE;
 
+	_enter_critical_bh(&ptdlsinfo->auto_ctl.lock, &irqL);
+	_rtw_memset(ptdlsinfo->auto_ctl.peer, 0, sizeof(ptdlsinfo->auto_ctl.peer));
+	ptdlsinfo->auto_ctl.last_time = rtw_get_current_time();
+	_exit_critical_bh(&ptdlsinfo->auto_ctl.lock, &irqL);
+
 #ifdef CONFIG_WFD
 	ptdlsinfo->wfd_info = &padapter->wfd_info;
 #endif
@@ -70,6 +76,20 @@ int rtw_init_tdls_info(_adapter *padapter)
 {
 	int	res = _SUCCESS;
 	struct tdls_info *ptdlsinfo = &padapter->tdlsinfo;
+	struct tdls_auto_ctl *actl = &ptdlsinfo->auto_ctl;
+
+	_rtw_spinlock_init(&actl->lock);
+#ifdef CONFIG_TDLS_AUTOSETUP
+	actl->enable = _TRUE;
+#else
+	actl->enable = _FALSE;
+#endif
+	actl->setup_kbps = TDLS_AUTO_SETUP_KBPS;
+	actl->setup_period = TDLS_AUTO_SETUP_PERIOD;
+	actl->teardown_kbps = TDLS_AUTO_TEARDOWN_KBPS;
+	actl->teardown_period = TDLS_AUTO_TEARDOWN_PERIOD;
+	actl->rssi_margin = TDLS_AUTO_RSSI_MARGIN;
+	actl->backoff_period = TDLS_AUTO_BACKOFF_PERIOD;
 
 	rtw_reset_tdls_info(padapter);
 
@@ -90,6 +110,7 @@ void rtw_free_tdls_info(struct tdls_info *ptdlsinfo)
 {
 	_rtw_spinlock_free(&ptdlsinfo->cmd_lock);
 	_rtw_spinlock_free(&ptdlsinfo->hdl_lock);
+	_rtw_spinlock_free(&ptdlsinfo->auto_ctl.lock);
 
 	_rtw_memset(ptdlsinfo, 0, sizeof(struct tdls_info));
 
@@ -1774,7 +1795,14 @@ int On_TDLS_Dis_Rsp(_adapter *padapter, union recv_frame *precv_frame)
 	if (ptdls_sta != NULL)
 		ptdls_sta->sta_stats.rx_tdls_disc_rsp_pkts++;
 
+	if (rtw_tdls_auto_on_dis_rsp(padapter, psa, pattrib->phy_info.rx_pwdb_all, rssi) == _TRUE)
+		goto exit;
+
 #ifdef CONFIG_TDLS_AUTOSETUP
+	/* legacy setup on any discovery response, only when traffic driven manager is off */
+	if (ptdlsinfo->auto_ctl.enable == _TRUE)
+		goto exit;
+
 	if (ptdls_sta != NULL) {
 		/* Record the tdls sta with lowest signal strength */
 		if (ptdlsinfo->sta_maximum == _TRUE && ptdls_sta->alive_count >= 1) {
@@ -3502,4 +3530,485 @@ const char *rtw_tdls_action_txt(enum TDLS_ACTION_FIELD action)
 	}
 }
 
+static const char *const tdls_auto_state_str[] = {
+	"IDLE",
+	"DISCOVER",
+	"SETUP",
+	"LINKED",
+	"BACKOFF",
+	"NORSP",
+};
+
+static void rtw_tdls_auto_set_state(struct tdls_auto_peer *peer, u8 state)
+{
+	peer->state = state;
+	peer->state_cnt = 0;
+	peer->busy_cnt = 0;
+	peer->idle_cnt = 0;
+}
+
+/*
+ * Called on TX path of STA mode to account unicast traffic to peers in the
+ * same BSS, the per destination rate is sampled by rtw_tdls_auto_watchdog()
+ * Bail out before taking the lock whenever the manager can not act on the
+ * result, this runs for every unicast frame.
+ * Destinations which never answered discovery (wired hosts and gateways
+ * behind the AP, non TDLS STAs) are kept in NORSP state and not counted
+ */
+void rtw_tdls_auto_tx_update(_adapter *padapter, u8 *da, u32 len)
+{
+	struct tdls_auto_ctl *actl = &padapter->tdlsinfo.auto_ctl;
+	struct tdls_auto_peer *peer, *victim = NULL;
+	_irqL irqL;
+	int i;
+
+	if (actl->enable == _FALSE || IS_MCAST(da))
+		return;
+
+	if (rtw_is_tdls_enabled(padapter) == _FALSE
+		|| rtw_tdls_is_driver_setup(padapter) == _FALSE)
+		return;
+
+	if (_rtw_memcmp(da, get_bssid(&padapter->mlmepriv), ETH_ALEN) == _TRUE
+		|| _rtw_memcmp(da, adapter_mac_addr(padapter), ETH_ALEN) == _TRUE)
+		return;
+
+	_enter_critical_bh(&actl->lock, &irqL);
+
+	for (i = 0; i < TDLS_AUTO_PEER_NUM; i++) {
+		peer = &actl->peer[i];
+
+		if (peer->used == _FALSE) {
+			if (victim == NULL || victim->used == _TRUE)
+				victim = peer;
+			continue;
+		}
+
+		if (_rtw_memcmp(peer->addr, da, ETH_ALEN) == _TRUE) {
+			if (peer->state == TDLS_AUTO_NORSP)
+				goto exit;
+			goto update;
+		}
+
+		/* only replace entries not taking part in a handshake or link */
+		if (peer->state == TDLS_AUTO_IDLE
+			&& (victim == NULL || (victim->used == _TRUE && peer->tx_kbps < victim->tx_kbps)))
+			victim = peer;
+	}
+
+	if (victim == NULL)
+		goto exit;
+
+	peer = victim;
+	_rtw_memset(peer, 0, sizeof(*peer));
+	_rtw_memcpy(peer->addr, da, ETH_ALEN);
+	peer->used = _TRUE;
+
+update:
+	peer->tx_bytes += len;
+	peer->total_bytes += len;
+
+exit:
+	_exit_critical_bh(&actl->lock, &irqL);
+}
+
+enum tdls_auto_act {
+	TDLS_AUTO_ACT_NONE = 0,
+	TDLS_AUTO_ACT_DISCOVER,	/* send discovery request to peer */
+	TDLS_AUTO_ACT_TEARDOWN,	/* tear down direct link to peer */
+};
+
+/*
+ * Sample one peer's TX rate over period_ms and advance its state,
+ * returns what the caller has to send outside of actl->lock
+ */
+static u8 rtw_tdls_auto_peer_step(struct tdls_auto_ctl *actl, struct tdls_auto_peer *peer
+	, u32 period_ms, u8 allowed, u8 linked, int peer_rssi, int ap_rssi)
+{
+	u8 act = TDLS_AUTO_ACT_NONE;
+
+	peer->tx_kbps = (u32)rtw_division64((u64)peer->tx_bytes * 8, period_ms);
+	peer->tx_bytes = 0;
+	if (peer->state_cnt < 0xFF)
+		peer->state_cnt++;
+
+	switch (peer->state) {
+	case TDLS_AUTO_IDLE:
+		/* link set up by peer or supplicant is not managed here */
+		if (linked == _TRUE)
+			break;
+
+		if (peer->tx_kbps >= actl->setup_kbps) {
+			peer->busy_cnt++;
+			peer->idle_cnt = 0;
+		} else {
+			peer->busy_cnt = 0;
+			if (peer->tx_kbps == 0 && ++peer->idle_cnt >= TDLS_AUTO_AGE_PERIOD) {
+				peer->used = _FALSE;
+				break;
+			}
+		}
+
+		if (allowed == _TRUE && peer->busy_cnt >= actl->setup_period) {
+			rtw_tdls_auto_set_state(peer, TDLS_AUTO_DISCOVER);
+			peer->discover_cnt++;
+			act = TDLS_AUTO_ACT_DISCOVER;
+		}
+		break;
+
+	case TDLS_AUTO_DISCOVER:
+	case TDLS_AUTO_SETUP:
+		if (linked == _TRUE) {
+			rtw_tdls_auto_set_state(peer, TDLS_AUTO_LINKED);
+			peer->link_cnt++;
+		} else if (peer->state_cnt >= TDLS_AUTO_RSP_TIMEOUT) {
+			peer->fail_cnt++;
+			if (peer->state == TDLS_AUTO_DISCOVER
+				&& ++peer->no_rsp_cnt >= TDLS_AUTO_NO_RSP_MAX)
+				rtw_tdls_auto_set_state(peer, TDLS_AUTO_NORSP);
+			else
+				rtw_tdls_auto_set_state(peer, TDLS_AUTO_BACKOFF);
+		}
+		break;
+
+	case TDLS_AUTO_LINKED:
+		if (linked == _FALSE) {
+			/* torn down by peer or AP */
+			rtw_tdls_auto_set_state(peer, TDLS_AUTO_IDLE);
+			break;
+		}
+
+		if (peer->tx_kbps < actl->teardown_kbps)
+			peer->idle_cnt++;
+		else
+			peer->idle_cnt = 0;
+
+		if (peer->idle_cnt >= actl->teardown_period) {
+			rtw_tdls_auto_set_state(peer, TDLS_AUTO_IDLE);
+			peer->teardown_idle_cnt++;
+			act = TDLS_AUTO_ACT_TEARDOWN;
+		} else if (peer_rssi + actl->rssi_margin + TDLS_AUTO_RSSI_HYST < ap_rssi) {
+			rtw_tdls_auto_set_state(peer, TDLS_AUTO_BACKOFF);
+			peer->teardown_rssi_cnt++;
+			act = TDLS_AUTO_ACT_TEARDOWN;
+		}
+		break;
+
+	case TDLS_AUTO_BACKOFF:
+		if (peer->state_cnt >= actl->backoff_period)
+			rtw_tdls_auto_set_state(peer, TDLS_AUTO_IDLE);
+		break;
+
+	case TDLS_AUTO_NORSP:
+		/* peer may have been replaced by a TDLS capable one, ask again */
+		if (linked == _TRUE || peer->state_cnt >= TDLS_AUTO_NORSP_PERIOD) {
+			rtw_tdls_auto_set_state(peer, TDLS_AUTO_IDLE);
+			peer->no_rsp_cnt = 0;
+		}
+		break;
+	}
+
+	return act;
+}
+
+static u8 rtw_tdls_auto_setup_allowed(_adapter *padapter)
+{
+	struct tdls_info *ptdlsinfo = &padapter->tdlsinfo;
+
+	if (rtw_is_tdls_enabled(padapter) == _FALSE)
+		return _FALSE;
+
+	/* covers association state and AP TDLS prohibited bit */
+	if (rtw_tdls_is_setup_allowed(padapter) == _FALSE)
+		return _FALSE;
+
+	/* handshake is done by wpa_supplicant otherwise */
+	if (rtw_tdls_is_driver_setup(padapter) == _FALSE)
+		return _FALSE;
+
+	if (ptdlsinfo->sta_maximum == _TRUE)
+		return _FALSE;
+
+	return _TRUE;
+}
+
+/* Called every 2 sec from traffic status watchdog */
+void rtw_tdls_auto_watchdog(_adapter *padapter)
+{
+	struct tdls_auto_ctl *actl = &padapter->tdlsinfo.auto_ctl;
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	struct sta_info *psta;
+	struct tdls_auto_peer *peer;
+	struct tdls_txmgmt txmgmt;
+	u8 addr[TDLS_AUTO_PEER_NUM][ETH_ALEN];
+	u8 linked[TDLS_AUTO_PEER_NUM];
+	int peer_rssi[TDLS_AUTO_PEER_NUM];
+	u8 dis_addr[TDLS_AUTO_PEER_NUM][ETH_ALEN];
+	u8 tear_addr[TDLS_AUTO_PEER_NUM][ETH_ALEN];
+	u8 dis_num = 0, tear_num = 0;
+	u8 allowed;
+	int ap_rssi = 0;
+	u32 period_ms;
+	_irqL irqL;
+	int i;
+
+	if (actl->enable == _FALSE)
+		return;
+
+	period_ms = rtw_get_passing_time_ms(actl->last_time);
+	actl->last_time = rtw_get_current_time();
+	if (period_ms == 0)
+		return;
+
+	allowed = rtw_tdls_auto_setup_allowed(padapter);
+
+	psta = rtw_get_stainfo(pstapriv, get_bssid(&padapter->mlmepriv));
+	if (psta)
+		ap_rssi = psta->cmn.rssi_stat.rssi;
+
+	/* sta_hash_lock is not taken under actl->lock, look up peers first */
+	_enter_critical_bh(&actl->lock, &irqL);
+	for (i = 0; i < TDLS_AUTO_PEER_NUM; i++)
+		_rtw_memcpy(addr[i], actl->peer[i].addr, ETH_ALEN);
+	_exit_critical_bh(&actl->lock, &irqL);
+
+	for (i = 0; i < TDLS_AUTO_PEER_NUM; i++) {
+		psta = rtw_get_stainfo(pstapriv, addr[i]);
+		linked[i] = (psta && (psta->tdls_sta_state & TDLS_LINKED_STATE)) ? _TRUE : _FALSE;
+		peer_rssi[i] = psta ? psta->cmn.rssi_stat.rssi : 0;
+	}
+
+	_enter_critical_bh(&actl->lock, &irqL);
+	for (i = 0; i < TDLS_AUTO_PEER_NUM; i++) {
+		peer = &actl->peer[i];
+
+		if (peer->used == _FALSE)
+			continue;
+
+		/* entry replaced by TX path after lookup, sample it next time */
+		if (_rtw_memcmp(peer->addr, addr[i], ETH_ALEN) == _FALSE)
+			continue;
+
+		switch (rtw_tdls_auto_peer_step(actl, peer, period_ms, allowed, linked[i], peer_rssi[i], ap_rssi)) {
+		case TDLS_AUTO_ACT_DISCOVER:
+			_rtw_memcpy(dis_addr[dis_num++], peer->addr, ETH_ALEN);
+			break;
+		case TDLS_AUTO_ACT_TEARDOWN:
+			_rtw_memcpy(tear_addr[tear_num++], peer->addr, ETH_ALEN);
+			break;
+		}
+	}
+	_exit_critical_bh(&actl->lock, &irqL);
+
+	for (i = 0; i < dis_num; i++) {
+		RTW_INFO(FUNC_ADPT_FMT" discover "MAC_FMT"\n", FUNC_ADPT_ARG(padapter), MAC_ARG(dis_addr[i]));
+		_rtw_memset(&txmgmt, 0x00, sizeof(struct tdls_txmgmt));
+		_rtw_memcpy(txmgmt.peer, dis_addr[i], ETH_ALEN);
+		issue_tdls_dis_req(padapter, &txmgmt);
+	}
+
+	for (i = 0; i < tear_num; i++) {
+		RTW_INFO(FUNC_ADPT_FMT" teardown "MAC_FMT"\n", FUNC_ADPT_ARG(padapter), MAC_ARG(tear_addr[i]));
+		rtw_tdls_cmd(padapter, tear_addr[i], TDLS_TEARDOWN_STA);
+	}
+}
+
+/*
+ * Return _TRUE if the discovery response answers a request issued by
+ * rtw_tdls_auto_watchdog(), setup request is sent when direct path is good enough
+ */
+u8 rtw_tdls_auto_on_dis_rsp(_adapter *padapter, u8 *addr, int pwdb, int ap_rssi)
+{
+	struct tdls_auto_ctl *actl = &padapter->tdlsinfo.auto_ctl;
+	struct tdls_auto_peer *peer = NULL;
+	struct tdls_txmgmt txmgmt;
+	u8 allowed = rtw_tdls_auto_setup_allowed(padapter);
+	u8 do_setup = _FALSE;
+	_irqL irqL;
+	int i;
+
+	if (actl->enable == _FALSE)
+		return _FALSE;
+
+	_enter_critical_bh(&actl->lock, &irqL);
+	for (i = 0; i < TDLS_AUTO_PEER_NUM; i++) {
+		if (actl->peer[i].used == _TRUE
+			&& actl->peer[i].state == TDLS_AUTO_DISCOVER
+			&& _rtw_memcmp(actl->peer[i].addr, addr, ETH_ALEN) == _TRUE) {
+			peer = &actl->peer[i];
+			break;
+		}
+	}
+
+	if (peer) {
+		peer->no_rsp_cnt = 0;
+		if (allowed == _TRUE && pwdb + actl->rssi_margin >= ap_rssi) {
+			rtw_tdls_auto_set_state(peer, TDLS_AUTO_SETUP);
+			peer->setup_cnt++;
+			do_setup = _TRUE;
+		} else {
+			rtw_tdls_auto_set_state(peer, TDLS_AUTO_BACKOFF);
+			peer->fail_cnt++;
+		}
+	}
+	_exit_critical_bh(&actl->lock, &irqL);
+
+	if (peer == NULL)
+		return _FALSE;
+
+	RTW_INFO(FUNC_ADPT_FMT" "MAC_FMT" pwdb:%d ap_rssi:%d %s\n", FUNC_ADPT_ARG(padapter)
+		, MAC_ARG(addr), pwdb, ap_rssi, do_setup == _TRUE ? "setup" : "backoff");
+
+	if (do_setup == _TRUE) {
+		_rtw_memset(&txmgmt, 0x00, sizeof(struct tdls_txmgmt));
+		_rtw_memcpy(txmgmt.peer, addr, ETH_ALEN);
+		issue_tdls_setup_req(padapter, &txmgmt, _FALSE);
+	}
+
+	return _TRUE;
+}
+
+void rtw_tdls_auto_dump(void *sel, _adapter *padapter)
+{
+	struct tdls_auto_ctl *actl = &padapter->tdlsinfo.auto_ctl;
+	struct tdls_auto_peer *peer;
+	_irqL irqL;
+	int i;
+
+	RTW_PRINT_SEL(sel, "enable:%u\n", actl->enable);
+	RTW_PRINT_SEL(sel, "setup_kbps:%u setup_period:%u\n", actl->setup_kbps, actl->setup_period);
+	RTW_PRINT_SEL(sel, "teardown_kbps:%u teardown_period:%u\n", actl->teardown_kbps, actl->teardown_period);
+	RTW_PRINT_SEL(sel, "rssi_margin:%u backoff_period:%u\n", actl->rssi_margin, actl->backoff_period);
+	RTW_PRINT_SEL(sel, "setup_allowed:%u\n", rtw_tdls_auto_setup_allowed(padapter));
+
+	RTW_PRINT_SEL(sel, "%-17s %-8s %3s %8s %12s %5s %5s %5s %5s %5s %5s\n"
+		, "addr", "state", "cnt", "kbps", "total_bytes"
+		, "disc", "setup", "link", "fail", "t_idl", "t_rsi");
+
+	_enter_critical_bh(&actl->lock, &irqL);
+	for (i = 0; i < TDLS_AUTO_PEER_NUM; i++) {
+		peer = &actl->peer[i];
+		if (peer->used == _FALSE)
+			continue;
+
+		RTW_PRINT_SEL(sel, MAC_FMT" %-8s %3u %8u %12llu %5u %5u %5u %5u %5u %5u\n"
+			, MAC_ARG(peer->addr), tdls_auto_state_str[peer->state], peer->state_cnt
+			, peer->tx_kbps, peer->total_bytes
+			, peer->discover_cnt, peer->setup_cnt, peer->link_cnt, peer->fail_cnt
+			, peer->teardown_idle_cnt, peer->teardown_rssi_cnt);
+	}
+	_exit_critical_bh(&actl->lock, &irqL);
+}
+
+#define TDLS_AUTO_TEST_PERIOD_MS	2000
+
+/* run n watchdog periods at kbps, returns number of actions, last one in act */
+static u8 rtw_tdls_auto_test_run(struct tdls_auto_ctl *actl, struct tdls_auto_peer *peer
+	, u32 kbps, u8 n, u8 allowed, u8 linked, int peer_rssi, int ap_rssi, u8 *act)
+{
+	u8 cnt = 0;
+	u8 ret;
+
+	*act = TDLS_AUTO_ACT_NONE;
+	while (n--) {
+		peer->tx_bytes = kbps * (TDLS_AUTO_TEST_PERIOD_MS / 8);
+		ret = rtw_tdls_auto_peer_step(actl, peer, TDLS_AUTO_TEST_PERIOD_MS, allowed, linked, peer_rssi, ap_rssi);
+		if (ret != TDLS_AUTO_ACT_NONE) {
+			*act = ret;
+			cnt++;
+		}
+	}
+
+	return cnt;
+}
+
+/*
+ * Drive the per peer state machine through setup, backoff and teardown
+ * with synthetic rates and RSSI, using this adapter's thresholds on a
+ * scratch peer, nothing is sent over the air
+ */
+void rtw_tdls_auto_test(void *sel, _adapter *padapter)
+{
+	struct tdls_auto_ctl *actl = &padapter->tdlsinfo.auto_ctl;
+	struct tdls_auto_peer peer;
+	u32 busy = actl->setup_kbps + 1;
+	u32 slow = actl->setup_kbps ? actl->setup_kbps - 1 : 0;
+	int ap_rssi = 60;
+	int weak = ap_rssi - actl->rssi_margin - TDLS_AUTO_RSSI_HYST;
+	u32 fail_cnt = 0;
+	u8 cnt, act;
+	int i;
+
+	/* periods are used as n - 1 below */
+	if (!actl->setup_period || !actl->teardown_period || !actl->backoff_period) {
+		RTW_PRINT_SEL(sel, "invalid period setting\n");
+		rtw_selftest_result(sel, 1);
+		return;
+	}
+
+	_rtw_memset(&peer, 0, sizeof(peer));
+	peer.used = _TRUE;
+
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, actl->setup_period - 1, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "busy before setup_period", cnt == 0 && peer.state == TDLS_AUTO_IDLE, &fail_cnt);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, 1, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "busy discovers", cnt == 1 && act == TDLS_AUTO_ACT_DISCOVER
+		&& peer.state == TDLS_AUTO_DISCOVER, &fail_cnt);
+
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, TDLS_AUTO_RSP_TIMEOUT, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "no response backs off", cnt == 0 && peer.state == TDLS_AUTO_BACKOFF
+		&& peer.fail_cnt == 1, &fail_cnt);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, actl->backoff_period - 1, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "backoff holds", cnt == 0 && peer.state == TDLS_AUTO_BACKOFF, &fail_cnt);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, 1, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "backoff expires", cnt == 0 && peer.state == TDLS_AUTO_IDLE, &fail_cnt);
+
+	rtw_tdls_auto_set_state(&peer, TDLS_AUTO_IDLE);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, actl->setup_period * 3, _FALSE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "busy but not allowed", cnt == 0 && peer.state == TDLS_AUTO_IDLE, &fail_cnt);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, slow, actl->setup_period * 3, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "slow stays idle", cnt == 0 && peer.state == TDLS_AUTO_IDLE, &fail_cnt);
+
+	rtw_tdls_auto_set_state(&peer, TDLS_AUTO_SETUP);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, 1, _TRUE, _TRUE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "setup links", cnt == 0 && peer.state == TDLS_AUTO_LINKED, &fail_cnt);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, 20, _TRUE, _TRUE, weak, ap_rssi, &act);
+	rtw_selftest_chk(sel, "busy link within hyst kept", cnt == 0 && peer.state == TDLS_AUTO_LINKED, &fail_cnt);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, 1, _TRUE, _TRUE, weak - 1, ap_rssi, &act);
+	rtw_selftest_chk(sel, "weak link torn down", cnt == 1 && act == TDLS_AUTO_ACT_TEARDOWN
+		&& peer.state == TDLS_AUTO_BACKOFF, &fail_cnt);
+
+	rtw_tdls_auto_set_state(&peer, TDLS_AUTO_LINKED);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, 0, actl->teardown_period - 1, _TRUE, _TRUE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "idle link before period", cnt == 0 && peer.state == TDLS_AUTO_LINKED, &fail_cnt);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, 0, 1, _TRUE, _TRUE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "idle link torn down", cnt == 1 && act == TDLS_AUTO_ACT_TEARDOWN
+		&& peer.state == TDLS_AUTO_IDLE, &fail_cnt);
+
+	rtw_tdls_auto_set_state(&peer, TDLS_AUTO_LINKED);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, 1, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "link lost goes idle", cnt == 0 && peer.state == TDLS_AUTO_IDLE, &fail_cnt);
+
+	cnt = rtw_tdls_auto_test_run(actl, &peer, 0, TDLS_AUTO_AGE_PERIOD, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "idle entry ages out", cnt == 0 && peer.used == _FALSE, &fail_cnt);
+
+	_rtw_memset(&peer, 0, sizeof(peer));
+	peer.used = _TRUE;
+	for (i = 0; i < TDLS_AUTO_NO_RSP_MAX; i++) {
+		if (peer.state == TDLS_AUTO_BACKOFF)
+			rtw_tdls_auto_test_run(actl, &peer, busy, actl->backoff_period, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+		rtw_tdls_auto_test_run(actl, &peer, busy, actl->setup_period, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+		rtw_tdls_auto_test_run(actl, &peer, busy, TDLS_AUTO_RSP_TIMEOUT, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	}
+	rtw_selftest_chk(sel, "silent peer parked", peer.state == TDLS_AUTO_NORSP
+		&& peer.discover_cnt == TDLS_AUTO_NO_RSP_MAX, &fail_cnt);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, TDLS_AUTO_NORSP_PERIOD - 1, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "silent peer not probed", cnt == 0 && peer.state == TDLS_AUTO_NORSP, &fail_cnt);
+	cnt = rtw_tdls_auto_test_run(actl, &peer, busy, 1, _TRUE, _FALSE, ap_rssi, ap_rssi, &act);
+	rtw_selftest_chk(sel, "silent peer retried later", cnt == 0 && peer.state == TDLS_AUTO_IDLE
+		&& peer.no_rsp_cnt == 0, &fail_cnt);
+
+	rtw_selftest_result(sel, fail_cnt);
+}
+
 #endif /* CONFIG_TDLS */
@@ -305,6 +305,7 @@ void rtw_wapi_init(_adapter *padapter)
 
 	pWapiInfo =  &padapter->wapiInfo;
 	pWapiInfo->bWapiEnable = false;
+	_rtw_spinlock_init(&pWapiInfo->rkLock);
 
 	/* Init BKID List */
 	INIT_LIST_HEAD(&pWapiInfo->wapiBKIDIdleList);
@@ -338,6 +339,7 @@ void rtw_wapi_free(_adapter *padapter)
 	}
 
 	WapiFreeAllStaInfo(padapter);
+	_rtw_spinlock_free(&padapter->wapiInfo.rkLock);
 
 	WAPI_TRACE(WAPI_INIT, "<========== %s\n", __FUNCTION__);
 }
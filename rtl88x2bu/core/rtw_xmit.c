@@ -1374,6 +1374,12 @@ get_sta_info:
 
 	pattrib->pktlen = pktfile.pkt_len;
 
+#ifdef CONFIG_TDLS
+	if (!bmcast && padapter->tdlsinfo.auto_ctl.enable == _TRUE
+		&& check_fwstate(pmlmepriv, WIFI_STATION_STATE))
+		rtw_tdls_auto_tx_update(padapter, pattrib->dst, pattrib->pktlen);
+#endif
+
 	/* TODO: 802.1Q VLAN header */
 	/* TODO: IPV6 */
 
@@ -1538,6 +1544,183 @@ exit:
 	return res;
 }
 
+#ifdef CONFIG_RTW_MESH
+/*
+ * Fast update_attrib() for frames forwarded to a mesh path with valid
+ * forwarding cache. Only the per packet fields are resolved here, the others
+ * are cloned from the template saved by the last full update_attrib().
+ * Packets needing special handling (EAPOL, DHCP, ICMP...) return _FAIL with
+ * pattrib untouched and go through update_attrib().
+ */
+static s32 update_attrib_mfwd(_adapter *padapter, _pkt *pkt, struct pkt_attrib *pattrib)
+{
+	struct pkt_file pktfile;
+	struct ethhdr etherhdr;
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	u16 ether_type;
+
+	if (!pattrib->mfwd_ttl || IS_MCAST(pattrib->mda))
+		return _FAIL;
+
+	_rtw_open_pktfile(pkt, &pktfile);
+	if (_rtw_pktfile_read(&pktfile, (u8 *)&etherhdr, ETH_HLEN) != ETH_HLEN)
+		return _FAIL;
+
+	ether_type = ntohs(etherhdr.h_proto);
+	if (ether_type == ETH_P_IP) {
+		u8 ip[20];
+
+		_rtw_pktfile_read(&pktfile, ip, 20);
+
+		if (GET_IPV4_PROTOCOL(ip) == 0x01) /* ICMP */
+			return _FAIL;
+
+		if (GET_IPV4_PROTOCOL(ip) == 0x11) { /* UDP */
+			u8 udp[8];
+
+			if (GET_IPV4_IHL(ip) * 4 > 20)
+				_rtw_pktfile_read(&pktfile, NULL, GET_IPV4_IHL(ip) * 4 - 20);
+			_rtw_pktfile_read(&pktfile, udp, 8);
+
+			/* 67 : UDP BOOTP server, 68 : UDP BOOTP client */
+			if ((GET_UDP_SRC(udp) == 68 && GET_UDP_DST(udp) == 67)
+				|| (GET_UDP_SRC(udp) == 67 && GET_UDP_DST(udp) == 68))
+				return _FAIL;
+		}
+	} else if (ether_type != ETH_P_IPV6)
+		return _FAIL;
+
+	if (rtw_mesh_fwd_cache_apply(padapter, pattrib) != _TRUE)
+		return _FAIL;
+
+	pattrib->ether_type = ether_type;
+	pattrib->pktlen = pktfile.pkt_len;
+	pattrib->icmp_pkt = 0;
+	pattrib->dhcp_pkt = 0;
+
+	pattrib->pkt_hdrlen = ETH_HLEN;
+	pattrib->hdrlen = WLAN_HDR_A3_LEN;
+	pattrib->subtype = WIFI_DATA_TYPE;
+	pattrib->priority = 0;
+
+	if (pattrib->qos_en) {
+		set_qos(&pktfile, pattrib);
+		rtw_mesh_tx_set_whdr_mctrl_len(pattrib->mesh_frame_mode, pattrib);
+	}
+
+	pattrib->hw_ssn_sel = pxmitpriv->hw_ssn_seq_no;
+	rtw_set_tx_chksum_offload(pkt, pattrib);
+
+	return _SUCCESS;
+}
+
+/*
+ * Forwarding benchmark for a relay node, e.g. one of two interfaces of a
+ * host meshed over the air in loopback with mda reached through the other.
+ * num synthetic UDP frames forwarded to mda are resolved through the full
+ * update_attrib() and then through the forwarding cache, nothing is sent.
+ */
+void rtw_mesh_fwd_bench(void *sel, _adapter *adapter, const u8 *mda, u32 num)
+{
+	struct pkt_attrib *tmpl = NULL, *attrib = NULL;
+	struct rtw_mesh_path *mpath;
+	struct sta_info *next_hop;
+	struct sk_buff *skb = NULL;
+	u8 ra[ETH_ALEN];
+	u8 *p;
+	systime start;
+	u32 full_ms, cache_ms, full_ok = 0, hit = 0;
+	u32 i, len = ETH_HLEN + 20 + 8 + 1000;
+
+	if (!MLME_IS_MESH(adapter)) {
+		RTW_PRINT_SEL(sel, "not in mesh mode\n");
+		return;
+	}
+
+	rtw_rcu_read_lock();
+	mpath = rtw_mesh_path_lookup(adapter, mda);
+	next_hop = mpath ? rtw_rcu_dereference(mpath->next_hop) : NULL;
+	if (next_hop)
+		_rtw_memcpy(ra, next_hop->cmn.mac_addr, ETH_ALEN);
+	rtw_rcu_read_unlock();
+
+	if (!next_hop) {
+		RTW_PRINT_SEL(sel, "no path with next hop to "MAC_FMT"\n", MAC_ARG(mda));
+		return;
+	}
+
+	tmpl = rtw_zmalloc(sizeof(struct pkt_attrib));
+	attrib = rtw_zmalloc(sizeof(struct pkt_attrib));
+	skb = rtw_skb_alloc(len);
+	if (!tmpl || !attrib || !skb)
+		goto exit;
+
+	/* ethernet + IPv4 + UDP to port 5001, as relayed by rtw_mesh_rx_msdu_act_check() */
+	p = skb_put(skb, len);
+	_rtw_memset(p, 0, len);
+	_rtw_memcpy(p, mda, ETH_ALEN);
+	_rtw_memcpy(p + ETH_ALEN, adapter_mac_addr(adapter), ETH_ALEN);
+	*(u16 *)(p + 2 * ETH_ALEN) = htons(ETH_P_IP);
+	p += ETH_HLEN;
+	p[0] = 0x45;
+	*(u16 *)(p + 2) = htons(len - ETH_HLEN);
+	p[8] = 64;
+	p[9] = 0x11;
+	*(u16 *)(p + 20) = htons(5001);
+	*(u16 *)(p + 22) = htons(5001);
+	*(u16 *)(p + 24) = htons(len - ETH_HLEN - 20);
+
+	tmpl->mfwd_ttl = 31;
+	_rtw_memcpy(tmpl->dst, mda, ETH_ALEN);
+	_rtw_memcpy(tmpl->src, adapter_mac_addr(adapter), ETH_ALEN);
+	_rtw_memcpy(tmpl->mda, mda, ETH_ALEN);
+	_rtw_memcpy(tmpl->msa, adapter_mac_addr(adapter), ETH_ALEN);
+	_rtw_memcpy(tmpl->ta, adapter_mac_addr(adapter), ETH_ALEN);
+	_rtw_memcpy(tmpl->ra, ra, ETH_ALEN);
+	tmpl->mesh_frame_mode = MESH_UCAST_DATA;
+
+	start = rtw_get_current_time();
+	for (i = 0; i < num; i++) {
+		_rtw_memcpy(attrib, tmpl, sizeof(struct pkt_attrib));
+		tmpl->mseq++;
+		if (update_attrib(adapter, skb, attrib) == _SUCCESS)
+			full_ok++;
+	}
+	full_ms = rtw_get_passing_time_ms(start);
+
+	/* warm the cache the way rtw_xmit_posthandle() does on a miss */
+	_rtw_memcpy(attrib, tmpl, sizeof(struct pkt_attrib));
+	if (update_attrib(adapter, skb, attrib) == _SUCCESS)
+		rtw_mesh_fwd_cache_update(adapter, attrib);
+
+	start = rtw_get_current_time();
+	for (i = 0; i < num; i++) {
+		_rtw_memcpy(attrib, tmpl, sizeof(struct pkt_attrib));
+		tmpl->mseq++;
+		if (update_attrib_mfwd(adapter, skb, attrib) == _SUCCESS)
+			hit++;
+	}
+	cache_ms = rtw_get_passing_time_ms(start);
+
+	RTW_PRINT_SEL(sel, "mda:"MAC_FMT" next_hop:"MAC_FMT" num:%u len:%u\n"
+		, MAC_ARG(mda), MAC_ARG(ra), num, len);
+	RTW_PRINT_SEL(sel, "full:  %u ms, %u pps, ok:%u\n", full_ms
+		, full_ms ? (u32)rtw_division64((u64)num * 1000, full_ms) : 0, full_ok);
+	RTW_PRINT_SEL(sel, "cache: %u ms, %u pps, hit:%u\n", cache_ms
+		, cache_ms ? (u32)rtw_division64((u64)num * 1000, cache_ms) : 0, hit);
+	if (num && hit == 0)
+		RTW_PRINT_SEL(sel, "cache not used, path not active or next hop has special tx tracking\n");
+
+exit:
+	if (skb)
+		rtw_skb_free(skb);
+	if (attrib)
+		rtw_mfree(attrib, sizeof(struct pkt_attrib));
+	if (tmpl)
+		rtw_mfree(tmpl, sizeof(struct pkt_attrib));
+}
+#endif /* CONFIG_RTW_MESH */
+
 static s32 xmitframe_addmic(_adapter *padapter, struct xmit_frame *pxmitframe)
 {
 	sint			curfragnum, length;
@@ -3162,6 +3345,11 @@ void rtw_count_tx_stats(PADAPTER padapter, struct xmit_frame *pxmitframe, int sz
 			pstats->tx_bytes += sz;
 		}
 
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+		rtw_lstats_count(&padapter->lstats, 1, pxmitframe->attrib.priority
+			, IS_MCAST(pxmitframe->attrib.ra), pkt_num);
+#endif
+
 #ifdef CONFIG_CHECK_LEAVE_LPS
 		/* traffic_check_for_leave_lps(padapter, _TRUE); */
 #endif /* CONFIG_LPS */
@@ -4462,6 +4650,27 @@ s32 rtw_xmit_posthandle(_adapter *padapter, struct xmit_frame *pxmitframe, _pkt
 	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
 	s32 res;
 
+#ifdef CONFIG_RTW_MESH
+	if (MLME_IS_MESH(padapter) && pxmitframe->attrib.mfwd_ttl) {
+		struct rtw_mesh_stats *mshstats = &padapter->mesh_info.mshstats;
+
+		res = update_attrib_mfwd(padapter, pkt, &pxmitframe->attrib);
+		if (res == _SUCCESS)
+			mshstats->fwd_cache_hit++;
+		else {
+			res = update_attrib(padapter, pkt, &pxmitframe->attrib);
+			if (res == _SUCCESS && !IS_MCAST(pxmitframe->attrib.mda)) {
+				/* same filter as update_attrib_mfwd(), others never hit the cache */
+				if ((pxmitframe->attrib.ether_type == ETH_P_IP || pxmitframe->attrib.ether_type == ETH_P_IPV6)
+					&& !pxmitframe->attrib.icmp_pkt && !pxmitframe->attrib.dhcp_pkt) {
+					mshstats->fwd_cache_miss++;
+					rtw_mesh_fwd_cache_update(padapter, &pxmitframe->attrib);
+				} else
+					mshstats->fwd_cache_bypass++;
+			}
+		}
+	} else
+#endif
 	res = update_attrib(padapter, pkt, &pxmitframe->attrib);
 
 #ifdef CONFIG_MCC_MODE
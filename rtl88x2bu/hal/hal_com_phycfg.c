@@ -2837,6 +2837,7 @@ phy_GetChannelIndexOfTxPowerLimit(
 /*
 * return txpwr limit absolute value
 * MAX_POWER_INDEX is returned when NO limit
+* limit of current regd is got from the compiled txpwr_lmt_tbl without lock
 */
 s8 phy_get_txpwr_lmt_abs(
 	IN	PADAPTER			Adapter,
@@ -2849,14 +2850,11 @@ s8 phy_get_txpwr_lmt_abs(
 	u8 lock
 )
 {
-	struct dvobj_priv *dvobj = adapter_to_dvobj(Adapter);
 	struct rf_ctl_t *rfctl = adapter_to_rfctl(Adapter);
 	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(Adapter);
-	struct txpwr_lmt_ent *ent = NULL;
+	struct txpwr_lmt_tbl *tbl;
 	_irqL irqL;
-	_list *cur, *head;
 	s8 ch_idx;
-	u8 is_ww_regd = 0;
 	s8 lmt = MAX_POWER_INDEX;
 
 	if ((Adapter->registrypriv.RegEnableTxPowerLimit == 2 && hal_data->EEPROMRegulatory != 1) ||
@@ -2874,69 +2872,33 @@ s8 phy_get_txpwr_lmt_abs(
 		goto exit;
 	}
 
+	ch_idx = phy_GetChannelIndexOfTxPowerLimit(Band, cch);
+	if (ch_idx == -1)
+		goto exit;
+
+	rtw_rcu_read_lock();
+	tbl = rtw_rcu_dereference(rfctl->txpwr_lmt_tbl);
+	if (tbl && (!regd_name || regd_name == tbl->regd_name)) {
+		if (Band == BAND_ON_2_4G)
+			lmt = tbl->lmt_2g[bw][tlrs][ch_idx][ntx_idx];
+		#ifdef CONFIG_IEEE80211_BAND_5GHZ
+		else if (Band == BAND_ON_5G)
+			lmt = tbl->lmt_5g[bw][tlrs - 1][ch_idx][ntx_idx];
+		#endif
+		rtw_rcu_read_unlock();
+		goto exit;
+	}
+	rtw_rcu_read_unlock();
+
+	/* other regd or no compiled table, search from txpwr_lmt_list */
 	if (lock)
 		_enter_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
 
 	if (!regd_name) /* no regd_name specified, use currnet */
 		regd_name = rfctl->regd_name;
 
-	if (rfctl->txpwr_regd_num == 0
-		|| strcmp(regd_name, regd_str(TXPWR_LMT_NONE)) == 0)
-		goto release_lock;
-
-	if (strcmp(regd_name, regd_str(TXPWR_LMT_WW)) == 0)
-		is_ww_regd = 1;
-
-	if (!is_ww_regd) {
-		ent = _rtw_txpwr_lmt_get_by_name(rfctl, regd_name);
-		if (!ent)
-			goto release_lock;
-	}
-
-	ch_idx = phy_GetChannelIndexOfTxPowerLimit(Band, cch);
-	if (ch_idx == -1)
-		goto release_lock;
+	lmt = _rtw_txpwr_lmt_get_from_list(rfctl, regd_name, Band, bw, tlrs, ntx_idx, ch_idx);
 
-	if (Band == BAND_ON_2_4G) {
-		if (!is_ww_regd) {
-			lmt = ent->lmt_2g[bw][tlrs][ch_idx][ntx_idx];
-			if (lmt != -MAX_POWER_INDEX)
-				goto release_lock;
-		}
-
-		/* search for min value for WW regd or WW limit */
-		lmt = MAX_POWER_INDEX;
-		head = &rfctl->txpwr_lmt_list;
-		cur = get_next(head);
-		while ((rtw_end_of_queue_search(head, cur)) == _FALSE) {
-			ent = LIST_CONTAINOR(cur, struct txpwr_lmt_ent, list);
-			cur = get_next(cur);
-			if (ent->lmt_2g[bw][tlrs][ch_idx][ntx_idx] != -MAX_POWER_INDEX)
-				lmt = rtw_min(lmt, ent->lmt_2g[bw][tlrs][ch_idx][ntx_idx]);
-		}
-	}
-	#ifdef CONFIG_IEEE80211_BAND_5GHZ
-	else if (Band == BAND_ON_5G) {
-		if (!is_ww_regd) {
-			lmt = ent->lmt_5g[bw][tlrs - 1][ch_idx][ntx_idx];
-			if (lmt != -MAX_POWER_INDEX)
-				goto release_lock;
-		}
-
-		/* search for min value for WW regd or WW limit */
-		lmt = MAX_POWER_INDEX;
-		head = &rfctl->txpwr_lmt_list;
-		cur = get_next(head);
-		while ((rtw_end_of_queue_search(head, cur)) == _FALSE) {
-			ent = LIST_CONTAINOR(cur, struct txpwr_lmt_ent, list);
-			cur = get_next(cur);
-			if (ent->lmt_5g[bw][tlrs - 1][ch_idx][ntx_idx] != -MAX_POWER_INDEX)
-				lmt = rtw_min(lmt, ent->lmt_5g[bw][tlrs - 1][ch_idx][ntx_idx]);
-		}
-	}
-	#endif
-
-release_lock:
 	if (lock)
 		_exit_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
 
@@ -2993,7 +2955,6 @@ PHY_GetTxPowerLimit(_adapter *adapter
 	, u8 rfpath, u8 rate, u8 ntx_idx, u8 cch)
 {
 	struct dvobj_priv *dvobj = adapter_to_dvobj(adapter);
-	struct rf_ctl_t *rfctl = adapter_to_rfctl(adapter);
 	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
 	BOOLEAN no_sc = _FALSE;
 	s8 tlrs = -1, rs = -1;
@@ -3003,7 +2964,6 @@ PHY_GetTxPowerLimit(_adapter *adapter
 	u8 bw_bmp = 0;
 	s8 min_lmt = MAX_POWER_INDEX;
 	u8 final_bw = bw, final_cch = cch;
-	_irqL irqL;
 
 #ifdef CONFIG_MP_INCLUDED
 	/* MP mode channel don't use secondary channel */
@@ -3054,8 +3014,6 @@ PHY_GetTxPowerLimit(_adapter *adapter
 	if (bw_bmp == 0)
 		goto exit;
 
-	_enter_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
-
 	/* loop for each possible tx bandwidth to find minimum limit */
 	for (tmp_bw = CHANNEL_WIDTH_20; tmp_bw <= bw; tmp_bw++) {
 		if (!(ch_width_to_bw_cap(tmp_bw) & bw_bmp))
@@ -3074,7 +3032,7 @@ PHY_GetTxPowerLimit(_adapter *adapter
 			}
 		}
 
-		lmt = phy_get_txpwr_lmt_abs(adapter, regd_name, band, tmp_bw, tlrs, ntx_idx, tmp_cch, 0);
+		lmt = phy_get_txpwr_lmt_abs(adapter, regd_name, band, tmp_bw, tlrs, ntx_idx, tmp_cch, 1);
 
 		if (min_lmt >= lmt) {
 			min_lmt = lmt;
@@ -3084,8 +3042,6 @@ PHY_GetTxPowerLimit(_adapter *adapter
 
 	}
 
-	_exit_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
-
 	if (min_lmt != MAX_POWER_INDEX) {
 		/* return diff value */
 		min_lmt = min_lmt - PHY_GetTxPowerByRateBase(adapter, band, rfpath, rs);
@@ -44,7 +44,7 @@ static void _rtw_bss_nums_count(_adapter *adapter, u8 *pbss_nums)
 		pnetwork = LIST_CONTAINOR(plist, struct wlan_network, list);
 		if (!pnetwork)
 			break;
-		chan_idx = rtw_chset_search_ch(adapter_to_chset(adapter), pnetwork->network.Configuration.DSConfig);
+		chan_idx = rtw_rfctl_search_ch(adapter_to_rfctl(adapter), pnetwork->network.Configuration.DSConfig);
 		if ((chan_idx == -1) || (chan_idx >= MAX_CHANNEL_NUM)) {
 			RTW_ERR("%s can't get chan_idx(CH:%d)\n",
 				__func__, pnetwork->network.Configuration.DSConfig);
@@ -183,7 +183,7 @@ void rtw_acs_get_rst(_adapter *adapter)
 	if (!hal_data->acs.triggered)
 		return;
 
-	chan_idx = rtw_chset_search_ch(adapter_to_chset(adapter), cur_chan);
+	chan_idx = rtw_rfctl_search_ch(adapter_to_rfctl(adapter), cur_chan);
 	if ((chan_idx == -1) || (chan_idx >= MAX_CHANNEL_NUM)) {
 		RTW_ERR("[ACS] %s can't get chan_idx(CH:%d)\n", __func__, cur_chan);
 		return;
@@ -326,7 +326,7 @@ u8 rtw_acs_get_clm_ratio_by_ch_num(_adapter *adapter, u8 chan)
 	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
 	int chan_idx = -1;
 
-	chan_idx = rtw_chset_search_ch(adapter_to_chset(adapter), chan);
+	chan_idx = rtw_rfctl_search_ch(adapter_to_rfctl(adapter), chan);
 	if ((chan_idx == -1) || (chan_idx >= MAX_CHANNEL_NUM)) {
 		RTW_ERR("[ACS] Get CLM fail, can't get chan_idx(CH:%d)\n", chan);
 		return 0;
@@ -350,7 +350,7 @@ u8 rtw_acs_get_nhm_ratio_by_ch_num(_adapter *adapter, u8 chan)
 	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
 	int chan_idx = -1;
 
-	chan_idx = rtw_chset_search_ch(adapter_to_chset(adapter), chan);
+	chan_idx = rtw_rfctl_search_ch(adapter_to_rfctl(adapter), chan);
 	if ((chan_idx == -1) || (chan_idx >= MAX_CHANNEL_NUM)) {
 		RTW_ERR("[ACS] Get NHM fail, can't get chan_idx(CH:%d)\n", chan);
 		return 0;
@@ -477,7 +477,7 @@ void rtw_noise_measure(_adapter *adapter, u8 chan, u8 is_pause_dig, u8 igi_value
 		chan, (is_pause_dig) ? "Y" : "N", igi_value, max_time);
 	#endif
 
-	chan_idx = rtw_chset_search_ch(adapter_to_chset(adapter), chan);
+	chan_idx = rtw_rfctl_search_ch(adapter_to_rfctl(adapter), chan);
 	if ((chan_idx == -1) || (chan_idx >= MAX_CHANNEL_NUM)) {
 		RTW_ERR("[NM] Get noise fail, can't get chan_idx(CH:%d)\n", chan);
 		return;
@@ -502,7 +502,7 @@ s16 rtw_noise_query_by_chan_num(_adapter *adapter, u8 chan)
 	s16 noise = 0;
 	int chan_idx = -1;
 
-	chan_idx = rtw_chset_search_ch(adapter_to_chset(adapter), chan);
+	chan_idx = rtw_rfctl_search_ch(adapter_to_rfctl(adapter), chan);
 	if ((chan_idx == -1) || (chan_idx >= MAX_CHANNEL_NUM)) {
 		RTW_ERR("[NM] Get noise fail, can't get chan_idx(CH:%d)\n", chan);
 		return noise;
@@ -3282,6 +3282,65 @@ exit:
 	return err;
 }
 
+/*
+ * Description:
+ *	Re-run MAC initial flow on a powered on chip without downloading
+ *	firmware again, BB/RF setting is kept. Used by silent reset to recover
+ *	MAC/DMA hang while firmware is still alive.
+ *
+ * Return:
+ *	0	Success
+ *	others	Fail
+ */
+int rtw_halmac_reinit_mac(struct dvobj_priv *d)
+{
+	PADAPTER adapter;
+	struct halmac_adapter *halmac;
+	struct halmac_api *api;
+	enum halmac_ret_status status;
+	u8 ok;
+	int err, err_ret = -1;
+
+
+	adapter = dvobj_get_primary_adapter(d);
+	halmac = dvobj_to_halmac(d);
+	if (!halmac)
+		goto out;
+	api = HALMAC_GET_API(halmac);
+
+	/* InitMACFlow */
+	err = init_mac_flow(d);
+	if (err)
+		goto out;
+
+	/* Driver insert flow: Enable TR/RX */
+	err = _drv_enable_trx(d);
+	if (err)
+		goto out;
+
+	/* Firmware is kept, sync general info again */
+	err = _send_general_info(d);
+	if (err)
+		goto out;
+
+	/* Init Phy parameter-MAC */
+	ok = rtw_hal_init_mac_register(adapter);
+	if (_FALSE == ok)
+		goto out;
+
+	err = rtw_halmac_config_rx_info(d, HALMAC_DRV_INFO_PHY_STATUS);
+	if (err)
+		goto out;
+
+	status = api->halmac_init_interface_cfg(halmac);
+	if (status != HALMAC_RET_SUCCESS)
+		goto out;
+
+	err_ret = 0;
+out:
+	return err_ret;
+}
+
 int rtw_halmac_deinit_hal(struct dvobj_priv *d)
 {
 	PADAPTER adapter;
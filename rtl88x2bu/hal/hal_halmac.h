@@ -159,6 +159,7 @@ int rtw_halmac_poweroff(struct dvobj_priv *);
 int rtw_halmac_init_hal(struct dvobj_priv *);
 int rtw_halmac_init_hal_fw(struct dvobj_priv *, u8 *fw, u32 fwsize);
 int rtw_halmac_init_hal_fw_file(struct dvobj_priv *, u8 *fwpath);
+int rtw_halmac_reinit_mac(struct dvobj_priv *d);
 int rtw_halmac_deinit_hal(struct dvobj_priv *);
 int rtw_halmac_self_verify(struct dvobj_priv *);
 int rtw_halmac_txfifo_wait_empty(struct dvobj_priv *d, u32 timeout);
@@ -176,13 +176,27 @@ void usb_free_recv_priv(_adapter *padapter, u16 ini_in_buf_sz)
 	if (skb_queue_len(&precvpriv->rx_skb_queue))
 		RTW_WARN("rx_skb_queue not empty\n");
 
+#if defined(CONFIG_PREALLOC_RX_SKB_BUFFER) && !defined(CONFIG_USE_USB_BUFFER_ALLOC_RX)
+	{
+		struct sk_buff *skb;
+
+		/* RX buffers taken from the pool by usb_read_port() go back there */
+		while ((skb = skb_dequeue(&precvpriv->rx_skb_queue)) != NULL) {
+			skb_reset_tail_pointer(skb);
+			skb->len = 0;
+			if (rtw_free_skb_premem(skb) != 0)
+				rtw_skb_free(skb);
+		}
+	}
+#else
 	rtw_skb_queue_purge(&precvpriv->rx_skb_queue);
+#endif
 
 	if (skb_queue_len(&precvpriv->free_recv_skb_queue))
 		RTW_WARN("free_recv_skb_queue not empty, %d\n", skb_queue_len(&precvpriv->free_recv_skb_queue));
 
 #if !defined(CONFIG_USE_USB_BUFFER_ALLOC_RX)
-#if defined(CONFIG_PREALLOC_RECV_SKB) && defined(CONFIG_PREALLOC_RX_SKB_BUFFER)
+#if defined(CONFIG_PREALLOC_RX_SKB_BUFFER)
 	{
 		struct sk_buff *skb;
 
@@ -193,7 +207,7 @@ void usb_free_recv_priv(_adapter *padapter, u16 ini_in_buf_sz)
 	}
 #else
 	rtw_skb_queue_purge(&precvpriv->free_recv_skb_queue);
-#endif /* defined(CONFIG_PREALLOC_RX_SKB_BUFFER) && defined(CONFIG_PREALLOC_RECV_SKB) */
+#endif /* defined(CONFIG_PREALLOC_RX_SKB_BUFFER) */
 #endif /* !defined(CONFIG_USE_USB_BUFFER_ALLOC_RX) */
 
 #endif /* PLATFORM_LINUX */
@@ -754,6 +754,14 @@ void rtw_hal_sreset_reset_value(_adapter *padapter)
 	padapter->hal_func.sreset_reset_value(padapter);
 }
 
+u8 rtw_hal_sreset_mac_reinit(_adapter *padapter)
+{
+	padapter = GET_PRIMARY_ADAPTER(padapter);
+	if (padapter->hal_func.sreset_mac_reinit)
+		return padapter->hal_func.sreset_mac_reinit(padapter);
+	return _FALSE;
+}
+
 void rtw_hal_sreset_xmit_status_check(_adapter *padapter)
 {
 	padapter->hal_func.sreset_xmit_status_check(padapter);
@@ -22,6 +22,9 @@ void dump_led_config(void *sel, _adapter *adapter)
 	struct dvobj_priv *dvobj = adapter_to_dvobj(adapter);
 	struct led_priv	*ledpriv = adapter_to_led(adapter);
 	int i;
+#ifdef CONFIG_RTW_SW_LED
+	u32 ms, io_cnt;
+#endif
 
 	RTW_PRINT_SEL(sel, "strategy:%u\n", ledpriv->LedStrategy);
 #ifdef CONFIG_RTW_SW_LED
@@ -29,6 +32,23 @@ void dump_led_config(void *sel, _adapter *adapter)
 	RTW_PRINT_SEL(sel, "iface_en_mask:0x%02X\n", ledpriv->iface_en_mask);
 	for (i = 0; i < dvobj->iface_nums; i++)
 		RTW_PRINT_SEL(sel, "ctl_en_mask[%d]:0x%08X\n", i, ledpriv->ctl_en_mask[i]);
+
+	io_cnt = ledpriv->io_cnt;
+	ms = ledpriv->io_rate_time ? rtw_get_passing_time_ms(ledpriv->io_rate_time) : 0;
+	RTW_PRINT_SEL(sel, "hw_blink:%s\n", ledpriv->SwLedHwBlink ? "Y" : "N");
+	RTW_PRINT_SEL(sel, "io_cnt:%u io_skip_cnt:%u hw_blink_cnt:%u\n"
+		, io_cnt, ledpriv->io_skip_cnt, ledpriv->hw_blink_cnt);
+	for (i = 0; i < LED_PIN_NUM; i++) {
+		if (ledpriv->pin_hw_blink[i])
+			RTW_PRINT_SEL(sel, "pin[%d]: hw_blink mode:%u\n", i, ledpriv->pin_hw_mode[i]);
+		else if (ledpriv->pin_io_state[i] != LED_UNKNOWN)
+			RTW_PRINT_SEL(sel, "pin[%d]: %s\n", i, ledpriv->pin_io_state[i] == RTW_LED_ON ? "on" : "off");
+	}
+	if (ms)
+		RTW_PRINT_SEL(sel, "io_per_sec:%u (last %u ms)\n"
+			, (u32)rtw_division64((u64)(io_cnt - ledpriv->io_rate_cnt) * 1000, ms), ms);
+	ledpriv->io_rate_time = rtw_get_current_time();
+	ledpriv->io_rate_cnt = io_cnt;
 #endif
 }
 
@@ -17,6 +17,211 @@
 #include <hal_data.h>
 #ifdef CONFIG_RTW_SW_LED
 
+/*
+ * LED engine
+ *
+ * The blink state machines below only decide what the LED should look like.
+ * Every toggle goes through UsbLedOn()/UsbLedOff(), which drop writes that
+ * would not change the pin, and every timer goes through
+ * UsbLedSetBlinkTimer(), which clamps the period to what the pattern table
+ * allows. Traffic patterns are handed to the hardware LED engine when the
+ * chip provides SwLedHwBlink, the state machine then only ticks slowly to
+ * keep its bookkeeping and no register is touched until hardware blinking
+ * is released.
+ *
+ * Several LEDs may drive one physical pin (SwLedPhyPin), so the last
+ * written level and the hardware blink owner are kept per pin in led_priv.
+ *
+ * Only the traffic states are described by usb_led_patterns[]. The
+ * per customer SwLedBlink1..15 and SwLedControlMode1..15 state machines
+ * still pick their own intervals and next states in code, the table only
+ * adds the hardware mode and the minimum period on top of them.
+ */
+#define LED_HW_BLINK_HOLD_MS	2000	/* keep hardware blinking across short traffic gaps */
+#define LED_HW_BLINK_TICK_MS	500	/* state machine tick while hardware blinks */
+#define LED_SW_MIN_INTERVAL	100	/* lowest toggle period for software traffic blinking */
+
+struct usb_led_pattern {
+	u8 state;	/* LED_STATE */
+	u8 hw_mode;	/* enum led_hw_mode, LED_HW_MODE_SW if hardware can't do it */
+	u16 min_interval;	/* ms, 0 for no limit */
+};
+
+static const struct usb_led_pattern usb_led_patterns[] = {
+	{LED_BLINK_TXRX, LED_HW_MODE_TRX, LED_SW_MIN_INTERVAL},
+	{LED_BLINK_Azurewave_5Mbps, LED_HW_MODE_TRX, LED_SW_MIN_INTERVAL},
+	{LED_BLINK_Azurewave_10Mbps, LED_HW_MODE_TRX, LED_SW_MIN_INTERVAL},
+	{LED_BLINK_Azurewave_20Mbps, LED_HW_MODE_TRX, LED_SW_MIN_INTERVAL},
+	{LED_BLINK_Azurewave_40Mbps, LED_HW_MODE_TRX, LED_SW_MIN_INTERVAL},
+	{LED_BLINK_Azurewave_80Mbps, LED_HW_MODE_TRX, LED_SW_MIN_INTERVAL},
+	{LED_BLINK_Azurewave_MAXMbps, LED_HW_MODE_TRX, LED_SW_MIN_INTERVAL},
+};
+
+static const struct usb_led_pattern *usb_led_get_pattern(u8 state)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(usb_led_patterns); i++)
+		if (usb_led_patterns[i].state == state)
+			return &usb_led_patterns[i];
+
+	return NULL;
+}
+
+static u8 UsbLedPhyPin(PLED_USB pLed)
+{
+	struct led_priv *ledpriv = adapter_to_led(pLed->padapter);
+	u8 pin = ledpriv->SwLedPhyPin ? ledpriv->SwLedPhyPin(pLed) : pLed->LedPin;
+
+	return pin < LED_PIN_NUM ? pin : LED_PIN_GPIO0;
+}
+
+/* TRUE if the hardware blinks the pin of pLed on behalf of pLed */
+static u8 UsbLedIsHwBlink(PLED_USB pLed)
+{
+	return adapter_to_led(pLed->padapter)->pin_hw_blink[UsbLedPhyPin(pLed)] == pLed;
+}
+
+static void UsbLedExitHwBlink(PLED_USB pLed);
+
+static void UsbLedSwitch(_adapter *padapter, PLED_USB pLed, u8 on)
+{
+	struct led_priv *ledpriv = adapter_to_led(padapter);
+	const struct usb_led_pattern *pattern;
+	u8 state = on ? RTW_LED_ON : RTW_LED_OFF;
+	u8 pin = UsbLedPhyPin(pLed);
+	PLED_USB owner = ledpriv->pin_hw_blink[pin];
+
+	if (owner) {
+		pattern = usb_led_get_pattern(pLed->CurrLedState);
+		if (owner == pLed
+		    || (pattern && pattern->hw_mode == ledpriv->pin_hw_mode[pin])) {
+			/* pin is blinked by hardware the way pLed wants it, just track the SW view */
+			pLed->bLedOn = on ? _TRUE : _FALSE;
+			ledpriv->io_skip_cnt++;
+			return;
+		}
+		/* another LED on the same pin needs it, take it back from hardware */
+		UsbLedExitHwBlink(owner);
+	}
+
+	if (ledpriv->pin_io_state[pin] == state) {
+		pLed->bLedOn = on ? _TRUE : _FALSE;
+		ledpriv->io_skip_cnt++;
+		return;
+	}
+
+	if (on)
+		SwLedOn(padapter, pLed);
+	else
+		SwLedOff(padapter, pLed);
+
+	/* SwLedOn/SwLedOff leave bLedOn untouched when the write is not done */
+	if (pLed->bLedOn == (on ? _TRUE : _FALSE)) {
+		ledpriv->pin_io_state[pin] = state;
+		ledpriv->io_cnt++;
+	}
+}
+
+#define UsbLedOn(adapter, pLed) UsbLedSwitch((adapter), (pLed), 1)
+#define UsbLedOff(adapter, pLed) UsbLedSwitch((adapter), (pLed), 0)
+
+static void UsbLedSetBlinkTimer(PLED_USB pLed, u32 ms)
+{
+	const struct usb_led_pattern *pattern;
+
+	if (ms) {
+		if (UsbLedIsHwBlink(pLed)) {
+			if (ms < LED_HW_BLINK_TICK_MS)
+				ms = LED_HW_BLINK_TICK_MS;
+		} else {
+			pattern = usb_led_get_pattern(pLed->CurrLedState);
+			if (pattern && ms < pattern->min_interval)
+				ms = pattern->min_interval;
+		}
+	}
+
+	_set_timer(&(pLed->BlinkTimer), ms);
+}
+
+static void UsbLedExitHwBlink(PLED_USB pLed)
+{
+	_adapter *padapter = pLed->padapter;
+	struct led_priv *ledpriv = adapter_to_led(padapter);
+	u8 pin = UsbLedPhyPin(pLed);
+
+	if (ledpriv->pin_hw_blink[pin] != pLed)
+		return;
+
+	if (ledpriv->SwLedHwBlink)
+		ledpriv->SwLedHwBlink(padapter, pLed, LED_HW_MODE_SW);
+	ledpriv->pin_hw_blink[pin] = NULL;
+	ledpriv->pin_hw_mode[pin] = LED_HW_MODE_SW;
+	/* pin level after hardware blinking is unknown, force next write */
+	ledpriv->pin_io_state[pin] = LED_UNKNOWN;
+}
+
+/*
+ * Called on every BlinkHandler run, moves the LED in and out of hardware
+ * blinking according to CurrLedState.
+ */
+static void UsbLedUpdateHwBlink(PLED_USB pLed)
+{
+	_adapter *padapter = pLed->padapter;
+	struct led_priv *ledpriv = adapter_to_led(padapter);
+	const struct usb_led_pattern *pattern;
+	u8 pin = UsbLedPhyPin(pLed);
+	PLED_USB owner;
+
+	if (!ledpriv->SwLedHwBlink)
+		return;
+#if CONFIG_RTW_SW_LED_TRX_DA_CLASSIFY
+	/* hal_led.c drives the pin directly in this mode */
+	if (ledpriv->LedStrategy == SW_LED_MODE_UC_TRX_ONLY)
+		return;
+#endif
+
+	owner = ledpriv->pin_hw_blink[pin];
+	pattern = usb_led_get_pattern(pLed->CurrLedState);
+	if (pattern && pattern->hw_mode != LED_HW_MODE_SW) {
+		if (owner == NULL) {
+			if (ledpriv->SwLedHwBlink(padapter, pLed, pattern->hw_mode) != _SUCCESS)
+				return;
+			ledpriv->pin_hw_blink[pin] = pLed;
+			ledpriv->pin_hw_mode[pin] = pattern->hw_mode;
+			ledpriv->hw_blink_cnt++;
+			owner = pLed;
+		}
+		/* a pin blinked for another LED in the same mode serves pLed too */
+		if (owner == pLed || ledpriv->pin_hw_mode[pin] == pattern->hw_mode)
+			owner->hw_blink_hold = rtw_get_current_time() + rtw_ms_to_systime(LED_HW_BLINK_HOLD_MS);
+		return;
+	}
+
+	if (owner != pLed)
+		return;
+
+	/* other blink patterns need SW, steady states wait for the hold to expire */
+	if ((pLed->CurrLedState != RTW_LED_ON && pLed->CurrLedState != RTW_LED_OFF)
+	    || rtw_time_after(rtw_get_current_time(), pLed->hw_blink_hold))
+		UsbLedExitHwBlink(pLed);
+}
+
+/*
+ * Hardware blinking ended in a steady state, nothing arms the timer anymore
+ * so do it here to release the pin once the hold expires.
+ */
+static void UsbLedHwBlinkHoldCheck(PLED_USB pLed)
+{
+	if (!UsbLedIsHwBlink(pLed))
+		return;
+
+	if (pLed->CurrLedState == RTW_LED_ON || pLed->CurrLedState == RTW_LED_OFF) {
+		pLed->BlinkingLedState = pLed->CurrLedState;
+		_set_timer(&(pLed->BlinkTimer), LED_HW_BLINK_TICK_MS);
+	}
+}
+
 /*
  *	Description:
  *		Implementation of LED blinking behavior.
@@ -33,9 +238,9 @@ SwLedBlink(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(padapter, pLed);
+		UsbLedOn(padapter, pLed);
 	} else {
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 	}
 
 	/* Determine if we shall change LED state again. */
@@ -71,11 +276,11 @@ SwLedBlink(
 
 	if (bStopBlinking) {
 		if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-			SwLedOff(padapter, pLed);
+			UsbLedOff(padapter, pLed);
 		else if ((check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) && (pLed->bLedOn == _FALSE))
-			SwLedOn(padapter, pLed);
+			UsbLedOn(padapter, pLed);
 		else if ((check_fwstate(pmlmepriv, _FW_LINKED) == _FALSE) &&  pLed->bLedOn == _TRUE)
-			SwLedOff(padapter, pLed);
+			UsbLedOff(padapter, pLed);
 
 		pLed->BlinkTimes = 0;
 		pLed->bLedBlinkInProgress = _FALSE;
@@ -89,24 +294,24 @@ SwLedBlink(
 		/* Schedule a timer to toggle LED state. */
 		switch (pLed->CurrLedState) {
 		case LED_BLINK_NORMAL:
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 			break;
 
 		case LED_BLINK_SLOWLY:
 		case LED_BLINK_StartToBlink:
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SLOWLY_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SLOWLY_INTERVAL);
 			break;
 
 		case LED_BLINK_WPS: {
 			if (pLed->BlinkingLedState == RTW_LED_ON)
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LONG_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LONG_INTERVAL);
 			else
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LONG_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LONG_INTERVAL);
 		}
 		break;
 
 		default:
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SLOWLY_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SLOWLY_INTERVAL);
 			break;
 		}
 	}
@@ -133,25 +338,25 @@ SwLedBlink1(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(padapter, pLed);
+		UsbLedOn(padapter, pLed);
 	} else {
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 	}
 
 
 	if (pHalData->CustomerID == RT_CID_DEFAULT) {
 		if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) {
 			if (!pLed1->bSWLedCtrl) {
-				SwLedOn(padapter, pLed1);
+				UsbLedOn(padapter, pLed1);
 				pLed1->bSWLedCtrl = _TRUE;
 			} else if (!pLed1->bLedOn)
-				SwLedOn(padapter, pLed1);
+				UsbLedOn(padapter, pLed1);
 		} else {
 			if (!pLed1->bSWLedCtrl) {
-				SwLedOff(padapter, pLed1);
+				UsbLedOff(padapter, pLed1);
 				pLed1->bSWLedCtrl = _TRUE;
 			} else if (pLed1->bLedOn)
-				SwLedOff(padapter, pLed1);
+				UsbLedOff(padapter, pLed1);
 		}
 	}
 
@@ -161,7 +366,7 @@ SwLedBlink1(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), uLedBlinkNoLinkInterval);/* change by ylb 20121012 for customer led for alpha */
+		UsbLedSetBlinkTimer(pLed, uLedBlinkNoLinkInterval);/* change by ylb 20121012 for customer led for alpha */
 		break;
 
 	case LED_BLINK_NORMAL:
@@ -169,7 +374,7 @@ SwLedBlink1(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 		break;
 
 	case LED_BLINK_SCAN:
@@ -179,7 +384,7 @@ SwLedBlink1(
 
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) {
 				pLed->bLedLinkBlinkInProgress = _TRUE;
 				pLed->CurrLedState = LED_BLINK_NORMAL;
@@ -187,7 +392,7 @@ SwLedBlink1(
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 
 			} else if (check_fwstate(pmlmepriv, _FW_LINKED) == _FALSE) {
 				pLed->bLedNoLinkBlinkInProgress = _TRUE;
@@ -196,18 +401,18 @@ SwLedBlink1(
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), uLedBlinkNoLinkInterval);
+				UsbLedSetBlinkTimer(pLed, uLedBlinkNoLinkInterval);
 			}
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -218,7 +423,7 @@ SwLedBlink1(
 			bStopBlinking = _TRUE;
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) {
 				pLed->bLedLinkBlinkInProgress = _TRUE;
 				pLed->CurrLedState = LED_BLINK_NORMAL;
@@ -226,7 +431,7 @@ SwLedBlink1(
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 			} else if (check_fwstate(pmlmepriv, _FW_LINKED) == _FALSE) {
 				pLed->bLedNoLinkBlinkInProgress = _TRUE;
 				pLed->CurrLedState = LED_BLINK_SLOWLY;
@@ -234,19 +439,19 @@ SwLedBlink1(
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), uLedBlinkNoLinkInterval);
+				UsbLedSetBlinkTimer(pLed, uLedBlinkNoLinkInterval);
 			}
 			pLed->BlinkTimes = 0;
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -256,20 +461,20 @@ SwLedBlink1(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		break;
 
 	case LED_BLINK_WPS_STOP:	/* WPS success */
 		if (pLed->BlinkingLedState == RTW_LED_ON) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_WPS_SUCESS_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_WPS_SUCESS_INTERVAL_ALPHA);
 			bStopBlinking = _FALSE;
 		} else
 			bStopBlinking = _TRUE;
 
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				pLed->bLedLinkBlinkInProgress = _TRUE;
 				pLed->CurrLedState = LED_BLINK_NORMAL;
@@ -277,7 +482,7 @@ SwLedBlink1(
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 			}
 			pLed->bLedWPSBlinkInProgress = _FALSE;
 		}
@@ -300,9 +505,9 @@ SwLedBlink2(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(padapter, pLed);
+		UsbLedOn(padapter, pLed);
 	} else {
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 	}
 
 	switch (pLed->CurrLedState) {
@@ -313,27 +518,27 @@ SwLedBlink2(
 
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) {
 				pLed->CurrLedState = RTW_LED_ON;
 				pLed->BlinkingLedState = RTW_LED_ON;
-				SwLedOn(padapter, pLed);
+				UsbLedOn(padapter, pLed);
 
 			} else if (check_fwstate(pmlmepriv, _FW_LINKED) == _FALSE) {
 				pLed->CurrLedState = RTW_LED_OFF;
 				pLed->BlinkingLedState = RTW_LED_OFF;
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			}
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -344,27 +549,27 @@ SwLedBlink2(
 			bStopBlinking = _TRUE;
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) {
 				pLed->CurrLedState = RTW_LED_ON;
 				pLed->BlinkingLedState = RTW_LED_ON;
-				SwLedOn(padapter, pLed);
+				UsbLedOn(padapter, pLed);
 
 			} else if (check_fwstate(pmlmepriv, _FW_LINKED) == _FALSE) {
 				pLed->CurrLedState = RTW_LED_OFF;
 				pLed->BlinkingLedState = RTW_LED_OFF;
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			}
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -386,10 +591,10 @@ SwLedBlink3(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(padapter, pLed);
+		UsbLedOn(padapter, pLed);
 	} else {
 		if (pLed->CurrLedState != LED_BLINK_WPS_STOP)
-			SwLedOff(padapter, pLed);
+			UsbLedOff(padapter, pLed);
 	}
 
 	switch (pLed->CurrLedState) {
@@ -400,30 +605,30 @@ SwLedBlink3(
 
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) {
 				pLed->CurrLedState = RTW_LED_ON;
 				pLed->BlinkingLedState = RTW_LED_ON;
 				if (!pLed->bLedOn)
-					SwLedOn(padapter, pLed);
+					UsbLedOn(padapter, pLed);
 
 			} else if (check_fwstate(pmlmepriv, _FW_LINKED) == _FALSE) {
 				pLed->CurrLedState = RTW_LED_OFF;
 				pLed->BlinkingLedState = RTW_LED_OFF;
 				if (pLed->bLedOn)
-					SwLedOff(padapter, pLed);
+					UsbLedOff(padapter, pLed);
 
 			}
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -434,33 +639,33 @@ SwLedBlink3(
 			bStopBlinking = _TRUE;
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) {
 				pLed->CurrLedState = RTW_LED_ON;
 				pLed->BlinkingLedState = RTW_LED_ON;
 
 				if (!pLed->bLedOn)
-					SwLedOn(padapter, pLed);
+					UsbLedOn(padapter, pLed);
 
 			} else if (check_fwstate(pmlmepriv, _FW_LINKED) == _FALSE) {
 				pLed->CurrLedState = RTW_LED_OFF;
 				pLed->BlinkingLedState = RTW_LED_OFF;
 
 				if (pLed->bLedOn)
-					SwLedOff(padapter, pLed);
+					UsbLedOff(padapter, pLed);
 
 
 			}
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -470,24 +675,24 @@ SwLedBlink3(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		break;
 
 	case LED_BLINK_WPS_STOP:	/* WPS success */
 		if (pLed->BlinkingLedState == RTW_LED_ON) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_WPS_SUCESS_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_WPS_SUCESS_INTERVAL_ALPHA);
 			bStopBlinking = _FALSE;
 		} else
 			bStopBlinking = _TRUE;
 
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				pLed->CurrLedState = RTW_LED_ON;
 				pLed->BlinkingLedState = RTW_LED_ON;
-				SwLedOn(padapter, pLed);
+				UsbLedOn(padapter, pLed);
 			}
 			pLed->bLedWPSBlinkInProgress = _FALSE;
 		}
@@ -514,15 +719,15 @@ SwLedBlink4(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(padapter, pLed);
+		UsbLedOn(padapter, pLed);
 	} else {
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 	}
 
 	if (!pLed1->bLedWPSBlinkInProgress && pLed1->BlinkingLedState == LED_UNKNOWN) {
 		pLed1->BlinkingLedState = RTW_LED_OFF;
 		pLed1->CurrLedState = RTW_LED_OFF;
-		SwLedOff(padapter, pLed1);
+		UsbLedOff(padapter, pLed1);
 	}
 
 	switch (pLed->CurrLedState) {
@@ -531,16 +736,16 @@ SwLedBlink4(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 		break;
 
 	case LED_BLINK_StartToBlink:
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SLOWLY_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SLOWLY_INTERVAL);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		}
 		break;
 
@@ -551,7 +756,7 @@ SwLedBlink4(
 
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(padapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				pLed->bLedNoLinkBlinkInProgress = _FALSE;
 				pLed->CurrLedState = LED_BLINK_SLOWLY;
@@ -559,18 +764,18 @@ SwLedBlink4(
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 			}
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(padapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -581,7 +786,7 @@ SwLedBlink4(
 			bStopBlinking = _TRUE;
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(padapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				pLed->bLedNoLinkBlinkInProgress = _TRUE;
 				pLed->CurrLedState = LED_BLINK_SLOWLY;
@@ -589,12 +794,12 @@ SwLedBlink4(
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 			}
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(padapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 
 				if (pLed->bLedOn)
@@ -602,7 +807,7 @@ SwLedBlink4(
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
 
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -610,10 +815,10 @@ SwLedBlink4(
 	case LED_BLINK_WPS:
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SLOWLY_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SLOWLY_INTERVAL);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		}
 		break;
 
@@ -623,7 +828,7 @@ SwLedBlink4(
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
 
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		break;
 
 	case LED_BLINK_WPS_STOP_OVERLAP:	/* WPS session overlap */
@@ -638,14 +843,14 @@ SwLedBlink4(
 		if (bStopBlinking) {
 			pLed->BlinkTimes = 10;
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 		} else {
 			if (pLed->bLedOn)
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
 
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		}
 		break;
 
@@ -655,7 +860,7 @@ SwLedBlink4(
 			bStopBlinking = _TRUE;
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(padapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				pLed->bLedNoLinkBlinkInProgress = _TRUE;
 				pLed->CurrLedState = LED_BLINK_SLOWLY;
@@ -664,19 +869,19 @@ SwLedBlink4(
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
 
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 			}
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(padapter)->rfoff_reason > RF_CHANGE_BY_PS) {
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			} else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
 
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -700,9 +905,9 @@ SwLedBlink5(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(padapter, pLed);
+		UsbLedOn(padapter, pLed);
 	} else {
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 	}
 
 	switch (pLed->CurrLedState) {
@@ -716,24 +921,24 @@ SwLedBlink5(
 				pLed->CurrLedState = RTW_LED_OFF;
 				pLed->BlinkingLedState = RTW_LED_OFF;
 				if (pLed->bLedOn)
-					SwLedOff(padapter, pLed);
+					UsbLedOff(padapter, pLed);
 			} else {
 				pLed->CurrLedState = RTW_LED_ON;
 				pLed->BlinkingLedState = RTW_LED_ON;
 				if (!pLed->bLedOn)
-					_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+					UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(padapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -749,24 +954,24 @@ SwLedBlink5(
 				pLed->CurrLedState = RTW_LED_OFF;
 				pLed->BlinkingLedState = RTW_LED_OFF;
 				if (pLed->bLedOn)
-					SwLedOff(padapter, pLed);
+					UsbLedOff(padapter, pLed);
 			} else {
 				pLed->CurrLedState = RTW_LED_ON;
 				pLed->BlinkingLedState = RTW_LED_ON;
 				if (!pLed->bLedOn)
-					_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+					UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(padapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(padapter, pLed);
+				UsbLedOff(padapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -790,9 +995,9 @@ SwLedBlink6(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(padapter, pLed);
+		UsbLedOn(padapter, pLed);
 	} else {
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 	}
 
 }
@@ -808,10 +1013,10 @@ SwLedBlink7(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 	} else {
 		if (pLed->CurrLedState != LED_BLINK_WPS_STOP)
-			SwLedOff(Adapter, pLed);
+			UsbLedOff(Adapter, pLed);
 	}
 
 	switch (pLed->CurrLedState) {
@@ -822,30 +1027,30 @@ SwLedBlink7(
 
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) {
 				pLed->CurrLedState = RTW_LED_ON;
 				pLed->BlinkingLedState = RTW_LED_ON;
 				if (!pLed->bLedOn)
-					SwLedOn(Adapter, pLed);
+					UsbLedOn(Adapter, pLed);
 
 			} else if (check_fwstate(pmlmepriv, _FW_LINKED) == _FALSE) {
 				pLed->CurrLedState = RTW_LED_OFF;
 				pLed->BlinkingLedState = RTW_LED_OFF;
 				if (pLed->bLedOn)
-					SwLedOff(Adapter, pLed);
+					UsbLedOff(Adapter, pLed);
 
 			}
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_NETGEAR);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_NETGEAR);
 			}
 		}
 		break;
@@ -855,24 +1060,24 @@ SwLedBlink7(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_NETGEAR);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_NETGEAR);
 		break;
 
 	case LED_BLINK_WPS_STOP:	/* WPS success */
 		if (pLed->BlinkingLedState == RTW_LED_ON) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_NETGEAR);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_NETGEAR);
 			bStopBlinking = _FALSE;
 		} else
 			bStopBlinking = _TRUE;
 
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				pLed->CurrLedState = RTW_LED_ON;
 				pLed->BlinkingLedState = RTW_LED_ON;
-				SwLedOn(Adapter, pLed);
+				UsbLedOn(Adapter, pLed);
 			}
 			pLed->bLedWPSBlinkInProgress = _FALSE;
 		}
@@ -895,9 +1100,9 @@ SwLedBlink8(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 	} else {
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 	}
 
 
@@ -915,20 +1120,20 @@ SwLedBlink9(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 	} else {
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 	}
 	/* RTW_INFO("%s, pLed->CurrLedState=%d, pLed->BlinkingLedState=%d\n", __FUNCTION__, pLed->CurrLedState, pLed->BlinkingLedState); */
 
 
 	switch (pLed->CurrLedState) {
 	case RTW_LED_ON:
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 		break;
 
 	case RTW_LED_OFF:
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 		break;
 
 	case LED_BLINK_SLOWLY:
@@ -936,16 +1141,16 @@ SwLedBlink9(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 		break;
 
 	case LED_BLINK_StartToBlink:
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SLOWLY_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SLOWLY_INTERVAL);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		}
 		break;
 
@@ -956,12 +1161,12 @@ SwLedBlink9(
 
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) {
 				pLed->bLedLinkBlinkInProgress = _TRUE;
 				pLed->CurrLedState = LED_BLINK_SLOWLY;
 
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 			} else if (check_fwstate(pmlmepriv, _FW_LINKED) == _FALSE) {
 				pLed->bLedNoLinkBlinkInProgress = _TRUE;
 				pLed->CurrLedState = LED_BLINK_SLOWLY;
@@ -969,19 +1174,19 @@ SwLedBlink9(
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 			}
 			pLed->BlinkTimes = 0;
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -992,26 +1197,26 @@ SwLedBlink9(
 			bStopBlinking = _TRUE;
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				pLed->CurrLedState = LED_BLINK_SLOWLY;
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
 
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -1019,10 +1224,10 @@ SwLedBlink9(
 	case LED_BLINK_WPS:
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SLOWLY_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SLOWLY_INTERVAL);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		}
 		break;
 
@@ -1032,7 +1237,7 @@ SwLedBlink9(
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
 
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		break;
 
 	case LED_BLINK_WPS_STOP_OVERLAP:	/* WPS session overlap		 */
@@ -1041,7 +1246,7 @@ SwLedBlink9(
 		if (pLed->BlinkCounter == 0) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
 			pLed->CurrLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		} else {
 			if (pLed->BlinkTimes == 0) {
 				if (pLed->bLedOn)
@@ -1053,14 +1258,14 @@ SwLedBlink9(
 			if (bStopBlinking) {
 				pLed->BlinkTimes = 10;
 				pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 			} else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
 
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 			}
 		}
 		break;
@@ -1071,7 +1276,7 @@ SwLedBlink9(
 			bStopBlinking = _TRUE;
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				if (IS_HARDWARE_TYPE_8812AU(Adapter)) {
 					pLed->BlinkingLedState = RTW_LED_ON;
@@ -1084,12 +1289,12 @@ SwLedBlink9(
 					else
 						pLed->BlinkingLedState = RTW_LED_ON;
 				}
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 			}
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS) {
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			} else {
 				if (IS_HARDWARE_TYPE_8812AU(Adapter))
 					pLed->BlinkingLedState = RTW_LED_ON;
@@ -1099,7 +1304,7 @@ SwLedBlink9(
 					else
 						pLed->BlinkingLedState = RTW_LED_ON;
 				}
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -1107,10 +1312,10 @@ SwLedBlink9(
 	case LED_BLINK_LINK_IN_PROCESS:
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ON_BELKIN);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ON_BELKIN);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_OFF_BELKIN);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_OFF_BELKIN);
 		}
 		break;
 
@@ -1121,15 +1326,15 @@ SwLedBlink9(
 		if (bStopBlinking == _FALSE) {
 			if (pLed->bLedOn) {
 				pLed->BlinkingLedState = RTW_LED_OFF;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_ERROR_INTERVAL_BELKIN);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_ERROR_INTERVAL_BELKIN);
 			} else {
 				pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_ERROR_INTERVAL_BELKIN);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_ERROR_INTERVAL_BELKIN);
 			}
 		} else {
 			pLed->CurrLedState = RTW_LED_OFF;
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_ERROR_INTERVAL_BELKIN);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_ERROR_INTERVAL_BELKIN);
 		}
 		break;
 
@@ -1151,19 +1356,19 @@ SwLedBlink10(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 	} else {
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 	}
 
 
 	switch (pLed->CurrLedState) {
 	case RTW_LED_ON:
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 		break;
 
 	case RTW_LED_OFF:
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 		break;
 
 	case LED_BLINK_SLOWLY:
@@ -1171,16 +1376,16 @@ SwLedBlink10(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 		break;
 
 	case LED_BLINK_StartToBlink:
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SLOWLY_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SLOWLY_INTERVAL);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		}
 		break;
 
@@ -1191,26 +1396,26 @@ SwLedBlink10(
 
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else if (check_fwstate(pmlmepriv, _FW_LINKED) == _TRUE) {
 				pLed->bLedNoLinkBlinkInProgress = _FALSE;
 				pLed->CurrLedState = RTW_LED_OFF;
 				pLed->BlinkingLedState = RTW_LED_OFF;
 
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 			}
 			pLed->BlinkTimes = 0;
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				if (pLed->bLedOn) {
 					pLed->BlinkingLedState = RTW_LED_OFF;
-					_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_NETGEAR);
+					UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_NETGEAR);
 				} else {
 					pLed->BlinkingLedState = RTW_LED_ON;
-					_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_SLOWLY_INTERVAL_NETGEAR + LED_BLINK_LINK_INTERVAL_NETGEAR);
+					UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_SLOWLY_INTERVAL_NETGEAR + LED_BLINK_LINK_INTERVAL_NETGEAR);
 				}
 			}
 		}
@@ -1219,10 +1424,10 @@ SwLedBlink10(
 	case LED_BLINK_WPS:
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_NETGEAR);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_NETGEAR);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL + LED_BLINK_LINK_INTERVAL_NETGEAR);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL + LED_BLINK_LINK_INTERVAL_NETGEAR);
 		}
 		break;
 
@@ -1232,7 +1437,7 @@ SwLedBlink10(
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
 
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		break;
 
 	case LED_BLINK_WPS_STOP_OVERLAP:	/* WPS session overlap */
@@ -1241,7 +1446,7 @@ SwLedBlink10(
 		if (pLed->BlinkCounter == 0) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
 			pLed->CurrLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		} else {
 			if (pLed->BlinkTimes == 0) {
 				if (pLed->bLedOn)
@@ -1253,14 +1458,14 @@ SwLedBlink10(
 			if (bStopBlinking) {
 				pLed->BlinkTimes = 10;
 				pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 			} else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
 
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 			}
 		}
 		break;
@@ -1271,7 +1476,7 @@ SwLedBlink10(
 			bStopBlinking = _TRUE;
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				if (IS_HARDWARE_TYPE_8812AU(Adapter)) {
 					pLed->BlinkingLedState = RTW_LED_ON;
@@ -1284,12 +1489,12 @@ SwLedBlink10(
 					else
 						pLed->BlinkingLedState = RTW_LED_ON;
 				}
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 			}
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS) {
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			} else {
 				if (IS_HARDWARE_TYPE_8812AU(Adapter))
 					pLed->BlinkingLedState = RTW_LED_ON;
@@ -1299,7 +1504,7 @@ SwLedBlink10(
 					else
 						pLed->BlinkingLedState = RTW_LED_ON;
 				}
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -1307,10 +1512,10 @@ SwLedBlink10(
 	case LED_BLINK_LINK_IN_PROCESS:
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ON_BELKIN);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ON_BELKIN);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_OFF_BELKIN);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_OFF_BELKIN);
 		}
 		break;
 
@@ -1321,15 +1526,15 @@ SwLedBlink10(
 		if (bStopBlinking == _FALSE) {
 			if (pLed->bLedOn) {
 				pLed->BlinkingLedState = RTW_LED_OFF;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_ERROR_INTERVAL_BELKIN);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_ERROR_INTERVAL_BELKIN);
 			} else {
 				pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_ERROR_INTERVAL_BELKIN);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_ERROR_INTERVAL_BELKIN);
 			}
 		} else {
 			pLed->CurrLedState = RTW_LED_OFF;
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_ERROR_INTERVAL_BELKIN);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_ERROR_INTERVAL_BELKIN);
 		}
 		break;
 
@@ -1351,36 +1556,36 @@ SwLedBlink11(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 	} else {
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 	}
 
 	switch (pLed->CurrLedState) {
 	case LED_BLINK_TXRX:
 		if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-			SwLedOff(Adapter, pLed);
+			UsbLedOff(Adapter, pLed);
 		else {
 			if (pLed->bLedOn)
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		}
 
 		break;
 
 	case LED_BLINK_WPS:
 		if (pLed->BlinkTimes == 5) {
-			SwLedOn(Adapter, pLed);
-			_set_timer(&(pLed->BlinkTimer), LED_CM11_LINK_ON_INTERVEL);
+			UsbLedOn(Adapter, pLed);
+			UsbLedSetBlinkTimer(pLed, LED_CM11_LINK_ON_INTERVEL);
 		} else {
 			if (pLed->bLedOn) {
 				pLed->BlinkingLedState = RTW_LED_OFF;
-				_set_timer(&(pLed->BlinkTimer), LED_CM11_BLINK_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_CM11_BLINK_INTERVAL);
 			} else {
 				pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_CM11_BLINK_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_CM11_BLINK_INTERVAL);
 			}
 		}
 		pLed->BlinkTimes--;
@@ -1396,12 +1601,12 @@ SwLedBlink11(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		} else {
 			pLed->CurrLedState = RTW_LED_ON;
 			pLed->BlinkingLedState = RTW_LED_ON;
-			SwLedOn(Adapter, pLed);
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedOn(Adapter, pLed);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -1422,9 +1627,9 @@ SwLedBlink12(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 	} else {
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 	}
 
 	switch (pLed->CurrLedState) {
@@ -1433,7 +1638,7 @@ SwLedBlink12(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 		break;
 
 	case LED_BLINK_TXRX:
@@ -1446,7 +1651,7 @@ SwLedBlink12(
 				pLed->CurrLedState = RTW_LED_OFF;
 				pLed->BlinkingLedState = RTW_LED_OFF;
 				if (pLed->bLedOn)
-					SwLedOff(Adapter, pLed);
+					UsbLedOff(Adapter, pLed);
 			} else {
 				pLed->bLedNoLinkBlinkInProgress = _TRUE;
 				pLed->CurrLedState = LED_BLINK_SLOWLY;
@@ -1454,19 +1659,19 @@ SwLedBlink12(
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 			}
 
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -1491,10 +1696,10 @@ SwLedBlink13(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 	} else {
 		if (pLed->CurrLedState != LED_BLINK_WPS_STOP)
-			SwLedOff(Adapter, pLed);
+			UsbLedOff(Adapter, pLed);
 	}
 	switch (pLed->CurrLedState) {
 	case LED_BLINK_LINK_IN_PROCESS:
@@ -1508,10 +1713,10 @@ SwLedBlink13(
 		}
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), 500);
+			UsbLedSetBlinkTimer(pLed, 500);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), 500);
+			UsbLedSetBlinkTimer(pLed, 500);
 		}
 
 		break;
@@ -1519,16 +1724,16 @@ SwLedBlink13(
 	case LED_BLINK_WPS:
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_WPS_BLINK_ON_INTERVAL_NETGEAR);
+			UsbLedSetBlinkTimer(pLed, LED_WPS_BLINK_ON_INTERVAL_NETGEAR);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_WPS_BLINK_OFF_INTERVAL_NETGEAR);
+			UsbLedSetBlinkTimer(pLed, LED_WPS_BLINK_OFF_INTERVAL_NETGEAR);
 		}
 
 		break;
 
 	case LED_BLINK_WPS_STOP:	/* WPS success */
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 		pLed->bLedWPSBlinkInProgress = _FALSE;
 		break;
 
@@ -1552,10 +1757,10 @@ SwLedBlink14(
 
 	/* Change LED according to BlinkingLedState specified. */
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 	} else {
 		if (pLed->CurrLedState != LED_BLINK_WPS_STOP)
-			SwLedOff(Adapter, pLed);
+			UsbLedOff(Adapter, pLed);
 	}
 	switch (pLed->CurrLedState) {
 	case LED_BLINK_TXRX:
@@ -1564,26 +1769,26 @@ SwLedBlink14(
 			bStopBlinking = _TRUE;
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else
-				SwLedOn(Adapter, pLed);
+				UsbLedOn(Adapter, pLed);
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				if (pLed->bLedOn) {
 					pLed->BlinkingLedState = RTW_LED_OFF;
 					if (IS_HARDWARE_TYPE_8812AU(Adapter))
-						_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+						UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 					else
-						_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+						UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 				} else {
 					pLed->BlinkingLedState = RTW_LED_ON;
 					if (IS_HARDWARE_TYPE_8812AU(Adapter))
-						_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+						UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 					else
-						_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+						UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 				}
 			}
 		}
@@ -1609,19 +1814,19 @@ SwLedBlink15(
 	/* Change LED according to BlinkingLedState specified. */
 
 	if (pLed->BlinkingLedState == RTW_LED_ON) {
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 	} else {
 		if (pLed->CurrLedState != LED_BLINK_WPS_STOP)
-			SwLedOff(Adapter, pLed);
+			UsbLedOff(Adapter, pLed);
 	}
 	switch (pLed->CurrLedState) {
 	case LED_BLINK_WPS:
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_WPS_BLINK_ON_INTERVAL_DLINK);
+			UsbLedSetBlinkTimer(pLed, LED_WPS_BLINK_ON_INTERVAL_DLINK);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_WPS_BLINK_OFF_INTERVAL_DLINK);
+			UsbLedSetBlinkTimer(pLed, LED_WPS_BLINK_OFF_INTERVAL_DLINK);
 		}
 		break;
 
@@ -1635,7 +1840,7 @@ SwLedBlink15(
 		pLed->CurrLedState = LED_BLINK_WPS_STOP;
 		pLed->BlinkingLedState = RTW_LED_OFF;
 
-		_set_timer(&(pLed->BlinkTimer), LED_WPS_BLINK_LINKED_ON_INTERVAL_DLINK);
+		UsbLedSetBlinkTimer(pLed, LED_WPS_BLINK_LINKED_ON_INTERVAL_DLINK);
 		break;
 
 	case LED_BLINK_NO_LINK: {
@@ -1648,7 +1853,7 @@ SwLedBlink15(
 			pLed->BlinkingLedState = RTW_LED_ON;
 		}
 		pLed->bLedBlinkInProgress = _TRUE;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL);
 	}
 	break;
 
@@ -1663,7 +1868,7 @@ SwLedBlink15(
 
 		}
 		pLed->bLedBlinkInProgress = _TRUE;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_IDEL_INTERVAL);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_IDEL_INTERVAL);
 	}
 	break;
 
@@ -1679,16 +1884,16 @@ SwLedBlink15(
 			pLed->bLedBlinkInProgress = _TRUE;
 
 			if (pLed->BlinkingLedState == RTW_LED_ON)
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_OFF_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_OFF_INTERVAL);
 			else
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_ON_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_ON_INTERVAL);
 		} else {
 			/* if(pLed->OLDLedState ==LED_NO_LINK_BLINK) */
 			if (check_fwstate(pmlmepriv, _FW_LINKED) == _FALSE) {
 				pLed->CurrLedState = LED_BLINK_NO_LINK;
 				pLed->BlinkingLedState = RTW_LED_ON;
 
-				_set_timer(&(pLed->BlinkTimer), 100);
+				UsbLedSetBlinkTimer(pLed, 100);
 			}
 			BlinkTime = 0;
 		}
@@ -1701,19 +1906,19 @@ SwLedBlink15(
 			bStopBlinking = _TRUE;
 		if (bStopBlinking) {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else
-				SwLedOn(Adapter, pLed);
+				UsbLedOn(Adapter, pLed);
 			pLed->bLedBlinkInProgress = _FALSE;
 		} else {
 			if (adapter_to_pwrctl(Adapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(Adapter)->rfoff_reason > RF_CHANGE_BY_PS)
-				SwLedOff(Adapter, pLed);
+				UsbLedOff(Adapter, pLed);
 			else {
 				if (pLed->bLedOn)
 					pLed->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -1745,6 +1950,8 @@ void BlinkHandler(PLED_USB pLed)
 		return;
 	}
 
+	UsbLedUpdateHwBlink(pLed);
+
 	switch (ledpriv->LedStrategy) {
 	#if CONFIG_RTW_SW_LED_TRX_DA_CLASSIFY
 	case SW_LED_MODE_UC_TRX_ONLY:
@@ -1820,6 +2027,8 @@ void BlinkHandler(PLED_USB pLed)
 		/* SwLedBlink(pLed); */
 		break;
 	}
+
+	UsbLedHwBlinkHoldCheck(pLed);
 }
 
 /*
@@ -1883,7 +2092,7 @@ SwLedControlMode0(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 		}
 		break;
 
@@ -1898,7 +2107,7 @@ SwLedControlMode0(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SLOWLY_INTERVAL);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SLOWLY_INTERVAL);
 		} else
 			pLed->CurrLedState = LED_BLINK_StartToBlink;
 		break;
@@ -1907,7 +2116,7 @@ SwLedControlMode0(
 		pLed->CurrLedState = RTW_LED_ON;
 		if (pLed->bLedBlinkInProgress == _FALSE) {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -1915,7 +2124,7 @@ SwLedControlMode0(
 		pLed->CurrLedState = RTW_LED_OFF;
 		if (pLed->bLedBlinkInProgress == _FALSE) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -1925,7 +2134,7 @@ SwLedControlMode0(
 			_cancel_timer_ex(&(pLed->BlinkTimer));
 			pLed->bLedBlinkInProgress = _FALSE;
 		}
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 		break;
 
 	case LED_CTL_START_WPS:
@@ -1937,10 +2146,10 @@ SwLedControlMode0(
 
 			if (pLed->bLedOn) {
 				pLed->BlinkingLedState = RTW_LED_OFF;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LONG_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LONG_INTERVAL);
 			} else {
 				pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_LONG_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_LONG_INTERVAL);
 			}
 		}
 		break;
@@ -2002,7 +2211,7 @@ SwLedControlMode1(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), uLedBlinkNoLinkInterval);/* change by ylb 20121012 for customer led for alpha */
+			UsbLedSetBlinkTimer(pLed, uLedBlinkNoLinkInterval);/* change by ylb 20121012 for customer led for alpha */
 		}
 		break;
 
@@ -2024,7 +2233,7 @@ SwLedControlMode1(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2056,9 +2265,9 @@ SwLedControlMode1(
 				pLed->BlinkingLedState = RTW_LED_ON;
 
 			if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on && adapter_to_pwrctl(padapter)->rfoff_reason == RF_CHANGE_BY_IPS)
-				_set_timer(&(pLed->BlinkTimer), LED_INITIAL_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_INITIAL_INTERVAL);
 			else
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 
 		}
 		break;
@@ -2083,7 +2292,7 @@ SwLedControlMode1(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2112,7 +2321,7 @@ SwLedControlMode1(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2142,10 +2351,10 @@ SwLedControlMode1(
 		pLed->CurrLedState = LED_BLINK_WPS_STOP;
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_WPS_SUCESS_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_WPS_SUCESS_INTERVAL_ALPHA);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -2161,7 +2370,7 @@ SwLedControlMode1(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), uLedBlinkNoLinkInterval);/* change by ylb 20121012 for customer led for alpha */
+		UsbLedSetBlinkTimer(pLed, uLedBlinkNoLinkInterval);/* change by ylb 20121012 for customer led for alpha */
 		break;
 
 	case LED_CTL_POWER_OFF:
@@ -2188,7 +2397,7 @@ SwLedControlMode1(
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		}
 
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 		break;
 
 	default:
@@ -2228,7 +2437,7 @@ SwLedControlMode2(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2245,7 +2454,7 @@ SwLedControlMode2(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2261,7 +2470,7 @@ SwLedControlMode2(
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		}
 
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_START_WPS: /* wait until xinpin finish */
@@ -2278,7 +2487,7 @@ SwLedControlMode2(
 			pLed->bLedWPSBlinkInProgress = _TRUE;
 			pLed->CurrLedState = RTW_LED_ON;
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -2287,11 +2496,11 @@ SwLedControlMode2(
 		if (adapter_to_pwrctl(padapter)->rf_pwrstate != rf_on) {
 			pLed->CurrLedState = RTW_LED_OFF;
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		} else {
 			pLed->CurrLedState = RTW_LED_ON;
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -2299,7 +2508,7 @@ SwLedControlMode2(
 		pLed->bLedWPSBlinkInProgress = _FALSE;
 		pLed->CurrLedState = RTW_LED_OFF;
 		pLed->BlinkingLedState = RTW_LED_OFF;
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_START_TO_LINK:
@@ -2307,7 +2516,7 @@ SwLedControlMode2(
 		if (!IS_LED_BLINKING(pLed)) {
 			pLed->CurrLedState = RTW_LED_OFF;
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -2327,7 +2536,7 @@ SwLedControlMode2(
 			pLed->bLedWPSBlinkInProgress = _FALSE;
 		}
 
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 		break;
 
 	default:
@@ -2367,7 +2576,7 @@ SwLedControlMode3(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2384,7 +2593,7 @@ SwLedControlMode3(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2403,7 +2612,7 @@ SwLedControlMode3(
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		}
 
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_START_WPS: /* wait until xinpin finish */
@@ -2423,7 +2632,7 @@ SwLedControlMode3(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2437,10 +2646,10 @@ SwLedControlMode3(
 		pLed->CurrLedState = LED_BLINK_WPS_STOP;
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_WPS_SUCESS_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_WPS_SUCESS_INTERVAL_ALPHA);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 
 		break;
@@ -2453,7 +2662,7 @@ SwLedControlMode3(
 
 		pLed->CurrLedState = RTW_LED_OFF;
 		pLed->BlinkingLedState = RTW_LED_OFF;
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_START_TO_LINK:
@@ -2461,7 +2670,7 @@ SwLedControlMode3(
 		if (!IS_LED_BLINKING(pLed)) {
 			pLed->CurrLedState = RTW_LED_OFF;
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -2481,7 +2690,7 @@ SwLedControlMode3(
 			pLed->bLedWPSBlinkInProgress = _FALSE;
 		}
 
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 		break;
 
 	default:
@@ -2514,7 +2723,7 @@ SwLedControlMode4(
 			pLed1->CurrLedState = RTW_LED_OFF;
 
 			if (pLed1->bLedOn)
-				_set_timer(&(pLed->BlinkTimer), 0);
+				UsbLedSetBlinkTimer(pLed, 0);
 		}
 
 		if (pLed->bLedStartToLinkBlinkInProgress == _FALSE) {
@@ -2533,10 +2742,10 @@ SwLedControlMode4(
 			pLed->CurrLedState = LED_BLINK_StartToBlink;
 			if (pLed->bLedOn) {
 				pLed->BlinkingLedState = RTW_LED_OFF;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SLOWLY_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SLOWLY_INTERVAL);
 			} else {
 				pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 			}
 		}
 		break;
@@ -2553,7 +2762,7 @@ SwLedControlMode4(
 				pLed1->CurrLedState = RTW_LED_OFF;
 
 				if (pLed1->bLedOn)
-					_set_timer(&(pLed->BlinkTimer), 0);
+					UsbLedSetBlinkTimer(pLed, 0);
 			}
 		}
 
@@ -2572,7 +2781,7 @@ SwLedControlMode4(
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
 
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2598,7 +2807,7 @@ SwLedControlMode4(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2618,7 +2827,7 @@ SwLedControlMode4(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2632,7 +2841,7 @@ SwLedControlMode4(
 			pLed1->CurrLedState = RTW_LED_OFF;
 
 			if (pLed1->bLedOn)
-				_set_timer(&(pLed->BlinkTimer), 0);
+				UsbLedSetBlinkTimer(pLed, 0);
 		}
 
 		if (pLed->bLedWPSBlinkInProgress == _FALSE) {
@@ -2652,10 +2861,10 @@ SwLedControlMode4(
 			pLed->CurrLedState = LED_BLINK_WPS;
 			if (pLed->bLedOn) {
 				pLed->BlinkingLedState = RTW_LED_OFF;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_SLOWLY_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_SLOWLY_INTERVAL);
 			} else {
 				pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+				UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 			}
 		}
 		break;
@@ -2672,7 +2881,7 @@ SwLedControlMode4(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 
 		break;
 
@@ -2688,7 +2897,7 @@ SwLedControlMode4(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 
 		/* LED1 settings */
 		if (pLed1->bLedWPSBlinkInProgress)
@@ -2701,7 +2910,7 @@ SwLedControlMode4(
 			pLed1->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed1->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 
 		break;
 
@@ -2717,7 +2926,7 @@ SwLedControlMode4(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 
 		/* LED1 settings */
 		if (pLed1->bLedWPSBlinkInProgress)
@@ -2731,7 +2940,7 @@ SwLedControlMode4(
 			pLed1->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed1->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 
 		break;
 
@@ -2770,8 +2979,8 @@ SwLedControlMode4(
 		}
 
 		pLed1->BlinkingLedState = LED_UNKNOWN;
-		SwLedOff(padapter, pLed);
-		SwLedOff(padapter, pLed1);
+		UsbLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed1);
 		break;
 
 	case LED_CTL_CONNECTION_NO_TRANSFER:
@@ -2784,7 +2993,7 @@ SwLedControlMode4(
 
 			pLed->CurrLedState = LED_BLINK_ALWAYS_ON;
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2819,7 +3028,7 @@ SwLedControlMode5(
 		pLed->CurrLedState = RTW_LED_ON;
 		pLed->BlinkingLedState = RTW_LED_ON;
 
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_SITE_SURVEY:
@@ -2837,7 +3046,7 @@ SwLedControlMode5(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2853,7 +3062,7 @@ SwLedControlMode5(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -2866,7 +3075,7 @@ SwLedControlMode5(
 			pLed->bLedBlinkInProgress = _FALSE;
 		}
 
-		SwLedOff(padapter, pLed);
+		UsbLedOff(padapter, pLed);
 		break;
 
 	default:
@@ -2894,11 +3103,11 @@ SwLedControlMode6(
 		_cancel_timer_ex(&(pLed0->BlinkTimer));
 		pLed0->CurrLedState = RTW_LED_ON;
 		pLed0->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed0->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed0, 0);
 		break;
 
 	case LED_CTL_POWER_OFF:
-		SwLedOff(padapter, pLed0);
+		UsbLedOff(padapter, pLed0);
 		break;
 
 	default:
@@ -2937,7 +3146,7 @@ SwLedControlMode7(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_NETGEAR);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_NETGEAR);
 		}
 		break;
 
@@ -2956,7 +3165,7 @@ SwLedControlMode7(
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		}
 
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_START_WPS: /* wait until xinpin finish */
@@ -2976,7 +3185,7 @@ SwLedControlMode7(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_NETGEAR);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_NETGEAR);
 		}
 		break;
 
@@ -2990,10 +3199,10 @@ SwLedControlMode7(
 		pLed->CurrLedState = LED_BLINK_WPS_STOP;
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_NETGEAR);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_NETGEAR);
 		} else {
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 
 		break;
@@ -3008,7 +3217,7 @@ SwLedControlMode7(
 
 		pLed->CurrLedState = RTW_LED_OFF;
 		pLed->BlinkingLedState = RTW_LED_OFF;
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_START_TO_LINK:
@@ -3016,7 +3225,7 @@ SwLedControlMode7(
 		if (!IS_LED_BLINKING(pLed)) {
 			pLed->CurrLedState = RTW_LED_OFF;
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -3037,7 +3246,7 @@ SwLedControlMode7(
 			pLed->bLedWPSBlinkInProgress = _FALSE;
 		}
 
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	default:
@@ -3062,18 +3271,18 @@ SwLedControlMode8(
 		_cancel_timer_ex(&(pLed0->BlinkTimer));
 		pLed0->CurrLedState = RTW_LED_ON;
 		pLed0->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed0->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed0, 0);
 		break;
 
 	case LED_CTL_NO_LINK:
 		_cancel_timer_ex(&(pLed0->BlinkTimer));
 		pLed0->CurrLedState = RTW_LED_OFF;
 		pLed0->BlinkingLedState = RTW_LED_OFF;
-		_set_timer(&(pLed0->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed0, 0);
 		break;
 
 	case LED_CTL_POWER_OFF:
-		SwLedOff(Adapter, pLed0);
+		UsbLedOff(Adapter, pLed0);
 		break;
 
 	default:
@@ -3104,7 +3313,7 @@ SwLedControlMode9(
 			pLed2->BlinkingLedState = RTW_LED_ON;
 			pLed2->CurrLedState = LED_BLINK_LINK_IN_PROCESS;
 
-			_set_timer(&(pLed2->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed2, 0);
 		}
 		break;
 
@@ -3119,18 +3328,18 @@ SwLedControlMode9(
 					pLed1->BlinkingLedState = RTW_LED_OFF;
 				else
 					pLed1->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed1->BlinkTimer), 0);
+				UsbLedSetBlinkTimer(pLed1, 0);
 			} else {
 				pLed1->CurrLedState = RTW_LED_OFF;
 				pLed1->BlinkingLedState = RTW_LED_OFF;
 				if (pLed1->bLedOn)
-					_set_timer(&(pLed1->BlinkTimer), 0);
+					UsbLedSetBlinkTimer(pLed1, 0);
 			}
 		} else {
 			pLed1->CurrLedState = RTW_LED_OFF;
 			pLed1->BlinkingLedState = RTW_LED_OFF;
 			if (pLed1->bLedOn)
-				_set_timer(&(pLed1->BlinkTimer), 0);
+				UsbLedSetBlinkTimer(pLed1, 0);
 		}
 
 		/* LED2 settings */
@@ -3143,13 +3352,13 @@ SwLedControlMode9(
 				pLed2->CurrLedState = RTW_LED_ON;
 				pLed2->bLedNoLinkBlinkInProgress = _TRUE;
 				if (!pLed2->bLedOn)
-					_set_timer(&(pLed2->BlinkTimer), 0);
+					UsbLedSetBlinkTimer(pLed2, 0);
 			} else {
 				if (pLed2->bLedWPSBlinkInProgress != _TRUE) {
 					pLed2->CurrLedState = RTW_LED_OFF;
 					pLed2->BlinkingLedState = RTW_LED_OFF;
 					if (pLed2->bLedOn)
-						_set_timer(&(pLed2->BlinkTimer), 0);
+						UsbLedSetBlinkTimer(pLed2, 0);
 				}
 			}
 		} else { /* NO_LINK */
@@ -3157,7 +3366,7 @@ SwLedControlMode9(
 				pLed2->CurrLedState = RTW_LED_OFF;
 				pLed2->BlinkingLedState = RTW_LED_OFF;
 				if (pLed2->bLedOn)
-					_set_timer(&(pLed2->BlinkTimer), 0);
+					UsbLedSetBlinkTimer(pLed2, 0);
 			}
 		}
 
@@ -3189,7 +3398,7 @@ SwLedControlMode9(
 				else
 					pLed->BlinkingLedState = RTW_LED_ON;
 			}
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 		}
 
 		break;
@@ -3216,7 +3425,7 @@ SwLedControlMode9(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 
 		}
 		break;
@@ -3237,7 +3446,7 @@ SwLedControlMode9(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -3248,7 +3457,7 @@ SwLedControlMode9(
 		pLed2->CurrLedState = LED_BLINK_LINK_IN_PROCESS;
 		pLed2->bLedWPSBlinkInProgress = _TRUE;
 
-		_set_timer(&(pLed2->BlinkTimer), 500);
+		UsbLedSetBlinkTimer(pLed2, 500);
 
 		break;
 
@@ -3262,14 +3471,14 @@ SwLedControlMode9(
 		pLed2->CurrLedState = RTW_LED_ON;
 		pLed2->bLedNoLinkBlinkInProgress = _TRUE;
 		if (!pLed2->bLedOn)
-			_set_timer(&(pLed2->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed2, 0);
 
 		/* LED1 settings */
 		_cancel_timer_ex(&(pLed1->BlinkTimer));
 		pLed1->CurrLedState = RTW_LED_OFF;
 		pLed1->BlinkingLedState = RTW_LED_OFF;
 		if (pLed1->bLedOn)
-			_set_timer(&(pLed1->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed1, 0);
 
 
 		break;
@@ -3284,14 +3493,14 @@ SwLedControlMode9(
 			pLed1->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed1->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed1->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed1, 0);
 	}
 		/* else */
 		/* { */
 		/*	bWPSOverLap = _FALSE; */
 		/*	pLed1->CurrLedState = RTW_LED_OFF; */
 		/*	pLed1->BlinkingLedState = RTW_LED_OFF;  */
-		/*	_set_timer(&(pLed1->BlinkTimer), 0); */
+		/*	UsbLedSetBlinkTimer(pLed1, 0); */
 		/* } */
 
 		/* LED2 settings */
@@ -3299,7 +3508,7 @@ SwLedControlMode9(
 	pLed2->BlinkingLedState = RTW_LED_OFF;
 	pLed2->bLedWPSBlinkInProgress = _FALSE;
 	if (pLed2->bLedOn)
-		_set_timer(&(pLed2->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed2, 0);
 
 	break;
 
@@ -3313,14 +3522,14 @@ SwLedControlMode9(
 			pLed1->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed1->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed1->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed1, 0);
 
 		/* LED2 settings */
 		pLed2->CurrLedState = RTW_LED_OFF;
 		pLed2->BlinkingLedState = RTW_LED_OFF;
 		pLed2->bLedWPSBlinkInProgress = _FALSE;
 		if (pLed2->bLedOn)
-			_set_timer(&(pLed2->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed2, 0);
 
 		break;
 
@@ -3360,8 +3569,8 @@ SwLedControlMode9(
 
 
 		pLed1->BlinkingLedState = LED_UNKNOWN;
-		SwLedOff(Adapter, pLed);
-		SwLedOff(Adapter, pLed1);
+		UsbLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed1);
 		break;
 
 	case LED_CTL_CONNECTION_NO_TRANSFER:
@@ -3374,7 +3583,7 @@ SwLedControlMode9(
 
 			pLed->CurrLedState = LED_BLINK_ALWAYS_ON;
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -3405,7 +3614,7 @@ SwLedControlMode10(
 			pLed1->BlinkingLedState = RTW_LED_ON;
 			pLed1->CurrLedState = LED_BLINK_LINK_IN_PROCESS;
 
-			_set_timer(&(pLed1->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed1, 0);
 		}
 		break;
 
@@ -3424,11 +3633,11 @@ SwLedControlMode10(
 						_cancel_timer_ex(&(pLed->BlinkTimer));
 						pLed->bLedBlinkInProgress = _FALSE;
 					}
-					_set_timer(&(pLed->BlinkTimer), 0);
+					UsbLedSetBlinkTimer(pLed, 0);
 
 					pLed1->CurrLedState = RTW_LED_OFF;
 					pLed1->BlinkingLedState = RTW_LED_OFF;
-					_set_timer(&(pLed1->BlinkTimer), 0);
+					UsbLedSetBlinkTimer(pLed1, 0);
 				} else if (pHalData->current_band_type == BAND_ON_5G)
 					/* LED1 settings */
 				{
@@ -3438,11 +3647,11 @@ SwLedControlMode10(
 						_cancel_timer_ex(&(pLed1->BlinkTimer));
 						pLed1->bLedBlinkInProgress = _FALSE;
 					}
-					_set_timer(&(pLed1->BlinkTimer), 0);
+					UsbLedSetBlinkTimer(pLed1, 0);
 
 					pLed->CurrLedState = RTW_LED_OFF;
 					pLed->BlinkingLedState = RTW_LED_OFF;
-					_set_timer(&(pLed->BlinkTimer), 0);
+					UsbLedSetBlinkTimer(pLed, 0);
 				}
 			}
 		} else if (LedAction == LED_CTL_NO_LINK) { /* TODO by page */
@@ -3452,12 +3661,12 @@ SwLedControlMode10(
 				pLed->CurrLedState = RTW_LED_OFF;
 				pLed->BlinkingLedState = RTW_LED_OFF;
 				if (pLed->bLedOn)
-					_set_timer(&(pLed->BlinkTimer), 0);
+					UsbLedSetBlinkTimer(pLed, 0);
 
 				pLed1->CurrLedState = RTW_LED_OFF;
 				pLed1->BlinkingLedState = RTW_LED_OFF;
 				if (pLed1->bLedOn)
-					_set_timer(&(pLed1->BlinkTimer), 0);
+					UsbLedSetBlinkTimer(pLed1, 0);
 			}
 		}
 
@@ -3482,7 +3691,7 @@ SwLedControlMode10(
 			pLed->CurrLedState = LED_BLINK_SCAN;
 			pLed->BlinkTimes = 12;
 			pLed->BlinkingLedState = LED_BLINK_SCAN;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 
 			if (pLed1->bLedNoLinkBlinkInProgress == _TRUE) {
 				_cancel_timer_ex(&(pLed1->BlinkTimer));
@@ -3496,7 +3705,7 @@ SwLedControlMode10(
 			pLed1->CurrLedState = LED_BLINK_SCAN;
 			pLed1->BlinkTimes = 12;
 			pLed1->BlinkingLedState = LED_BLINK_SCAN;
-			_set_timer(&(pLed1->BlinkTimer), LED_BLINK_LINK_SLOWLY_INTERVAL_NETGEAR);
+			UsbLedSetBlinkTimer(pLed1, LED_BLINK_LINK_SLOWLY_INTERVAL_NETGEAR);
 
 		}
 		break;
@@ -3509,7 +3718,7 @@ SwLedControlMode10(
 			pLed->bLedWPSBlinkInProgress = _TRUE;
 			pLed->BlinkingLedState = LED_BLINK_WPS;
 			pLed->CurrLedState = LED_BLINK_WPS;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 
 		/* LED1 settings */
@@ -3518,7 +3727,7 @@ SwLedControlMode10(
 			pLed1->bLedWPSBlinkInProgress = _TRUE;
 			pLed1->BlinkingLedState = LED_BLINK_WPS;
 			pLed1->CurrLedState = LED_BLINK_WPS;
-			_set_timer(&(pLed1->BlinkTimer), LED_BLINK_NORMAL_INTERVAL + LED_BLINK_LINK_INTERVAL_NETGEAR);
+			UsbLedSetBlinkTimer(pLed1, LED_BLINK_NORMAL_INTERVAL + LED_BLINK_LINK_INTERVAL_NETGEAR);
 		}
 
 
@@ -3535,11 +3744,11 @@ SwLedControlMode10(
 				_cancel_timer_ex(&(pLed->BlinkTimer));
 				pLed->bLedBlinkInProgress = _FALSE;
 			}
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 
 			pLed1->CurrLedState = RTW_LED_OFF;
 			pLed1->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed1->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed1, 0);
 		} else if (pHalData->current_band_type == BAND_ON_5G)
 			/* LED1 settings */
 		{
@@ -3550,11 +3759,11 @@ SwLedControlMode10(
 				_cancel_timer_ex(&(pLed1->BlinkTimer));
 				pLed1->bLedBlinkInProgress = _FALSE;
 			}
-			_set_timer(&(pLed1->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed1, 0);
 
 			pLed->CurrLedState = RTW_LED_OFF;
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 
 		break;
@@ -3564,14 +3773,14 @@ SwLedControlMode10(
 		pLed1->bLedWPSBlinkInProgress = _FALSE;
 		pLed1->CurrLedState = RTW_LED_OFF;
 		pLed1->BlinkingLedState = RTW_LED_OFF;
-		_set_timer(&(pLed1->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed1, 0);
 
 		/* LED0 settings */
 		pLed->bLedWPSBlinkInProgress = _FALSE;
 		pLed->CurrLedState = RTW_LED_OFF;
 		pLed->BlinkingLedState = RTW_LED_OFF;
 		if (pLed->bLedOn)
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 
 		break;
 
@@ -3600,7 +3809,7 @@ SwLedControlMode11(
 	case LED_CTL_NO_LINK:
 		pLed->CurrLedState = RTW_LED_ON;
 		pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_LINK:
@@ -3614,7 +3823,7 @@ SwLedControlMode11(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_SCAN_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_SCAN_INTERVAL_ALPHA);
 		break;
 
 	case LED_CTL_START_WPS: /* wait until xinpin finish */
@@ -3631,7 +3840,7 @@ SwLedControlMode11(
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
 		pLed->BlinkTimes = 5;
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 
 		break;
 
@@ -3643,7 +3852,7 @@ SwLedControlMode11(
 			pLed->bLedBlinkInProgress = _FALSE;
 		}
 		pLed->CurrLedState = LED_BLINK_WPS_STOP;
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_POWER_OFF:
@@ -3671,7 +3880,7 @@ SwLedControlMode11(
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		}
 
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 		break;
 
 	default:
@@ -3711,7 +3920,7 @@ SwLedControlMode12(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_NO_LINK_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_NO_LINK_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -3729,7 +3938,7 @@ SwLedControlMode12(
 				pLed->BlinkingLedState = RTW_LED_OFF;
 			else
 				pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+			UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 		}
 		break;
 
@@ -3752,7 +3961,7 @@ SwLedControlMode12(
 			pLed->bLedNoLinkBlinkInProgress = _FALSE;
 		}
 
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 		break;
 
 	default:
@@ -3791,7 +4000,7 @@ SwLedControlMode13(
 			pLed->bLedScanBlinkInProgress = _FALSE;
 		}
 
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_START_WPS: /* wait until xinpin finish */
@@ -3809,10 +4018,10 @@ SwLedControlMode13(
 			pLed->CurrLedState = LED_BLINK_WPS;
 			if (pLed->bLedOn) {
 				pLed->BlinkingLedState = RTW_LED_OFF;
-				_set_timer(&(pLed->BlinkTimer), LED_WPS_BLINK_OFF_INTERVAL_NETGEAR);
+				UsbLedSetBlinkTimer(pLed, LED_WPS_BLINK_OFF_INTERVAL_NETGEAR);
 			} else {
 				pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_WPS_BLINK_ON_INTERVAL_NETGEAR);
+				UsbLedSetBlinkTimer(pLed, LED_WPS_BLINK_ON_INTERVAL_NETGEAR);
 			}
 		}
 		break;
@@ -3829,7 +4038,7 @@ SwLedControlMode13(
 		if (pLed->bLedOn) {
 			pLed->BlinkingLedState = RTW_LED_OFF;
 
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 
 		break;
@@ -3844,7 +4053,7 @@ SwLedControlMode13(
 
 		pLed->CurrLedState = RTW_LED_OFF;
 		pLed->BlinkingLedState = RTW_LED_OFF;
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_START_TO_LINK:
@@ -3853,7 +4062,7 @@ SwLedControlMode13(
 			pLed->BlinkingLedState = RTW_LED_ON;
 			pLed->CurrLedState = LED_BLINK_LINK_IN_PROCESS;
 
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -3873,7 +4082,7 @@ SwLedControlMode13(
 		{
 			pLed->CurrLedState = RTW_LED_OFF;
 			pLed->BlinkingLedState = RTW_LED_OFF;
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 		break;
 
@@ -3895,9 +4104,9 @@ SwLedControlMode13(
 		}
 
 		if (LedAction == LED_CTL_POWER_ON)
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		else
-			SwLedOff(Adapter, pLed);
+			UsbLedOff(Adapter, pLed);
 		break;
 
 	default:
@@ -3927,17 +4136,17 @@ SwLedControlMode14(
 			_cancel_timer_ex(&(pLed->BlinkTimer));
 			pLed->bLedBlinkInProgress = _FALSE;
 		}
-		SwLedOff(Adapter, pLed);
+		UsbLedOff(Adapter, pLed);
 		break;
 
 	case LED_CTL_POWER_ON:
-		SwLedOn(Adapter, pLed);
+		UsbLedOn(Adapter, pLed);
 		break;
 
 	case LED_CTL_LINK:
 	case LED_CTL_NO_LINK:
 		if (IS_HARDWARE_TYPE_8812AU(Adapter))
-			SwLedOn(Adapter, pLed);
+			UsbLedOn(Adapter, pLed);
 		break;
 
 	case LED_CTL_TX:
@@ -3949,15 +4158,15 @@ SwLedControlMode14(
 			if (pLed->bLedOn) {
 				pLed->BlinkingLedState = RTW_LED_OFF;
 				if (IS_HARDWARE_TYPE_8812AU(Adapter))
-					_set_timer(&(pLed->BlinkTimer), LED_BLINK_LINK_INTERVAL_ALPHA);
+					UsbLedSetBlinkTimer(pLed, LED_BLINK_LINK_INTERVAL_ALPHA);
 				else
-					_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+					UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			} else {
 				pLed->BlinkingLedState = RTW_LED_ON;
 				if (IS_HARDWARE_TYPE_8812AU(Adapter))
-					_set_timer(&(pLed->BlinkTimer), LED_BLINK_NORMAL_INTERVAL);
+					UsbLedSetBlinkTimer(pLed, LED_BLINK_NORMAL_INTERVAL);
 				else
-					_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+					UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 			}
 		}
 		break;
@@ -3995,10 +4204,10 @@ SwLedControlMode15(
 			pLed->CurrLedState = LED_BLINK_WPS;
 			if (pLed->bLedOn) {
 				pLed->BlinkingLedState = RTW_LED_OFF;
-				_set_timer(&(pLed->BlinkTimer), LED_WPS_BLINK_OFF_INTERVAL_NETGEAR);
+				UsbLedSetBlinkTimer(pLed, LED_WPS_BLINK_OFF_INTERVAL_NETGEAR);
 			} else {
 				pLed->BlinkingLedState = RTW_LED_ON;
-				_set_timer(&(pLed->BlinkTimer), LED_WPS_BLINK_ON_INTERVAL_NETGEAR);
+				UsbLedSetBlinkTimer(pLed, LED_WPS_BLINK_ON_INTERVAL_NETGEAR);
 			}
 		}
 		break;
@@ -4012,7 +4221,7 @@ SwLedControlMode15(
 		{
 			pLed->BlinkingLedState = RTW_LED_ON;
 
-			_set_timer(&(pLed->BlinkTimer), 0);
+			UsbLedSetBlinkTimer(pLed, 0);
 		}
 
 		break;
@@ -4026,7 +4235,7 @@ SwLedControlMode15(
 
 		pLed->CurrLedState = RTW_LED_OFF;
 		pLed->BlinkingLedState = RTW_LED_OFF;
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_NO_LINK:
@@ -4057,7 +4266,7 @@ SwLedControlMode15(
 		{
 			pLed->CurrLedState = LED_BLINK_NO_LINK;
 			pLed->BlinkingLedState = RTW_LED_ON;
-			_set_timer(&(pLed->BlinkTimer), 30);
+			UsbLedSetBlinkTimer(pLed, 30);
 		}
 		break;
 
@@ -4074,7 +4283,7 @@ SwLedControlMode15(
 		pLed->CurrLedState = LED_BLINK_LINK_IDEL;
 		pLed->BlinkingLedState = RTW_LED_ON;
 
-		_set_timer(&(pLed->BlinkTimer), 30);
+		UsbLedSetBlinkTimer(pLed, 30);
 		break;
 
 	case LED_CTL_SITE_SURVEY:
@@ -4090,7 +4299,7 @@ SwLedControlMode15(
 		}
 		pLed->CurrLedState = LED_BLINK_SCAN;
 		pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), 0);
+		UsbLedSetBlinkTimer(pLed, 0);
 		break;
 
 	case LED_CTL_TX:
@@ -4110,7 +4319,7 @@ SwLedControlMode15(
 			pLed->BlinkingLedState = RTW_LED_OFF;
 		else
 			pLed->BlinkingLedState = RTW_LED_ON;
-		_set_timer(&(pLed->BlinkTimer), LED_BLINK_FASTER_INTERVAL_ALPHA);
+		UsbLedSetBlinkTimer(pLed, LED_BLINK_FASTER_INTERVAL_ALPHA);
 		break;
 
 	default:
@@ -4154,6 +4363,14 @@ LedControlUSB(
 	     LedAction == LED_CTL_POWER_ON))
 		return;
 
+	/* everything but traffic may write the pin directly, give it back to SW */
+	if (LedAction != LED_CTL_TX && LedAction != LED_CTL_RX
+	    && !(LedAction >= LED_CTL_UC_TX && LedAction <= LED_CTL_BMC_RX)) {
+		UsbLedExitHwBlink(&(ledpriv->SwLed0));
+		UsbLedExitHwBlink(&(ledpriv->SwLed1));
+		UsbLedExitHwBlink(&(ledpriv->SwLed2));
+	}
+
 	switch (ledpriv->LedStrategy) {
 	#if CONFIG_RTW_SW_LED_TRX_DA_CLASSIFY
 	case SW_LED_MODE_UC_TRX_ONLY:
@@ -4252,6 +4469,10 @@ void ResetLedStatus(PLED_USB pLed)
 	pLed->bLedLinkBlinkInProgress = _FALSE;
 	pLed->bLedStartToLinkBlinkInProgress = _FALSE;
 	pLed->bLedScanBlinkInProgress = _FALSE;
+
+	/* pin may be shared, force the next write of it */
+	if (pLed->padapter)
+		adapter_to_led(pLed->padapter)->pin_io_state[UsbLedPhyPin(pLed)] = LED_UNKNOWN;
 }
 
 /*
@@ -4285,6 +4506,7 @@ DeInitLed(
 {
 	_cancel_workitem_sync(&(pLed->BlinkWorkItem));
 	_cancel_timer_ex(&(pLed->BlinkTimer));
+	UsbLedExitHwBlink(pLed);
 	ResetLedStatus(pLed);
 }
 #endif
@@ -400,6 +400,23 @@ void halrf_iqk_info_dump(
 	PDM_SNPF(out_len, used, output + used, out_len - used,
 				"%-20s: %llu %s\n",
 				"progressing_time", dm->rf_calibrate_info.iqk_total_progressing_time, "(ms)");
+#if (RTL8822B_SUPPORT == 1)
+	if (dm->support_ic_type == ODM_RTL8822B) {
+		tmp = iqk_info->iqk_cache_hit + iqk_info->iqk_cache_miss + iqk_info->iqk_cache_drift;
+		PDM_SNPF(out_len, used, output + used, out_len - used,
+				"%-20s: %d %d %d\n",
+				"cache hit/miss/drift", iqk_info->iqk_cache_hit, iqk_info->iqk_cache_miss, iqk_info->iqk_cache_drift);
+		PDM_SNPF(out_len, used, output + used, out_len - used,
+				"%-20s: %d %s\n",
+				"cache hit rate", (tmp) ? (iqk_info->iqk_cache_hit * 100 / tmp) : 0, "(%)");
+		PDM_SNPF(out_len, used, output + used, out_len - used,
+				"%-20s: %llu %s\n",
+				"cache saved_time", iqk_info->iqk_cache_saved_time, "(ms)");
+		PDM_SNPF(out_len, used, output + used, out_len - used,
+				"%-20s: %d\n",
+				"cache thermal_th", iqk_info->iqk_cache_th);
+	}
+#endif
 		
 	tmp = odm_read_4byte(dm, 0x1bf0);
 	for(rf_path = RF_PATH_A; rf_path <= RF_PATH_B; rf_path++)
@@ -524,6 +541,17 @@ void halrf_iqk_dbg(void	*dm_void)
 
 	PHYDM_DBG(dm, ODM_COMP_CALIBRATION, "%-20s: %llu %s\n",
 				"progressing_time", dm->rf_calibrate_info.iqk_progressing_time, "(ms)");
+#if (RTL8822B_SUPPORT == 1)
+	if (dm->support_ic_type == ODM_RTL8822B) {
+		tmp = iqk_info->iqk_cache_hit + iqk_info->iqk_cache_miss + iqk_info->iqk_cache_drift;
+		PHYDM_DBG(dm, ODM_COMP_CALIBRATION, "%-20s: %d %d %d\n",
+				"cache hit/miss/drift", iqk_info->iqk_cache_hit, iqk_info->iqk_cache_miss, iqk_info->iqk_cache_drift);
+		PHYDM_DBG(dm, ODM_COMP_CALIBRATION, "%-20s: %d %s\n",
+				"cache hit rate", (tmp) ? (iqk_info->iqk_cache_hit * 100 / tmp) : 0, "(%)");
+		PHYDM_DBG(dm, ODM_COMP_CALIBRATION, "%-20s: %llu %s\n",
+				"cache saved_time", iqk_info->iqk_cache_saved_time, "(ms)");
+	}
+#endif
 
 	
 
@@ -748,6 +776,8 @@ void halrf_iqk_debug(
 	/*--> dm_value[1]:0:disable, 1:enable*/ 
 	/*if dm_value[0]=0x20 = enable, */
 	/*0x1:show rx_sym; 0x2: tx_xym; 0x3:gs1_xym; 0x4:gs2_sym; 0x5:rxk1_xym*/
+	/*dm_value[0]=0x40: set IQK cache thermal threshold to dm_value[1]*/
+	/*dm_value[0]=0x41: flush IQK cache and its counters*/
 
 	if (dm_value[0] == 0x0)
 		halrf_iqk_dbg_cfir_backup(dm);
@@ -767,6 +797,12 @@ void halrf_iqk_debug(
 		halrf_iqk_xym_show(dm,(u8)dm_value[1]);
 	else if (dm_value[0] == 0x30)
 		halrf_do_imr_test(dm, (u8)dm_value[1]);
+#if (RTL8822B_SUPPORT == 1)
+	else if (dm_value[0] == 0x40 && dm->support_ic_type == ODM_RTL8822B)
+		halrf_iqk_cache_set_8822b(dm, false, (u8)dm_value[1]);
+	else if (dm_value[0] == 0x41 && dm->support_ic_type == ODM_RTL8822B)
+		halrf_iqk_cache_set_8822b(dm, true, 0);
+#endif
 }
 
 void
@@ -1273,6 +1309,10 @@ halrf_watchdog(
 {
 	struct dm_struct		*dm = (struct dm_struct *)dm_void;
 	phydm_rf_watchdog(dm);
+#if (RTL8822B_SUPPORT == 1)
+	if (dm->support_ic_type == ODM_RTL8822B)
+		halrf_iqk_cache_watchdog_8822b(dm);
+#endif
 }
 #if 0
 void
@@ -39,8 +39,26 @@
 #define rxiqk_gs_limit 10
 
 #define	NUM 4
+#define	IQK_CACHE_NUM 8
+#define	IQK_CACHE_THERMAL_TH 3
+#define	IQK_CACHE_RECAL_RETRY 3
 /*---------------------------End Define Parameters-------------------------------*/
 
+#if (RTL8822B_SUPPORT == 1)
+struct iqk_cache_entry {
+	u32		rf_reg18;	/*key: channel / bandwidth / band*/
+	u8		thermal;	/*thermal meter at calibration time*/
+	u32		age;
+	boolean		valid;
+	boolean		iqk_fail_report[2][2];	/*path / TRX*/
+	u8		rxiqk_fail_code[2];
+	u32		lok_idac[2];
+	u16		rxiqk_agc[4];
+	u32		iqk_cfir_real[2][2][8];	/*path / TRX / CFIR_real*/
+	u32		iqk_cfir_imag[2][2][8];	/*path / TRX / CFIR_imag*/
+};
+#endif
+
 struct dm_iqk_info {
 	boolean		lok_fail[NUM];
 	boolean		iqk_fail[2][NUM];
@@ -80,6 +98,21 @@ struct dm_iqk_info {
 	u32		gs2_xym[2][6];
 	u32		rxk1_xym[2][6];
 #endif
+#if (RTL8822B_SUPPORT == 1)
+	struct iqk_cache_entry	iqk_cache[IQK_CACHE_NUM];
+	boolean		iqk_cache_init;	/*iqk_cache and iqk_cache_th set up for this dm*/
+	u8		iqk_cache_th;	/*max thermal delta for reusing a cached result*/
+	u32		iqk_cache_age;
+	boolean		iqk_cache_recal;	/*lazy recalibration pending*/
+	u32		iqk_cache_recal_key;
+	u8		iqk_cache_recal_retry;	/*failed lazy recal attempts*/
+	u8		iqk_cache_recal_wait;	/*watchdog ticks before next attempt*/
+	u32		iqk_cache_hit;
+	u32		iqk_cache_miss;
+	u32		iqk_cache_drift;
+	u64		iqk_cache_k_time;	/*last full IQK time (ms)*/
+	u64		iqk_cache_saved_time;	/*ms*/
+#endif
 };
 
 #endif
@@ -69,6 +69,11 @@ void do_iqk_8822b(
 	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
 	
 	dm->rf_calibrate_info.thermal_value_iqk = thermal_value;
+	/*thermal triggered IQK, don't serve it from the IQK cache*/
+	iqk_info->iqk_cache_recal = true;
+	iqk_info->iqk_cache_recal_key = odm_get_rf_reg(dm, RF_PATH_A, 0x18, RFREGOFFSETMASK);
+	iqk_info->iqk_cache_recal_retry = 0;
+	iqk_info->iqk_cache_recal_wait = 0;
 	halrf_segment_iqk_trigger(dm, true, iqk_info->segment_iqk);
 }
 #else
@@ -84,6 +89,11 @@ void do_iqk_8822b(
 	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
 	boolean		is_recovery = (boolean) delta_thermal_index;
 
+	/*thermal triggered IQK, don't serve it from the IQK cache*/
+	iqk_info->iqk_cache_recal = true;
+	iqk_info->iqk_cache_recal_key = odm_get_rf_reg(dm, RF_PATH_A, 0x18, RFREGOFFSETMASK);
+	iqk_info->iqk_cache_recal_retry = 0;
+	iqk_info->iqk_cache_recal_wait = 0;
 	halrf_segment_iqk_trigger(dm, true, iqk_info->segment_iqk);
 }
 #endif
@@ -465,6 +475,190 @@ _iqk_reload_iqk_setting_8822b(
 	}
 }
 
+void
+_iqk_cache_reset_8822b(
+	struct dm_struct			*dm
+)
+{
+	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
+	u8 i;
+
+	for (i = 0; i < IQK_CACHE_NUM; i++)
+		iqk_info->iqk_cache[i].valid = false;
+	iqk_info->iqk_cache_recal = false;
+	iqk_info->iqk_cache_recal_retry = 0;
+	iqk_info->iqk_cache_recal_wait = 0;
+}
+
+struct iqk_cache_entry *
+_iqk_cache_lookup_8822b(
+	struct dm_struct			*dm,
+	u32				rf_reg18
+)
+{
+	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
+	u8 i;
+
+	for (i = 0; i < IQK_CACHE_NUM; i++) {
+		if (iqk_info->iqk_cache[i].valid && iqk_info->iqk_cache[i].rf_reg18 == rf_reg18)
+			return &iqk_info->iqk_cache[i];
+	}
+	return NULL;
+}
+
+void
+_iqk_cache_schedule_recal_8822b(
+	struct dm_struct			*dm,
+	u32				rf_reg18
+)
+{
+	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
+
+	iqk_info->iqk_cache_recal = true;
+	iqk_info->iqk_cache_recal_key = rf_reg18;
+	iqk_info->iqk_cache_recal_retry = 0;
+	iqk_info->iqk_cache_recal_wait = 0;
+}
+
+/*a failed IQK must not be served from the cache, and a failing lazy recal
+ *is retried with backoff (2, then 4 watchdog ticks) then given up
+ */
+void
+_iqk_cache_fail_8822b(
+	struct dm_struct			*dm
+)
+{
+	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
+	struct iqk_cache_entry	*entry;
+
+	entry = _iqk_cache_lookup_8822b(dm, iqk_info->iqk_channel[0]);
+	if (entry)
+		entry->valid = false;
+
+	if (!iqk_info->iqk_cache_recal || iqk_info->iqk_cache_recal_key != iqk_info->iqk_channel[0])
+		return;
+
+	if (++iqk_info->iqk_cache_recal_retry >= IQK_CACHE_RECAL_RETRY) {
+		PHYDM_DBG(dm, ODM_COMP_CALIBRATION, "[IQK]lazy recal failed %d times, give up\n",
+			  iqk_info->iqk_cache_recal_retry);
+		iqk_info->iqk_cache_recal = false;
+		iqk_info->iqk_cache_recal_retry = 0;
+		iqk_info->iqk_cache_recal_wait = 0;
+		return;
+	}
+	iqk_info->iqk_cache_recal_wait = (u8)(1 << iqk_info->iqk_cache_recal_retry);
+}
+
+/*save the result of slot 0 (just calibrated) into the cache, LRU replacement*/
+void
+_iqk_cache_store_8822b(
+	struct dm_struct			*dm
+)
+{
+	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
+	struct iqk_cache_entry	*entry;
+	u8 i, j, k;
+
+	for (i = 0; i < SS_8822B; i++) {
+		if (iqk_info->iqk_fail_report[0][i][TX_IQK] || iqk_info->iqk_fail_report[0][i][RX_IQK]) {
+			_iqk_cache_fail_8822b(dm);
+			return;
+		}
+	}
+
+	entry = _iqk_cache_lookup_8822b(dm, iqk_info->iqk_channel[0]);
+	if (!entry) {
+		entry = &iqk_info->iqk_cache[0];
+		for (i = 0; i < IQK_CACHE_NUM; i++) {
+			if (!iqk_info->iqk_cache[i].valid) {
+				entry = &iqk_info->iqk_cache[i];
+				break;
+			}
+			if (iqk_info->iqk_cache[i].age < entry->age)
+				entry = &iqk_info->iqk_cache[i];
+		}
+	}
+
+	entry->rf_reg18 = iqk_info->iqk_channel[0];
+	entry->thermal = dm->rf_calibrate_info.thermal_value;
+	for (i = 0; i < SS_8822B; i++) {
+		entry->lok_idac[i] = iqk_info->lok_idac[0][i];
+		entry->rxiqk_fail_code[i] = iqk_info->rxiqk_fail_code[0][i];
+		for (j = 0; j < 2; j++) {
+			entry->iqk_fail_report[i][j] = iqk_info->iqk_fail_report[0][i][j];
+			for (k = 0; k < 8; k++) {
+				entry->iqk_cfir_real[i][j][k] = iqk_info->iqk_cfir_real[0][i][j][k];
+				entry->iqk_cfir_imag[i][j][k] = iqk_info->iqk_cfir_imag[0][i][j][k];
+			}
+		}
+	}
+	for (i = 0; i < 4; i++)
+		entry->rxiqk_agc[i] = iqk_info->rxiqk_agc[0][i];
+	entry->age = ++iqk_info->iqk_cache_age;
+	entry->valid = true;
+
+	if (iqk_info->iqk_cache_recal && iqk_info->iqk_cache_recal_key == entry->rf_reg18) {
+		iqk_info->iqk_cache_recal = false;
+		iqk_info->iqk_cache_recal_retry = 0;
+		iqk_info->iqk_cache_recal_wait = 0;
+	}
+}
+
+/*reload a cached result of the current channel into slot 0 and apply it.
+ *If the thermal meter drifted beyond iqk_cache_th since the result was taken,
+ *the stale result is still applied and a recalibration is left to the watchdog.
+ */
+boolean
+_iqk_cache_reload_8822b(
+	struct dm_struct			*dm
+)
+{
+	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
+	struct iqk_cache_entry	*entry;
+	u8 thermal = dm->rf_calibrate_info.thermal_value;
+	u8 delta, i, j, k;
+
+	if (iqk_info->iqk_cache_recal && iqk_info->iqk_cache_recal_key == iqk_info->rf_reg18)
+		return false;
+
+	entry = _iqk_cache_lookup_8822b(dm, iqk_info->rf_reg18);
+	if (!entry) {
+		iqk_info->iqk_cache_miss++;
+		return false;
+	}
+
+	_iqk_backup_iqk_8822b(dm, 0x0, 0x0);
+	for (i = 0; i < SS_8822B; i++) {
+		iqk_info->lok_idac[0][i] = entry->lok_idac[i];
+		iqk_info->rxiqk_fail_code[0][i] = entry->rxiqk_fail_code[i];
+		for (j = 0; j < 2; j++) {
+			iqk_info->iqk_fail_report[0][i][j] = entry->iqk_fail_report[i][j];
+			for (k = 0; k < 8; k++) {
+				iqk_info->iqk_cfir_real[0][i][j][k] = entry->iqk_cfir_real[i][j][k];
+				iqk_info->iqk_cfir_imag[0][i][j][k] = entry->iqk_cfir_imag[i][j][k];
+			}
+		}
+	}
+	for (i = 0; i < 4; i++)
+		iqk_info->rxiqk_agc[0][i] = entry->rxiqk_agc[i];
+
+	_iqk_reload_iqk_setting_8822b(dm, 0, 2);
+	_iqk_fill_iqk_report_8822b(dm, 0);
+	entry->age = ++iqk_info->iqk_cache_age;
+
+	delta = (thermal > entry->thermal) ? (thermal - entry->thermal) : (entry->thermal - thermal);
+	if (delta > iqk_info->iqk_cache_th) {
+		iqk_info->iqk_cache_drift++;
+		_iqk_cache_schedule_recal_8822b(dm, entry->rf_reg18);
+		PHYDM_DBG(dm, ODM_COMP_CALIBRATION, "[IQK]reload cached IQK result, thermal delta = %d, recal later\n", delta);
+	} else {
+		iqk_info->iqk_cache_hit++;
+		iqk_info->iqk_cache_saved_time += iqk_info->iqk_cache_k_time;
+		PHYDM_DBG(dm, ODM_COMP_CALIBRATION, "[IQK]reload cached IQK result, thermal delta = %d\n", delta);
+	}
+	return true;
+}
+
 boolean
 _iqk_reload_iqk_8822b(
 	struct dm_struct			*dm,
@@ -474,13 +668,12 @@ _iqk_reload_iqk_8822b(
 	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
 	u8 i;
 	iqk_info->is_reload = false;
+	iqk_info->rf_reg18 = odm_get_rf_reg(dm, RF_PATH_A, 0x18, RFREGOFFSETMASK);
 
 	if (reset) {
 		for (i = 0; i < 2; i++)
 			iqk_info->iqk_channel[i] = 0x0;
 	} else {
-		iqk_info->rf_reg18 = odm_get_rf_reg(dm, RF_PATH_A, 0x18, RFREGOFFSETMASK);
-
 		for (i = 0; i < 2; i++) {
 			if (iqk_info->rf_reg18 == iqk_info->iqk_channel[i]) {
 				_iqk_reload_iqk_setting_8822b(dm, i, 2);
@@ -489,7 +682,14 @@ _iqk_reload_iqk_8822b(
 				 iqk_info->is_reload = true;
 			}
 		}
+		if (iqk_info->is_reload) {
+			iqk_info->iqk_cache_hit++;
+			iqk_info->iqk_cache_saved_time += iqk_info->iqk_cache_k_time;
+		}
 	}
+	/*the cache is consulted on reset too: channel switch always asks for a clear IQK*/
+	if (!iqk_info->is_reload)
+		iqk_info->is_reload = _iqk_cache_reload_8822b(dm);
 	/*report*/
 	odm_set_bb_reg(dm, 0x1bf0, BIT(16), (u8) iqk_info->is_reload);
 	return  iqk_info->is_reload;
@@ -1278,6 +1478,12 @@ _iq_calibrate_8822b_init(
 			}
 		}
 	}
+	/*firstrun is shared by all adapters, the cache belongs to each dm*/
+	if (!iqk_info->iqk_cache_init) {
+		iqk_info->iqk_cache_init = true;
+		iqk_info->iqk_cache_th = IQK_CACHE_THERMAL_TH;
+		_iqk_cache_reset_8822b(dm);
+	}
 	/*parameters init.*/
 	/*cu_distance (IQK result variation)=111*/
 	odm_write_4byte(dm, 0x1b10, 0x88011c00);
@@ -1653,6 +1859,7 @@ _phy_iq_calibrate_8822b(
 	u32	backup_bb_reg[BB_REG_NUM_8822B] = {0x808, 0x90c, 0xc00, 0xcb0, 0xcb4, 0xcbc, 0xe00, 0xeb0, 0xeb4, 0xebc, 0x1990, 0x9a4, 0xa04, 0xb00, 0x838};
 	u32	backup_rf_reg[RF_REG_NUM_8822B] = {0xdf, 0x8f, 0x65, 0x0, 0x1};
 	boolean is_mp = false;
+	u64 start_time;
 
 	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
 
@@ -1663,6 +1870,8 @@ _phy_iq_calibrate_8822b(
 		if (_iqk_reload_iqk_8822b(dm, reset))
 			return;
 
+	start_time = odm_get_current_time(dm);
+
 	PHYDM_DBG(dm, ODM_COMP_CALIBRATION,"[IQK]==========IQK strat!!!!!==========\n");
 
 	PHYDM_DBG(dm, ODM_COMP_CALIBRATION,"[IQK]band_type = %s, band_width = %d, ExtPA2G = %d, ext_pa_5g = %d\n", (*dm->band_type == ODM_BAND_5G) ? "5G" : "2G", *dm->band_width, dm->ext_pa, dm->ext_pa_5g);
@@ -1709,6 +1918,8 @@ _phy_iq_calibrate_8822b(
 #endif
 	_iqk_fill_iqk_report_8822b(dm, 0);
 	_iqk_rf0xb0_workaround(dm);
+	iqk_info->iqk_cache_k_time = odm_get_progressing_time(dm, start_time);
+	_iqk_cache_store_8822b(dm);
 	PHYDM_DBG(dm, ODM_COMP_CALIBRATION, "[IQK]==========IQK end!!!!!==========\n");
 }
 
@@ -1738,6 +1949,59 @@ _phy_iq_calibrate_by_fw_8822b(
 		PHYDM_DBG(dm, ODM_COMP_CALIBRATION, "[IQK]FWIQK fail!!!\n");
 }
 
+void
+halrf_iqk_cache_watchdog_8822b(
+	void		*dm_void
+)
+{
+	struct dm_struct	*dm = (struct dm_struct *)dm_void;
+	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
+
+	if (!iqk_info->iqk_cache_recal)
+		return;
+
+	if (dm->fw_offload_ability & PHYDM_RF_IQK_OFFLOAD) {
+		iqk_info->iqk_cache_recal = false;
+		return;
+	}
+
+	if (dm->rf_calibrate_info.is_iqk_in_progress)
+		return;
+
+	/*backoff after a failed recal*/
+	if (iqk_info->iqk_cache_recal_wait) {
+		iqk_info->iqk_cache_recal_wait--;
+		return;
+	}
+
+	/*left the channel, the recal is done when coming back*/
+	if (odm_get_rf_reg(dm, RF_PATH_A, 0x18, RFREGOFFSETMASK) != iqk_info->iqk_cache_recal_key)
+		return;
+
+	PHYDM_DBG(dm, ODM_COMP_CALIBRATION, "[IQK]cached IQK result drifted, recal\n");
+	halrf_segment_iqk_trigger(dm, true, iqk_info->segment_iqk);
+}
+
+void
+halrf_iqk_cache_set_8822b(
+	void		*dm_void,
+	boolean		flush,
+	u8		thermal_th
+)
+{
+	struct dm_struct	*dm = (struct dm_struct *)dm_void;
+	struct dm_iqk_info	*iqk_info = &dm->IQK_info;
+
+	if (flush) {
+		_iqk_cache_reset_8822b(dm);
+		iqk_info->iqk_cache_hit = 0;
+		iqk_info->iqk_cache_miss = 0;
+		iqk_info->iqk_cache_drift = 0;
+		iqk_info->iqk_cache_saved_time = 0;
+	} else
+		iqk_info->iqk_cache_th = thermal_th;
+}
+
 /*IQK_version:0x2f, NCTL:0x8*/
 /*1.disable CCK block and OFDM CCA block while IQKing*/
 void
@@ -69,9 +69,23 @@ do_imr_test_8822b(
 	void		*dm_void
 );
 
+void
+halrf_iqk_cache_watchdog_8822b(
+	void		*dm_void
+);
+
+void
+halrf_iqk_cache_set_8822b(
+	void		*dm_void,
+	boolean		flush,
+	u8		thermal_th
+);
+
 #else	/* (RTL8822B_SUPPORT == 0)*/
 
 #define phy_iq_calibrate_8822b(_pdm_void, clear, segment_iqk)
+#define halrf_iqk_cache_watchdog_8822b(_pdm_void)
+#define halrf_iqk_cache_set_8822b(_pdm_void, flush, thermal_th)
 
 #endif	/* RTL8822B_SUPPORT */
 
@@ -1824,6 +1824,8 @@ phydm_watchdog(
 	struct dm_struct		*dm
 )
 {
+	u32 io_start = dm->io_cnt;
+
 	PHYDM_DBG(dm, DBG_COMMON_FLOW, "%s ======>\n", __func__);
 
 	phydm_common_info_self_update(dm);
@@ -1832,8 +1834,10 @@ phydm_watchdog(
 	phydm_auto_dbg_engine(dm);
 	phydm_receiver_blocking(dm);
 	
-	if (phydm_stop_dm_watchdog_check(dm) == true)
+	if (phydm_stop_dm_watchdog_check(dm) == true) {
+		dm->watchdog_io_cnt = dm->io_cnt - io_start;
 		return;
+	}
 
 	phydm_hw_setting(dm);
 	
@@ -1883,6 +1887,7 @@ phydm_watchdog(
 
 	phydm_common_info_self_reset(dm);
 
+	dm->watchdog_io_cnt = dm->io_cnt - io_start;
 }
 
 
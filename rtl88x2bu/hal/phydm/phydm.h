@@ -975,6 +975,12 @@ struct	phydm_iot_center {
 
 	struct	phydm_pause_lv				pause_lv_table;	
 	struct	phydm_api_stuc 				api_table;
+
+	/*register access statistic, see PHYDM_IO_CNT*/
+	u32			io_cnt;
+	u32			watchdog_io_cnt;	/*register access of the last watchdog pass*/
+	u32			fa_io_cnt;		/*register access of the last FA counter statistic*/
+	boolean			fa_snapshot_en;		/*read FA counter report registers in blocks*/
 #ifdef PHYDM_POWER_TRAINING_SUPPORT
 	struct	phydm_pow_train_stuc			pow_train_table;
 #endif
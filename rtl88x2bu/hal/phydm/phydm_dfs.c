@@ -339,6 +339,8 @@ phydm_radar_detect_dm_check(
 	boolean tri_short_pulse = 0, tri_long_pulse = 0, radar_type = 0, fault_flag_det = 0, fault_flag_psd = 0, fa_flag = 0, radar_detected = 0;
 	u8 st_l2h_new = 0, fa_mask_th = 0, sum = 0;
 	u8 c_channel = *dm->channel;
+
+	odm_memory_set(dm, &dfs->rpt, 0, sizeof(dfs->rpt));
 		
 	/*Get FA count during past 100ms*/
 	fa_count_cur = (u16)odm_get_bb_reg(dm, 0xf48, 0x0000ffff);
@@ -443,6 +445,15 @@ phydm_radar_detect_dm_check(
 	else if(tri_long_pulse)
 		radar_type = 1;
 
+	dfs->rpt.short_pulse_cnt_inc = short_pulse_cnt_inc;
+	dfs->rpt.long_pulse_cnt_inc = long_pulse_cnt_inc;
+	dfs->rpt.fa_count_inc = fa_count_inc;
+	dfs->rpt.total_crc_ok_cnt_inc = total_crc_ok_cnt_inc;
+	dfs->rpt.igi = dfs->igi_cur;
+	dfs->rpt.st_l2h = dfs->st_l2h_cur;
+	dfs->rpt.tri_short_pulse = tri_short_pulse;
+	dfs->rpt.tri_long_pulse = tri_long_pulse;
+
 	if (tri_short_pulse) {
 		odm_set_bb_reg(dm, 0x924, BIT(15), 0);
 		odm_set_bb_reg(dm, 0x924, BIT(15), 1);
@@ -458,6 +469,7 @@ phydm_radar_detect_dm_check(
 		if (region_domain == PHYDM_DFS_DOMAIN_ETSI) {
 			tri_long_pulse = 0;
 		}
+		dfs->rpt.long_pulse_filtered = !tri_long_pulse;
 	}
 
 	st_l2h_new = dfs->st_l2h_cur;
@@ -558,6 +570,9 @@ phydm_radar_detect_dm_check(
 			"fault_flag_det[%d], fault_flag_psd[%d], DFS_detected [%d]\n", fault_flag_det, fault_flag_psd, radar_detected);
 	}
 
+	dfs->rpt.fa_masked = fa_flag;
+	dfs->rpt.hist_masked = fault_flag_det;
+
 	return radar_detected;
 
 }
@@ -598,9 +613,19 @@ boolean phydm_radar_detect(void *dm_void)
 		}
 	}
 
+	dfs->rpt.detected = enable_DFS && radar_detected;
+
 	return enable_DFS && radar_detected;
 }
 
+void phydm_radar_detect_get_rpt(void *dm_void, struct phydm_radar_rpt *rpt)
+{
+	struct dm_struct *dm = (struct dm_struct *)dm_void;
+	struct _DFS_STATISTICS	*dfs = (struct _DFS_STATISTICS *)phydm_get_structure(dm, PHYDM_DFS);
+
+	odm_move_memory(dm, rpt, &dfs->rpt, sizeof(*rpt));
+}
+
 
 void
 phydm_dfs_debug(
@@ -39,6 +39,22 @@
  ============================================================
 */
 
+/* status of one radar_detect poll, for driver side radar event handling */
+struct phydm_radar_rpt {
+	u16			short_pulse_cnt_inc;
+	u16			long_pulse_cnt_inc;
+	u16			fa_count_inc;
+	u16			total_crc_ok_cnt_inc;
+	u8			igi;
+	u8			st_l2h;
+	boolean		tri_short_pulse;
+	boolean		tri_long_pulse;	/* before region filter */
+	boolean		long_pulse_filtered;	/* long pulse ignored by region */
+	boolean		fa_masked;
+	boolean		hist_masked;
+	boolean		detected;
+};
+
 struct _DFS_STATISTICS {
 	u8			mask_idx;
 	u8			igi_cur;
@@ -71,6 +87,7 @@ struct _DFS_STATISTICS {
 	boolean		dbg_mode;
 	boolean		det_print;
 	boolean		det_print2;
+	struct phydm_radar_rpt	rpt;
 };
 
 
@@ -96,6 +113,7 @@ void phydm_radar_detect_reset(void *dm_void);
 void phydm_radar_detect_disable(void *dm_void);
 void phydm_radar_detect_enable(void *dm_void);
 boolean phydm_radar_detect(void *dm_void);
+void phydm_radar_detect_get_rpt(void *dm_void, struct phydm_radar_rpt *rpt);
 void phydm_dfs_parameter_init(void *dm_void);
 void phydm_dfs_debug(void *dm_void, u32 *const argv, u32 *_used, char *output, u32 *_out_len);
 #endif /* defined(CONFIG_PHYDM_DFS_MASTER) */
@@ -377,6 +377,7 @@ phydm_dig_init(
 	dig_t->fa_th[1] = 500;
 	dig_t->fa_th[2] = 750;
 	dig_t->is_dbg_fa_th = false;
+	dm->fa_snapshot_en = true;
 #if (DM_ODM_SUPPORT_TYPE & (ODM_AP))
 	/* For RTL8881A */
 	false_alm_cnt->cnt_ofdm_fail_pre = 0;
@@ -889,6 +890,86 @@ phydm_dig_by_rssi_lps(
 /* 3============================================================
  * 3 FASLE ALARM CHECK
  * 3============================================================ */
+#if (ODM_IC_11AC_SERIES_SUPPORT == 1)
+/*
+ * FA counter snapshot for 11AC series.
+ * CRC32/CCA report registers (0xF04 ~ 0xF17) and OFDM FA type registers
+ * (0xFBC ~ 0xFD3) are read with one bus access per range when
+ * fa_snapshot_en is set and the interface supports block read, otherwise
+ * every register is read on its own.
+ */
+#define PHYDM_FA_SNAP_CRC_ADDR		ODM_REG_CCK_CRC32_CNT_11AC
+#define PHYDM_FA_SNAP_CRC_LEN		20
+#define PHYDM_FA_SNAP_TYPE_ADDR		ODM_REG_OFDM_FA_TYPE3_11AC
+#define PHYDM_FA_SNAP_TYPE_LEN		24
+
+struct phydm_fa_snapshot {
+	boolean	crc_valid;
+	boolean	type_valid;
+	u8	crc[PHYDM_FA_SNAP_CRC_LEN];
+	u8	type[PHYDM_FA_SNAP_TYPE_LEN];
+};
+
+static void
+phydm_fa_snapshot_read(
+	struct dm_struct		*dm,
+	struct phydm_fa_snapshot	*snap
+)
+{
+	snap->crc_valid = false;
+	snap->type_valid = false;
+
+	if (!dm->fa_snapshot_en)
+		return;
+
+	snap->crc_valid = odm_read_mem(dm, PHYDM_FA_SNAP_CRC_ADDR, PHYDM_FA_SNAP_CRC_LEN, snap->crc);
+	if (snap->crc_valid)
+		snap->type_valid = odm_read_mem(dm, PHYDM_FA_SNAP_TYPE_ADDR, PHYDM_FA_SNAP_TYPE_LEN, snap->type);
+}
+
+static u32
+phydm_fa_snapshot_get(
+	struct dm_struct		*dm,
+	struct phydm_fa_snapshot	*snap,
+	u32				reg_addr
+)
+{
+	u8 *p = NULL;
+
+	if (snap->crc_valid && reg_addr >= PHYDM_FA_SNAP_CRC_ADDR &&
+	    reg_addr < PHYDM_FA_SNAP_CRC_ADDR + PHYDM_FA_SNAP_CRC_LEN)
+		p = snap->crc + (reg_addr - PHYDM_FA_SNAP_CRC_ADDR);
+	else if (snap->type_valid && reg_addr >= PHYDM_FA_SNAP_TYPE_ADDR &&
+		 reg_addr < PHYDM_FA_SNAP_TYPE_ADDR + PHYDM_FA_SNAP_TYPE_LEN)
+		p = snap->type + (reg_addr - PHYDM_FA_SNAP_TYPE_ADDR);
+
+	if (!p)
+		return odm_get_bb_reg(dm, reg_addr, MASKDWORD);
+
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((u32)p[3] << 24);
+}
+
+/*pulse a counter reset/hold bit with one read and two writes*/
+static void
+phydm_fa_pulse_bit(
+	struct dm_struct	*dm,
+	u32		reg_addr,
+	u32		bit,
+	boolean		active_high
+)
+{
+	u32 val = odm_get_bb_reg(dm, reg_addr, MASKDWORD);
+
+	if (active_high) {
+		odm_set_bb_reg(dm, reg_addr, MASKDWORD, val | bit);
+		odm_set_bb_reg(dm, reg_addr, MASKDWORD, val & ~bit);
+	} else {
+		odm_set_bb_reg(dm, reg_addr, MASKDWORD, val & ~bit);
+		odm_set_bb_reg(dm, reg_addr, MASKDWORD, val | bit);
+	}
+}
+#endif
+
 void
 phydm_false_alarm_counter_reg_reset(
 	void					*dm_void
@@ -954,6 +1035,13 @@ phydm_false_alarm_counter_reg_reset(
 				PHYDM_DBG(dm, DBG_FA_CNT, "Reset FA_cnt\n");
 			}
 	#endif	/* #if (RTL8881A_SUPPORT == 1) */
+			if (dm->fa_snapshot_en) {
+				phydm_fa_pulse_bit(dm, 0x9A4, BIT(17), true);
+				phydm_fa_pulse_bit(dm, 0xA2C, BIT(15), false);
+				phydm_fa_pulse_bit(dm, 0xB58, BIT(0), true);
+				return;
+			}
+
 			/* reset OFDM FA countner */
 			odm_set_bb_reg(dm, 0x9A4, BIT(17), 1);
 			odm_set_bb_reg(dm, 0x9A4, BIT(17), 0);
@@ -998,6 +1086,7 @@ odm_false_alarm_counter_statistics(
 	struct phydm_fa_struct	*false_alm_cnt = (struct phydm_fa_struct *)phydm_get_structure(dm, PHYDM_FALSEALMCNT);
 	struct phydm_adaptivity_struct	*adaptivity = (struct phydm_adaptivity_struct *)phydm_get_structure(dm, PHYDM_ADAPTIVITY);
 	u32						ret_value;
+	u32						io_start = dm->io_cnt;
 
 	if (!(dm->support_ability & ODM_BB_FA_CNT))
 		return;
@@ -1102,26 +1191,29 @@ odm_false_alarm_counter_statistics(
 
 #if (ODM_IC_11AC_SERIES_SUPPORT == 1)
 	if (dm->support_ic_type & ODM_IC_11AC_SERIES) {
+		struct phydm_fa_snapshot snap;
 		u32 cck_enable;
 
-		ret_value = odm_get_bb_reg(dm, ODM_REG_OFDM_FA_TYPE1_11AC, MASKDWORD);
+		phydm_fa_snapshot_read(dm, &snap);
+
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_OFDM_FA_TYPE1_11AC);
 		false_alm_cnt->cnt_fast_fsync = ((ret_value & 0xffff0000) >> 16);
 
-		ret_value = odm_get_bb_reg(dm, ODM_REG_OFDM_FA_TYPE2_11AC, MASKDWORD);
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_OFDM_FA_TYPE2_11AC);
 		false_alm_cnt->cnt_sb_search_fail = (ret_value & 0xffff);
 
-		ret_value = odm_get_bb_reg(dm, ODM_REG_OFDM_FA_TYPE3_11AC, MASKDWORD);
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_OFDM_FA_TYPE3_11AC);
 		false_alm_cnt->cnt_parity_fail = (ret_value & 0xffff);
 		false_alm_cnt->cnt_rate_illegal = ((ret_value & 0xffff0000) >> 16);
 
-		ret_value = odm_get_bb_reg(dm, ODM_REG_OFDM_FA_TYPE4_11AC, MASKDWORD);
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_OFDM_FA_TYPE4_11AC);
 		false_alm_cnt->cnt_crc8_fail = (ret_value & 0xffff);
 		false_alm_cnt->cnt_mcs_fail = ((ret_value & 0xffff0000) >> 16);
 
-		ret_value = odm_get_bb_reg(dm, ODM_REG_OFDM_FA_TYPE5_11AC, MASKDWORD);
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_OFDM_FA_TYPE5_11AC);
 		false_alm_cnt->cnt_crc8_fail_vht = (ret_value & 0xffff);
 
-		ret_value = odm_get_bb_reg(dm, ODM_REG_OFDM_FA_TYPE6_11AC, MASKDWORD);
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_OFDM_FA_TYPE6_11AC);
 		false_alm_cnt->cnt_mcs_fail_vht = (ret_value & 0xffff);
 
 		/* read OFDM FA counter */
@@ -1131,27 +1223,27 @@ odm_false_alarm_counter_statistics(
 		false_alm_cnt->cnt_cck_fail = odm_get_bb_reg(dm, ODM_REG_CCK_FA_11AC, MASKLWORD);
 
 		/* read CCK/OFDM CCA counter */
-		ret_value = odm_get_bb_reg(dm, ODM_REG_CCK_CCA_CNT_11AC, MASKDWORD);
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_CCK_CCA_CNT_11AC);
 		false_alm_cnt->cnt_ofdm_cca = (ret_value & 0xffff0000) >> 16;
 		false_alm_cnt->cnt_cck_cca = ret_value & 0xffff;
 
 		/* read CCK CRC32 counter */
-		ret_value = odm_get_bb_reg(dm, ODM_REG_CCK_CRC32_CNT_11AC, MASKDWORD);
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_CCK_CRC32_CNT_11AC);
 		false_alm_cnt->cnt_cck_crc32_error = (ret_value & 0xffff0000) >> 16;
 		false_alm_cnt->cnt_cck_crc32_ok = ret_value & 0xffff;
 
 		/* read OFDM CRC32 counter */
-		ret_value = odm_get_bb_reg(dm, ODM_REG_OFDM_CRC32_CNT_11AC, MASKDWORD);
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_OFDM_CRC32_CNT_11AC);
 		false_alm_cnt->cnt_ofdm_crc32_error = (ret_value & 0xffff0000) >> 16;
 		false_alm_cnt->cnt_ofdm_crc32_ok = ret_value & 0xffff;
 
 		/* read HT CRC32 counter */
-		ret_value = odm_get_bb_reg(dm, ODM_REG_HT_CRC32_CNT_11AC, MASKDWORD);
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_HT_CRC32_CNT_11AC);
 		false_alm_cnt->cnt_ht_crc32_error = (ret_value & 0xffff0000) >> 16;
 		false_alm_cnt->cnt_ht_crc32_ok = ret_value & 0xffff;
 
 		/* read VHT CRC32 counter */
-		ret_value = odm_get_bb_reg(dm, ODM_REG_VHT_CRC32_CNT_11AC, MASKDWORD);
+		ret_value = phydm_fa_snapshot_get(dm, &snap, ODM_REG_VHT_CRC32_CNT_11AC);
 		false_alm_cnt->cnt_vht_crc32_error = (ret_value & 0xffff0000) >> 16;
 		false_alm_cnt->cnt_vht_crc32_ok = ret_value & 0xffff;
 
@@ -1224,6 +1316,9 @@ odm_false_alarm_counter_statistics(
 	PHYDM_DBG(dm, DBG_FA_CNT, "[VHT]  CRC32 {error, ok}= {%d, %d}\n", false_alm_cnt->cnt_vht_crc32_error, false_alm_cnt->cnt_vht_crc32_ok);
 	PHYDM_DBG(dm, DBG_FA_CNT, "[TOTAL]  CRC32 {error, ok}= {%d, %d}\n", false_alm_cnt->cnt_crc32_error_all, false_alm_cnt->cnt_crc32_ok_all);
 	PHYDM_DBG(dm, DBG_FA_CNT, "FA_Cnt: Dbg port 0x0 = 0x%x, EDCCA = %d\n\n", false_alm_cnt->dbg_port0, false_alm_cnt->edcca_flag);
+
+	dm->fa_io_cnt = dm->io_cnt - io_start;
+	PHYDM_DBG(dm, DBG_FA_CNT, "FA_Cnt: reg access = %d, snapshot = %d\n", dm->fa_io_cnt, dm->fa_snapshot_en);
 }
 
 #ifdef PHYDM_TDMA_DIG_SUPPORT
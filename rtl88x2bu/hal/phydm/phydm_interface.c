@@ -49,6 +49,8 @@ odm_read_1byte(
 	return rtl_read_byte(rtlpriv, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void		*adapter = dm->adapter;
+
+	PHYDM_IO_CNT(dm, 1);
 	return rtw_read8(adapter, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void		*adapter = dm->adapter;
@@ -73,6 +75,8 @@ odm_read_2byte(
 	return rtl_read_word(rtlpriv, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void		*adapter = dm->adapter;
+
+	PHYDM_IO_CNT(dm, 1);
 	return rtw_read16(adapter, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void		*adapter = dm->adapter;
@@ -97,6 +101,8 @@ odm_read_4byte(
 	return rtl_read_dword(rtlpriv, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void		*adapter = dm->adapter;
+
+	PHYDM_IO_CNT(dm, 1);
 	return rtw_read32(adapter, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void		*adapter = dm->adapter;
@@ -122,6 +128,8 @@ odm_write_1byte(
 	rtl_write_byte(rtlpriv, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void		*adapter = dm->adapter;
+
+	PHYDM_IO_CNT(dm, 1);
 	rtw_write8(adapter, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void		*adapter = dm->adapter;
@@ -147,6 +155,8 @@ odm_write_2byte(
 	rtl_write_word(rtlpriv, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void		*adapter = dm->adapter;
+
+	PHYDM_IO_CNT(dm, 1);
 	rtw_write16(adapter, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void		*adapter = dm->adapter;
@@ -172,6 +182,8 @@ odm_write_4byte(
 	rtl_write_dword(rtlpriv, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void		*adapter = dm->adapter;
+
+	PHYDM_IO_CNT(dm, 1);
 	rtw_write32(adapter, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void		*adapter = dm->adapter;
@@ -198,6 +210,7 @@ odm_set_mac_reg(
 
 	rtl_set_bbreg(rtlpriv->hw, reg_addr, bit_mask, data);
 #else
+	PHYDM_IO_CNT(dm, (bit_mask == MASKDWORD) ? 1 : 2);
 	phy_set_bb_reg(dm->adapter, reg_addr, bit_mask, data);
 #endif
 }
@@ -219,6 +232,7 @@ odm_get_mac_reg(
 
 	return rtl_get_bbreg(rtlpriv->hw, reg_addr, bit_mask);
 #else
+	PHYDM_IO_CNT(dm, 1);
 	return phy_query_mac_reg(dm->adapter, reg_addr, bit_mask);
 #endif
 }
@@ -241,6 +255,7 @@ odm_set_bb_reg(
 
 	rtl_set_bbreg(rtlpriv->hw, reg_addr, bit_mask, data);
 #else
+	PHYDM_IO_CNT(dm, (bit_mask == MASKDWORD) ? 1 : 2);
 	phy_set_bb_reg(dm->adapter, reg_addr, bit_mask, data);
 #endif
 }
@@ -262,10 +277,37 @@ odm_get_bb_reg(
 
 	return rtl_get_bbreg(rtlpriv->hw, reg_addr, bit_mask);
 #else
+	PHYDM_IO_CNT(dm, 1);
 	return phy_query_bb_reg(dm->adapter, reg_addr, bit_mask);
 #endif
 }
 
+/*
+ * Read a block of consecutive registers with one bus access.
+ * Return false if the interface can't do it, caller must fall back to
+ * register-by-register access.
+ */
+boolean
+odm_read_mem(
+	struct dm_struct	*dm,
+	u32		reg_addr,
+	u32		len,
+	u8		*buf
+)
+{
+#if (DM_ODM_SUPPORT_TYPE & ODM_CE) && !defined(DM_ODM_CE_MAC80211) && defined(CONFIG_USB_HCI)
+	void		*adapter = dm->adapter;
+
+	if (len > MAX_VENDOR_REQ_CMD_SIZE)
+		return false;
+
+	PHYDM_IO_CNT(dm, 1);
+	rtw_read_mem(adapter, reg_addr, len, buf);
+	return true;
+#else
+	return false;
+#endif
+}
 
 void
 odm_set_rf_reg(
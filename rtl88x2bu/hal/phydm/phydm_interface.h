@@ -31,6 +31,9 @@
 
 #define pdm_set_reg	odm_set_bb_reg
 
+/*count register access issued by phydm*/
+#define PHYDM_IO_CNT(dm, n)	((dm)->io_cnt += (n))
+
 /*=========== Constant/Structure/Enum/... Define*/
 
 enum phydm_h2c_cmd {
@@ -224,6 +227,14 @@ odm_get_bb_reg(
 	u32		bit_mask
 );
 
+boolean
+odm_read_mem(
+	struct dm_struct	*dm,
+	u32		reg_addr,
+	u32		len,
+	u8		*buf
+);
+
 void
 odm_set_rf_reg(
 	struct dm_struct			*dm,
@@ -125,6 +125,8 @@ phydm_ra_debug(
 			       "{1} {100}: show offset\n");
 		PDM_SNPF(out_len, used, output + used, out_len - used,
 			       "{2} {en} {macid} {bw} {rate}: fw fix rate\n");
+		PDM_SNPF(out_len, used, output + used, out_len - used,
+			       "{3}: show RA mask update statistic\n");
 		
 	} else if (var1[0] == 1) { /*Adjust PCR offset*/
 
@@ -159,6 +161,15 @@ phydm_ra_debug(
 		
 		phydm_fw_fix_rate(dm, (u8)var1[1], (u8)var1[2], (u8)var1[3], (u8)var1[4]);
 		
+	} else if (var1[0] == 3) { /*RA mask update statistic*/
+
+		PDM_SNPF(out_len, used, output + used, out_len - used,
+			       "RA mask H2C/sec=((%d)), last WD sta=((%d))\n",
+			       ra_tab->ra_h2c_per_sec, ra_tab->ra_mask_wd_sta_cnt);
+		PDM_SNPF(out_len, used, output + used, out_len - used,
+			       "RA mask WD time=((%llu)) ms, max=((%llu)) ms\n",
+			       ra_tab->ra_mask_wd_time, ra_tab->ra_mask_wd_time_max);
+
 	} else {
 		PDM_SNPF(out_len, used, output + used, out_len - used,
 			       "[Set] Error\n");
@@ -630,6 +641,11 @@ phydm_rate_adaptive_mask_init(
 	ra_t->ldpc_thres = 35;
 	ra_t->up_ramask_cnt = 0;
 	ra_t->up_ramask_cnt_tmp = 0;
+	odm_memory_set(dm, ra_t->ra_mask_dirty, 0, sizeof(ra_t->ra_mask_dirty));
+	ra_t->ra_h2c_cnt = 0;
+	ra_t->ra_h2c_per_sec = 0;
+	ra_t->ra_h2c_sample_time = odm_get_current_time(dm);
+	ra_t->ra_mask_wd_time_max = 0;
 
 }
 
@@ -1094,6 +1110,7 @@ phydm_ra_h2c(
 		h2c_val[6], h2c_val[5], h2c_val[4], h2c_val[3], h2c_val[2], h2c_val[1], h2c_val[0]);
 
 	odm_fill_h2c_cmd(dm, PHYDM_H2C_RA_MASK, H2C_MAX_LENGTH, h2c_val);
+	dm->dm_ra_table.ra_h2c_cnt++;
 
 	#if (defined(PHYDM_COMPILE_ABOVE_3SS))
 	if (dm->support_ic_type & (PHYDM_IC_ABOVE_3SS)) {
@@ -1209,6 +1226,83 @@ phydm_ra_offline(
 		phydm_ra_h2c(dm, macid, ra->disable_ra, ra->disable_pt, 0, 0, 0);
 }
 
+void
+phydm_ra_mask_set_dirty(
+	void	*dm_void,
+	u8	macid
+)
+{
+	struct dm_struct		*dm = (struct dm_struct *)dm_void;
+	struct ra_table	*ra_t = &dm->dm_ra_table;
+
+	ra_t->ra_mask_dirty[macid >> 3] |= BIT(macid & 0x7);
+}
+
+/*Called by RSSI monitor for each active station,
+ *mark the station dirty only when its RSSI level changes.
+ *phydm_rssi_lv_dec keeps a RA_FLOOR_UP_GAP hysteresis on the level.
+ */
+void
+phydm_ra_mask_rssi_update(
+	void	*dm_void,
+	u8	macid
+)
+{
+	struct dm_struct		*dm = (struct dm_struct *)dm_void;
+	struct cmn_sta_info			*sta = dm->phydm_sta_info[macid];
+	struct ra_sta_info				*ra = NULL;
+	u8		rssi_lv_new;
+
+	if (!(dm->support_ability & ODM_BB_RA_MASK))
+		return;
+
+	if (!is_sta_active(sta))
+		return;
+
+	ra = &sta->ra_info;
+
+	if (ra->disable_ra)
+		return;
+
+	/*to be modified*/
+	#if ((RTL8812A_SUPPORT == 1) || (RTL8821A_SUPPORT == 1))
+	if ((dm->support_ic_type == ODM_RTL8812) ||
+		((dm->support_ic_type == ODM_RTL8821) && (dm->cut_version == ODM_CUT_A))
+		) {
+		
+		if (sta->rssi_stat.rssi < dm->dm_ra_table.ldpc_thres) {
+			
+			#if (DM_ODM_SUPPORT_TYPE == ODM_CE)
+			set_ra_ldpc_8812(sta, true);		/*LDPC TX enable*/
+			#elif (DM_ODM_SUPPORT_TYPE == ODM_WIN)
+				{
+					MgntSet_TX_LDPC(macid, true);
+				}
+			#endif
+			PHYDM_DBG(dm, DBG_RA_MASK, "RSSI=%d, ldpc_en =TRUE\n", sta->rssi_stat.rssi);
+			
+		} else if (sta->rssi_stat.rssi > (dm->dm_ra_table.ldpc_thres + 3)) {
+			#if (DM_ODM_SUPPORT_TYPE == ODM_CE)
+			set_ra_ldpc_8812(sta, false);	/*LDPC TX disable*/
+			#elif (DM_ODM_SUPPORT_TYPE == ODM_WIN)
+				{
+					MgntSet_TX_LDPC(macid, false);
+				}
+			#endif
+			PHYDM_DBG(dm, DBG_RA_MASK, "RSSI=%d, ldpc_en =FALSE\n", sta->rssi_stat.rssi);
+		}	
+	}
+	#endif
+
+	rssi_lv_new = phydm_rssi_lv_dec(dm, (u32)sta->rssi_stat.rssi, ra->rssi_level);
+
+	if (ra->rssi_level != rssi_lv_new) {
+		PHYDM_DBG(dm, DBG_RA_MASK, "MACID=%d, RSSI LV:((%d))->((%d))\n", macid, ra->rssi_level, rssi_lv_new);
+		ra->rssi_level = rssi_lv_new;
+		phydm_ra_mask_set_dirty(dm, macid);
+	}
+}
+
 void
 phydm_ra_mask_watchdog(
 	void	*dm_void
@@ -1218,9 +1312,11 @@ phydm_ra_mask_watchdog(
 	struct ra_table	*ra_t = &dm->dm_ra_table;
 	struct cmn_sta_info			*sta = NULL;
 	struct ra_sta_info				*ra = NULL;
-	u8		macid;
+	u8		macid, i, j;
+	u8		h2c_num = 0;
 	u64		ra_mask;
-	u8		rssi_lv_new;
+	u64		start_time;
+	u32		period;
 
 	if (!(dm->support_ability & ODM_BB_RA_MASK))
 		return;
@@ -1229,61 +1325,51 @@ phydm_ra_mask_watchdog(
 		return;
 
 	PHYDM_DBG(dm, DBG_RA_MASK, "%s ======>\n", __func__);
-	
+
+	start_time = odm_get_current_time(dm);
 	ra_t->up_ramask_cnt++;
 
-	for (macid = 0; macid < ODM_ASSOCIATE_ENTRY_NUM; macid++) {
-		
-		sta = dm->phydm_sta_info[macid];
-		
-		if (!is_sta_active(sta))
-			continue;
+	/*RSSI monitor is off, nobody feeds the dirty list*/
+	if (!(dm->support_ability & ODM_BB_RSSI_MONITOR)) {
+		for (macid = 0; macid < ODM_ASSOCIATE_ENTRY_NUM; macid++)
+			phydm_ra_mask_rssi_update(dm, macid);
+	}
 
-		ra = &sta->ra_info;
+	if (ra_t->up_ramask_cnt >= FORCED_UPDATE_RAMASK_PERIOD) {
+		ra_t->up_ramask_cnt = 0;
+		for (macid = 0; macid < ODM_ASSOCIATE_ENTRY_NUM; macid++) {
+			if (is_sta_active(dm->phydm_sta_info[macid]))
+				phydm_ra_mask_set_dirty(dm, macid);
+		}
+	}
+
+	for (i = 0; i < sizeof(ra_t->ra_mask_dirty); i++) {
 
-		if (ra->disable_ra)
+		if (!ra_t->ra_mask_dirty[i])
 			continue;
 
+		for (j = 0; j < 8; j++) {
 
-		/*to be modified*/
-		#if ((RTL8812A_SUPPORT == 1) || (RTL8821A_SUPPORT == 1))
-		if ((dm->support_ic_type == ODM_RTL8812) ||
-			((dm->support_ic_type == ODM_RTL8821) && (dm->cut_version == ODM_CUT_A))
-			) {
-			
-			if (sta->rssi_stat.rssi < ra_t->ldpc_thres) {
-				
-				#if (DM_ODM_SUPPORT_TYPE == ODM_CE)
-				set_ra_ldpc_8812(sta, true);		/*LDPC TX enable*/
-				#elif (DM_ODM_SUPPORT_TYPE == ODM_WIN)
-					{
-						MgntSet_TX_LDPC(macid, true);
-					}
-				#endif
-				PHYDM_DBG(dm, DBG_RA_MASK, "RSSI=%d, ldpc_en =TRUE\n", sta->rssi_stat.rssi);
-				
-			} else if (sta->rssi_stat.rssi > (ra_t->ldpc_thres + 3)) {
-				#if (DM_ODM_SUPPORT_TYPE == ODM_CE)
-				set_ra_ldpc_8812(sta, false);	/*LDPC TX disable*/
-				#elif (DM_ODM_SUPPORT_TYPE == ODM_WIN)
-					{
-						MgntSet_TX_LDPC(macid, false);
-					}
-				#endif
-				PHYDM_DBG(dm, DBG_RA_MASK, "RSSI=%d, ldpc_en =FALSE\n", sta->rssi_stat.rssi);
-			}	
-		}
-		#endif
+			if (!(ra_t->ra_mask_dirty[i] & BIT(j)))
+				continue;
 
-		rssi_lv_new = phydm_rssi_lv_dec(dm, (u32)sta->rssi_stat.rssi, ra->rssi_level);
+			if (h2c_num >= RA_MASK_H2C_BATCH_NUM)
+				goto out;
+
+			ra_t->ra_mask_dirty[i] &= ~BIT(j);
+			macid = (i << 3) + j;
+			sta = dm->phydm_sta_info[macid];
+
+			if (!is_sta_active(sta))
+				continue;
+
+			ra = &sta->ra_info;
+
+			if (ra->disable_ra)
+				continue;
+
+			PHYDM_DBG(dm, DBG_RA_MASK, "MACID=%d, update RA mask, RSSI LV=((%d))\n", macid, ra->rssi_level);
 
-		if ((ra->rssi_level != rssi_lv_new) || 
-			(ra_t->up_ramask_cnt >= FORCED_UPDATE_RAMASK_PERIOD)) {
-			PHYDM_DBG(dm, DBG_RA_MASK, "RSSI LV:((%d))->((%d))\n", ra->rssi_level, rssi_lv_new);
-			
-			ra->rssi_level = rssi_lv_new;
-			ra_t->up_ramask_cnt = 0;
-			
 			ra_mask = phydm_get_bb_mod_ra_mask(dm, macid);
 
 			if (ra_t->record_ra_info)
@@ -1299,9 +1385,25 @@ phydm_ra_mask_watchdog(
 				/*FW RA*/
 				phydm_ra_h2c(dm, macid, ra->disable_ra, ra->disable_pt, 1, 0, ra_mask);
 			}
+			h2c_num++;
 		}
 	}
 
+out:
+	ra_t->ra_mask_wd_sta_cnt = h2c_num;
+	ra_t->ra_mask_wd_time = odm_get_progressing_time(dm, start_time);
+	if (ra_t->ra_mask_wd_time > ra_t->ra_mask_wd_time_max)
+		ra_t->ra_mask_wd_time_max = ra_t->ra_mask_wd_time;
+
+	period = (u32)odm_get_progressing_time(dm, ra_t->ra_h2c_sample_time);
+	if (period >= 1000) {
+		ra_t->ra_h2c_per_sec = ra_t->ra_h2c_cnt * 1000 / period;
+		ra_t->ra_h2c_cnt = 0;
+		ra_t->ra_h2c_sample_time = odm_get_current_time(dm);
+	}
+
+	PHYDM_DBG(dm, DBG_RA_MASK, "RA mask H2C=%d, time=%llu ms, H2C/sec=%d\n",
+		h2c_num, ra_t->ra_mask_wd_time, ra_t->ra_h2c_per_sec);
 }
 #endif
 
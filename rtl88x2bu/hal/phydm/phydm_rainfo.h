@@ -38,6 +38,7 @@
 #define RAINFO_VERSION	"5.0"  /*2017.04.20 Dino, the 3rd PHYDM reform*/
 
 #define	FORCED_UPDATE_RAMASK_PERIOD	5
+#define	RA_MASK_H2C_BATCH_NUM	8	/*max RA mask H2C per watchdog, the rest wait for next one*/
 
 #define	H2C_MAX_LENGTH	7
 
@@ -207,6 +208,13 @@ struct ra_table {
 	u8	retrylimit_high;
 #endif
 	u8	ldpc_thres;			/* if RSSI > ldpc_thres => switch from LPDC to BCC */
+	u8	ra_mask_dirty[(ODM_ASSOCIATE_ENTRY_NUM + 7) >> 3]; /*macid bitmap, RA mask to be updated*/
+	u32	ra_h2c_cnt;			/*RA mask H2C since ra_h2c_sample_time*/
+	u32	ra_h2c_per_sec;
+	u64	ra_h2c_sample_time;
+	u8	ra_mask_wd_sta_cnt;		/*stations updated in the last RA mask watchdog*/
+	u64	ra_mask_wd_time;		/*ms*/
+	u64	ra_mask_wd_time_max;		/*ms*/
 
 	void (*record_ra_info)(void *dm_void, u8 macid, struct cmn_sta_info *sta, u64 ra_mask);
 };
@@ -386,6 +394,18 @@ phydm_ra_offline(
 );
 
 
+void
+phydm_ra_mask_set_dirty(
+	void	*dm_void,
+	u8	macid
+);
+
+void
+phydm_ra_mask_rssi_update(
+	void	*dm_void,
+	u8	macid
+);
+
 void
 phydm_ra_mask_watchdog(
 	void	*dm_void
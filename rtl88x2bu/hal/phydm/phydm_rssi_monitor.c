@@ -127,6 +127,10 @@ phydm_calculate_rssi_min_max(
 			if (sta->ra_info.disable_ra == false)
 				phydm_rssi_monitor_h2c(dm, i);
 
+			#ifdef PHYDM_3RD_REFORM_RA_MASK
+			phydm_ra_mask_rssi_update(dm, i);
+			#endif
+
 			if (sta_cnt == dm->number_linked_client)
 				break;
 		}
@@ -46,6 +46,7 @@ void rtl8822b_init_hal_spec(PADAPTER);
 u32 rtl8822b_power_on(PADAPTER);
 void rtl8822b_power_off(PADAPTER);
 u8 rtl8822b_hal_init(PADAPTER);
+u8 rtl8822b_mac_reinit(PADAPTER);
 u8 rtl8822b_mac_verify(PADAPTER);
 void rtl8822b_init_misc(PADAPTER padapter);
 u32 rtl8822b_init(PADAPTER);
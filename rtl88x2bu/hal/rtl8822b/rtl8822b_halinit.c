@@ -169,6 +169,38 @@ u8 rtl8822b_hal_init(PADAPTER adapter)
 	return _TRUE;
 }
 
+/*
+ * Reset MAC and re-initialize TRX DMA, but keep firmware and BB/RF alive.
+ * Caller should restore CAM, BSSID and link related settings afterward.
+ */
+u8 rtl8822b_mac_reinit(PADAPTER adapter)
+{
+	struct dvobj_priv *d;
+	PHAL_DATA_TYPE hal;
+	int err;
+
+
+	d = adapter_to_dvobj(adapter);
+	hal = GET_HAL_DATA(adapter);
+
+	/* without running firmware, only full init could help */
+	if (hal->bFWReady == _FALSE)
+		return _FALSE;
+
+	err = rtw_halmac_reinit_mac(d);
+	if (err) {
+		RTW_ERR("%s: MAC re-init fail(err=%d)\n", __FUNCTION__, err);
+		return _FALSE;
+	}
+
+	/* Sync driver status with hardware setting */
+	rtw_hal_get_hwreg(adapter, HW_VAR_RCR, NULL);
+
+	rtl8822b_init_misc(adapter);
+
+	return _TRUE;
+}
+
 u8 rtl8822b_mac_verify(PADAPTER adapter)
 {
 	struct dvobj_priv *d;
@@ -4094,6 +4094,7 @@ void rtl8822b_set_hal_ops(PADAPTER adapter)
 	ops->sreset_init_value = sreset_init_value;
 	ops->sreset_reset_value = sreset_reset_value;
 	ops->silentreset = sreset_reset;
+	ops->sreset_mac_reinit = rtl8822b_mac_reinit;
 	ops->sreset_xmit_status_check = xmit_status_check;
 	ops->sreset_linked_status_check = linked_status_check;
 	ops->sreset_get_wifi_status = sreset_get_wifi_status;
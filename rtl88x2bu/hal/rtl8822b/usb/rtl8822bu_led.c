@@ -90,6 +90,49 @@ static void swledoff(PADAPTER padapter, PLED_USB led)
 	led->bLedOn = _FALSE;
 }
 
+/*
+ * Description:
+ * Let MAC blink the LED by itself, LED_HW_MODE_SW gives control back to
+ * swledon()/swledoff(). Only the WL LED pin can be blinked by MAC.
+ */
+static u8 swledhwblink(PADAPTER padapter, PLED_USB led, u8 mode)
+{
+	struct dvobj_priv *d = adapter_to_dvobj(padapter);
+
+	if (RTW_CANNOT_RUN(padapter))
+		return _FAIL;
+
+	switch (led->LedPin) {
+	case LED_PIN_LED0:
+	case LED_PIN_LED1:
+	case LED_PIN_LED2:
+		/* halmac only changes LED mode on enable */
+		if (rtw_halmac_led_cfg(d, 0, LED_HW_MODE_SW) != 0)
+			return _FAIL;
+		if (rtw_halmac_led_cfg(d, 1, mode) != 0)
+			return _FAIL;
+		return _SUCCESS;
+	default:
+		return _FAIL;
+	}
+}
+
+/*
+ * Description:
+ * LED0/1/2 all end up on the one halmac WL LED pin, see swledon()/swledoff().
+ */
+static u8 swledphypin(PLED_USB led)
+{
+	switch (led->LedPin) {
+	case LED_PIN_LED0:
+	case LED_PIN_LED1:
+	case LED_PIN_LED2:
+		return LED_PIN_LED0;
+	default:
+		return led->LedPin;
+	}
+}
+
 /*
  * =============================================================================
  * Interface to manipulate LED objects.
@@ -115,6 +158,8 @@ void rtl8822bu_initswleds(PADAPTER padapter)
 	ledpriv->LedControlHandler = LedControlUSB;
 	ledpriv->SwLedOn = swledon;
 	ledpriv->SwLedOff = swledoff;
+	ledpriv->SwLedHwBlink = swledhwblink;
+	ledpriv->SwLedPhyPin = swledphypin;
 
 	InitLed(padapter, &(ledpriv->SwLed0), LED_PIN_LED0);
 	InitLed(padapter, &(ledpriv->SwLed1), LED_PIN_LED1);
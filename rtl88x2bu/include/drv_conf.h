@@ -151,6 +151,11 @@
 #define CONFIG_SCAN_BACKOP
 #endif
 
+/* link layer statistics served from snapshot folded by watchdog */
+#if defined(CONFIG_IOCTL_CFG80211) && defined(CONFIG_RTW_CFGVEDNOR_LLSTATS)
+#define CONFIG_RTW_LSTATS_SNAPSHOT
+#endif
+
 #define RTW_SCAN_SPARSE_MIRACAST 1
 #define RTW_SCAN_SPARSE_BG 0
 #define RTW_SCAN_SPARSE_ROAMING_ACTIVE 1
@@ -843,6 +843,7 @@ struct rf_ctl_t {
 	u8 ChannelPlan;
 	u8 max_chan_nums;
 	RT_CHANNEL_INFO channel_set[MAX_CHANNEL_NUM];
+	struct chset_map ch_map;
 	struct p2p_channels channel_list;
 
 	_mutex offch_mutex;
@@ -864,6 +865,7 @@ struct rf_ctl_t {
 	_list txpwr_lmt_list;
 	u8 txpwr_regd_num;
 	const char *regd_name;
+	struct txpwr_lmt_tbl __rcu *txpwr_lmt_tbl;
 
 	u8 txpwr_lmt_2g_cck_ofdm_state;
 	#ifdef CONFIG_IEEE80211_BAND_5GHZ
@@ -889,6 +891,8 @@ struct rf_ctl_t {
 
 	u8 dfs_ch_sel_d_flags;
 
+	struct radar_evt_ctl radar_evt;
+
 	u8 dbg_dfs_master_fake_radar_detect_cnt;
 	u8 dbg_dfs_master_radar_detect_trigger_non;
 	u8 dbg_dfs_master_choose_dfs_ch_first;
@@ -981,6 +985,7 @@ struct dvobj_priv {
 	_adapter *padapters[CONFIG_IFACE_NUMBER];/*IFACE_ID_MAX*/
 	u8 iface_nums; /* total number of ifaces used runtime */
 	struct mi_state iface_state;
+	unsigned long fwstate_ifbmp[MI_FWSTATE_BIT_NUM]; /* by fw_state bit, bit i for padapters[i], each iface sets/clears only its own bit atomically */
 
 #ifdef CONFIG_AP_MODE
 	u8 nr_ap_if; /* total interface s number of ap/go mode. */
@@ -1329,6 +1334,9 @@ struct _ADAPTER {
 
 #ifdef CONFIG_RTW_80211K
 	struct	rm_priv		rmpriv;
+#endif
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+	struct rtw_lstats_priv lstats;
 #endif
 	/* struct	io_queue	*pio_queue; */
 	struct	io_priv	iopriv;
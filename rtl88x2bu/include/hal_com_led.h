@@ -118,6 +118,14 @@ typedef enum _LED_CTL_MODE {
 	LED_CTL_CONNECTION_NO_TRANSFER = 18,
 } LED_CTL_MODE;
 
+/* hardware LED modes, same values as mode of rtw_halmac_led_cfg() */
+enum led_hw_mode {
+	LED_HW_MODE_TRX = 0,
+	LED_HW_MODE_TX = 1,
+	LED_HW_MODE_RX = 2,
+	LED_HW_MODE_SW = 3,
+};
+
 typedef	enum _LED_STATE {
 	LED_UNKNOWN = 0,
 	RTW_LED_ON = 1,
@@ -154,6 +162,7 @@ typedef enum _LED_PIN {
 	LED_PIN_LED1,
 	LED_PIN_LED2
 } LED_PIN;
+#define LED_PIN_NUM	4
 
 
 /* ********************************************************************************
@@ -269,6 +278,8 @@ typedef struct _LED_USB {
 	_timer				BlinkTimer; /* Timer object for led blinking. */
 
 	_workitem			BlinkWorkItem; /* Workitem used by BlinkTimer to manipulate H/W to blink LED.' */
+
+	systime				hw_blink_hold; /* hardware blinking is kept until this time */
 } LED_USB, *PLED_USB;
 
 typedef struct _LED_USB	LED_DATA, *PLED_DATA;
@@ -356,6 +367,21 @@ struct led_priv {
 	void (*LedControlHandler)(_adapter *padapter, LED_CTL_MODE LedAction);
 	void (*SwLedOn)(_adapter *padapter, PLED_DATA pLed);
 	void (*SwLedOff)(_adapter *padapter, PLED_DATA pLed);
+	/* switch pin to hardware blink mode, LED_HW_MODE_SW gives it back to SwLedOn/SwLedOff, _FAIL if pin can't */
+	u8 (*SwLedHwBlink)(_adapter *padapter, PLED_DATA pLed, u8 mode);
+	/* physical pin driven by pLed, NULL if every LedPin is a pin of its own */
+	u8 (*SwLedPhyPin)(PLED_DATA pLed);
+
+	/* state of the physical pins, several LEDs may share one */
+	u8 pin_io_state[LED_PIN_NUM]; /* RTW_LED_ON/RTW_LED_OFF last written, LED_UNKNOWN if not known */
+	PLED_DATA pin_hw_blink[LED_PIN_NUM]; /* LED the hardware blinks the pin for, NULL if SW driven */
+	u8 pin_hw_mode[LED_PIN_NUM];
+
+	u32 io_cnt; /* LED register writes */
+	u32 io_skip_cnt; /* toggles not written: pin already in state or blinked by hardware */
+	u32 hw_blink_cnt;
+	systime io_rate_time;
+	u32 io_rate_cnt;
 #endif
 };
 
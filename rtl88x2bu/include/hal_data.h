@@ -319,6 +319,27 @@ struct txpwr_lmt_ent {
 
 	char regd_name[0];
 };
+
+/*
+* txpwr limit of rf_ctl_t.regd_name compiled from txpwr_lmt_list
+* with the WW (minimum) limit already resolved, read under RCU
+*/
+struct txpwr_lmt_tbl {
+	rtw_rcu_head rcu;
+	const char *regd_name;
+
+	s8 lmt_2g[MAX_2_4G_BANDWIDTH_NUM]
+		[TXPWR_LMT_RS_NUM_2G]
+		[CENTER_CH_2G_NUM]
+		[MAX_TX_COUNT];
+
+#ifdef CONFIG_IEEE80211_BAND_5GHZ
+	s8 lmt_5g[MAX_5G_BANDWIDTH_NUM]
+		[TXPWR_LMT_RS_NUM_5G]
+		[CENTER_CH_5G_ALL_NUM]
+		[MAX_TX_COUNT];
+#endif
+};
 #endif /* CONFIG_TXPWR_LIMIT */
 
 typedef struct hal_com_data {
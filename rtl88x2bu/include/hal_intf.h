@@ -372,6 +372,7 @@ struct hal_ops {
 	void (*sreset_init_value)(_adapter *padapter);
 	void (*sreset_reset_value)(_adapter *padapter);
 	void (*silentreset)(_adapter *padapter);
+	u8 (*sreset_mac_reinit)(_adapter *padapter);
 	void (*sreset_xmit_status_check)(_adapter *padapter);
 	void (*sreset_linked_status_check)(_adapter *padapter);
 	u8(*sreset_get_wifi_status)(_adapter *padapter);
@@ -704,6 +705,7 @@ void	rtw_hal_get_tx_power_level(_adapter *padapter, s32 *powerlevel);
 void rtw_hal_sreset_init(_adapter *padapter);
 void rtw_hal_sreset_reset(_adapter *padapter);
 void rtw_hal_sreset_reset_value(_adapter *padapter);
+u8   rtw_hal_sreset_mac_reinit(_adapter *padapter);
 void rtw_hal_sreset_xmit_status_check(_adapter *padapter);
 void rtw_hal_sreset_linked_status_check(_adapter *padapter);
 u8   rtw_hal_sreset_get_wifi_status(_adapter *padapter);
@@ -30,6 +30,13 @@
 #define SU_SOUNDING_TIMEOUT	5	/* unit: ms */
 #define MU_SOUNDING_TIMEOUT	8	/* unit: ms */
 
+/* Adaptive sounding scheduler */
+#define BF_SOUND_PERIOD_MIN	20	/* unit: ms, busy or moving BFee */
+#define BF_SOUND_PERIOD_DEF	40	/* unit: ms, before any traffic statistic */
+#define BF_SOUND_PERIOD_MAX	200	/* unit: ms, static BFee with little traffic */
+#define BF_SCHED_PRIO_MAX	400
+#define BF_SCHED_TOP_N_DEF	MAX_NUM_BEAMFORMEE_SU
+
 #define GET_BEAMFORM_INFO(adapter)	(&GET_HAL_DATA(adapter)->beamforming_info)
 #define GetInitSoundCnt(_SoundPeriod, _MinSoundPeriod)	((_SoundPeriod)/(_MinSoundPeriod))
 
@@ -119,6 +126,19 @@ struct beamformee_entry {
 	systime tx_timestamp;
 	u64 tx_bytes;
 
+	/* adaptive sounding scheduler, updated by rtw_bf_update_traffic() */
+	u8 sched_idle;		/* no traffic since last update, not sounded */
+	u16 sched_tp;		/* Mbps */
+	u8 sched_last_rate;
+	u16 sched_rate_drift;	/* EWMA of tx rate index change, x16 */
+	u16 sched_rssi_avg;	/* EWMA of RSSI, x16 */
+	u16 sched_rssi_var;	/* EWMA of squared RSSI deviation */
+	u16 sched_prio;		/* 0 ~ BF_SCHED_PRIO_MAX */
+	systime last_sound_time;
+	u32 sound_interval;	/* ms between the last two soundings */
+	u32 sound_cnt;
+	u64 sound_airtime;	/* us, estimated */
+
 	u16 LogStatusFailCnt:5;	/* 0~21 */
 	u16 DefaultCSICnt:5; /* 0~21 */
 	u8 CSIMatrix[327];
@@ -233,6 +253,11 @@ struct beamforming_info {
 
 	/* For debug */
 	s8 sounding_running;
+
+	/* max BFees picked per sounding period, by priority */
+	u8 sched_top_n;
+	u32 sched_defer_cnt;
+	u64 sound_airtime;	/* us, estimated */
 };
 
 enum beamforming_cap rtw_bf_bfee_get_entry_cap_by_macid(void *mlmepriv, u8 mac_id);
@@ -248,6 +273,9 @@ u8 rtw_bf_cmd(PADAPTER, s32 type, u8 *pbuf, s32 size, u8 enqueue);
 void rtw_bf_update_attrib(PADAPTER, struct pkt_attrib *, struct sta_info *);
 void rtw_bf_c2h_handler(PADAPTER, u8 id, u8 *buf, u8 buf_len);
 void rtw_bf_update_traffic(PADAPTER);
+void rtw_bf_dump_sched(void *sel, PADAPTER);
+void rtw_bf_set_sched_top_n(PADAPTER, u8 top_n);
+void rtw_bf_sched_sim(void *sel, u32 rounds);
 
 /* Compatible with old function name, only for using outside rtw_beamforming.c */
 #define beamforming_get_entry_beam_cap_by_mac_id	rtw_bf_bfee_get_entry_cap_by_macid
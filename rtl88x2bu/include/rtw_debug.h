@@ -281,6 +281,9 @@ void dump_sec_cam_ent_title(void *sel, u8 has_id);
 void dump_sec_cam(void *sel, _adapter *adapter);
 void dump_sec_cam_cache(void *sel, _adapter *adapter);
 
+void rtw_selftest_chk(void *sel, const char *name, u8 ok, u32 *fail_cnt);
+void rtw_selftest_result(void *sel, u32 fail_cnt);
+
 #ifdef CONFIG_PROC_DEBUG
 ssize_t proc_set_write_reg(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 int proc_get_read_reg(struct seq_file *m, void *v);
@@ -295,6 +298,8 @@ ssize_t proc_set_roam_flags(struct file *file, const char __user *buffer, size_t
 int proc_get_roam_param(struct seq_file *m, void *v);
 ssize_t proc_set_roam_param(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 ssize_t proc_set_roam_tgt_addr(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+int proc_get_roam_pred(struct seq_file *m, void *v);
+ssize_t proc_set_roam_pred(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 #endif /* CONFIG_LAYER2_ROAMING */
 #ifdef CONFIG_RTW_80211R
 int proc_get_ft_flags(struct seq_file *m, void *v);
@@ -337,6 +342,10 @@ ssize_t proc_set_rx_cnt_dump(struct file *file, const char __user *buffer, size_
 int proc_get_bmc_tx_rate(struct seq_file *m, void *v);
 ssize_t proc_set_bmc_tx_rate(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 #endif /*CONFIG_AP_MODE*/
+#if defined(CONFIG_AP_MODE) && defined(CONFIG_NATIVEAP_MLME)
+int proc_get_probersp(struct seq_file *m, void *v);
+ssize_t proc_set_probersp(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+#endif
 
 int proc_get_ps_dbg_info(struct seq_file *m, void *v);
 ssize_t proc_set_ps_dbg_info(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
@@ -404,6 +413,10 @@ ssize_t proc_set_ldpc_cap(struct file *file, const char __user *buffer, size_t c
 #ifdef CONFIG_BEAMFORMING
 int proc_get_txbf_cap(struct seq_file *m, void *v);
 ssize_t proc_set_txbf_cap(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+#ifdef RTW_BEAMFORMING_VERSION_2
+int proc_get_bf_sched(struct seq_file *m, void *v);
+ssize_t proc_set_bf_sched(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+#endif
 #endif
 int proc_get_rx_ampdu_factor(struct seq_file *m, void *v);
 ssize_t proc_set_rx_ampdu_factor(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
@@ -447,6 +460,8 @@ ssize_t proc_set_rf4ce_state(struct file *file, const char __user *buffer, size_
 #if defined(DBG_CONFIG_ERROR_DETECT)
 int proc_get_sreset(struct seq_file *m, void *v);
 ssize_t proc_set_sreset(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+int proc_get_sreset_tier(struct seq_file *m, void *v);
+ssize_t proc_set_sreset_tier(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 #endif /* DBG_CONFIG_ERROR_DETECT */
 
 int proc_get_odm_adaptivity(struct seq_file *m, void *v);
@@ -503,6 +518,9 @@ ssize_t proc_set_wmmps_info(struct file *file, const char __user *buffer, size_t
 int proc_get_tdls_enable(struct seq_file *m, void *v);
 ssize_t proc_set_tdls_enable(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 int proc_get_tdls_info(struct seq_file *m, void *v);
+int proc_get_tdls_auto(struct seq_file *m, void *v);
+ssize_t proc_set_tdls_auto(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+int proc_get_tdls_auto_test(struct seq_file *m, void *v);
 #endif
 
 int proc_get_monitor(struct seq_file *m, void *v);
@@ -515,8 +533,14 @@ ssize_t proc_set_xmit_block(struct file *file, const char __user *buffer, size_t
 
 #ifdef CONFIG_PREALLOC_RX_SKB_BUFFER
 int proc_get_rtkm_info(struct seq_file *m, void *v);
+ssize_t proc_set_rtkm_info(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 #endif /* CONFIG_PREALLOC_RX_SKB_BUFFER */
 
+#ifdef CONFIG_RTW_80211K
+int proc_get_rm_bcn_cache(struct seq_file *m, void *v);
+ssize_t proc_set_rm_bcn_cache(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+#endif
+
 #ifdef CONFIG_IEEE80211W
 ssize_t proc_set_tx_sa_query(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 int proc_get_tx_sa_query(struct seq_file *m, void *v);
@@ -25,12 +25,36 @@
 	#define MAX_RTKM_RECVBUF_SZ (15360) /* 15k */
 #endif /* CONFIG_PLATFORM_MSTAR_HIGH */
 #define MAX_RTKM_NR_PREALLOC_RECV_SKB 16
+#define MAX_RTKM_NR_PREALLOC_RECV_SKB_MAX 64
+
+struct rtkm_stats {
+	u32 target;
+	u32 max;
+	u32 total;
+	u32 free;
+	u32 lent;
+	u32 in_use_max;
+
+	u32 alloc_cnt;
+	u32 alloc_fail_cnt;
+	u32 pcpu_hit_cnt;
+	u32 free_cnt;
+	u32 free_reject_cnt;
+	u32 adopt_cnt;
+	u32 refill_cnt;
+	u32 refill_skb_cnt;
+	u32 refill_fail_cnt;
+	u32 shrink_cnt;
+	u32 shrink_skb_cnt;
+};
 
 u16 rtw_rtkm_get_buff_size(void);
 u8 rtw_rtkm_get_nr_recv_skb(void);
 struct u8 *rtw_alloc_revcbuf_premem(void);
 struct sk_buff *rtw_alloc_skb_premem(u16 in_size);
 int rtw_free_skb_premem(struct sk_buff *pskb);
+void rtw_rtkm_get_stats(struct rtkm_stats *stats);
+int rtw_rtkm_stress(u32 round, u32 burst, u32 *alloc_fail);
 
 
 #endif /* __RTW_MEM_H__ */
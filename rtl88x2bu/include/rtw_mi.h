@@ -188,6 +188,11 @@ u8 rtw_mi_buddy_busy_traffic_check(_adapter *padapter, bool check_sc_interval);
 u8 rtw_mi_check_mlmeinfo_state(_adapter *padapter, u32 state);
 u8 rtw_mi_buddy_check_mlmeinfo_state(_adapter *padapter, u32 state);
 
+#define MI_FWSTATE_BIT_NUM	32
+
+/*#define DBG_MI_FWSTATE_IFBMP*/	/* cross check fwstate_ifbmp with full iface scan */
+
+u8 rtw_mi_get_fwstate_ifbmp(_adapter *adapter, sint state);
 u8 rtw_mi_check_fwstate(_adapter *padapter, sint state);
 u8 rtw_mi_buddy_check_fwstate(_adapter *padapter, sint state);
 enum {
@@ -481,6 +481,51 @@ struct tdls_ch_switch {
 };
 #endif
 
+#define TDLS_AUTO_PEER_NUM	8
+
+enum tdls_auto_state {
+	TDLS_AUTO_IDLE = 0,
+	TDLS_AUTO_DISCOVER,	/* discovery request sent, wait for response */
+	TDLS_AUTO_SETUP,	/* setup request sent, wait for link */
+	TDLS_AUTO_LINKED,
+	TDLS_AUTO_BACKOFF,	/* failed or torn down by RSSI, hold off retry */
+	TDLS_AUTO_NORSP,	/* never answers discovery, TX to it not counted */
+};
+
+/* per destination TX rate tracking of peers behind the same BSSID */
+struct tdls_auto_peer {
+	u8 addr[ETH_ALEN];
+	u8 used;
+	u8 state;
+	u8 state_cnt;		/* watchdog periods in current state */
+	u8 busy_cnt;
+	u8 idle_cnt;
+	u8 no_rsp_cnt;		/* discovery requests in a row without response */
+	u32 tx_bytes;		/* bytes in current watchdog period */
+	u32 tx_kbps;
+	u64 total_bytes;
+
+	u32 discover_cnt;
+	u32 setup_cnt;
+	u32 link_cnt;
+	u32 fail_cnt;
+	u32 teardown_idle_cnt;
+	u32 teardown_rssi_cnt;
+};
+
+struct tdls_auto_ctl {
+	_lock lock;
+	u8 enable;
+	u32 setup_kbps;		/* TX rate to start setup */
+	u8 setup_period;	/* in watchdog periods */
+	u32 teardown_kbps;	/* TX rate under which link is idle */
+	u8 teardown_period;	/* in watchdog periods */
+	u8 rssi_margin;		/* direct link RSSI below AP RSSI allowed */
+	u8 backoff_period;	/* in watchdog periods */
+	systime last_time;
+	struct tdls_auto_peer peer[TDLS_AUTO_PEER_NUM];
+};
+
 struct tdls_info {
 	u8					ap_prohibited;
 	u8					ch_switch_prohibited;
@@ -507,6 +552,7 @@ struct tdls_info {
 #endif
 
 	struct submit_ctx	*tdls_sctx;
+	struct tdls_auto_ctl	auto_ctl;
 };
 
 struct tdls_txmgmt {
@@ -744,6 +790,74 @@ struct roam_nb_info {
 #endif	/* defined(CONFIG_RTW_WNM) || defined(CONFIG_RTW_80211K) */
 #endif
 
+#ifdef CONFIG_LAYER2_ROAMING
+#define RTW_ROAM_PRED_TICK_MS	2000	/* linked_status_chk period */
+#define RTW_ROAM_PRED_LEAD_MS	4000	/* < RTW_ROAM_SCAN_RESULT_EXP_MS */
+#define RTW_ROAM_CAND_NUM	4
+
+struct roam_cand {
+	u8 addr[ETH_ALEN];
+	u8 ch;
+	s8 rssi;
+};
+
+/* beacon rssi trend, fed once per linked_status_chk */
+struct roam_pred_info {
+	s32 ewma;		/* signal_strength avg_val EWMA, Q4 */
+	s32 slope;		/* smoothed per-tick EWMA delta, Q4 */
+	u8 samples;
+	u32 lead_ms;		/* bg scan when crossing is this close, 0: off */
+	systime bg_scan_time;
+
+	/* ranked on every scan done while linked */
+	struct roam_cand cand[RTW_ROAM_CAND_NUM];
+	u8 cand_num;
+	systime cand_time;
+
+	systime cross_time;	/* first tick below threshold, 0: above */
+	systime kick_time;	/* roam started, 0: none in progress */
+	u32 bg_scan_cnt;
+	u32 roam_cnt;
+	u32 warm_roam_cnt;	/* roamed on crossing without a new scan */
+	u32 roam_fail_cnt;
+	u32 ttr_ms_last;	/* threshold crossing to link up */
+	u32 ttr_ms_max;
+	u32 gap_ms_last;	/* roam start to link up, no data path */
+	u32 gap_ms_max;
+};
+#endif /* CONFIG_LAYER2_ROAMING */
+
+#if defined(CONFIG_AP_MODE) && defined(CONFIG_NATIVEAP_MLME)
+#define RTW_PROBERSP_DEDUP_NUM	16
+#define RTW_PROBERSP_DEDUP_MS	30	/* wildcard probes from one SA within this get one reply */
+
+struct probersp_dedup_ent {
+	u8 addr[ETH_ALEN];
+	systime time;
+};
+
+/*
+* AP probe response body (fixed fields + IEs), protected by bcn_update_lock.
+* Rebuilt only when the beacon IE set, operating channel or the probe
+* response specific IEs change, copied as is for every other request.
+*/
+struct probersp_tmpl_info {
+	u8 *body;
+	u32 body_len;
+	u32 ielen;	/* cur_network IELength body was built from */
+	u8 ch;		/* cur_network DSConfig body was built from */
+
+	struct probersp_dedup_ent dedup[RTW_PROBERSP_DEDUP_NUM];
+	u8 dedup_idx;
+	u32 dedup_ms;	/* 0: off */
+
+	u32 rsp_cnt;
+	u32 hit_cnt;
+	u32 build_cnt;
+	u32 dedup_cnt;
+};
+#endif /* defined(CONFIG_AP_MODE) && defined(CONFIG_NATIVEAP_MLME) */
+
 struct mlme_priv {
 
 	_lock	lock;
@@ -759,6 +873,7 @@ struct mlme_priv {
 	u8 roam_tgt_addr[ETH_ALEN]; /* request to roam to speicific target without other consideration */
 	u8 roam_rssi_threshold;
 	bool need_to_roam;
+	struct roam_pred_info roam_pred;
 #endif
 
 	u8	*nic_hdl;
@@ -937,6 +1052,8 @@ struct mlme_priv {
 	_lock	bcn_update_lock;
 	u8		update_bcn;
 
+	struct probersp_tmpl_info probersp;
+
 	u8 ori_ch;
 	u8 ori_bw;
 	u8 ori_offset;
@@ -1030,6 +1147,7 @@ struct mlme_priv {
 #define RTW_AUTO_SCAN_REASON_ACS				BIT1
 #define RTW_AUTO_SCAN_REASON_ROAM				BIT2
 #define RTW_AUTO_SCAN_REASON_MESH_OFFCH_CAND	BIT3
+#define RTW_AUTO_SCAN_REASON_ROAM_PRED			BIT4
 
 void rtw_mlme_reset_auto_scan_int(_adapter *adapter, u8 *reason);
 
@@ -1300,6 +1418,14 @@ void rtw_set_to_roam(_adapter *adapter, u8 to_roam);
 u8 rtw_dec_to_roam(_adapter *adapter);
 u8 rtw_to_roam(_adapter *adapter);
 int rtw_select_roaming_candidate(struct mlme_priv *pmlmepriv);
+void rtw_roam_kick(_adapter *adapter);
+void rtw_roam_pred_tick(_adapter *adapter, u8 rssi);
+u8 rtw_roam_pred_warm_roam(_adapter *adapter);
+void rtw_roam_pred_rank(_adapter *adapter);
+void rtw_roam_pred_link_chg(_adapter *adapter, u8 connected);
+void rtw_roam_pred_dump(void *sel, _adapter *adapter);
+void rtw_roam_pred_replay(void *sel, _adapter *adapter, const u8 *rssi, u8 num);
+void rtw_roam_pred_test(void *sel);
 #else
 #define rtw_roam_flags(adapter) 0
 #define rtw_chk_roam_flags(adapter, flags) 0
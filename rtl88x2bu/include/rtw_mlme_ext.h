@@ -492,6 +492,16 @@ typedef struct _RT_CHANNEL_INFO {
 #endif /* CONFIG_RTW_MESH */
 } RT_CHANNEL_INFO, *PRT_CHANNEL_INFO;
 
+#define CHSET_MAP_CH_NUM	178	/* ch 0~177 */
+#define CHSET_MAP_BMP_SZ	((CHSET_MAP_CH_NUM + 7) / 8)
+
+/* per channel index and flags of channel_set, rebuilt with channel_set */
+struct chset_map {
+	u8 idx[CHSET_MAP_CH_NUM];		/* channel_set idx + 1, 0: not in channel_set */
+	u8 passive_bmp[CHSET_MAP_BMP_SZ];	/* ScanType == SCAN_PASSIVE */
+	u8 dfs_bmp[CHSET_MAP_BMP_SZ];
+};
+
 #define DFS_MASTER_TIMER_MS 100
 #define CAC_TIME_MS (60*1000)
 #define CAC_TIME_CE_MS (10*60*1000)
@@ -504,6 +514,86 @@ void rtw_rfctl_init(_adapter *adapter);
 void rtw_rfctl_deinit(_adapter *adapter);
 
 #ifdef CONFIG_DFS_MASTER
+#define RADAR_EVT_RING_NUM	32
+#define RADAR_EVT_REGION_NUM	4	/* by PHYDM_DFS_DOMAIN_XXX */
+#define RADAR_EVT_PULSE_HIST	3	/* phydm decides on pulse flag of 2 polls before */
+#define RADAR_EVT_IDLE_MS	1000
+#define RADAR_EVT_REPLAY_MAX	64
+
+#define RADAR_EVT_F_TRI_SHORT	BIT0
+#define RADAR_EVT_F_TRI_LONG	BIT1
+#define RADAR_EVT_F_LONG_FILTERED	BIT2
+#define RADAR_EVT_F_FA_MASKED	BIT3
+#define RADAR_EVT_F_HIST_MASKED	BIT4
+#define RADAR_EVT_F_DETECTED	BIT5
+
+enum radar_evt_result {
+	RADAR_EVT_NONE = 0,	/* no pulse trigger */
+	RADAR_EVT_RAW,		/* pulse trigger, not decided by phydm yet */
+	RADAR_EVT_PENDING,	/* candidate, waiting for more within window */
+	RADAR_EVT_CONFIRMED,
+	RADAR_EVT_REJ_MASK,	/* masked by FA or mask history */
+	RADAR_EVT_REJ_REGION,	/* pulse type not applicable to region */
+	RADAR_EVT_REJ_PULSE,	/* pulse count below region pattern */
+};
+
+struct radar_evt {
+	systime time;
+	u16 short_pulse;
+	u16 long_pulse;
+	u16 fa;
+	u8 ch;
+	u8 bw;
+	u8 offset;
+	u8 region;
+	u8 flags;
+	u8 result;
+};
+
+/* per region pattern checked before radar detected by phydm is confirmed */
+struct radar_pattern {
+	u16 min_short_pulse;	/* over RADAR_EVT_PULSE_HIST polls, 0: no check */
+	u16 min_long_pulse;	/* over RADAR_EVT_PULSE_HIST polls, 0: no check */
+	u8 confirm_num;		/* candidates needed within window_ms */
+	u16 window_ms;
+};
+
+struct radar_cls_state {
+	u16 short_hist[RADAR_EVT_PULSE_HIST];
+	u16 long_hist[RADAR_EVT_PULSE_HIST];
+	u8 hist_idx;
+	u8 cand_num;
+	u32 first_cand_ms;
+	bool trig_active;
+	u32 first_trig_ms;
+	u32 last_trig_ms;
+	u32 delay_ms;		/* first pulse trigger to last confirm */
+};
+
+struct radar_replay_rst {
+	u8 region;
+	u16 sample_num;
+	int truth_idx;		/* -1: no radar in trace */
+	u16 confirm_num;
+	u16 false_alarm;
+	int delay_ms;		/* -1: missed */
+};
+
+struct radar_evt_ctl {
+	struct radar_evt ring[RADAR_EVT_RING_NUM];
+	u8 ring_idx;
+	u8 ring_num;
+	struct radar_pattern pattern[RADAR_EVT_REGION_NUM];
+	struct radar_cls_state cls;
+
+	u32 poll_cnt;
+	u32 trig_cnt;
+	u32 confirm_cnt;
+	u32 reject_cnt;
+
+	struct radar_replay_rst replay;
+};
+
 struct rf_ctl_t;
 #define CH_IS_NON_OCP(rt_ch_info) (rtw_time_after((rt_ch_info)->non_ocp_end_time, rtw_get_current_time()))
 bool rtw_is_cac_reset_needed(_adapter *adapter, u8 ch, u8 bw, u8 offset);
@@ -516,6 +606,12 @@ void rtw_chset_update_non_ocp_ms(RT_CHANNEL_INFO *ch_set, u8 ch, u8 bw, u8 offse
 u32 rtw_get_ch_waiting_ms(_adapter *adapter, u8 ch, u8 bw, u8 offset, u32 *r_non_ocp_ms, u32 *r_cac_ms);
 void rtw_reset_cac(_adapter *adapter, u8 ch, u8 bw, u8 offset);
 u32 rtw_force_stop_cac(_adapter *adapter, u32 timeout_ms);
+
+void rtw_radar_evt_init(struct radar_evt_ctl *ctl);
+u8 rtw_radar_evt_classify(const struct radar_pattern *pattern, struct radar_cls_state *cls, struct radar_evt *evt, u32 now_ms);
+bool rtw_radar_evt_poll(_adapter *adapter);
+void rtw_radar_evt_replay(struct radar_evt_ctl *ctl, u8 region, int truth_idx, struct radar_evt *trace, u16 num);
+void dump_radar_evt(void *sel, struct rf_ctl_t *rfctl);
 #else
 #define CH_IS_NON_OCP(rt_ch_info) 0
 #define rtw_chset_is_ch_non_ocp(ch_set, ch, bw, offset) _FALSE
@@ -544,6 +640,13 @@ void dump_chset(void *sel, RT_CHANNEL_INFO *ch_set);
 void dump_cur_chset(void *sel, _adapter *adapter);
 
 int rtw_chset_search_ch(RT_CHANNEL_INFO *ch_set, const u32 ch);
+void rtw_chset_map_build(struct chset_map *map, RT_CHANNEL_INFO *ch_set);
+int rtw_chset_map_search_ch(struct chset_map *map, const u32 ch);
+bool rtw_chset_map_is_passive(struct chset_map *map, const u32 ch);
+bool rtw_chset_map_is_dfs(struct chset_map *map, const u32 ch);
+void rtw_chset_map_set_active(struct chset_map *map, RT_CHANNEL_INFO *ch_set, const u32 ch);
+void rtw_chset_map_test(void *sel, _adapter *adapter);
+#define rtw_rfctl_search_ch(rfctl, ch) rtw_chset_map_search_ch(&(rfctl)->ch_map, (ch))
 u8 rtw_chset_is_chbw_valid(RT_CHANNEL_INFO *ch_set, u8 ch, u8 bw, u8 offset);
 void rtw_chset_sync_chbw(RT_CHANNEL_INFO *ch_set, u8 *req_ch, u8 *req_bw, u8 *req_offset
 	, u8 *g_ch, u8 *g_bw, u8 *g_offset);
@@ -939,6 +1042,17 @@ void issue_p2p_invitation_request(_adapter *padapter, u8 *raddr);
 #endif /* CONFIG_P2P */
 void issue_beacon(_adapter *padapter, int timeout_ms);
 void issue_probersp(_adapter *padapter, unsigned char *da, u8 is_valid_p2p_probereq);
+#if defined(CONFIG_AP_MODE) && defined(CONFIG_NATIVEAP_MLME)
+void rtw_probersp_tmpl_clear(_adapter *adapter);
+void rtw_probersp_tmpl_invalidate(_adapter *adapter);
+bool rtw_probersp_dedup_chk(_adapter *adapter, const u8 *sa);
+void rtw_probersp_dump(void *sel, _adapter *adapter);
+void rtw_probersp_bench(void *sel, _adapter *adapter, u32 num);
+#else
+#define rtw_probersp_tmpl_clear(adapter) do {} while (0)
+#define rtw_probersp_tmpl_invalidate(adapter) do {} while (0)
+#define rtw_probersp_dedup_chk(adapter, sa) _FALSE
+#endif
 void _issue_assocreq(_adapter *padapter, u8 is_assoc);
 void issue_assocreq(_adapter *padapter);
 void issue_reassocreq(_adapter *padapter);
@@ -78,6 +78,8 @@ void rtw_odm_adaptivity_config_msg(void *sel, _adapter *adapter);
 bool rtw_odm_adaptivity_needed(_adapter *adapter);
 void rtw_odm_adaptivity_parm_msg(void *sel, _adapter *adapter);
 void rtw_odm_adaptivity_parm_set(_adapter *adapter, s8 th_l2h_ini, s8 th_edcca_hl_diff, s8 th_l2h_ini_mode2, s8 th_edcca_hl_diff_mode2, u8 edcca_enable);
+void rtw_odm_watchdog_io_msg(void *sel, _adapter *adapter);
+void rtw_odm_watchdog_io_set(_adapter *adapter, u8 fa_snapshot_en);
 void rtw_odm_get_perpkt_rssi(void *sel, _adapter *adapter);
 void rtw_odm_acquirespinlock(_adapter *adapter,	enum rt_spinlock_type type);
 void rtw_odm_releasespinlock(_adapter *adapter,	enum rt_spinlock_type type);
@@ -89,6 +91,7 @@ VOID rtw_odm_radar_detect_reset(_adapter *adapter);
 VOID rtw_odm_radar_detect_disable(_adapter *adapter);
 VOID rtw_odm_radar_detect_enable(_adapter *adapter);
 BOOLEAN rtw_odm_radar_detect(_adapter *adapter);
+void rtw_odm_radar_detect_get_evt(_adapter *adapter, struct radar_evt *evt);
 #endif /* CONFIG_DFS_MASTER */
 
 void rtw_odm_parse_rx_phy_status_chinfo(union recv_frame *rframe, u8 *phys);
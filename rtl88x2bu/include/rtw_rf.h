@@ -228,6 +228,10 @@ void rtw_txpwr_lmt_add(struct rf_ctl_t *rfctl, const char *regd_name
 struct txpwr_lmt_ent *_rtw_txpwr_lmt_get_by_name(struct rf_ctl_t *rfctl, const char *regd_name);
 struct txpwr_lmt_ent *rtw_txpwr_lmt_get_by_name(struct rf_ctl_t *rfctl, const char *regd_name);
 void rtw_txpwr_lmt_list_free(struct rf_ctl_t *rfctl);
+s8 _rtw_txpwr_lmt_get_from_list(struct rf_ctl_t *rfctl, const char *regd_name
+	, u8 band, u8 bw, u8 tlrs, u8 ntx_idx, u8 ch_idx);
+void _rtw_txpwr_lmt_tbl_build(struct rf_ctl_t *rfctl);
+void dump_txpwr_lmt_tbl_chk(void *sel, _adapter *adapter);
 #endif /* CONFIG_TXPWR_LIMIT */
 
 #define BB_GAIN_2G 0
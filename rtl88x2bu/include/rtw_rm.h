@@ -57,6 +57,13 @@ struct rm_clock {
 	enum RM_EV_ID evid;
 };
 
+/* what a site survey dwell on one channel could have collected */
+struct rm_ch_dwell {
+	systime time;
+	u8 active;		/* probe requests were sent */
+	NDIS_802_11_SSID ssid;	/* specific SSID probed, len 0 for wildcard only */
+};
+
 struct rm_priv {
 	u8 enable;
 	_queue ev_queue;
@@ -69,6 +76,17 @@ struct rm_priv {
 
 	/* rm debug */
 	void *prm_sel;
+
+	/* beacon report served from scanned_queue */
+	u32 bcn_cache_fresh_ms;			/* 0: always scan */
+	struct rm_ch_dwell ch_dwell[MAX_CHANNEL_NUM];	/* last dwell, chset idx */
+	u32 bcn_rep_cnt;
+	u32 bcn_rep_cached_cnt;			/* no off-channel scan at all */
+	u32 bcn_ch_cached_cnt;
+	u32 bcn_ch_scanned_cnt;
+	u32 bcn_lat_ms_last;
+	u32 bcn_lat_ms_max;
+	u64 bcn_lat_ms_sum;
 };
 
 int rtw_init_rm(_adapter *padapter);
@@ -84,5 +102,10 @@ void rm_handler(_adapter *padapter, struct rm_event *pev);
 
 u8 rm_add_nb_req(_adapter *padapter, struct sta_info *psta);
 
+void rm_scan_ch_done(_adapter *padapter, struct rtw_ieee80211_channel *ch);
+void rm_bcn_cache_flush(_adapter *padapter);
+void rm_dump_bcn_cache(void *sel, _adapter *padapter);
+void rm_set_bcn_cache_fresh_ms(_adapter *padapter, u32 ms);
+
 #endif /*CONFIG_RTW_80211K */
 #endif /* __RTW_RM_H_ */
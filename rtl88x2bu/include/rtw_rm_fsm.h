@@ -35,6 +35,7 @@
 #define RM_SCAN_DENY_TIMES	10
 #define RM_BUSY_TRAFFIC_TIMES	10
 #define RM_WAIT_BUSY_TIMEOUT	1000	/*  1 seconds */
+#define RM_BCN_CACHE_FRESH_MS	10000	/* 10 seconds, < SCANQUEUE_LIFETIME */
 
 #define MEAS_REQ_MOD_PARALLEL	BIT(0)
 #define MEAS_REQ_MOD_ENABLE	BIT(1)
@@ -282,6 +283,8 @@ struct rm_obj {
 	/* meas report */
 	u64 meas_start_time;
 	u64 meas_end_time;
+	systime meas_req_time;	/* entered DO_MEAS, for report latency */
+	u8 bcn_scan_ch_num;	/* channels not served from scan cache */
 	int wait_busy;
 	u8 poll_mode;
 
@@ -383,6 +386,7 @@ int issue_radio_meas_rep(struct rm_obj *prm);
 void rm_set_rep_mode(struct rm_obj *prm, u8 mode);
 
 int ready_for_scan(struct rm_obj *prm);
+u8 rm_bcn_cache_plan(struct rm_obj *prm, struct rtw_ieee80211_channel *pscan_ch);
 int rm_sitesurvey(struct rm_obj *prm);
 
 #endif /*CONFIG_RTW_80211K*/
@@ -24,6 +24,29 @@ enum {
 	SRESET_TGP_INFO = 99,
 };
 
+/* recovery tiers, tried from cheap to expensive */
+enum {
+	SRESET_TIER_LIGHT = 0,	/* flush TX/RX queues and DMA state */
+	SRESET_TIER_MEDIUM = 1,	/* MAC reset, firmware kept */
+	SRESET_TIER_FULL = 2,	/* power cycle and download firmware */
+	SRESET_TIER_NUM,
+};
+
+/* same hang within this window after a reset starts from the next tier */
+#define SRESET_REHANG_MS	10000
+/* time for DMA error flags to show up again after TRX restart */
+#define SRESET_SETTLE_MS	50
+
+struct sreset_tier_stat {
+	u32 try_cnt;
+	u32 ok_cnt;
+	u32 last_ms;
+	u32 max_ms;
+	u32 total_ms;
+};
+
+struct sreset_snapshot;
+
 struct sreset_priv {
 	_mutex	silentreset_mutex;
 	u8	silent_reset_inprogress;
@@ -42,6 +65,24 @@ struct sreset_priv {
 	u8 self_dect_case;
 	u16 last_mac_rxff_ptr;
 	u8 dbg_sreset_ctrl;
+
+	u8 cur_tier;
+	struct sreset_tier_stat tier_stat[SRESET_TIER_NUM];
+	struct sreset_snapshot *snap;
+
+	/* DMA status latched before it's cleared by the reset */
+	u32 hang_txdma_status;
+	u32 hang_rxdma_status;
+
+	/* last handled hang, for escalation of recurring ones */
+	u8 last_case;
+	u8 last_tier;
+	systime last_reset_time;
+	u32 rehang_cnt;
+
+	/* fault injection */
+	u8 dbg_force_tier;	/* first tier to try, SRESET_TIER_NUM for auto */
+	u8 dbg_fail_tier;	/* bitmap of tiers to be reported as failed */
 };
 
 
@@ -62,5 +103,7 @@ void sreset_set_wifi_error_status(_adapter *padapter, u32 status);
 void sreset_set_trigger_point(_adapter *padapter, s32 tgp);
 bool sreset_inprogress(_adapter *padapter);
 void sreset_reset(_adapter *padapter);
+void sreset_dump_tier_stat(void *sel, _adapter *padapter);
+void sreset_inject_fault(_adapter *padapter, u8 tier, u8 fail_tier);
 
 #endif
@@ -46,6 +46,19 @@
 #define	TDLS_HANDSHAKE_TIME			3000
 #define	TDLS_PTI_TIME				7000
 
+/* auto setup manager defaults, periods in units of 2 sec watchdog */
+#define	TDLS_AUTO_SETUP_KBPS			2000
+#define	TDLS_AUTO_SETUP_PERIOD			2
+#define	TDLS_AUTO_TEARDOWN_KBPS			100
+#define	TDLS_AUTO_TEARDOWN_PERIOD		5
+#define	TDLS_AUTO_RSSI_MARGIN			10
+#define	TDLS_AUTO_RSSI_HYST			5
+#define	TDLS_AUTO_BACKOFF_PERIOD		15
+#define	TDLS_AUTO_RSP_TIMEOUT			2
+#define	TDLS_AUTO_AGE_PERIOD			30
+#define	TDLS_AUTO_NO_RSP_MAX			3
+#define	TDLS_AUTO_NORSP_PERIOD			150
+
 #define TDLS_CH_SW_STAY_ON_BASE_CHNL_TIMEOUT	20		/* ms */
 #define TDLS_CH_SW_MONITOR_TIMEOUT				2000	/*ms */
 
@@ -180,6 +193,12 @@ void rtw_build_tunneled_probe_rsp_ies(_adapter *padapter, struct xmit_frame *pxm
 int rtw_tdls_is_driver_setup(_adapter *padapter);
 void rtw_tdls_set_key(_adapter *padapter, struct sta_info *ptdls_sta);
 const char *rtw_tdls_action_txt(enum TDLS_ACTION_FIELD action);
+
+void rtw_tdls_auto_tx_update(_adapter *padapter, u8 *da, u32 len);
+void rtw_tdls_auto_watchdog(_adapter *padapter);
+u8 rtw_tdls_auto_on_dis_rsp(_adapter *padapter, u8 *addr, int pwdb, int ap_rssi);
+void rtw_tdls_auto_dump(void *sel, _adapter *padapter);
+void rtw_tdls_auto_test(void *sel, _adapter *padapter);
 #endif /* CONFIG_TDLS */
 
 #endif
@@ -98,6 +98,12 @@ typedef struct  _RT_WAPI_KEY {
 	u8			keyId;
 	bool			bSet;
 	bool             bTxEnable;
+	/* SMS4 round keys, valid while dataKey/micKey equal the keys they were expanded from */
+	u8			rkDataKey[16];
+	u8			rkMicKey[16];
+	u32			dataKeyRk[32];
+	u32			micKeyRk[32];
+	bool			bRkValid;
 } RT_WAPI_KEY, *PRT_WAPI_KEY;
 
 typedef enum _RT_WAPI_PACKET_TYPE {
@@ -152,6 +158,8 @@ typedef struct _RT_WAPI_T {
 	struct list_head		wapiBKIDStoreList;
 	/* Key for Tx Multicast/Broadcast */
 	RT_WAPI_KEY		      wapiTxMsk;
+	/* round keys of all RT_WAPI_KEY, TX and RX paths refresh them concurrently */
+	_lock				rkLock;
 
 	/* sec related */
 	u8				lastTxMulticastPN[16];
@@ -219,6 +227,8 @@ u32	rtw_sms4_encrypt(_adapter *padapter, u8 *pxmitframe);
 
 u32	rtw_sms4_decrypt(_adapter *padapter, u8 *precvframe);
 
+void rtw_sms4_selftest(void *sel);
+
 void rtw_wapi_get_iv(_adapter *padapter, u8 *pRA, u8 *IV);
 
 u8 WapiIncreasePN(u8 *PN, u8 AddCount);
@@ -1282,7 +1282,7 @@ static int rtw_wx_set_freq(struct net_device *dev,
 		goto exit;
 	if (wrqu->freq.m <= 1000) {
 		if (wrqu->freq.flags == IW_FREQ_AUTO) {
-			if (rtw_chset_search_ch(adapter_to_chset(padapter), wrqu->freq.m) > 0) {
+			if (rtw_rfctl_search_ch(adapter_to_rfctl(padapter), wrqu->freq.m) > 0) {
 				padapter->mlmeextpriv.cur_channel = wrqu->freq.m;
 				RTW_INFO("%s: channel is auto, set to channel %d\n", __func__, wrqu->freq.m);
 			} else {
@@ -2218,7 +2218,7 @@ static int rtw_wx_get_scan(struct net_device *dev, struct iw_request_info *a,
 		pnetwork = LIST_CONTAINOR(plist, struct wlan_network, list);
 
 		/* report network only if the current channel set contains the channel to which this network belongs */
-		if (rtw_chset_search_ch(adapter_to_chset(padapter), pnetwork->network.Configuration.DSConfig) >= 0
+		if (rtw_rfctl_search_ch(adapter_to_rfctl(padapter), pnetwork->network.Configuration.DSConfig) >= 0
 		    && rtw_mlme_band_check(padapter, pnetwork->network.Configuration.DSConfig) == _TRUE
 		    && _TRUE == rtw_validate_ssid(&(pnetwork->network.Ssid))
 		   )
@@ -7568,6 +7568,7 @@ static int rtw_set_wps_probe_resp(struct net_device *dev, struct ieee_param *par
 		}
 		_rtw_memcpy(pmlmepriv->wps_probe_resp_ie, param->u.bcn_ie.buf, ie_len);
 	}
+	rtw_probersp_tmpl_invalidate(padapter);
 
 
 	return ret;
@@ -8419,6 +8420,7 @@ int rtw_vendor_ie_set(struct net_device *dev, struct iw_request_info *info, unio
 		RTW_INFO("[%s] Assoc Resp append vendor ie\n", __func__);
 
 	pmlmepriv->vendor_ie_mask[vendor_ie_num] = vendor_ie_mask;
+	rtw_probersp_tmpl_invalidate(padapter);
 
 	return ret;
 
@@ -2374,6 +2374,11 @@ u8 rtw_init_drv_sw(_adapter *padapter)
 	rtw_init_rm(padapter);
 #endif
 
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+	if (rtw_lstats_init(padapter) == _FAIL)
+		RTW_WARN("%s: lstats snapshot disabled\n", __func__);
+#endif
+
 exit:
 
 
@@ -2486,6 +2491,10 @@ u8 rtw_free_drv_sw(_adapter *padapter)
 	rtw_free_rm_priv(padapter);
 #endif
 
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+	rtw_lstats_deinit(padapter);
+#endif
+
 	rtw_free_cmd_priv(&padapter->cmdpriv);
 
 	rtw_free_evt_priv(&padapter->evtpriv);
@@ -1230,7 +1230,8 @@ static int rtw_cfgvendor_lstats_get_info(struct wiphy *wiphy,
 	output = rtw_malloc(sizeof(wifi_radio_stat) + sizeof(wifi_iface_stat)+1);
 	if (output == NULL) {
 		RTW_DBG("Allocate lstats info buffer fail!\n");
-}
+		return -ENOMEM;
+	}
 
 	radio = (wifi_radio_stat *)output;
 
@@ -1254,6 +1255,32 @@ static int rtw_cfgvendor_lstats_get_info(struct wiphy *wiphy,
 	radio->on_time_gscan = 0;
 	radio->on_time_pno_scan = 0;
 	radio->on_time_hs20 = 0;
+
+	iface = (wifi_iface_stat *)(output + sizeof(wifi_radio_stat));
+	_rtw_memset(iface, 0, sizeof(wifi_iface_stat));
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+	{
+		_adapter *iface_adapter = (_adapter *)rtw_netdev_priv(wdev_to_ndev(wdev));
+		struct rtw_lstats_snap *snap;
+		int i;
+
+		/* served from watchdog snapshot, no data path lock taken here */
+		snap = rtw_malloc(sizeof(*snap));
+		if (snap) {
+			rtw_lstats_read(iface_adapter, snap);
+			iface->mgmt_rx = snap->cnt.mgmt_rx;
+			iface->mgmt_action_rx = snap->cnt.mgmt_action_rx;
+			for (i = 0; i < WIFI_AC_MAX; i++) {
+				iface->ac[i].ac = i;
+				iface->ac[i].tx_mpdu = snap->cnt.tx_mpdu[i];
+				iface->ac[i].rx_mpdu = snap->cnt.rx_mpdu[i];
+				iface->ac[i].tx_mcast = snap->cnt.tx_mcast[i];
+				iface->ac[i].rx_mcast = snap->cnt.rx_mcast[i];
+			}
+			rtw_mfree(snap, sizeof(*snap));
+		}
+	}
+#endif /* CONFIG_RTW_LSTATS_SNAPSHOT */
 	#ifdef CONFIG_RTW_WIFI_HAL_DEBUG
 	RTW_INFO("==== %s ====\n", __func__);
 	RTW_INFO("radio->radio : %d\n", (radio->radio));
@@ -1287,6 +1314,9 @@ static int rtw_cfgvendor_lstats_clear_info(struct wiphy *wiphy,
 {
 	int err = 0;
 	RTW_INFO("%s\n", __func__);
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+	rtw_lstats_clear((_adapter *)rtw_netdev_priv(wdev_to_ndev(wdev)));
+#endif
 	return err;
 }
 #endif /* CONFIG_RTW_CFGVEDNOR_LLSTATS */
@@ -1478,4 +1508,281 @@ int rtw_cfgvendor_detach(struct wiphy *wiphy)
 }
 #endif /* (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 14, 0)) || defined(RTW_VENDOR_EXT_SUPPORT) */
 
+
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+const u8 rtw_lstats_tid_to_ac[8] = {
+	WIFI_AC_BE, WIFI_AC_BK, WIFI_AC_BK, WIFI_AC_BE,
+	WIFI_AC_VI, WIFI_AC_VI, WIFI_AC_VO, WIFI_AC_VO,
+};
+
+#define RTW_LSTATS_CNT_NUM (sizeof(struct rtw_lstats_cnt) / sizeof(u32))
+
+int rtw_lstats_init(_adapter *adapter)
+{
+	struct rtw_lstats_priv *lstats = &adapter->lstats;
+
+	_rtw_memset(lstats, 0, sizeof(*lstats));
+	ATOMIC_SET(&lstats->clear_req, 0);
+	ATOMIC_SET(&lstats->read_cnt, 0);
+	ATOMIC_SET(&lstats->read_retry_cnt, 0);
+
+	lstats->pcpu = alloc_percpu(struct rtw_lstats_cnt);
+	if (!lstats->pcpu)
+		return _FAIL;
+
+	return _SUCCESS;
+}
+
+void rtw_lstats_deinit(_adapter *adapter)
+{
+	struct rtw_lstats_priv *lstats = &adapter->lstats;
+
+	if (lstats->pcpu) {
+		free_percpu(lstats->pcpu);
+		lstats->pcpu = NULL;
+	}
+}
+
+static void rtw_lstats_fold_peers(_adapter *adapter, struct rtw_lstats_snap *snap)
+{
+	struct sta_priv *pstapriv = &adapter->stapriv;
+	struct sta_info *psta;
+	struct rtw_lstats_peer *peer;
+	_list *plist, *phead;
+	_irqL irqL;
+	u8 bc_addr[ETH_ALEN] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+	u8 null_addr[ETH_ALEN] = {0};
+	int i;
+
+	snap->peer_num = 0;
+
+	_enter_critical_bh(&pstapriv->sta_hash_lock, &irqL);
+	for (i = 0; i < NUM_STA && snap->peer_num < RTW_LSTATS_PEER_NUM; i++) {
+		phead = &(pstapriv->sta_hash[i]);
+		plist = get_next(phead);
+		while ((rtw_end_of_queue_search(phead, plist)) == _FALSE) {
+			psta = LIST_CONTAINOR(plist, struct sta_info, hash_list);
+			plist = get_next(plist);
+
+			if (_rtw_memcmp(psta->cmn.mac_addr, bc_addr, ETH_ALEN) == _TRUE
+				|| _rtw_memcmp(psta->cmn.mac_addr, null_addr, ETH_ALEN) == _TRUE
+				|| _rtw_memcmp(psta->cmn.mac_addr, adapter_mac_addr(adapter), ETH_ALEN) == _TRUE)
+				continue;
+
+			peer = &snap->peer[snap->peer_num];
+			_rtw_memcpy(peer->addr, psta->cmn.mac_addr, ETH_ALEN);
+			#ifdef CONFIG_TDLS
+			if (psta->tdls_sta_state & TDLS_LINKED_STATE)
+				peer->type = WIFI_PEER_TDLS;
+			else
+			#endif
+			if (MLME_IS_STA(adapter))
+				peer->type = WIFI_PEER_AP;
+			else
+				peer->type = WIFI_PEER_STA;
+			peer->rssi = psta->cmn.rssi_stat.rssi;
+			peer->tx_pkts = psta->sta_stats.tx_pkts;
+			peer->rx_pkts = psta->sta_stats.rx_data_pkts;
+			peer->tx_bytes = psta->sta_stats.tx_bytes;
+			peer->rx_bytes = psta->sta_stats.rx_bytes;
+
+			if (++snap->peer_num >= RTW_LSTATS_PEER_NUM)
+				break;
+		}
+	}
+	_exit_critical_bh(&pstapriv->sta_hash_lock, &irqL);
+}
+
+/* called from watchdog, the only writer of snap[] */
+void rtw_lstats_fold(_adapter *adapter)
+{
+	struct rtw_lstats_priv *lstats = &adapter->lstats;
+	struct rtw_lstats_snap *snap;
+	struct rtw_lstats_cnt sum;
+	u32 *dst, *src, *base;
+	int cpu, i;
+	u8 w;
+
+	if (!lstats->pcpu)
+		return;
+
+	_rtw_memset(&sum, 0, sizeof(sum));
+	for_each_possible_cpu(cpu) {
+		src = (u32 *)per_cpu_ptr(lstats->pcpu, cpu);
+		dst = (u32 *)&sum;
+		for (i = 0; i < RTW_LSTATS_CNT_NUM; i++)
+			dst[i] += src[i];
+	}
+
+	if (ATOMIC_READ(&lstats->clear_req)) {
+		ATOMIC_SET(&lstats->clear_req, 0);
+		_rtw_memcpy(&lstats->base, &sum, sizeof(sum));
+	}
+
+	w = !lstats->cur;
+	snap = &lstats->snap[w];
+	snap->seq++;
+	smp_wmb();
+
+	dst = (u32 *)&snap->cnt;
+	src = (u32 *)&sum;
+	base = (u32 *)&lstats->base;
+	for (i = 0; i < RTW_LSTATS_CNT_NUM; i++)
+		dst[i] = src[i] - base[i];
+
+	rtw_lstats_fold_peers(adapter, snap);
+	snap->time = rtw_get_current_time();
+
+	smp_wmb();
+	snap->seq++;
+	smp_wmb();
+	lstats->cur = w;
+	lstats->fold_cnt++;
+}
+
+/* counters restart from zero at next fold */
+void rtw_lstats_clear(_adapter *adapter)
+{
+	ATOMIC_SET(&adapter->lstats.clear_req, 1);
+}
+
+void rtw_lstats_read(_adapter *adapter, struct rtw_lstats_snap *out)
+{
+	struct rtw_lstats_priv *lstats = &adapter->lstats;
+	struct rtw_lstats_snap *snap;
+	u32 seq;
+
+	while (1) {
+		smp_rmb();
+		snap = &lstats->snap[lstats->cur];
+		seq = snap->seq;
+		smp_rmb();
+		_rtw_memcpy(out, snap, sizeof(*out));
+		smp_rmb();
+		if (!(seq & 1) && seq == snap->seq)
+			break;
+		ATOMIC_INC(&lstats->read_retry_cnt);
+	}
+
+	ATOMIC_INC(&lstats->read_cnt);
+}
+
+void rtw_lstats_dump(void *sel, _adapter *adapter)
+{
+	struct rtw_lstats_priv *lstats = &adapter->lstats;
+	struct rtw_lstats_snap *snap;
+	struct rtw_lstats_peer *peer;
+	static const char *const ac_str[WIFI_AC_MAX] = {"VO", "VI", "BE", "BK"};
+	int i;
+
+	snap = rtw_malloc(sizeof(*snap));
+	if (!snap)
+		return;
+
+	rtw_lstats_read(adapter, snap);
+
+	RTW_PRINT_SEL(sel, "fold:%u read:%d read_retry:%d age:%ums\n"
+		, lstats->fold_cnt, ATOMIC_READ(&lstats->read_cnt), ATOMIC_READ(&lstats->read_retry_cnt)
+		, snap->time ? rtw_get_passing_time_ms(snap->time) : 0);
+	RTW_PRINT_SEL(sel, "mgmt_rx:%u mgmt_action_rx:%u\n"
+		, snap->cnt.mgmt_rx, snap->cnt.mgmt_action_rx);
+	RTW_PRINT_SEL(sel, "%-3s %10s %10s %10s %10s\n", "ac", "tx_mpdu", "rx_mpdu", "tx_mcast", "rx_mcast");
+	for (i = 0; i < WIFI_AC_MAX; i++) {
+		RTW_PRINT_SEL(sel, "%-3s %10u %10u %10u %10u\n", ac_str[i]
+			, snap->cnt.tx_mpdu[i], snap->cnt.rx_mpdu[i]
+			, snap->cnt.tx_mcast[i], snap->cnt.rx_mcast[i]);
+	}
+
+	for (i = 0; i < snap->peer_num; i++) {
+		peer = &snap->peer[i];
+		RTW_PRINT_SEL(sel, MAC_FMT" type:%u rssi:%d tx:%llu/%lluB rx:%llu/%lluB\n"
+			, MAC_ARG(peer->addr), peer->type, peer->rssi
+			, peer->tx_pkts, peer->tx_bytes, peer->rx_pkts, peer->rx_bytes);
+	}
+
+	rtw_mfree(snap, sizeof(*snap));
+}
+
+struct rtw_lstats_bench_reader {
+	_adapter *adapter;
+	struct task_struct *thread;
+	struct rtw_lstats_snap snap;
+	u32 read_cnt;
+};
+
+static int rtw_lstats_bench_thread(void *data)
+{
+	struct rtw_lstats_bench_reader *reader = data;
+
+	while (!kthread_should_stop()) {
+		rtw_lstats_read(reader->adapter, &reader->snap);
+		reader->read_cnt++;
+		cond_resched();
+	}
+
+	return 0;
+}
+
+static u64 rtw_lstats_bench_trx_bytes(_adapter *adapter)
+{
+	return adapter->xmitpriv.tx_bytes + adapter->recvpriv.rx_bytes;
+}
+
+/*
+ * Measure TRX throughput over ms without readers, then over ms with
+ * reader_num threads polling the snapshot back to back.
+ */
+void rtw_lstats_bench(void *sel, _adapter *adapter, u8 reader_num, u32 ms)
+{
+	struct rtw_lstats_bench_reader *readers;
+	u64 bytes, base_kbps, bench_kbps;
+	u32 retry, read_cnt = 0;
+	u8 started = 0;
+	int i;
+
+	if (reader_num < 1)
+		reader_num = 1;
+	reader_num = rtw_min(reader_num, 8);
+	if (ms < 100)
+		ms = 100;
+	ms = rtw_min(ms, 10000);
+
+	readers = rtw_zvmalloc(sizeof(*readers) * reader_num);
+	if (!readers) {
+		RTW_PRINT_SEL(sel, "lstats bench: no memory\n");
+		return;
+	}
+
+	bytes = rtw_lstats_bench_trx_bytes(adapter);
+	rtw_msleep_os(ms);
+	base_kbps = rtw_division64((rtw_lstats_bench_trx_bytes(adapter) - bytes) * 8, ms);
+
+	retry = ATOMIC_READ(&adapter->lstats.read_retry_cnt);
+	bytes = rtw_lstats_bench_trx_bytes(adapter);
+	for (i = 0; i < reader_num; i++) {
+		readers[i].adapter = adapter;
+		readers[i].thread = kthread_run(rtw_lstats_bench_thread, &readers[i], "rtw_lstats_%d", i);
+		if (IS_ERR(readers[i].thread)) {
+			readers[i].thread = NULL;
+			break;
+		}
+		started++;
+	}
+	rtw_msleep_os(ms);
+	for (i = 0; i < started; i++) {
+		kthread_stop(readers[i].thread);
+		read_cnt += readers[i].read_cnt;
+	}
+	bench_kbps = rtw_division64((rtw_lstats_bench_trx_bytes(adapter) - bytes) * 8, ms);
+	retry = ATOMIC_READ(&adapter->lstats.read_retry_cnt) - retry;
+
+	RTW_PRINT_SEL(sel, "lstats bench: readers:%u ms:%u reads:%u (%u/s) retry:%u\n"
+		, started, ms, read_cnt, (u32)rtw_division64((u64)read_cnt * 1000, ms), retry);
+	RTW_PRINT_SEL(sel, "lstats bench: trx %llu kbps idle, %llu kbps polling\n"
+		, base_kbps, bench_kbps);
+
+	rtw_vmfree(readers, sizeof(*readers) * reader_num);
+}
+#endif /* CONFIG_RTW_LSTATS_SNAPSHOT */
+
 #endif /* CONFIG_IOCTL_CFG80211 */
@@ -542,6 +542,97 @@ typedef struct {
 #define WIFI_STATS_IFACE_AC           0x00000040      // all ac statistics (within interface statistics)
 #define WIFI_STATS_IFACE_CONTENTION   0x00000080      // all contention (min, max, avg) statistics (within ac statisctics)
 
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+/*
+ * Data path counts into per-CPU counters without lock. Watchdog folds them
+ * with per-station counters into the back buffer of snap[] and flips cur,
+ * so vendor commands and proc read a consistent copy without taking
+ * sta_hash_lock or xmit locks.
+ */
+#define RTW_LSTATS_PEER_NUM 8
+
+struct rtw_lstats_cnt {
+	u32 tx_mpdu[WIFI_AC_MAX];
+	u32 rx_mpdu[WIFI_AC_MAX];
+	u32 tx_mcast[WIFI_AC_MAX];
+	u32 rx_mcast[WIFI_AC_MAX];
+	u32 mgmt_rx;
+	u32 mgmt_action_rx;
+};
+
+struct rtw_lstats_peer {
+	u8 addr[ETH_ALEN];
+	u8 type;		/* wifi_peer_type */
+	s8 rssi;
+	u64 tx_pkts;
+	u64 rx_pkts;
+	u64 tx_bytes;
+	u64 rx_bytes;
+};
+
+struct rtw_lstats_snap {
+	u32 seq;		/* odd while buffer is being written */
+	systime time;
+	struct rtw_lstats_cnt cnt;
+	u8 peer_num;
+	struct rtw_lstats_peer peer[RTW_LSTATS_PEER_NUM];
+};
+
+struct rtw_lstats_priv {
+	struct rtw_lstats_cnt __percpu *pcpu;
+	struct rtw_lstats_cnt base;	/* sum at last clear */
+	ATOMIC_T clear_req;
+
+	struct rtw_lstats_snap snap[2];
+	u8 cur;
+
+	u32 fold_cnt;
+	ATOMIC_T read_cnt;
+	ATOMIC_T read_retry_cnt;
+};
+
+extern const u8 rtw_lstats_tid_to_ac[8];
+
+static inline void rtw_lstats_count(struct rtw_lstats_priv *lstats, u8 tx, u8 priority, u8 mcast, u32 num)
+{
+	u8 ac;
+
+	if (!lstats->pcpu)
+		return;
+
+	ac = rtw_lstats_tid_to_ac[priority & 0x07];
+	if (tx) {
+		if (mcast)
+			this_cpu_add(lstats->pcpu->tx_mcast[ac], num);
+		else
+			this_cpu_add(lstats->pcpu->tx_mpdu[ac], num);
+	} else {
+		if (mcast)
+			this_cpu_add(lstats->pcpu->rx_mcast[ac], num);
+		else
+			this_cpu_add(lstats->pcpu->rx_mpdu[ac], num);
+	}
+}
+
+static inline void rtw_lstats_count_mgmt_rx(struct rtw_lstats_priv *lstats, u8 action)
+{
+	if (!lstats->pcpu)
+		return;
+
+	this_cpu_inc(lstats->pcpu->mgmt_rx);
+	if (action)
+		this_cpu_inc(lstats->pcpu->mgmt_action_rx);
+}
+
+int rtw_lstats_init(_adapter *adapter);
+void rtw_lstats_deinit(_adapter *adapter);
+void rtw_lstats_fold(_adapter *adapter);
+void rtw_lstats_clear(_adapter *adapter);
+void rtw_lstats_read(_adapter *adapter, struct rtw_lstats_snap *snap);
+void rtw_lstats_dump(void *sel, _adapter *adapter);
+void rtw_lstats_bench(void *sel, _adapter *adapter, u8 reader_num, u32 ms);
+#endif /* CONFIG_RTW_LSTATS_SNAPSHOT */
+
 #endif /* CONFIG_RTW_CFGVEDNOR_LLSTATS */
 
 
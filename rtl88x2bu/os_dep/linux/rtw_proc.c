@@ -1003,6 +1003,16 @@ static int proc_get_chan_plan(struct seq_file *m, void *v)
 	return 0;
 }
 
+static int proc_get_chset_map_test(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	rtw_chset_map_test(m, adapter);
+
+	return 0;
+}
+
 static ssize_t proc_set_chan_plan(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
 {
 	struct net_device *dev = data;
@@ -1456,6 +1466,90 @@ exit:
 	return count;
 }
 
+static int proc_get_radar_evt(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	dump_radar_evt(m, adapter_to_rfctl(adapter));
+
+	return 0;
+}
+
+static ssize_t proc_set_radar_evt(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct rf_ctl_t *rfctl = adapter_to_rfctl(adapter);
+	struct radar_evt_ctl *ctl = &rfctl->radar_evt;
+	char tmp[256] = {0};
+	char cmd[8] = {0};
+	u8 region;
+	u16 min_short, min_long, window_ms;
+	u8 confirm_num;
+	int truth_idx;
+	struct radar_evt *trace;
+	u16 num = 0;
+	char *c;
+	int n;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp) - 1) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (!buffer || copy_from_user(tmp, buffer, count))
+		goto exit;
+
+	if (sscanf(tmp, "%7s", cmd) != 1)
+		goto exit;
+
+	if (strcmp(cmd, "clear") == 0) {
+		ctl->ring_idx = ctl->ring_num = 0;
+		ctl->poll_cnt = ctl->trig_cnt = ctl->confirm_cnt = ctl->reject_cnt = 0;
+		_rtw_memset(&ctl->replay, 0, sizeof(ctl->replay));
+
+	} else if (strcmp(cmd, "pattern") == 0) {
+		/* pattern <region> <min_short> <min_long> <confirm_num> <window_ms> */
+		if (sscanf(tmp, "%*s %hhu %hu %hu %hhu %hu", &region, &min_short, &min_long, &confirm_num, &window_ms) != 5
+			|| region >= RADAR_EVT_REGION_NUM)
+			goto exit;
+
+		ctl->pattern[region].min_short_pulse = min_short;
+		ctl->pattern[region].min_long_pulse = min_long;
+		ctl->pattern[region].confirm_num = confirm_num;
+		ctl->pattern[region].window_ms = window_ms;
+
+	} else if (strcmp(cmd, "replay") == 0) {
+		/* replay <region> <truth_idx> <short>:<long>:<flags> ... */
+		if (sscanf(tmp, "%*s %hhu %d%n", &region, &truth_idx, &n) != 2)
+			goto exit;
+
+		trace = rtw_zmalloc(sizeof(*trace) * RADAR_EVT_REPLAY_MAX);
+		if (!trace)
+			goto exit;
+
+		c = tmp + n;
+		while (num < RADAR_EVT_REPLAY_MAX
+			&& sscanf(c, " %hu:%hu:%hhx%n", &trace[num].short_pulse, &trace[num].long_pulse, &trace[num].flags, &n) == 3
+		) {
+			c += n;
+			num++;
+		}
+
+		if (num)
+			rtw_radar_evt_replay(ctl, region, truth_idx, trace, num);
+
+		rtw_mfree(trace, sizeof(*trace) * RADAR_EVT_REPLAY_MAX);
+	}
+
+exit:
+	return count;
+}
+
 static int proc_get_dfs_ch_sel_d_flags(struct seq_file *m, void *v)
 {
 	struct net_device *dev = m->private;
@@ -1894,8 +1988,27 @@ static int proc_get_tx_power_limit(struct seq_file *m, void *v)
 
 	return 0;
 }
+
+static int proc_get_tx_power_limit_tbl_chk(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	dump_txpwr_lmt_tbl_chk(m, adapter);
+
+	return 0;
+}
 #endif /* CONFIG_TXPWR_LIMIT */
 
+#ifdef CONFIG_WAPI_SUPPORT
+static int proc_get_sms4_selftest(struct seq_file *m, void *v)
+{
+	rtw_sms4_selftest(m);
+
+	return 0;
+}
+#endif
+
 static int proc_get_tx_power_ext_info(struct seq_file *m, void *v)
 {
 	struct net_device *dev = m->private;
@@ -3115,6 +3228,40 @@ static int proc_get_mesh_stats(struct seq_file *m, void *v)
 	return 0;
 }
 
+static ssize_t proc_set_mesh_fwd_bench(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32] = {0};
+	u8 mda[ETH_ALEN];
+	u32 num;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp) - 1) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		/* <num> <mda> */
+		if (sscanf(tmp, "%u "MAC_SFMT, &num, MAC_SARG(mda)) == 7)
+			rtw_mesh_fwd_bench(RTW_DBGDUMP, adapter, mda, rtw_min(num, 1000000));
+		else
+			RTW_INFO("invalid mesh_fwd_bench parameter!\n");
+	}
+
+	return count;
+}
+
+static int proc_get_mesh_mrc_bench(struct seq_file *m, void *v)
+{
+	rtw_mrc_bench(m);
+
+	return 0;
+}
+
 static int proc_get_mesh_gate_timeout(struct seq_file *m, void *v)
 {
 	struct net_device *dev = m->private;
@@ -3157,6 +3304,52 @@ exit:
 }
 #endif /* CONFIG_RTW_MESH */
 
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+static int proc_get_lstats(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	rtw_lstats_dump(m, adapter);
+
+	return 0;
+}
+
+static ssize_t proc_set_lstats(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32];
+	char cmd[8] = {0};
+	u32 reader_num = 0, ms = 0;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		/* clear | bench <readers> <ms> */
+		int num = sscanf(tmp, "%7s %u %u", cmd, &reader_num, &ms);
+
+		if (num < 1)
+			return count;
+
+		if (strcmp(cmd, "clear") == 0)
+			rtw_lstats_clear(adapter);
+		else if (strcmp(cmd, "bench") == 0 && num == 3)
+			rtw_lstats_bench(RTW_DBGDUMP, adapter, rtw_min(reader_num, 0xFF), ms);
+		else
+			RTW_INFO("invalid lstats parameter!\n");
+	}
+
+	return count;
+}
+#endif /* CONFIG_RTW_LSTATS_SNAPSHOT */
+
 /*
 * rtw_adapter_proc:
 * init/deinit when register/unregister net_device
@@ -3204,6 +3397,7 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("roam_flags", proc_get_roam_flags, proc_set_roam_flags),
 	RTW_PROC_HDL_SSEQ("roam_param", proc_get_roam_param, proc_set_roam_param),
 	RTW_PROC_HDL_SSEQ("roam_tgt_addr", NULL, proc_set_roam_tgt_addr),
+	RTW_PROC_HDL_SSEQ("roam_pred", proc_get_roam_pred, proc_set_roam_pred),
 #endif /* CONFIG_LAYER2_ROAMING */
 
 #ifdef CONFIG_RTW_80211R
@@ -3234,6 +3428,9 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("aid_status", proc_get_aid_status, proc_set_aid_status),
 	RTW_PROC_HDL_SSEQ("all_sta_info", proc_get_all_sta_info, NULL),
 	RTW_PROC_HDL_SSEQ("bmc_tx_rate", proc_get_bmc_tx_rate, proc_set_bmc_tx_rate),
+#ifdef CONFIG_NATIVEAP_MLME
+	RTW_PROC_HDL_SSEQ("probersp", proc_get_probersp, proc_set_probersp),
+#endif
 #endif /* CONFIG_AP_MODE */
 
 #ifdef DBG_MEMORY_LEAK
@@ -3282,6 +3479,7 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 
 #if defined(DBG_CONFIG_ERROR_DETECT)
 	RTW_PROC_HDL_SSEQ("sreset", proc_get_sreset, proc_set_sreset),
+	RTW_PROC_HDL_SSEQ("sreset_tier", proc_get_sreset_tier, proc_set_sreset_tier),
 #endif /* DBG_CONFIG_ERROR_DETECT */
 	RTW_PROC_HDL_SSEQ("trx_info_debug", proc_get_trx_info_debug, NULL),
 	RTW_PROC_HDL_SSEQ("linked_info_dump", proc_get_linked_info_dump, proc_set_linked_info_dump),
@@ -3336,6 +3534,7 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 #endif
 	RTW_PROC_HDL_SSEQ("country_code", proc_get_country_code, proc_set_country_code),
 	RTW_PROC_HDL_SSEQ("chan_plan", proc_get_chan_plan, proc_set_chan_plan),
+	RTW_PROC_HDL_SSEQ("chset_map_test", proc_get_chset_map_test, NULL),
 #if CONFIG_RTW_MACADDR_ACL
 	RTW_PROC_HDL_SSEQ("macaddr_acl", proc_get_macaddr_acl, proc_set_macaddr_acl),
 #endif
@@ -3347,6 +3546,7 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("dfs_master_test_case", proc_get_dfs_master_test_case, proc_set_dfs_master_test_case),
 	RTW_PROC_HDL_SSEQ("update_non_ocp", NULL, proc_set_update_non_ocp),
 	RTW_PROC_HDL_SSEQ("radar_detect", NULL, proc_set_radar_detect),
+	RTW_PROC_HDL_SSEQ("radar_evt", proc_get_radar_evt, proc_set_radar_evt),
 	RTW_PROC_HDL_SSEQ("dfs_ch_sel_d_flags", proc_get_dfs_ch_sel_d_flags, proc_set_dfs_ch_sel_d_flags),
 #endif
 	RTW_PROC_HDL_SSEQ("new_bcn_max", proc_get_new_bcn_max, proc_set_new_bcn_max),
@@ -3361,6 +3561,7 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("tx_power_by_rate", proc_get_tx_power_by_rate, NULL),
 #ifdef CONFIG_TXPWR_LIMIT
 	RTW_PROC_HDL_SSEQ("tx_power_limit", proc_get_tx_power_limit, NULL),
+	RTW_PROC_HDL_SSEQ("tx_power_limit_tbl_chk", proc_get_tx_power_limit_tbl_chk, NULL),
 #endif
 	RTW_PROC_HDL_SSEQ("tx_power_ext_info", proc_get_tx_power_ext_info, proc_set_tx_power_ext_info),
 	RTW_PROC_HDL_SEQ("tx_power_idx", &seq_ops_tx_power_idx, NULL),
@@ -3379,6 +3580,8 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 #ifdef CONFIG_TDLS
 	RTW_PROC_HDL_SSEQ("tdls_info", proc_get_tdls_info, NULL),
 	RTW_PROC_HDL_SSEQ("tdls_enable", proc_get_tdls_enable, proc_set_tdls_enable),
+	RTW_PROC_HDL_SSEQ("tdls_auto", proc_get_tdls_auto, proc_set_tdls_auto),
+	RTW_PROC_HDL_SSEQ("tdls_auto_test", proc_get_tdls_auto_test, NULL),
 #endif
 	RTW_PROC_HDL_SSEQ("monitor", proc_get_monitor, proc_set_monitor),
 
@@ -3392,7 +3595,10 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 #endif
 
 #ifdef CONFIG_PREALLOC_RX_SKB_BUFFER
-	RTW_PROC_HDL_SSEQ("rtkm_info", proc_get_rtkm_info, NULL),
+	RTW_PROC_HDL_SSEQ("rtkm_info", proc_get_rtkm_info, proc_set_rtkm_info),
+#endif
+#ifdef CONFIG_RTW_80211K
+	RTW_PROC_HDL_SSEQ("rm_bcn_cache", proc_get_rm_bcn_cache, proc_set_rm_bcn_cache),
 #endif
 	RTW_PROC_HDL_SSEQ("efuse_map", proc_get_efuse_map, NULL),
 #ifdef CONFIG_IEEE80211W
@@ -3411,6 +3617,9 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("rx_stat", proc_get_rx_stat, NULL),
 
 	RTW_PROC_HDL_SSEQ("tx_stat", proc_get_tx_stat, NULL),
+#ifdef CONFIG_WAPI_SUPPORT
+	RTW_PROC_HDL_SSEQ("sms4_selftest", proc_get_sms4_selftest, NULL),
+#endif
 	/**** PHY Capability ****/
 	RTW_PROC_HDL_SSEQ("phy_cap", proc_get_phy_cap, NULL),
 
@@ -3419,6 +3628,9 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("ldpc_cap", proc_get_ldpc_cap, proc_set_ldpc_cap),
 #ifdef CONFIG_BEAMFORMING
 	RTW_PROC_HDL_SSEQ("txbf_cap", proc_get_txbf_cap, proc_set_txbf_cap),
+#ifdef RTW_BEAMFORMING_VERSION_2
+	RTW_PROC_HDL_SSEQ("bf_sched", proc_get_bf_sched, proc_set_bf_sched),
+#endif
 #endif
 
 #ifdef CONFIG_SUPPORT_TRX_SHARED
@@ -3459,8 +3671,14 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("mesh_b2u_flags", proc_get_mesh_b2u_flags, proc_set_mesh_b2u_flags),
 	#endif
 	RTW_PROC_HDL_SSEQ("mesh_stats", proc_get_mesh_stats, NULL),
+	RTW_PROC_HDL_SSEQ("mesh_mrc_bench", proc_get_mesh_mrc_bench, NULL),
+	RTW_PROC_HDL_SSEQ("mesh_fwd_bench", NULL, proc_set_mesh_fwd_bench),
 	RTW_PROC_HDL_SSEQ("mesh_gate_timeout_factor", proc_get_mesh_gate_timeout, proc_set_mesh_gate_timeout),
 #endif
+
+#ifdef CONFIG_RTW_LSTATS_SNAPSHOT
+	RTW_PROC_HDL_SSEQ("lstats", proc_get_lstats, proc_set_lstats),
+#endif
 };
 
 const int adapter_proc_hdls_num = sizeof(adapter_proc_hdls) / sizeof(struct rtw_proc_hdl);
@@ -3559,6 +3777,44 @@ ssize_t proc_set_odm_adaptivity(struct file *file, const char __user *buffer, si
 	return count;
 }
 
+int proc_get_odm_watchdog_io(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+
+	rtw_odm_watchdog_io_msg(m, padapter);
+
+	return 0;
+}
+
+ssize_t proc_set_odm_watchdog_io(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32];
+	u8 fa_snapshot_en;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		int num = sscanf(tmp, "%hhu", &fa_snapshot_en);
+
+		if (num != 1)
+			return count;
+
+		rtw_odm_watchdog_io_set(padapter, fa_snapshot_en);
+	}
+
+	return count;
+}
+
 static char *phydm_msg = NULL;
 #define PHYDM_MSG_LEN	80*24
 
@@ -3633,6 +3889,7 @@ ssize_t proc_set_phydm_cmd(struct file *file, const char __user *buffer, size_t
 const struct rtw_proc_hdl odm_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("adaptivity", proc_get_odm_adaptivity, proc_set_odm_adaptivity),
 	RTW_PROC_HDL_SSEQ("cmd", proc_get_phydm_cmd, proc_set_phydm_cmd),
+	RTW_PROC_HDL_SSEQ("watchdog_io", proc_get_odm_watchdog_io, proc_set_odm_watchdog_io),
 };
 
 const int odm_proc_hdls_num = sizeof(odm_proc_hdls) / sizeof(struct rtw_proc_hdl);
@@ -372,7 +372,16 @@ static u32 usb_bulkout_zero(struct intf_hdl *pintfhdl, u32 addr)
 
 void usb_read_mem(struct intf_hdl *pintfhdl, u32 addr, u32 cnt, u8 *rmem)
 {
-
+	u16 len;
+
+	/* consecutive registers, one vendor request per MAX_VENDOR_REQ_CMD_SIZE */
+	while (cnt) {
+		len = (cnt > MAX_VENDOR_REQ_CMD_SIZE) ? MAX_VENDOR_REQ_CMD_SIZE : cnt;
+		usbctrl_vendorreq(pintfhdl, 0x05, (u16)(addr & 0x0000ffff), 0, rmem, len, 0x01);
+		addr += len;
+		rmem += len;
+		cnt -= len;
+	}
 }
 
 void usb_write_mem(struct intf_hdl *pintfhdl, u32 addr, u32 cnt, u8 *wmem)
@@ -878,6 +887,8 @@ void usb_recv_tasklet(void *priv)
 				, rtw_is_drv_stopped(padapter) ? "True" : "False"
 				, rtw_is_surprise_removed(padapter) ? "True" : "False");
 			#ifdef CONFIG_PREALLOC_RX_SKB_BUFFER
+			skb_reset_tail_pointer(pskb);
+			pskb->len = 0;
 			if (rtw_free_skb_premem(pskb) != 0)
 			#endif /* CONFIG_PREALLOC_RX_SKB_BUFFER */
 				rtw_skb_free(pskb);
@@ -1005,6 +1016,14 @@ u32 usb_read_port(struct intf_hdl *pintfhdl, u32 addr, u32 cnt, u8 *rmem)
 			goto recv_buf_hook;
 
 		#ifndef CONFIG_FIX_NR_BULKIN_BUFFER
+		#ifdef CONFIG_PREALLOC_RX_SKB_BUFFER
+		/* pool buffers are used as is, same as in usb_init_recv_priv() */
+		precvbuf->pskb = rtw_alloc_skb_premem(MAX_RECVBUF_SZ);
+		if (NULL != precvbuf->pskb) {
+			precvbuf->pskb->dev = adapter->pnetdev;
+			goto recv_buf_hook;
+		}
+		#endif /* CONFIG_PREALLOC_RX_SKB_BUFFER */
 		precvbuf->pskb = rtw_skb_alloc(MAX_RECVBUF_SZ + RECVBUFF_ALIGN_SZ);
 		#endif
 